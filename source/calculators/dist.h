@@ -11,21 +11,69 @@
 
 #include "mothur.h"
 #include "sequence.hpp"
+#include "encodedsequence.h"
 
 /**************************************************************************************************/
 
 class Dist {
 	
 public:
-	Dist(){ dist = 0; m = MothurOut::getInstance(); }
-	Dist(const Dist& d) : dist(d.dist) { m = MothurOut::getInstance(); }
+	Dist(){ dist = 0; cutoff = 1.0; m = MothurOut::getInstance(); }
+	Dist(const Dist& d) : dist(d.dist), cutoff(d.cutoff) { m = MothurOut::getInstance(); }
 	virtual ~Dist() {}
 	virtual void calcDist(Sequence, Sequence) = 0;
+	//faster when each sequence is compared many times, the calculators give the same distance either way
+	virtual void calcDist(const EncodedSequence& A, const EncodedSequence& B) {	calcDist(A.getSequence(), B.getSequence());	}
 	double getDist()	{	return dist;	}
+	
+	//the encoded calculators stop as soon as a pair is sure to be further apart than the cutoff, and getDist returns a
+	//value above the cutoff instead of the distance.  Only set it if the distances above the cutoff are not used.
+	void setCutoff(double c)	{	cutoff = c;		}
 
 protected:
 	double dist;
+	double cutoff;
 	MothurOut* m;
+	
+	//every column left to count either has a residue in both sequences, or adds to the differences, so the distance
+	//is at least differences / (length + the fewest residues left in either sequence)
+	bool aboveCutoff(int difference, int length, int residuesLeft) {
+		if ((cutoff >= 1.0) || (difference == 0)) { return false; }
+		
+		double lowest = (double)difference / (double)(length + residuesLeft);
+		if (lowest > cutoff) { dist = lowest; return true; }
+		return false;
+	}
+	
+	bool canUseEncoded(const EncodedSequence& A, const EncodedSequence& B) {
+		return (A.isEncoded() && B.isEncoded() && (A.getLength() == B.getLength()));
+	}
+	
+	//the one gap calculators count a run of gaps in the same sequence once.  gapA and gapB are the columns of a word with a
+	//gap in one sequence across from a base in the other, a column in closed ends the runs.  Only the first column of each
+	//run of set bits has to be checked, because a gap next to another gap in the same sequence never opens a new one.
+	int countGapOpenings(unsigned long long gapA, unsigned long long gapB, unsigned long long closed, int& openGapA, int& openGapB) {
+		int openings = 0;
+		unsigned long long check = (gapA & ~(gapA << 1)) | (gapB & ~(gapB << 1));
+		unsigned long long done = 0;
+		
+		while (check) {
+			unsigned long long bit = check & (~check + 1);
+			if (closed & (bit - 1) & ~done) { openGapA = 0; openGapB = 0; }
+			
+			if (gapA & bit) {
+				if (openGapA == 0) { openings++; openGapA = 1; openGapB = 0; }
+			}else {
+				if (openGapB == 0) { openings++; openGapA = 0; openGapB = 1; }
+			}
+			
+			done |= bit | (bit - 1);
+			check ^= bit;
+		}
+		if (closed & ~done) { openGapA = 0; openGapB = 0; }
+		
+		return openings;
+	}
 };
 
 /**************************************************************************************************/
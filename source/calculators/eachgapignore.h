@@ -68,6 +68,52 @@ public:
 		
 	}
 	
+	void calcDist(const EncodedSequence& A, const EncodedSequence& B){
+		if (!canUseEncoded(A, B)) { Dist::calcDist(A, B); return; }
+		
+		int diff = 0;
+		int length = 0;
+		
+		int numWords = A.getNumWords();
+		const unsigned long long* a = A.getWords();
+		const unsigned long long* b = B.getWords();
+		
+		//the first and last columns with a base in both sequences
+		int start = -1;
+		int end = -1;
+		for(int w=0;w<numWords;w++){
+			unsigned long long bothBases = EncodedSequence::bases(a+3*w) & EncodedSequence::bases(b+3*w);
+			if(bothBases){
+				start = 64 * w + EncodedSequence::lowestBit(bothBases);
+				break;
+			}
+		}
+		for(int w=numWords-1;w>=0 && start >= 0;w--){
+			unsigned long long bothBases = EncodedSequence::bases(a+3*w) & EncodedSequence::bases(b+3*w);
+			if(bothBases){
+				end = 64 * w + EncodedSequence::highestBit(bothBases);
+				break;
+			}
+		}
+		
+		//non-overlapping sequences have no columns to count
+		for(int w=(start < 0 ? numWords : start / 64);w<=end / 64;w++){
+			unsigned long long mask = EncodedSequence::columns(w, start, end + 1);
+			unsigned long long stop = (EncodedSequence::dots(a+3*w) | EncodedSequence::dots(b+3*w)) & mask;
+			if(stop){	mask &= (stop & (~stop + 1)) - 1;	}
+			
+			unsigned long long counted = ~(EncodedSequence::gaps(a+3*w) & EncodedSequence::gaps(b+3*w)) & mask;
+			diff += EncodedSequence::popCount(counted & EncodedSequence::differ(a+3*w, b+3*w));
+			length += EncodedSequence::popCount(counted);
+			
+			if(aboveCutoff(diff, length, min(A.getResiduesAfter(w), B.getResiduesAfter(w)))){	return;	}
+			
+			if(stop){	break;	}
+		}
+		
+		if(length == 0)	{	dist = 1.0000;								}
+		else			{	dist = ((double)diff  / (double)length);	}
+	}
 };
 
 /**************************************************************************************************/
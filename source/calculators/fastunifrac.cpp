@@ -0,0 +1,334 @@
+/*
+ *  fastunifrac.cpp
+ *  Mothur
+ *
+ *  Copyright 2026 Schloss Lab. All rights reserved.
+ *
+ */
+
+#include "fastunifrac.h"
+#include "threadpool.h"
+
+/**************************************************************************************************/
+
+FastUnifrac::FastUnifrac(Tree* t, bool r) {
+	try {
+		m = MothurOut::getInstance();
+		includeRoot = r;
+
+		CountTable* ct = t->getCountTable();
+		vector<string> groups = ct->getNamesOfGroups();
+		for (int i = 0; i < groups.size(); i++) {
+			columnIndex[groups[i]] = i;
+			totals.push_back(ct->getGroupCount(groups[i]));
+		}
+		numColumns = groups.size() + 1;
+		totals.push_back(0);
+
+		//number the nodes in postorder, left subtree before right
+		vector<int> rowOf(t->getNumNodes(), -1);
+		vector<int> order;
+		vector< pair<int, bool> > stack;
+		stack.push_back(make_pair(t->findRoot(), false));
+		while (stack.size() != 0) {
+			int node = stack.back().first;
+			bool childrenDone = stack.back().second;
+			stack.pop_back();
+
+			int lc = t->tree[node].getLChild();
+			int rc = t->tree[node].getRChild();
+			if (childrenDone || (lc == -1)) { rowOf[node] = order.size(); order.push_back(node); continue; }
+
+			stack.push_back(make_pair(node, true));
+			stack.push_back(make_pair(rc, false));
+			stack.push_back(make_pair(lc, false));
+		}
+
+		numNodes = order.size();
+		root = numNodes - 1;
+		leftChild.resize(numNodes, -1); rightChild.resize(numNodes, -1); parent.resize(numNodes, -1); first.resize(numNodes);
+		lengths.resize(numNodes, 0);
+		counts.resize(numNodes * numColumns, 0);
+
+		for (int row = 0; row < numNodes; row++) {
+			if (m->control_pressed) { break; }
+
+			Node& node = t->tree[order[row]];
+			if (node.getBranchLength() != -1) { lengths[row] = abs(node.getBranchLength()); }
+
+			int* abundances = &counts[row * numColumns];
+			if (node.getLChild() == -1) {
+				first[row] = row;
+				for (map<string, int>::iterator it = node.pcount.begin(); it != node.pcount.end(); it++) {
+					map<string, int>::iterator itColumn = columnIndex.find(it->first);
+					if (itColumn != columnIndex.end()) { abundances[itColumn->second] += it->second; }
+				}
+			}else {
+				int lc = rowOf[node.getLChild()];
+				int rc = rowOf[node.getRChild()];
+				leftChild[row] = lc; rightChild[row] = rc;
+				parent[lc] = row; parent[rc] = row;
+				first[row] = first[lc];
+
+				const int* left = &counts[lc * numColumns];
+				const int* right = &counts[rc * numColumns];
+				for (int j = 0; j < numColumns; j++) { abundances[j] = left[j] + right[j]; }
+			}
+		}
+	}
+	catch(exception& e) {
+		m->errorOut(e, "FastUnifrac", "FastUnifrac");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//the ancestor is the lowest branch that has all the seqs from the groups, or the parent of a leaf
+FastUnifrac::Grouping FastUnifrac::getGrouping(vector<string>& groups) {
+	try {
+		Grouping grouping;
+		for (int i = 0; i < groups.size(); i++) {
+			map<string, int>::iterator it = columnIndex.find(groups[i]);
+			if (it != columnIndex.end())	{ grouping.columns.push_back(it->second);	}
+			else							{ grouping.columns.push_back(numColumns-1);	}
+		}
+
+		const int* rootCounts = &counts[root * numColumns];
+		grouping.found = false;
+		for (int i = 0; i < grouping.columns.size(); i++) { if (rootCounts[grouping.columns[i]] != 0) { grouping.found = true; } }
+
+		grouping.start = 0;
+		grouping.end = numNodes;
+		if (includeRoot || !grouping.found) { return grouping; }
+
+		int ancestor = root;
+		while (leftChild[ancestor] != -1) {
+			int next = -1;
+			int children[2] = { leftChild[ancestor], rightChild[ancestor] };
+			for (int c = 0; c < 2; c++) {
+				bool hasAll = true;
+				for (int i = 0; i < grouping.columns.size(); i++) {
+					if (counts[children[c] * numColumns + grouping.columns[i]] != rootCounts[grouping.columns[i]]) { hasAll = false; break; }
+				}
+				if (hasAll) { next = children[c]; }
+			}
+			if (next == -1) { break; }
+			ancestor = next;
+		}
+		if ((leftChild[ancestor] == -1) && (parent[ancestor] != -1)) { ancestor = parent[ancestor]; }
+
+		grouping.start = first[ancestor];
+		grouping.end = ancestor;
+
+		return grouping;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "FastUnifrac", "getGrouping");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//the sum of the branches weighted by the difference of the groups' shares, over the sum of the leaves' distances
+double FastUnifrac::weightedScore(Grouping& grouping, const int* rows, int rowSize, vector<int>& columns, int firstRow) {
+	try {
+		double totalA = totals[grouping.columns[0]];
+		double totalB = totals[grouping.columns[1]];
+		int a = columns[0];
+		int b = columns[1];
+
+		double score = 0.0;
+		double D = 0.0;
+		for (int row = grouping.start; row < grouping.end; row++) {
+			const int* abundances = rows + (row - firstRow) * rowSize;
+			double shareA = (abundances[a] != 0) ? abundances[a] / totalA : 0.0;
+			double shareB = (abundances[b] != 0) ? abundances[b] / totalB : 0.0;
+
+			score += abs((shareA - shareB) * lengths[row]);
+			if (row != root) { D += (shareA + shareB) * lengths[row]; }
+		}
+
+		double weighted = score / D;
+		if (isnan(weighted) || isinf(weighted)) { weighted = 0; }
+
+		return weighted;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "FastUnifrac", "weightedScore");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//the branches with seqs from only one of the groups over the branches with seqs from any of them
+double FastUnifrac::unweightedScore(Grouping& grouping, const int* rows, int rowSize, vector<int>& columns, int firstRow) {
+	try {
+		double uniqueBL = 0.0;
+		double totalBL = 0.0;
+		for (int row = grouping.start; row < grouping.end; row++) {
+			const int* abundances = rows + (row - firstRow) * rowSize;
+			int numPresent = 0;
+			for (int i = 0; i < columns.size(); i++) {
+				if (abundances[columns[i]] != 0) { numPresent++; if (numPresent > 1) { break; } }
+			}
+
+			if (numPresent == 1)	{ uniqueBL += lengths[row];	}
+			if (numPresent != 0)	{ totalBL += lengths[row];	}
+		}
+
+		double unweighted = uniqueBL / totalBL;
+		if (isnan(unweighted) || isinf(unweighted)) { unweighted = 0; }
+
+		return unweighted;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "FastUnifrac", "unweightedScore");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+
+EstOutput FastUnifrac::getWeighted(vector< vector<string> >& groupings, int processors) {
+	return getValues(groupings, processors, true);
+}
+/**************************************************************************************************/
+
+EstOutput FastUnifrac::getUnweighted(vector< vector<string> >& groupings, int processors) {
+	return getValues(groupings, processors, false);
+}
+/**************************************************************************************************/
+
+vector<EstOutput> FastUnifrac::getRandomWeighted(vector< vector<string> >& groupings, int iters, int processors) {
+	return getRandomValues(groupings, iters, processors, true);
+}
+/**************************************************************************************************/
+
+vector<EstOutput> FastUnifrac::getRandomUnweighted(vector< vector<string> >& groupings, int iters, int processors) {
+	return getRandomValues(groupings, iters, processors, false);
+}
+/**************************************************************************************************/
+
+EstOutput FastUnifrac::getValues(vector< vector<string> >& groupings, int processors, bool weighted) {
+	try {
+		EstOutput results(groupings.size(), 0);
+
+		ThreadPool pool(processors);
+		int blockSize = 50;
+		for (int start = 0; start < groupings.size(); start += blockSize) {
+			int end = min(start + blockSize, (int)groupings.size());
+			pool.submit([this, &groupings, &results, start, end, weighted](int) {
+				for (int h = start; h < end; h++) {
+					if (m->control_pressed) { return; }
+
+					Grouping grouping = getGrouping(groupings[h]);
+					if (!grouping.found) {
+						if (!weighted) {
+							string names = "";
+							for (int g = 0; g < groupings[h].size(); g++) { names += ((g == 0) ? "" : "-") + groupings[h][g]; }
+							m->mothurOut("[WARNING]: cannot find a nodes in the tree from grouping " + names + ", skipping.\n");
+						}
+						continue;
+					}
+
+					if (weighted)	{ results[h] = weightedScore(grouping, &counts[0], numColumns, grouping.columns, 0);	}
+					else			{ results[h] = unweightedScore(grouping, &counts[0], numColumns, grouping.columns, 0);	}
+				}
+			});
+		}
+		pool.wait();
+
+		return results;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "FastUnifrac", "getValues");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//the seeds are drawn in order here, so the scores do not depend on the number of processors
+vector<EstOutput> FastUnifrac::getRandomValues(vector< vector<string> >& groupings, int iters, int processors, bool weighted) {
+	try {
+		vector<EstOutput> results(groupings.size(), EstOutput(iters, 0));
+		if (iters == 0) { return results; }
+
+		ThreadPool pool(processors);
+		int blockSize = 100;
+		for (int h = 0; h < groupings.size(); h++) {
+			for (int start = 0; start < iters; start += blockSize) {
+				int num = min(blockSize, iters - start);
+				unsigned seed = rand();
+				double* scores = &results[h][start];
+				pool.submit([this, &groupings, h, num, seed, weighted, scores](int) {
+					if (m->control_pressed) { return; }
+					Grouping grouping = getGrouping(groupings[h]);
+					if (grouping.found) { getRandomScores(grouping, num, seed, weighted, scores); }
+				});
+			}
+		}
+		pool.wait();
+
+		return results;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "FastUnifrac", "getRandomValues");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//the leaves with seqs from the grouping are all below the ancestor, so only those rows are summed
+void FastUnifrac::getRandomScores(Grouping& grouping, int iters, unsigned seed, bool weighted, double* scores) {
+	try {
+		int numGroups = grouping.columns.size();
+		vector<int> columns;
+		for (int i = 0; i < numGroups; i++) { columns.push_back(i); }
+
+		//the leaves that swap labels and their abundances in the grouping's groups
+		vector<int> leafIndex(grouping.end - grouping.start, -1);
+		vector<int> leafCounts;
+		for (int row = grouping.start; row < grouping.end; row++) {
+			if (leftChild[row] != -1) { continue; }
+
+			bool inGrouping = false;
+			for (int i = 0; i < numGroups; i++) { if (counts[row * numColumns + grouping.columns[i]] != 0) { inGrouping = true; } }
+			if (!inGrouping) { continue; }
+
+			leafIndex[row - grouping.start] = leafCounts.size() / numGroups;
+			for (int i = 0; i < numGroups; i++) { leafCounts.push_back(counts[row * numColumns + grouping.columns[i]]); }
+		}
+		int numLeaves = leafCounts.size() / numGroups;
+		if (grouping.start == grouping.end) { return; }
+
+		vector<int> order(numLeaves);
+		for (int i = 0; i < numLeaves; i++) { order[i] = i; }
+		vector<int> rows((grouping.end - grouping.start) * numGroups, 0);
+		unsigned long long state = seed;		//rand() is shared by the threads, so each block of random trees has its own generator
+
+		for (int iter = 0; iter < iters; iter++) {
+			if (m->control_pressed) { return; }
+
+			for (int i = numLeaves - 1; i > 0; i--) {
+				state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+				swap(order[i], order[(state >> 33) % (i + 1)]);
+			}
+
+			for (int row = grouping.start; row < grouping.end; row++) {
+				int* abundances = &rows[(row - grouping.start) * numGroups];
+				if (leftChild[row] == -1) {
+					int leaf = leafIndex[row - grouping.start];
+					if (leaf == -1) { continue; }
+					const int* swapped = &leafCounts[order[leaf] * numGroups];
+					for (int i = 0; i < numGroups; i++) { abundances[i] = swapped[i]; }
+				}else {
+					const int* left = &rows[(leftChild[row] - grouping.start) * numGroups];
+					const int* right = &rows[(rightChild[row] - grouping.start) * numGroups];
+					for (int i = 0; i < numGroups; i++) { abundances[i] = left[i] + right[i]; }
+				}
+			}
+
+			if (weighted)	{ scores[iter] = weightedScore(grouping, &rows[0], numGroups, columns, grouping.start);		}
+			else			{ scores[iter] = unweightedScore(grouping, &rows[0], numGroups, columns, grouping.start);	}
+		}
+	}
+	catch(exception& e) {
+		m->errorOut(e, "FastUnifrac", "getRandomScores");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
@@ -0,0 +1,67 @@
+#ifndef FASTUNIFRAC_H
+#define FASTUNIFRAC_H
+
+/*
+ *  fastunifrac.h
+ *  Mothur
+ *
+ *  Copyright 2026 Schloss Lab. All rights reserved.
+ *
+ */
+
+/* FastUnifrac scores the weighted and unweighted unifrac of many groupings from one table of the tree's abundances,
+ as in Hamady, Lozupone and Knight's Fast UniFrac. One postorder pass over the tree fills a row for each branch with
+ the number of seqs from each group below it, so a grouping is scored by one scan over the rows instead of by walking
+ from each leaf to the root.
+
+ The rows are kept in postorder, so the branches below a node are the rows just before it. Without the root, a
+ grouping is scored on the branches below the common ancestor of its groups' leaves, as the old calculators did.
+
+ The random trees swap the labels of the leaves that have seqs from the grouping's groups. Each random tree shuffles
+ those leaves' rows and sums them up into the branches below the ancestor, which the shuffle does not move. */
+
+#include "mothur.h"
+#include "mothurout.h"
+#include "tree.h"
+#include "treecalculator.h"
+
+/**************************************************************************************************/
+
+class FastUnifrac {
+
+public:
+	FastUnifrac(Tree*, bool);		//tree, include the root
+	~FastUnifrac() {}
+
+	EstOutput getWeighted(vector< vector<string> >&, int);		//pairs of groups, processors
+	EstOutput getUnweighted(vector< vector<string> >&, int);		//groupings, processors
+	vector<EstOutput> getRandomWeighted(vector< vector<string> >&, int, int);		//pairs of groups, iters, processors - iters scores for each pair
+	vector<EstOutput> getRandomUnweighted(vector< vector<string> >&, int, int);
+
+private:
+	struct Grouping {
+		vector<int> columns;
+		int start, end;		//the rows of the branches that are scored
+		bool found;			//the tree has seqs from the groups
+	};
+
+	MothurOut* m;
+	bool includeRoot;
+	int numNodes, numColumns, root;
+	vector<int> leftChild, rightChild, parent, first;		//rows in postorder, first is the first row below the branch
+	vector<double> lengths;			//absolute branch lengths, 0 for branches without one
+	vector<int> counts;				//numNodes rows of numColumns, the last column is empty for groups not in the tree
+	vector<double> totals;			//seqs in each group
+	map<string, int> columnIndex;
+
+	Grouping getGrouping(vector<string>&);
+	double weightedScore(Grouping&, const int*, int, vector<int>&, int);		//grouping, rows, row size, columns, row of the first branch
+	double unweightedScore(Grouping&, const int*, int, vector<int>&, int);
+	EstOutput getValues(vector< vector<string> >&, int, bool);
+	vector<EstOutput> getRandomValues(vector< vector<string> >&, int, int, bool);
+	void getRandomScores(Grouping&, int, unsigned, bool, double*);		//grouping, iters, seed, weighted, scores
+};
+
+/**************************************************************************************************/
+
+#endif
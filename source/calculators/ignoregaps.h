@@ -60,6 +60,43 @@ public:
 		
 	}
 	
+	void calcDist(const EncodedSequence& A, const EncodedSequence& B){
+		if (!canUseEncoded(A, B)) { Dist::calcDist(A, B); return; }
+		
+		int diff = 0;
+		int length = 0;
+		
+		int numWords = A.getNumWords();
+		const unsigned long long* a = A.getWords();
+		const unsigned long long* b = B.getWords();
+		
+		int start = -1;
+		for(int w=0;w<numWords;w++){
+			unsigned long long noDots = ~(EncodedSequence::dots(a+3*w) | EncodedSequence::dots(b+3*w));
+			if(noDots){
+				start = 64 * w + EncodedSequence::lowestBit(noDots);
+				break;
+			}
+		}
+		
+		//columns with a base in both sequences count until either is '.'
+		for(int w=(start < 0 ? numWords : start / 64);w<numWords;w++){
+			unsigned long long mask = EncodedSequence::columns(w, start, 64 * numWords);
+			unsigned long long stop = (EncodedSequence::dots(a+3*w) | EncodedSequence::dots(b+3*w)) & mask;
+			if(stop){	mask &= (stop & (~stop + 1)) - 1;	}
+			
+			unsigned long long counted = EncodedSequence::bases(a+3*w) & EncodedSequence::bases(b+3*w) & mask;
+			diff += EncodedSequence::popCount(counted & EncodedSequence::differ(a+3*w, b+3*w));
+			length += EncodedSequence::popCount(counted);
+			
+			if(aboveCutoff(diff, length, min(A.getResiduesAfter(w), B.getResiduesAfter(w)))){	return;	}
+			
+			if(stop){	break;	}
+		}
+		
+		if(length == 0)		{	dist = 1.0000;								}
+		else				{	dist = ((double)diff  / (double)length);	}
+	}
 };
 
 /**************************************************************************************************/
@@ -79,6 +79,51 @@ public:
 		else				{	dist = (double)difference / minLength;	}
 	}
 	
+	void calcDist(const EncodedSequence& A, const EncodedSequence& B){
+		if (!canUseEncoded(A, B)) { Dist::calcDist(A, B); return; }
+		
+		int difference = 0;
+		int minLength = 0;
+		int openGapA = 0;
+		int openGapB = 0;
+		
+		int numWords = A.getNumWords();
+		const unsigned long long* a = A.getWords();
+		const unsigned long long* b = B.getWords();
+		
+		int start = -1;
+		for(int w=0;w<numWords;w++){
+			unsigned long long notBothDots = ~(EncodedSequence::dots(a+3*w) & EncodedSequence::dots(b+3*w));
+			if(notBothDots){
+				start = 64 * w + EncodedSequence::lowestBit(notBothDots);
+				break;
+			}
+		}
+		
+		for(int w=(start < 0 ? numWords : start / 64);w<numWords;w++){
+			unsigned long long mask = EncodedSequence::columns(w, start, 64 * numWords);
+			unsigned long long stop = EncodedSequence::dots(a+3*w) & EncodedSequence::dots(b+3*w) & mask;
+			if(stop){	mask &= (stop & (~stop + 1)) - 1;	}
+			
+			unsigned long long basesA = EncodedSequence::bases(a+3*w);
+			unsigned long long basesB = EncodedSequence::bases(b+3*w);
+			unsigned long long bothBases = basesA & basesB & mask;
+			
+			difference += EncodedSequence::popCount(bothBases & EncodedSequence::differ(a+3*w, b+3*w));
+			minLength += EncodedSequence::popCount(bothBases);
+			
+			int openings = countGapOpenings(~basesA & basesB & mask, basesA & ~basesB & mask, bothBases, openGapA, openGapB);
+			difference += openings;
+			minLength += openings;
+			
+			if(aboveCutoff(difference, minLength, min(A.getResiduesAfter(w), B.getResiduesAfter(w)))){	return;	}
+			
+			if(stop){	break;	}
+		}
+		
+		if(minLength == 0)	{	dist = 1.0000;							}
+		else				{	dist = (double)difference / minLength;	}
+	}
 };
 
 /**************************************************************************************************/
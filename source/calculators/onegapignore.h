@@ -86,7 +86,57 @@ public:
 		if(minLength == 0)	{	dist = 1.0000;							}
 		else				{	dist = (double)difference / minLength;	}
 	}
-
+	
+	void calcDist(const EncodedSequence& A, const EncodedSequence& B){
+		if (!canUseEncoded(A, B)) { Dist::calcDist(A, B); return; }
+		
+		int difference = 0;
+		int openGapA = 0;
+		int openGapB = 0;
+		int minLength = 0;
+		
+		int numWords = A.getNumWords();
+		const unsigned long long* a = A.getWords();
+		const unsigned long long* b = B.getWords();
+		
+		//the first and last columns with a base in both sequences
+		int start = -1;
+		int end = -1;
+		for(int w=0;w<numWords;w++){
+			unsigned long long bothBases = EncodedSequence::bases(a+3*w) & EncodedSequence::bases(b+3*w);
+			if(bothBases){
+				start = 64 * w + EncodedSequence::lowestBit(bothBases);
+				break;
+			}
+		}
+		for(int w=numWords-1;w>=0 && start >= 0;w--){
+			unsigned long long bothBases = EncodedSequence::bases(a+3*w) & EncodedSequence::bases(b+3*w);
+			if(bothBases){
+				end = 64 * w + EncodedSequence::highestBit(bothBases);
+				break;
+			}
+		}
+		
+		//only '-' is a gap here, a '.' between start and end is compared like a base
+		for(int w=(start < 0 ? numWords : start / 64);w<=end / 64;w++){
+			unsigned long long mask = EncodedSequence::columns(w, start, end + 1);
+			unsigned long long gapsA = EncodedSequence::gaps(a+3*w);
+			unsigned long long gapsB = EncodedSequence::gaps(b+3*w);
+			unsigned long long noGaps = ~gapsA & ~gapsB & mask;
+			
+			difference += EncodedSequence::popCount(noGaps & EncodedSequence::differ(a+3*w, b+3*w));
+			minLength += EncodedSequence::popCount(noGaps);
+			
+			int openings = countGapOpenings(gapsA & ~gapsB & mask, ~gapsA & gapsB & mask, noGaps, openGapA, openGapB);
+			difference += openings;
+			minLength += openings;
+			
+			if(aboveCutoff(difference, minLength, min(A.getResiduesAfter(w), B.getResiduesAfter(w)))){	return;	}
+		}
+		
+		if(minLength == 0)	{	dist = 1.0000;							}
+		else				{	dist = (double)difference / minLength;	}
+	}
 };
 
 /**************************************************************************************************/
@@ -34,6 +34,7 @@ Classify(), kmerSize(ksize), confidenceThreshold(cutoff), iters(i) {
 		string phyloTreeSumName = tfileroot + "tree.sum";
 		string probFileName = tfileroot + tempfileroot + char('0'+ kmerSize) + "mer.prob";
 		string probFileName2 = tfileroot + tempfileroot + char('0'+ kmerSize) + "mer.numNonZero";
+		string cacheFileName = tfileroot + tempfileroot + char('0'+ kmerSize) + "mer.cache";
 		
 		ofstream out;
 		ofstream out2;
@@ -51,8 +52,15 @@ Classify(), kmerSize(ksize), confidenceThreshold(cutoff), iters(i) {
 			FilesGood = checkReleaseDate(probFileTest, probFileTest2, phyloTreeTest, probFileTest3);
 		}
 		
+		//the binary cache holds the same training as the shortcut files
+		bool CacheGood = false;
+		if ((tfile != "saved") && cache.open(cacheFileName, kmerSize)) {
+			CacheGood = checkReleaseDate(cache.getVersion());
+			if (!CacheGood) { cache.close(); }
+		}
+		
 		//if you want to save, but you dont need to calculate then just read
-		if (rdb->save && probFileTest && probFileTest2 && phyloTreeTest && probFileTest3 && FilesGood && (tempFile != "saved")) {  
+		if (rdb->save && ((probFileTest && probFileTest2 && phyloTreeTest && probFileTest3 && FilesGood) || CacheGood) && (tempFile != "saved")) {  
 			ifstream saveIn;
 			m->openInputFile(tempFile, saveIn);
 			
@@ -65,7 +73,18 @@ Classify(), kmerSize(ksize), confidenceThreshold(cutoff), iters(i) {
 			saveIn.close();			
 		}
 
-		if(probFileTest && probFileTest2 && phyloTreeTest && probFileTest3 && FilesGood){	
+		if (CacheGood) {
+			m->mothurOut("Reading template taxonomy and probabilities...     "); cout.flush();
+			
+			phyloTree = cache.getPhyloTree();
+			genusNodes = phyloTree->getGenusNodes(); 
+			genusTotals = phyloTree->getGenusTotals();
+			numKmers = cache.getNumKmers();
+			WordPairDiffArr = cache.getWordPairDiffArr();
+			
+			//saving needs its own copy, otherwise the probabilities are used from the cache
+			if (rdb->save) { wordGenusProb.assign(cache.getWordGenusProb(), cache.getWordGenusProb() + (unsigned long long)numKmers * genusNodes.size()); }
+		}else if(probFileTest && probFileTest2 && phyloTreeTest && probFileTest3 && FilesGood){	
 			if (tempFile == "saved") { m->mothurOutEndLine();  m->mothurOut("Using sequences from " + rdb->getSavedReference() + " that are saved in memory.");	m->mothurOutEndLine(); }
 			
 			m->mothurOut("Reading template taxonomy...     "); cout.flush();
@@ -110,10 +129,8 @@ Classify(), kmerSize(ksize), confidenceThreshold(cutoff), iters(i) {
 				numKmers = database->getMaxKmer() + 1;
 			
 				//initialze probabilities
-				wordGenusProb.resize(numKmers);
+				wordGenusProb.resize((unsigned long long)numKmers * genusNodes.size());
 				WordPairDiffArr.resize(numKmers);
-			
-				for (int j = 0; j < wordGenusProb.size(); j++) {	wordGenusProb[j].resize(genusNodes.size());		}
                 ofstream out;
 				ofstream out2;
 				
@@ -180,7 +197,7 @@ Classify(), kmerSize(ksize), confidenceThreshold(cutoff), iters(i) {
 						//probabilityInThisTaxonomy = (# of seqs with that word in this taxonomy + probabilityInTemplate) / (total number of seqs in this taxonomy + 1);
 						
 						
-						wordGenusProb[i][k] = log((count[k] + probabilityInTemplate) / (float) (genusTotals[k] + 1));  
+						wordProb(i, k) = log((count[k] + probabilityInTemplate) / (float) (genusTotals[k] + 1));  
 									
 						if (count[k] != 0) { 
 							#ifdef USE_MPI
@@ -190,7 +207,7 @@ Classify(), kmerSize(ksize), confidenceThreshold(cutoff), iters(i) {
 								if (pid == 0) {  
 							#endif
 
-                            if (shortcuts) { out << k << '\t' << wordGenusProb[i][k] << '\t' ; }
+                            if (shortcuts) { out << k << '\t' << wordProb(i, k) << '\t' ; }
 							
 							#ifdef USE_MPI
 								}
@@ -248,6 +265,25 @@ Classify(), kmerSize(ksize), confidenceThreshold(cutoff), iters(i) {
 		//save probabilities
 		if (rdb->save) { rdb->wordGenusProb = wordGenusProb; rdb->WordPairDiffArr = WordPairDiffArr; }
 		
+		if (wordGenusProb.size() != 0)	{ probTable = &wordGenusProb[0];			}
+		else							{ probTable = cache.getWordGenusProb();	}
+		
+		//write the binary cache, so the next run doesn't need to parse the shortcut files
+		if (shortcuts && !CacheGood && !m->control_pressed && (wordGenusProb.size() != 0)) {
+			#ifdef USE_MPI
+				int pid;
+				MPI_Comm_rank(MPI_COMM_WORLD, &pid); //find out who we are
+				
+				if (pid == 0) {  
+			#endif
+			
+			BayesianCache::write(cacheFileName, kmerSize, phyloTree, genusNodes, genusTotals, WordPairDiffArr, wordGenusProb);
+			
+			#ifdef USE_MPI
+				}
+			#endif
+		}
+		
 		m->mothurOut("DONE."); m->mothurOutEndLine();
 		m->mothurOut("It took " + toString(time(NULL) - start) + " seconds get probabilities. "); m->mothurOutEndLine();
 	}
@@ -270,6 +306,18 @@ Bayesian::~Bayesian() {
 
 /**************************************************************************************************/
 string Bayesian::getTaxonomy(Sequence* seq) {
+	try {
+		return getTaxonomy(seq, simpleTax, flipped, rand());
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Bayesian", "getTaxonomy");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//the probabilities are only read, so threads can share the classifier. the bootstrap draws from its own
+//generator seeded by the caller, so the confidence scores do not depend on thread scheduling
+string Bayesian::getTaxonomy(Sequence* seq, string& simpleTax, bool& flipped, unsigned seed) {
 	try {
 		string tax = "";
 		Kmer kmer(kmerSize);
@@ -314,7 +362,8 @@ string Bayesian::getTaxonomy(Sequence* seq) {
 	
         if (m->debug) {  m->mothurOut(seq->getName() + "\t"); }
         
-		tax = bootstrapResults(queryKmers, index, numToSelect);
+		mt19937 randomGenerator(seed);
+		tax = bootstrapResults(queryKmers, index, numToSelect, simpleTax, randomGenerator);
         
         if (m->debug) {  m->mothurOut("\n"); }
 		
@@ -326,7 +375,7 @@ string Bayesian::getTaxonomy(Sequence* seq) {
 	}
 }
 /**************************************************************************************************/
-string Bayesian::bootstrapResults(vector<int> kmers, int tax, int numToSelect) {
+string Bayesian::bootstrapResults(vector<int> kmers, int tax, int numToSelect, string& simpleTax, mt19937& randomGenerator) {
 	try {
 				
 		map<int, int> confidenceScores; 
@@ -346,20 +395,25 @@ string Bayesian::bootstrapResults(vector<int> kmers, int tax, int numToSelect) {
 		map<int, int>::iterator itBoot2;
 		map<int, int>::iterator itConvert;
 			
+		//select the kmers for every iteration, so they can be scored together
+		vector<int> temp; temp.reserve(iters * numToSelect);
 		for (int i = 0; i < iters; i++) {
-			if (m->control_pressed) { return "control"; }
-			
-			vector<int> temp;
 			for (int j = 0; j < numToSelect; j++) {
-				int index = int(rand() % kmers.size());
+				int index = int(randomGenerator() % kmers.size());
 				
 				//add word to temp
 				temp.push_back(kmers[index]);
 			}
+		}
+		
+		vector<int> newTaxes;
+		getMostProbableTaxonomies(temp, iters, newTaxes);
+		
+		for (int i = 0; i < iters; i++) {
+			if (m->control_pressed) { return "control"; }
 			
 			//get taxonomy
-			int newTax = getMostProbableTaxonomy(temp);
-			//int newTax = 1;
+			int newTax = newTaxes[i];
 			TaxNode taxonomyTemp = phyloTree->get(newTax);
 			
 			//add to confidence results
@@ -414,39 +468,65 @@ string Bayesian::bootstrapResults(vector<int> kmers, int tax, int numToSelect) {
 	}
 }
 /**************************************************************************************************/
-int Bayesian::getMostProbableTaxonomy(vector<int> queryKmer) {
+int Bayesian::getMostProbableTaxonomy(vector<int>& queryKmer) {
 	try {
-		int indexofGenus = 0;
+		vector<int> indexes;
+		getMostProbableTaxonomies(queryKmer, 1, indexes);
 		
-		double maxProbability = -1000000.0;
-		//find taxonomy with highest probability that this sequence is from it
+		return indexes[0];
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Bayesian", "getMostProbableTaxonomy");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//queryKmers holds numSets sets of kmers of the same size, one after the other. indexes is filled with the genus
+//that each set is most likely from. The genera are scored in tiles small enough that the query's rows of
+//wordGenusProb stay in cache while every set is scored, and each genus sums its probabilities in the order of the set.
+void Bayesian::getMostProbableTaxonomies(vector<int>& queryKmers, int numSets, vector<int>& indexes) {
+	try {
+		int numGenus = genusNodes.size();
+		int setSize = 0;
+		if (numSets != 0) { setSize = queryKmers.size() / numSets; }
 		
+		indexes.assign(numSets, 0);
+		vector<double> maxProbability(numSets, -1000000.0);
 		
-//		cout << genusNodes.size() << endl;
+		int numRows = min(queryKmers.size(), WordPairDiffArr.size());
+		int tileSize = max(64, 65536 / max(1, numRows));
+		if (numSets == 1) { tileSize = numGenus; }
 		
+		vector<double> prob(min(tileSize, numGenus));
 		
-		for (int k = 0; k < genusNodes.size(); k++) {
-			//for each taxonomy calc its probability
+		for (int tileStart = 0; tileStart < numGenus; tileStart += tileSize) {
+			if (m->control_pressed) { break; }
 			
-			double prob = 0.0000;
-			for (int i = 0; i < queryKmer.size(); i++) {
-				prob += wordGenusProb[queryKmer[i]][k];
-			}
+			int length = min(tileSize, numGenus - tileStart);
 			
-//			cout << phyloTree->get(genusNodes[k]).name << '\t' << prob << endl;
-
-			//is this the taxonomy with the greatest probability?
-			if (prob > maxProbability) { 
-				indexofGenus = genusNodes[k];
-				maxProbability = prob;
+			for (int s = 0; s < numSets; s++) {
+				//for each taxonomy calc its probability
+				double* genusProb = &prob[0];
+				for (int k = 0; k < length; k++) { genusProb[k] = 0.0000; }
+				
+				for (int i = s * setSize; i < (s+1) * setSize; i++) {
+					const float* row = probTable + (unsigned long long)queryKmers[i] * numGenus + tileStart;
+					for (int k = 0; k < length; k++) { genusProb[k] += row[k]; }
+				}
+				
+				//is this the taxonomy with the greatest probability?
+				for (int k = 0; k < length; k++) {
+					if (genusProb[k] > maxProbability[s]) {
+						indexes[s] = genusNodes[tileStart + k];
+						maxProbability[s] = genusProb[k];
+					}
+				}
 			}
 		}
 		
-			
-		return indexofGenus;
 	}
 	catch(exception& e) {
-		m->errorOut(e, "Bayesian", "getMostProbableTaxonomy");
+		m->errorOut(e, "Bayesian", "getMostProbableTaxonomies");
 		exit(1);
 	}
 }
@@ -586,9 +666,7 @@ void Bayesian::readProbFile(ifstream& in, ifstream& inNum, string inName, string
 			iss >> numKmers;  
 			
 			//initialze probabilities
-			wordGenusProb.resize(numKmers);
-			
-			for (int j = 0; j < wordGenusProb.size(); j++) {	wordGenusProb[j].resize(genusNodes.size());		}
+			wordGenusProb.resize((unsigned long long)numKmers * genusNodes.size());
 			
 			int kmer, name;  
 			vector<int> numbers; numbers.resize(numKmers);
@@ -641,13 +719,13 @@ void Bayesian::readProbFile(ifstream& in, ifstream& inNum, string inName, string
 				
 				//set them all to zero value
 				for (int i = 0; i < genusNodes.size(); i++) {
-					wordGenusProb[kmer][i] = log(zeroCountProb[kmer] / (float) (genusTotals[i]+1));
+					wordProb(kmer, i) = log(zeroCountProb[kmer] / (float) (genusTotals[i]+1));
 				}
 				
 				//get probs for nonzero values
 				for (int i = 0; i < numbers[kmer]; i++) {
 					iss >> name >> prob;
-					wordGenusProb[kmer][name] = prob;
+					wordProb(kmer, name) = prob;
 				}
 				
 			}
@@ -660,9 +738,7 @@ void Bayesian::readProbFile(ifstream& in, ifstream& inNum, string inName, string
 			in >> numKmers; m->gobble(in);
 			//cout << threadID << '\t' << line << '\t' << numKmers << &in << '\t' << &inNum << '\t' << genusNodes.size() << endl;
 			//initialze probabilities
-			wordGenusProb.resize(numKmers);
-			
-			for (int j = 0; j < wordGenusProb.size(); j++) {	wordGenusProb[j].resize(genusNodes.size());		}
+			wordGenusProb.resize((unsigned long long)numKmers * genusNodes.size());
 			
 			int kmer, name, count;  count = 0;
 			vector<int> num; num.resize(numKmers);
@@ -690,13 +766,13 @@ void Bayesian::readProbFile(ifstream& in, ifstream& inNum, string inName, string
 			//cout << threadID << '\t' << kmer << endl;
 				//set them all to zero value
 				for (int i = 0; i < genusNodes.size(); i++) {
-					wordGenusProb[kmer][i] = log(zeroCountProb[kmer] / (float) (genusTotals[i]+1));
+					wordProb(kmer, i) = log(zeroCountProb[kmer] / (float) (genusTotals[i]+1));
 				}
 			//cout << threadID << '\t' << num[kmer] << "here" << endl;	
 				//get probs for nonzero values
 				for (int i = 0; i < num[kmer]; i++) {
 					in >> name >> prob;
-					wordGenusProb[kmer][name] = prob;
+					wordProb(kmer, name) = prob;
 				}
 				
 				m->gobble(in);
@@ -711,6 +787,41 @@ void Bayesian::readProbFile(ifstream& in, ifstream& inNum, string inName, string
 	}
 }
 /**************************************************************************************************/
+//returns false if this version of mothur is newer than the one that made the file
+bool Bayesian::checkReleaseDate(string fileVersion) {
+	try {
+		
+		bool good = true;
+		
+		//get mothurs current version
+		string version = m->getVersion();
+		
+		vector<string> versionVector;
+		m->splitAtChar(version, versionVector, '.');
+		
+		vector<string> linesVector;
+		m->splitAtChar(fileVersion, linesVector, '.');
+		
+		if (versionVector.size() != linesVector.size()) { good = false; }
+		else {
+			for (int j = 0; j < versionVector.size(); j++) {
+				int num1, num2;
+				convert(versionVector[j], num1);
+				convert(linesVector[j], num2);
+				
+				//if mothurs version is newer than this files version, then we want to remake it
+				if (num1 > num2) {  good = false; break;  }
+			}
+		}
+		
+		return good;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Bayesian", "checkReleaseDate");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
 bool Bayesian::checkReleaseDate(ifstream& file1, ifstream& file2, ifstream& file3, ifstream& file4) {
 	try {
 		
@@ -725,33 +836,9 @@ bool Bayesian::checkReleaseDate(ifstream& file1, ifstream& file2, ifstream& file
 		//before we added this check
 		if ((lines[0][0] != '#') || (lines[1][0] != '#') || (lines[2][0] != '#') || (lines[3][0] != '#')) {  good = false;  }
 		else {
-			//rip off #
-			for (int i = 0; i < lines.size(); i++) { lines[i] = lines[i].substr(1);  }
-			
-			//get mothurs current version
-			string version = m->getVersion();
-			
-			vector<string> versionVector;
-			m->splitAtChar(version, versionVector, '.');
-			
-			//check each files version
+			//rip off # and check each files version
 			for (int i = 0; i < lines.size(); i++) { 
-				vector<string> linesVector;
-				m->splitAtChar(lines[i], linesVector, '.');
-			
-				if (versionVector.size() != linesVector.size()) { good = false; break; }
-				else {
-					for (int j = 0; j < versionVector.size(); j++) {
-						int num1, num2;
-						convert(versionVector[j], num1);
-						convert(linesVector[j], num2);
-						
-						//if mothurs version is newer than this files version, then we want to remake it
-						if (num1 > num2) {  good = false; break;  }
-					}
-				}
-				
-				if (!good) { break; }
+				if (!checkReleaseDate(lines[i].substr(1))) { good = false; break; }
 			}
 		}
 		
@@ -12,6 +12,7 @@
 
 #include "mothur.h"
 #include "classify.h"
+#include "bayesiancache.h"
 
 /**************************************************************************************************/
 
@@ -22,10 +23,14 @@ public:
 	~Bayesian();
 	
 	string getTaxonomy(Sequence*);
+	string getTaxonomy(Sequence*, string&, bool&, unsigned);
 	
 private:
-	vector< vector<float> > wordGenusProb;	//vector of maps from genus to probability
-										//wordGenusProb[0][392] = probability that a sequence within genus that's index in the tree is 392 would contain kmer 0;
+	vector<float> wordGenusProb;	//numKmers rows of genusNodes.size() probabilities, stored row after row so a kmer's probabilities are contiguous
+									//wordProb(0, 392) = probability that a sequence within genus that's index in the tree is 392 would contain kmer 0;
+	
+	const float* probTable;			//wordGenusProb, or the probabilities in the cache
+	BayesianCache cache;
 	
 	vector<int> genusTotals;
 	vector<int> genusNodes;  //indexes in phyloTree where genus' are located
@@ -34,10 +39,13 @@ private:
 	
 	int kmerSize, numKmers, confidenceThreshold, iters;
 	
-	string bootstrapResults(vector<int>, int, int);
-	int getMostProbableTaxonomy(vector<int>);
+	string bootstrapResults(vector<int>, int, int, string&, mt19937&);
+	int getMostProbableTaxonomy(vector<int>&);
+	void getMostProbableTaxonomies(vector<int>&, int, vector<int>&);
+	float& wordProb(int kmer, int genus) { return wordGenusProb[(unsigned long long)kmer * genusNodes.size() + genus]; }
 	void readProbFile(ifstream&, ifstream&, string, string);
 	bool checkReleaseDate(ifstream&, ifstream&, ifstream&, ifstream&);
+	bool checkReleaseDate(string);
 	bool isReversed(vector<int>&);
 	vector<int> createWordIndexArr(Sequence*);
 	int generateWordPairDiffArr();
@@ -0,0 +1,192 @@
+/*
+ *  bayesiancache.cpp
+ *  Mothur
+ *
+ *  Copyright 2026 Schloss Lab. All rights reserved.
+ *
+ */
+
+#include "bayesiancache.h"
+
+#define BAYESIANCACHE_TAG "MOTHURBC"
+#define BAYESIANCACHE_VERSION 1
+#define BAYESIANCACHE_HEADERSIZE 64
+
+/***********************************************************************/
+
+BayesianCache::BayesianCache() {
+	m = MothurOut::getInstance();
+	data = NULL;
+	names = NULL; levels = NULL; parents = NULL; genusNodes = NULL; genusTotals = NULL; wordPairs = NULL; wordGenusProb = NULL;
+	numNodes = 0; numGenus = 0; numKmers = 0; nameBytes = 0; fileSize = 0;
+}
+/***********************************************************************/
+
+BayesianCache::~BayesianCache() { close(); }
+
+/***********************************************************************/
+//number of '\0' needed after a section of this many bytes to keep the next section on an 8 byte boundary
+unsigned long long BayesianCache::padding(unsigned long long bytes) {
+	return (8 - (bytes % 8)) % 8;
+}
+/***********************************************************************/
+
+int BayesianCache::write(string file, int kmerSize, PhyloTree* tree, vector<int>& genus, vector<int>& totals, vector<diffPair>& pairs, vector<float>& probs) {
+	try {
+		MothurOut* m = MothurOut::getInstance();
+
+		string mothurVersion = m->getVersion();
+		unsigned int nodes = tree->getNumNodes();
+		unsigned int numGenera = genus.size();
+		unsigned int kmers = pairs.size();
+
+		if (probs.size() != ((unsigned long long)kmers * numGenera)) { m->mothurOut("[ERROR]: the template probabilities do not match the number of kmers and genera, not writing " + file + ".\n"); return 0; }
+
+		string nameTable = "";
+		vector<int> nodeLevels(nodes), nodeParents(nodes);
+		for (int i = 0; i < nodes; i++) {
+			TaxNode node = tree->get(i);
+			nameTable += node.name + '\n';
+			nodeLevels[i] = node.level;
+			nodeParents[i] = node.parent;
+		}
+
+		char header[BAYESIANCACHE_HEADERSIZE];
+		memset(header, 0, BAYESIANCACHE_HEADERSIZE);
+		unsigned int fields[6] = { BAYESIANCACHE_VERSION, (unsigned int)kmerSize, nodes, numGenera, kmers, (unsigned int)mothurVersion.length() };
+		unsigned long long names = nameTable.length();
+		memcpy(header, BAYESIANCACHE_TAG, 8);
+		memcpy(header+8, fields, sizeof(fields));
+		memcpy(header+32, &names, sizeof(unsigned long long));
+
+		char zeros[8];
+		memset(zeros, 0, 8);
+
+		//write to a temp file and move it, so other processes never map a partly written cache
+		string tempFile = file + ".temp";
+		ofstream out;
+		m->openOutputFileBinary(tempFile, out);
+
+		out.write(header, BAYESIANCACHE_HEADERSIZE);
+		out.write(mothurVersion.c_str(), mothurVersion.length());		out.write(zeros, padding(mothurVersion.length()));
+		out.write(nameTable.c_str(), names);							out.write(zeros, padding(names));
+		out.write((char*)&nodeLevels[0], nodes * sizeof(int));
+		out.write((char*)&nodeParents[0], nodes * sizeof(int));			out.write(zeros, padding(2 * nodes * sizeof(int)));
+		out.write((char*)&genus[0], numGenera * sizeof(int));
+		out.write((char*)&totals[0], numGenera * sizeof(int));			out.write(zeros, padding(2 * numGenera * sizeof(int)));
+		out.write((char*)&pairs[0], kmers * sizeof(diffPair));
+		out.write((char*)&probs[0], probs.size() * sizeof(float));
+		out.close();
+
+		m->renameFile(tempFile, file);
+
+		return 0;
+	}
+	catch(exception& e) {
+		MothurOut::getInstance()->errorOut(e, "BayesianCache", "write");
+		exit(1);
+	}
+}
+/***********************************************************************/
+
+bool BayesianCache::open(string file, int kmerSize) {
+	try {
+		close();
+		filename = file;
+
+		//read only and shared, so every process classifying with this reference uses the same pages
+		if (!mapped.open(filename)) { return false; }
+		data = mapped.getData();
+		fileSize = mapped.getSize();
+		if (fileSize < BAYESIANCACHE_HEADERSIZE) { close(); return false; }
+
+		if (strncmp(data, BAYESIANCACHE_TAG, 8) != 0) { close(); return false; }
+
+		const unsigned int* fields = (const unsigned int*)(data+8);
+		if (fields[0] != BAYESIANCACHE_VERSION) { close(); return false; }
+		if (fields[1] != kmerSize) { close(); return false; }
+		numNodes = fields[2];
+		numGenus = fields[3];
+		numKmers = fields[4];
+		unsigned long long versionBytes = fields[5];
+		nameBytes = *((const unsigned long long*)(data+32));
+
+		//find the sections
+		unsigned long long offset = BAYESIANCACHE_HEADERSIZE;
+		unsigned long long versionStart = offset;					offset += versionBytes + padding(versionBytes);
+		unsigned long long namesStart = offset;						offset += nameBytes + padding(nameBytes);
+		unsigned long long levelsStart = offset;					offset += 2 * numNodes * sizeof(int);		offset += padding(offset);
+		unsigned long long genusStart = offset;						offset += 2 * numGenus * sizeof(int);		offset += padding(offset);
+		unsigned long long pairsStart = offset;						offset += numKmers * sizeof(diffPair);
+		unsigned long long probsStart = offset;						offset += (unsigned long long)numKmers * numGenus * sizeof(float);
+
+		if (offset > fileSize) { m->mothurOut("[WARNING]: " + filename + " is truncated, ignoring it.\n"); close(); return false; }
+
+		version = string(data + versionStart, versionBytes);
+		names = data + namesStart;
+		levels = (const int*)(data + levelsStart);
+		parents = levels + numNodes;
+		genusNodes = (const int*)(data + genusStart);
+		genusTotals = genusNodes + numGenus;
+		wordPairs = (const diffPair*)(data + pairsStart);
+		wordGenusProb = (const float*)(data + probsStart);
+
+		return true;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "BayesianCache", "open");
+		exit(1);
+	}
+}
+/***********************************************************************/
+
+void BayesianCache::close() {
+	try {
+		mapped.close();
+		data = NULL;
+		names = NULL; levels = NULL; parents = NULL; genusNodes = NULL; genusTotals = NULL; wordPairs = NULL; wordGenusProb = NULL;
+		numNodes = 0; numGenus = 0; numKmers = 0; nameBytes = 0; fileSize = 0;
+		version = "";
+	}
+	catch(exception& e) {
+		m->errorOut(e, "BayesianCache", "close");
+		exit(1);
+	}
+}
+/***********************************************************************/
+
+PhyloTree* BayesianCache::getPhyloTree() {
+	try {
+		vector<string> nodeNames; nodeNames.reserve(numNodes);
+		string name = "";
+		for (unsigned long long i = 0; i < nameBytes; i++) {
+			if (names[i] == '\n') { nodeNames.push_back(name); name = ""; }
+			else { name += names[i]; }
+		}
+
+		if (nodeNames.size() != numNodes) { m->mothurOut("[ERROR]: " + filename + " should contain " + toString(numNodes) + " taxa, but I found " + toString(nodeNames.size()) + ".\n"); m->control_pressed = true; }
+
+		vector<int> nodeLevels(levels, levels + numNodes);
+		vector<int> nodeParents(parents, parents + numNodes);
+		vector<int> genus(genusNodes, genusNodes + numGenus);
+		vector<int> totals(genusTotals, genusTotals + numGenus);
+
+		return new PhyloTree(nodeNames, nodeLevels, nodeParents, genus, totals);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "BayesianCache", "getPhyloTree");
+		exit(1);
+	}
+}
+/***********************************************************************/
+
+vector<diffPair> BayesianCache::getWordPairDiffArr() {
+	try {
+		return vector<diffPair>(wordPairs, wordPairs + numKmers);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "BayesianCache", "getWordPairDiffArr");
+		exit(1);
+	}
+}
+/***********************************************************************/
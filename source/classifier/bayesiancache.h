@@ -0,0 +1,70 @@
+#ifndef BAYESIANCACHE_H
+#define BAYESIANCACHE_H
+/*
+ *  bayesiancache.h
+ *  Mothur
+ *
+ *  Copyright 2026 Schloss Lab. All rights reserved.
+ *
+ */
+
+#include "mothur.h"
+#include "mothurout.h"
+#include "phylotree.h"
+#include "mappedfile.h"
+
+/* The Bayesian classifier writes its training to a binary cache the first time a reference and taxonomy are used, next
+ to the tree.train, tree.sum, mer.prob and mer.numNonZero shortcut files. Later runs map the cache into memory instead of
+ parsing the shortcut files. The word probabilities are used straight from the mapping, so processes classifying with the
+ same reference share one read only copy.
+
+ header:    8 byte tag "MOTHURBC", unsigned ints format version, kmer size, number of tree nodes, number of genera, number
+            of kmers and length of the mothur version string, ull number of bytes in the name table, padded to 64 bytes
+ sections:  each padded with '\0' to an 8 byte boundary
+            the version of mothur that wrote the cache
+            numNodes taxon names, each followed by '\n'
+            int levels[numNodes], int parents[numNodes]
+            int genusNodes[numGenus], int genusTotals[numGenus]
+            diffPair WordPairDiffArr[numKmers]
+            float wordGenusProb[numKmers * numGenus], kmer by kmer */
+
+/******************************************************/
+
+class BayesianCache {
+
+public:
+	BayesianCache();
+	~BayesianCache();
+
+	static int write(string, int, PhyloTree*, vector<int>&, vector<int>&, vector<diffPair>&, vector<float>&);	//filename, kmer size, tree, genus nodes, genus totals, word pairs, word probabilities
+
+	bool open(string, int);		//maps the file into memory, returns false if it is missing, for another kmer size or not a cache
+	void close();
+
+	string getVersion()					{ return version;			}
+	int getNumKmers()					{ return numKmers;			}
+	PhyloTree* getPhyloTree();			//caller deletes the tree
+	vector<diffPair> getWordPairDiffArr();
+	const float* getWordGenusProb()		{ return wordGenusProb;		}
+
+private:
+	MothurOut* m;
+	string filename, version;
+	unsigned int numNodes, numGenus, numKmers;
+	const char* names;
+	const int* levels;
+	const int* parents;
+	const int* genusNodes;
+	const int* genusTotals;
+	const diffPair* wordPairs;
+	const float* wordGenusProb;
+	unsigned long long nameBytes, fileSize;
+	MappedFile mapped;
+	const char* data;
+
+	static unsigned long long padding(unsigned long long);
+};
+
+/******************************************************/
+
+#endif
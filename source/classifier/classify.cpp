@@ -238,6 +238,23 @@ void Classify::generateDatabaseAndNames(string tfile, string tempFile, string me
 /**************************************************************************************************/
 Classify::Classify() {		m = MothurOut::getInstance();	database = NULL;	phyloTree=NULL; flipped=false; }
 /**************************************************************************************************/
+//the classifiers keep the simple taxonomy and flip in the object, so threads sharing the classifier take turns
+string Classify::getTaxonomy(Sequence* seq, string& simpleTaxonomy, bool& wasFlipped, unsigned seed) {
+	try {
+		lock_guard<mutex> guard(classifyLock);
+		
+		string tax = getTaxonomy(seq);
+		simpleTaxonomy = getSimpleTax();
+		wasFlipped = getFlipped();
+		
+		return tax;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Classify", "getTaxonomy");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
 
 int Classify::readTaxonomy(string file) {
 	try {
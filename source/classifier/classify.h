@@ -27,6 +27,7 @@ public:
 	Classify();
 	virtual ~Classify(){};
 	virtual string getTaxonomy(Sequence*) = 0;
+	virtual string getTaxonomy(Sequence*, string&, bool&, unsigned);	//also sets the simple taxonomy and whether the sequence was flipped, safe to call from several threads. the seed is for any random draws, so results do not depend on which thread runs first
 	virtual string getSimpleTax()  { return simpleTax;	}
 	virtual bool getFlipped()  { return flipped;	}
 	virtual void generateDatabaseAndNames(string, string, string, int, float, float, float, float);
@@ -45,6 +46,8 @@ protected:
 	int threadID, numLevels, numTaxa;
 	bool flip, flipped, shortcuts;
 	
+	mutex classifyLock;
+	
 	int readTaxonomy(string);
 	vector<string> parseTax(string);
     double getLogExpSum(vector<double>, int&);
@@ -18,8 +18,6 @@ KmerNode::KmerNode(string s, int l, int n) : TaxonomyNode(s, l), kmerSize(n) {
         
         numPossibleKmers = power4s[kmerSize];
         numUniqueKmers = 0;
-        
-        kmerVector.assign(numPossibleKmers, 0);
     }
 	catch(exception& e) {
 		m->errorOut(e, "KmerNode", "KmerNode");
@@ -31,12 +29,9 @@ KmerNode::KmerNode(string s, int l, int n) : TaxonomyNode(s, l), kmerSize(n) {
 
 void KmerNode::loadSequence(vector<int>& kmerProfile){
 	try {
-        for(int i=0;i<numPossibleKmers;i++){
-            if (m->control_pressed) { break; }
-            if(kmerVector[i] == 0 && kmerProfile[i] != 0)	{	numUniqueKmers++;	}
-            
-            kmerVector[i] += kmerProfile[i];
-        }
+        vector<int> ones(kmerProfile.size(), 1);
+        
+        numUniqueKmers += addKmers(kmerProfile, ones);
         
         numSeqs++;
     }
@@ -46,6 +41,42 @@ void KmerNode::loadSequence(vector<int>& kmerProfile){
 	}
 }	
 
+/**********************************************************************************************************************/
+//	merges the kmers and their counts into the node's and returns the number of kmers the node had not seen
+
+int KmerNode::addKmers(vector<int>& newKmers, vector<int>& newCounts){
+	try {
+        vector<int> mergedKmers;	mergedKmers.reserve(kmers.size() + newKmers.size());
+        vector<int> mergedCounts;	mergedCounts.reserve(kmers.size() + newKmers.size());
+        int numNew = 0;
+        
+        int i = 0; int j = 0;
+        while(i < kmers.size() || j < newKmers.size()){
+            if(j == newKmers.size() || (i < kmers.size() && kmers[i] < newKmers[j])){
+                mergedKmers.push_back(kmers[i]);	mergedCounts.push_back(counts[i]);
+                i++;
+            }
+            else if(i == kmers.size() || newKmers[j] < kmers[i]){
+                mergedKmers.push_back(newKmers[j]);	mergedCounts.push_back(newCounts[j]);
+                j++;	numNew++;
+            }
+            else{
+                mergedKmers.push_back(kmers[i]);	mergedCounts.push_back(counts[i] + newCounts[j]);
+                i++;	j++;
+            }
+        }
+        
+        kmers.swap(mergedKmers);
+        counts.swap(mergedCounts);
+        
+        return numNew;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "KmerNode", "addKmers");
+		exit(1);
+	}
+}
+
 /**********************************************************************************************************************/
 
 string KmerNode::getKmerBases(int kmerNumber){
@@ -89,12 +120,9 @@ string KmerNode::getKmerBases(int kmerNumber){
 
 /**************************************************************************************************/
 
-void KmerNode::addThetas(vector<int> newTheta, int newNumSeqs){
+void KmerNode::addThetas(vector<int>& newKmers, vector<int>& newCounts, int newNumSeqs){
 	try {
-        for(int i=0;i<numPossibleKmers;i++){
-            if (m->control_pressed) { break; }
-            kmerVector[i] += newTheta[i];		
-        }
+        addKmers(newKmers, newCounts);
         
         //	if(alignLength == 0){
         //		alignLength = (int)newTheta.size();
@@ -123,15 +151,7 @@ void KmerNode::addThetas(vector<int> newTheta, int newNumSeqs){
 int KmerNode::getNumUniqueKmers(){
     try {
         if(numUniqueKmers == 0){
-            
-            for(int i=0;i<numPossibleKmers;i++){
-                if (m->control_pressed) { return numUniqueKmers; }
-                if(kmerVector[i] != 0){
-                    numUniqueKmers++;
-                }
-                
-            }
-            
+            numUniqueKmers = (int)kmers.size();
         }
         
         return numUniqueKmers;	
@@ -148,10 +168,8 @@ int KmerNode::getNumUniqueKmers(){
 void KmerNode::printTheta(){
 	try {
         m->mothurOut(name + "\n");
-        for(int i=0;i<numPossibleKmers;i++){
-            if(kmerVector[i] != 0){
-                m->mothurOut(getKmerBases(i) + '\t' + toString(kmerVector[i]) + "\n");
-            }
+        for(int i=0;i<kmers.size();i++){
+            m->mothurOut(getKmerBases(kmers[i]) + '\t' + toString(counts[i]) + "\n");
         }
         m->mothurOutEndLine();	
     }
@@ -167,14 +185,17 @@ double KmerNode::getSimToConsensus(vector<int>& queryKmerProfile){
 	try {
         double present = 0;
         
-        for(int i=0;i<numPossibleKmers;i++){
+        int index = 0;
+        for(int i=0;i<queryKmerProfile.size();i++){
             if (m->control_pressed) { return present; }
-            if(queryKmerProfile[i] != 0 && kmerVector[i] != 0){
+            index = (int)(lower_bound(kmers.begin()+index, kmers.end(), queryKmerProfile[i]) - kmers.begin());
+            if(index < kmers.size() && kmers[index] == queryKmerProfile[i]){
                 present++;
             }
         }	
         
-        return present / double(queryKmerProfile.size() - kmerSize + 1);
+        //	scaled by the length of the full 4^k+1 profile, as before the profiles were sparse
+        return present / double(numPossibleKmers + 1 - kmerSize + 1);
     }
 	catch(exception& e) {
 		m->errorOut(e, "KmerNode", "getSimToConsensus");
@@ -190,12 +211,17 @@ double KmerNode::getPxGivenkj_D_j(vector<int>& queryKmerProfile)	{
         double alpha = 1.0 / (double)totalSeqs;	//flat prior
         //	double alpha = pow((1.0 / (double)numUniqueKmers), numSeqs)+0.0001;	//non-flat prior
         
-        for(int i=0;i<numPossibleKmers;i++){
+        //	only the query's kmers are scored, and both lists are in order so each search starts where the last stopped
+        int index = 0;
+        for(int i=0;i<queryKmerProfile.size();i++){
             if (m->control_pressed) { return sumLogProb; }
-            if(queryKmerProfile[i] != 0){		//numUniqueKmers needs to be the value from Root;
-                sumLogProb += log((kmerVector[i] + alpha) / (numSeqs + numUniqueKmers * alpha));
-            }
+            index = (int)(lower_bound(kmers.begin()+index, kmers.end(), queryKmerProfile[i]) - kmers.begin());
+            
+            int count = 0;
+            if(index < kmers.size() && kmers[index] == queryKmerProfile[i]){	count = counts[index];	}
             
+            //numUniqueKmers needs to be the value from Root;
+            sumLogProb += log((count + alpha) / (numSeqs + numUniqueKmers * alpha));
         }
         return sumLogProb;
     }
@@ -19,24 +19,27 @@ class KmerNode : public TaxonomyNode {
 	
 public:
 	KmerNode(string, int, int);
-	void loadSequence(vector<int>&);
+	void loadSequence(vector<int>&);			//	the kmers in the sequence, in order
 	void printTheta();
-	double getPxGivenkj_D_j(vector<int>&);
+	double getPxGivenkj_D_j(vector<int>&);		//	the kmers in the query, in order
 	double getSimToConsensus(vector<int>&);
 	void checkTheta(){};
 	void setNumUniqueKmers(int num)	{	numUniqueKmers = num;	}
 	int getNumUniqueKmers();
-	void addThetas(vector<int>, int);
-	vector<int> getTheta()	{	return kmerVector;	}
+	void addThetas(vector<int>&, vector<int>&, int);
+	vector<int>& getKmers()		{	return kmers;	}
+	vector<int>& getCounts()	{	return counts;	}
 
 
 private:
 	string getKmerBases(int);
+	int addKmers(vector<int>&, vector<int>&);
 	int kmerSize;								//	value of k
 	int numPossibleKmers;						//	4^kmerSize
 	int numUniqueKmers;							//	number of unique kmers seen in a group ~ O_kj
 	int numKmers;								//	number of kmers in a sequence
-	vector<int> kmerVector;						//	counts of kmers across all sequences in a node
+	vector<int> kmers;							//	kmers seen across all sequences in a node, in order
+	vector<int> counts;							//	counts[i] is the number of sequences in the node with kmers[i]
 };
 
 /**********************************************************************************************************************/
@@ -91,7 +91,8 @@ vector<int> KmerTree::ripKmerProfile(string sequence){
         
         int nKmers = (int)sequence.length() - kmerSize + 1;
         
-        vector<int> kmerProfile(numPossibleKmers + 1, 0);
+        //	the kmers in the sequence, each once and in order. Kmers with an N in them are left out, the nodes never scored them
+        vector<int> kmerProfile;
         
         for(int i=0;i<nKmers;i++){
             
@@ -106,9 +107,12 @@ vector<int> KmerTree::ripKmerProfile(string sequence){
                 else if(toupper(sequence[j+i]) == 'T')	{	kmer += (3 * power4s[kmerSize-j-1]);	}
                 else									{	kmer = power4s[kmerSize]; j = kmerSize;	}
             }
-            kmerProfile[kmer] = 1;
+            if(kmer != numPossibleKmers){	kmerProfile.push_back(kmer);	}
         }
         
+        sort(kmerProfile.begin(), kmerProfile.end());
+        kmerProfile.erase(unique(kmerProfile.begin(), kmerProfile.end()), kmerProfile.end());
+        
         return kmerProfile;	
     }
 	catch(exception& e) {
@@ -189,7 +193,7 @@ int KmerTree::aggregateThetas(){
                 
                 KmerNode* holder = tree[levelMatrix[i][j]];
                 
-                tree[holder->getParent()]->addThetas(holder->getTheta(), holder->getNumSeqs());				
+                tree[holder->getParent()]->addThetas(holder->getKmers(), holder->getCounts(), holder->getNumSeqs());				
             }
         }
         
@@ -118,6 +118,33 @@ PhyloTree::PhyloTree(ifstream& in, string filename){
 }
 /**************************************************************************************************/
 
+PhyloTree::PhyloTree(vector<string>& nodeNames, vector<int>& nodeLevels, vector<int>& nodeParents, vector<int>& genusNodes, vector<int>& genusTotals){
+	try {
+		m = MothurOut::getInstance();
+		calcTotals = false;
+		numNodes = nodeNames.size();
+		numSeqs = 0;
+		
+		tree.resize(numNodes);
+		for (int i = 0; i < tree.size(); i++) {
+			tree[i].name = nodeNames[i];
+			tree[i].level = nodeLevels[i];
+			tree[i].parent = nodeParents[i];
+		}
+		
+		totals.clear();
+		for (int i = 0; i < genusNodes.size(); i++) {
+			uniqueTaxonomies.insert(genusNodes[i]);
+			totals.push_back(genusTotals[i]);
+		}
+	}
+	catch(exception& e) {
+		m->errorOut(e, "PhyloTree", "PhyloTree");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+
 PhyloTree::PhyloTree(string tfile){
 	try {
 		m = MothurOut::getInstance();
@@ -33,6 +33,7 @@ public:
 	PhyloTree();
 	PhyloTree(string);  //pass it a taxonomy file and it makes the tree
 	PhyloTree(ifstream&, string);  //pass it a taxonomy file and it makes the train.tree
+	PhyloTree(vector<string>&, vector<int>&, vector<int>&, vector<int>&, vector<int>&);  //names, levels and parents of the nodes, genus nodes and their sizes, used by the bayesian cache
 	~PhyloTree() {};
 	int addSeqToTree(string, string);
 	void assignHeirarchyIDs(int);
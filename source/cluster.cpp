@@ -47,7 +47,7 @@ void Cluster::clusterNames(){
 	try {
 		if (mapWanted) {  updateMap();  }
 		
-		list->set(smallCol, list->get(smallRow)+','+list->get(smallCol));
+		list->merge(smallCol, smallRow, smallCol);
 		list->set(smallRow, "");	
 		list->setLabel(toString(smallDist));
     }
@@ -507,7 +507,7 @@ void ClusterClassic::clusterNames(){
 	//	cout << smallCol << '\t' << smallRow << '\t' << smallDist << '\t' << list->get(smallRow) << '\t' << list->get(smallCol);
 		if (mapWanted) {  updateMap();  }
 		
-		list->set(smallRow, list->get(smallRow)+','+list->get(smallCol));
+		list->merge(smallRow, smallRow, smallCol);
 		list->set(smallCol, "");	
 		/*for (int i = smallCol+1; i < list->size(); i++) {
 			list->set((i-1), list->get(i));
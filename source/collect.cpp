@@ -73,10 +73,14 @@ try {
                 vector<SharedRAbundVector*> lookup; 
 				vector<SharedRAbundVector*> subset;
 
+                //the otus with no seqs are not counted in getNumBins, so size the vectors by the last otu
+                int numBins = 0;
+                for (int i = 0; i < numSeqs; i++) {  numBins = max(numBins, sharedorder->get(i).bin+1);  }
+                
                 //create and initialize vector of sharedvectors, one for each group
 				vector<string> mGroups = m->getGroups();
                 for (int i = 0; i < mGroups.size(); i++) { 
-                        SharedRAbundVector* temp = new SharedRAbundVector(sharedorder->getNumBins());
+                        SharedRAbundVector* temp = new SharedRAbundVector(numBins);
                         temp->setLabel(sharedorder->getLabel());
                         temp->setGroup(mGroups[i]);
 						lookup.push_back(temp);
@@ -150,10 +150,12 @@
 #include "lefsecommand.h"
 #include "kruskalwalliscommand.h"
 #include "sracommand.h"
+#include "convertdistscommand.h"
 #include "mergesfffilecommand.h"
 #include "getmimarkspackagecommand.h"
 #include "mimarksattributescommand.h"
 #include "setseedcommand.h"
+#include "setprofilecommand.h"
 #include "makefilecommand.h"
 
 //needed for testing project
@@ -331,11 +333,13 @@ CommandFactory::CommandFactory(){
     commands["lefse"]               = "lefse";
     commands["kruskal.wallis"]      = "kruskal.wallis";
     commands["make.sra"]            = "make.sra";
+    commands["convert.dists"]       = "convert.dists";
     commands["merge.sfffiles"]      = "merge.sfffiles";
     commands["get.mimarkspackage"]  = "get.mimarkspackage";
     commands["mimarks.attributes"]  = "mimarks.attributes";
     commands["make.file"]           = "make.file";
     commands["set.seed"]            = "set.seed";
+    commands["set.profile"]         = "set.profile";
 
 
 }
@@ -594,10 +598,12 @@ Command* CommandFactory::getCommand(string commandName, string optionString){
         else if(commandName == "lefse")                 {	command = new LefseCommand(optionString);                   }
         else if(commandName == "kruskal.wallis")        {	command = new KruskalWallisCommand(optionString);           }
         else if(commandName == "make.sra")              {	command = new SRACommand(optionString);                     }
+        else if(commandName == "convert.dists")         {	command = new ConvertDistsCommand(optionString);            }
         else if(commandName == "merge.sfffiles")        {	command = new MergeSfffilesCommand(optionString);           }
         else if(commandName == "get.mimarkspackage")    {	command = new GetMIMarksPackageCommand(optionString);       }
         else if(commandName == "mimarks.attributes")    {	command = new MimarksAttributesCommand(optionString);       }
         else if(commandName == "set.seed")              {	command = new SetSeedCommand(optionString);                 }
+        else if(commandName == "set.profile")           {	command = new SetProfileCommand(optionString);              }
         else if(commandName == "make.file")             {	command = new MakeFileCommand(optionString);                }
 		else											{	command = new NoCommand(optionString);						}
 
@@ -768,11 +774,13 @@ Command* CommandFactory::getCommand(string commandName, string optionString, str
         else if(commandName == "lefse")                 {	pipecommand = new LefseCommand(optionString);                   }
         else if(commandName == "kruskal.wallis")        {	pipecommand = new KruskalWallisCommand(optionString);           }
         else if(commandName == "make.sra")              {	pipecommand = new SRACommand(optionString);                     }
+        else if(commandName == "convert.dists")         {	pipecommand = new ConvertDistsCommand(optionString);            }
         else if(commandName == "merge.sfffiles")        {	pipecommand = new MergeSfffilesCommand(optionString);           }
         else if(commandName == "classify.svm")          {   pipecommand = new ClassifySvmSharedCommand(optionString);       }
         else if(commandName == "get.mimarkspackage")    {	pipecommand = new GetMIMarksPackageCommand(optionString);       }
         else if(commandName == "mimarks.attributes")    {	pipecommand = new MimarksAttributesCommand(optionString);       }
         else if(commandName == "set.seed")              {	pipecommand = new SetSeedCommand(optionString);                 }
+        else if(commandName == "set.profile")           {	pipecommand = new SetProfileCommand(optionString);              }
         else if(commandName == "make.file")             {	pipecommand = new MakeFileCommand(optionString);                }
 		else											{	pipecommand = new NoCommand(optionString);						}
 
@@ -930,10 +938,12 @@ Command* CommandFactory::getCommand(string commandName){
         else if(commandName == "kruskal.wallis")        {	shellcommand = new KruskalWallisCommand();          }
         else if(commandName == "classify.svm")          {   shellcommand = new ClassifySvmSharedCommand();      }
         else if(commandName == "make.sra")              {	shellcommand = new SRACommand();                    }
+        else if(commandName == "convert.dists")         {	shellcommand = new ConvertDistsCommand();           }
         else if(commandName == "merge.sfffiles")        {	shellcommand = new MergeSfffilesCommand();          }
         else if(commandName == "get.mimarkspackage")    {	shellcommand = new GetMIMarksPackageCommand();      }
         else if(commandName == "mimarks.attributes")    {	shellcommand = new MimarksAttributesCommand();      }
         else if(commandName == "set.seed")              {	shellcommand = new SetSeedCommand();                }
+        else if(commandName == "set.profile")           {	shellcommand = new SetProfileCommand();             }
         else if(commandName == "make.file")             {	shellcommand = new MakeFileCommand();               }
 		else											{	shellcommand = new NoCommand();						}
 
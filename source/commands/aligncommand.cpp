@@ -26,6 +26,7 @@ vector<string> AlignCommand::setParameters(){
 		CommandParameter pksize("ksize", "Number", "", "8", "", "", "","",false,false); parameters.push_back(pksize);
 		CommandParameter pmatch("match", "Number", "", "1.0", "", "", "","",false,false); parameters.push_back(pmatch);
 		CommandParameter palign("align", "Multiple", "needleman-gotoh-blast-noalign", "needleman", "", "", "","",false,false,true); parameters.push_back(palign);
+		CommandParameter pband("band", "Number", "", "0", "", "", "","",false,false); parameters.push_back(pband);
 		CommandParameter pmismatch("mismatch", "Number", "", "-1.0", "", "", "","",false,false); parameters.push_back(pmismatch);
 		CommandParameter pgapopen("gapopen", "Number", "", "-5.0", "", "", "","",false,false); parameters.push_back(pgapopen);
 		CommandParameter pgapextend("gapextend", "Number", "", "-2.0", "", "", "","",false,false); parameters.push_back(pgapextend);
@@ -51,10 +52,12 @@ string AlignCommand::getHelpString(){
 	try {
 		string helpString = "";
 		helpString += "The align.seqs command reads a file containing sequences and creates an alignment file and a report file.";
-		helpString += "The align.seqs command parameters are reference, fasta, search, ksize, align, match, mismatch, gapopen, gapextend and processors.";
+		helpString += "The align.seqs command parameters are reference, fasta, search, ksize, align, band, match, mismatch, gapopen, gapextend and processors.";
 		helpString += "The reference and fasta parameters are required. You may leave fasta blank if you have a valid fasta file. You may enter multiple fasta files by separating their names with dashes. ie. fasta=abrecovery.fasta-amzon.fasta.";
 		helpString += "The search parameter allows you to specify the method to find most similar template.  Your options are: suffix, kmer and blast. The default is kmer.";
-		helpString += "The align parameter allows you to specify the alignment method to use.  Your options are: gotoh, needleman, blast and noalign. The default is needleman.";
+		helpString += "The align parameter allows you to specify the alignment method to use.  Your options are: gotoh, needleman, needleman-simd, blast and noalign. The default is needleman.";
+		helpString += "The needleman-simd method finds the same alignments as needleman, but scores several cells of the alignment matrix at once and uses less memory.";
+		helpString += "The band parameter is used with needleman-simd to only score the cells within band positions of the diagonal shared by the most 7-mers of the candidate and template.  This is faster for long sequences, but may miss the best alignment.  The default is 0, meaning the full matrix is scored.";
 		helpString += "The ksize parameter allows you to specify the kmer size for finding most similar template to candidate.  The default is 8.";
 		helpString += "The match parameter allows you to specify the bonus for having the same base. The default is 1.0.";
 		helpString += "The mistmatch parameter allows you to specify the penalty for having different bases.  The default is -1.0.";
@@ -256,6 +259,9 @@ AlignCommand::AlignCommand(string option)  {
 			temp = validParameter.validFile(parameters, "gapextend", false);	if (temp == "not found"){	temp = "-2.0";			}
 			m->mothurConvert(temp, gapExtend); 
 			
+			temp = validParameter.validFile(parameters, "band", false);			if (temp == "not found"){	temp = "0";				}
+			m->mothurConvert(temp, band); 
+			
 			temp = validParameter.validFile(parameters, "processors", false);	if (temp == "not found"){	temp = m->getProcessors();	}
 			m->setProcessors(temp);
 			m->mothurConvert(temp, processors); 
@@ -291,7 +297,7 @@ AlignCommand::AlignCommand(string option)  {
 			if ((search != "suffix") && (search != "kmer") && (search != "blast")) { m->mothurOut("invalid search option: choices are kmer, suffix or blast."); m->mothurOutEndLine(); abort=true; }
 			
 			align = validParameter.validFile(parameters, "align", false);		if (align == "not found"){	align = "needleman";	}
-			if ((align != "needleman") && (align != "gotoh") && (align != "blast") && (align != "noalign")) { m->mothurOut("invalid align option: choices are needleman, gotoh, blast or noalign."); m->mothurOutEndLine(); abort=true; }
+			if ((align != "needleman") && (align != "needleman-simd") && (align != "gotoh") && (align != "blast") && (align != "noalign")) { m->mothurOut("invalid align option: choices are needleman, needleman-simd, gotoh, blast or noalign."); m->mothurOutEndLine(); abort=true; }
 
 		}
 		
@@ -305,7 +311,6 @@ AlignCommand::AlignCommand(string option)  {
 AlignCommand::~AlignCommand(){	
 
 	if (abort == false) {
-		for (int i = 0; i < lines.size(); i++) {  delete lines[i];  }  lines.clear();
 		delete templateDB;
 	}
 }
@@ -315,8 +320,12 @@ int AlignCommand::execute(){
 	try {
 		if (abort == true) { if (calledHelp) { return 0; }  return 2;	}
 
+		Profiler::getInstance()->startPhase("read");
+		
 		templateDB = new AlignmentDB(templateFileName, search, kmerSize, gapOpen, gapExtend, match, misMatch, rand());
 		
+		Profiler::getInstance()->startPhase("compute");
+		
 		for (int s = 0; s < candidateFileNames.size(); s++) {
 			if (m->control_pressed) { outputTypes.clear(); return 0; }
 			
@@ -331,7 +340,6 @@ int AlignCommand::execute(){
 			bool hasAccnos = true;
 			
 			int numFastaSeqs = 0;
-			for (int i = 0; i < lines.size(); i++) {  delete lines[i];  }  lines.clear();
 			int start = time(NULL);
 		
 #ifdef USE_MPI	
@@ -441,32 +449,7 @@ int AlignCommand::execute(){
 				
 #else
 
-			vector<unsigned long long> positions; 
-		#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
-			positions = m->divideFile(candidateFileNames[s], processors);
-			for (int i = 0; i < (positions.size()-1); i++) {	lines.push_back(new linePair(positions[i], positions[(i+1)]));	}
-		#else
-			if (processors == 1) {
-				lines.push_back(new linePair(0, 1000));
-			}else {
-				positions = m->setFilePosFasta(candidateFileNames[s], numFastaSeqs); 
-				if (positions.size() < processors) { processors = positions.size(); }
-                
-				//figure out how many sequences you have to process
-				int numSeqsPerProcessor = numFastaSeqs / processors;
-				for (int i = 0; i < processors; i++) {
-					int startIndex =  i * numSeqsPerProcessor;
-					if(i == (processors - 1)){	numSeqsPerProcessor = numFastaSeqs - i * numSeqsPerProcessor; 	}
-					lines.push_back(new linePair(positions[startIndex], numSeqsPerProcessor));
-				}
-			}
-		#endif
-			
-			if(processors == 1){
-				numFastaSeqs = driver(lines[0], alignFileName, reportFileName, accnosFileName, candidateFileNames[s]);
-			}else{
-				numFastaSeqs = createProcesses(alignFileName, reportFileName, accnosFileName, candidateFileNames[s]); 
-			}
+			numFastaSeqs = createProcesses(alignFileName, reportFileName, accnosFileName, candidateFileNames[s]);
 				
 			if (m->control_pressed) { m->mothurRemove(accnosFileName); m->mothurRemove(alignFileName); m->mothurRemove(reportFileName); outputTypes.clear();  return 0; }
 			
@@ -523,150 +506,111 @@ int AlignCommand::execute(){
 }
 
 //**********************************************************************************************************************
-int AlignCommand::driver(linePair* filePos, string alignFName, string reportFName, string accnosFName, string filename){
+//aligns a block of sequences, output holds the alignments, report and accnos lines for the block.
+//several processors run driver at once, so it only reads from the command and the template database
+int AlignCommand::driver(vector<Sequence*>& seqs, Alignment* alignment, vector<string>& output){
 	try {
-		ofstream alignmentFile;
-		m->openOutputFile(alignFName, alignmentFile);
-		
-		ofstream accnosFile;
-		m->openOutputFile(accnosFName, accnosFile);
-		
-		NastReport report(reportFName);
-		
-		ifstream inFASTA;
-		m->openInputFile(filename, inFASTA);
-
-		inFASTA.seekg(filePos->start);
-
-		bool done = false;
+		ostringstream alignmentFile, reportFile, accnosFile;
+		NastReport report;
 		int count = 0;
 		
-		//moved this into driver to avoid deep copies in windows paralellized version
-		Alignment* alignment;
-		int longestBase = templateDB->getLongestBase();
-        if (m->debug) { m->mothurOut("[DEBUG]: template longest base = "  + toString(templateDB->getLongestBase()) + " \n"); }
-		if(align == "gotoh")			{	alignment = new GotohOverlap(gapOpen, gapExtend, match, misMatch, longestBase);			}
-		else if(align == "needleman")	{	alignment = new NeedlemanOverlap(gapOpen, match, misMatch, longestBase);				}
-		else if(align == "blast")		{	alignment = new BlastAlignment(gapOpen, gapExtend, match, misMatch);		}
-		else if(align == "noalign")		{	alignment = new NoAlign();													}
-		else {
-			m->mothurOut(align + " is not a valid alignment option. I will run the command using needleman.");
-			m->mothurOutEndLine();
-			alignment = new NeedlemanOverlap(gapOpen, match, misMatch, longestBase);
-		}
-	
-		while (!done) {
+		for (int i = 0; i < seqs.size(); i++) {
 			
 			if (m->control_pressed) {  break; }
 			
-			Sequence* candidateSeq = new Sequence(inFASTA);  m->gobble(inFASTA);
+			Sequence* candidateSeq = seqs[i];
 			report.setCandidate(candidateSeq);
 
 			int origNumBases = candidateSeq->getNumBases();
 			string originalUnaligned = candidateSeq->getUnaligned();
 			int numBasesNeeded = origNumBases * threshold;
 	
-			if (candidateSeq->getName() != "") { //incase there is a commented sequence at the end of a file
-				if (candidateSeq->getUnaligned().length()+1 > alignment->getnRows()) {
-                    if (m->debug) { m->mothurOut("[DEBUG]: " + candidateSeq->getName() + " " + toString(candidateSeq->getUnaligned().length()) + " " + toString(alignment->getnRows()) + " \n"); }
-					alignment->resize(candidateSeq->getUnaligned().length()+2);
-				}
-				Sequence temp = templateDB->findClosestSequence(candidateSeq);
-				Sequence* templateSeq = new Sequence(temp.getName(), temp.getAligned());
-				
-				float searchScore = templateDB->getSearchScore();
-								
-				Nast* nast = new Nast(alignment, candidateSeq, templateSeq);
-		
-				Sequence* copy;
-				
-				Nast* nast2;
-				bool needToDeleteCopy = false;  //this is needed in case you have you enter the ifs below
-												//since nast does not make a copy of hte sequence passed, and it is used by the reporter below
-												//you can't delete the copy sequence til after you report, but you may choose not to create it in the first place
-												//so this bool tells you if you need to delete it
-												
-				//if there is a possibility that this sequence should be reversed
-				if (candidateSeq->getNumBases() < numBasesNeeded) {
-					
-					string wasBetter =  "";
-					//if the user wants you to try the reverse
-					if (flip) {
-				
-						//get reverse compliment
-						copy = new Sequence(candidateSeq->getName(), originalUnaligned);
-						copy->reverseComplement();
-                        
-                        if (m->debug) { m->mothurOut("[DEBUG]: flipping "  + candidateSeq->getName() + " \n"); }
-						
-						//rerun alignment
-						Sequence temp2 = templateDB->findClosestSequence(copy);
-						Sequence* templateSeq2 = new Sequence(temp2.getName(), temp2.getAligned());
-                        
-                        if (m->debug) { m->mothurOut("[DEBUG]: closest template "  + temp2.getName() + " \n"); }
-						
-						searchScore = templateDB->getSearchScore();
-						
-						nast2 = new Nast(alignment, copy, templateSeq2);
-                        
-                        if (m->debug) { m->mothurOut("[DEBUG]: completed Nast2 "  + candidateSeq->getName() + " flipped numBases = " + toString(copy->getNumBases()) + " old numbases = " + toString(candidateSeq->getNumBases()) +" \n"); }
+			if (candidateSeq->getUnaligned().length()+1 > alignment->getnRows()) {
+				if (m->debug) { m->mothurOut("[DEBUG]: " + candidateSeq->getName() + " " + toString(candidateSeq->getUnaligned().length()) + " " + toString(alignment->getnRows()) + " \n"); }
+				alignment->resize(candidateSeq->getUnaligned().length()+2);
+			}
 			
-						//check if any better
-						if (copy->getNumBases() > candidateSeq->getNumBases()) {
-							candidateSeq->setAligned(copy->getAligned());  //use reverse compliments alignment since its better
-                            delete templateSeq;
-							templateSeq = templateSeq2;
-							delete nast;
-							nast = nast2;
-							needToDeleteCopy = true;
-							wasBetter = "\treverse complement produced a better alignment, so mothur used the reverse complement.";
-						}else{  
-							wasBetter = "\treverse complement did NOT produce a better alignment so it was not used, please check sequence.";
-							delete nast2;
-                            delete templateSeq2;
-							delete copy;	
-						}
-                        if (m->debug) { m->mothurOut("[DEBUG]: done.\n"); }
-					}
+			float searchScore;
+			Sequence temp = templateDB->findClosestSequence(candidateSeq, searchScore);
+			Sequence* templateSeq = new Sequence(temp.getName(), temp.getAligned());
+							
+			Nast* nast = new Nast(alignment, candidateSeq, templateSeq);
+	
+			Sequence* copy;
+			
+			Nast* nast2;
+			bool needToDeleteCopy = false;  //this is needed in case you have you enter the ifs below
+											//since nast does not make a copy of hte sequence passed, and it is used by the reporter below
+											//you can't delete the copy sequence til after you report, but you may choose not to create it in the first place
+											//so this bool tells you if you need to delete it
+											
+			//if there is a possibility that this sequence should be reversed
+			if (candidateSeq->getNumBases() < numBasesNeeded) {
+				
+				string wasBetter =  "";
+				//if the user wants you to try the reverse
+				if (flip) {
+			
+					//get reverse compliment
+					copy = new Sequence(candidateSeq->getName(), originalUnaligned);
+					copy->reverseComplement();
 					
-					//create accnos file with names
-					accnosFile << candidateSeq->getName() << wasBetter << endl;
+					if (m->debug) { m->mothurOut("[DEBUG]: flipping "  + candidateSeq->getName() + " \n"); }
+					
+					//rerun alignment
+					float searchScore2;
+					Sequence temp2 = templateDB->findClosestSequence(copy, searchScore2);
+					Sequence* templateSeq2 = new Sequence(temp2.getName(), temp2.getAligned());
+					
+					if (m->debug) { m->mothurOut("[DEBUG]: closest template "  + temp2.getName() + " \n"); }
+					
+					searchScore = searchScore2;
+					
+					nast2 = new Nast(alignment, copy, templateSeq2);
+					
+					if (m->debug) { m->mothurOut("[DEBUG]: completed Nast2 "  + candidateSeq->getName() + " flipped numBases = " + toString(copy->getNumBases()) + " old numbases = " + toString(candidateSeq->getNumBases()) +" \n"); }
+		
+					//check if any better
+					if (copy->getNumBases() > candidateSeq->getNumBases()) {
+						candidateSeq->setAligned(copy->getAligned());  //use reverse compliments alignment since its better
+						delete templateSeq;
+						templateSeq = templateSeq2;
+						delete nast;
+						nast = nast2;
+						needToDeleteCopy = true;
+						wasBetter = "\treverse complement produced a better alignment, so mothur used the reverse complement.";
+					}else{  
+						wasBetter = "\treverse complement did NOT produce a better alignment so it was not used, please check sequence.";
+						delete nast2;
+						delete templateSeq2;
+						delete copy;	
+					}
+					if (m->debug) { m->mothurOut("[DEBUG]: done.\n"); }
 				}
 				
-				report.setTemplate(templateSeq);
-				report.setSearchParameters(search, searchScore);
-				report.setAlignmentParameters(align, alignment);
-				report.setNastParameters(*nast);
-	
-				alignmentFile << '>' << candidateSeq->getName() << '\n' << candidateSeq->getAligned() << endl;
-				
-				report.print();
-				delete nast;
-                delete templateSeq;
-				if (needToDeleteCopy) {   delete copy;   }
-				
-				count++;
+				//create accnos file with names
+				accnosFile << candidateSeq->getName() << wasBetter << endl;
 			}
-			delete candidateSeq;
 			
-			#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
-				unsigned long long pos = inFASTA.tellg();
-				if ((pos == -1) || (pos >= filePos->end)) { break; }
-			#else
-				if (inFASTA.eof()) { break; }
-			#endif
+			report.setTemplate(templateSeq);
+			report.setSearchParameters(search, searchScore);
+			report.setAlignmentParameters(align, alignment);
+			report.setNastParameters(*nast);
+
+			alignmentFile << '>' << candidateSeq->getName() << '\n' << candidateSeq->getAligned() << endl;
 			
-			//report progress
-			if((count) % 100 == 0){	m->mothurOutJustToScreen(toString(count) + "\n"); 		}
+			report.print(reportFile);
+			delete nast;
+			delete templateSeq;
+			if (needToDeleteCopy) {   delete copy;   }
 			
+			count++;
 		}
-		//report progress
-		if((count) % 100 != 0){	m->mothurOutJustToScreen(toString(count) + "\n"); 		}
 		
-		delete alignment;
-		alignmentFile.close();
-		inFASTA.close();
-		accnosFile.close();
+		output.clear();
+		output.push_back(alignmentFile.str());
+		output.push_back(reportFile.str());
+		output.push_back(accnosFile.str());
 		
 		return count;
 	}
@@ -705,6 +649,7 @@ int AlignCommand::driverMPI(int start, int num, MPI_File& inMPI, MPI_File& align
 		int longestBase = templateDB->getLongestBase();
 		if(align == "gotoh")			{	alignment = new GotohOverlap(gapOpen, gapExtend, match, misMatch, longestBase);			}
 		else if(align == "needleman")	{	alignment = new NeedlemanOverlap(gapOpen, match, misMatch, longestBase);				}
+		else if(align == "needleman-simd")	{	alignment = new NeedlemanSIMD(gapOpen, match, misMatch, longestBase, band);			}
 		else if(align == "blast")		{	alignment = new BlastAlignment(gapOpen, gapExtend, match, misMatch);		}
 		else if(align == "noalign")		{	alignment = new NoAlign();													}
 		else {
@@ -856,246 +801,78 @@ int AlignCommand::driverMPI(int start, int num, MPI_File& inMPI, MPI_File& align
 }
 #endif
 /**************************************************************************************************/
-
+//the processors share the template database. The fasta file is read in blocks of 100 sequences, and
+//the aligned blocks are written in the order they were read, so the output does not depend on processors.
 int AlignCommand::createProcesses(string alignFileName, string reportFileName, string accnosFName, string filename) {
 	try {
-		int num = 0;
-		processIDS.resize(0);
-        bool recalc = false;
-        
-#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
-		int process = 1;
-		
-		//loop through and create all the processes you want
-		while (process != processors) {
-			pid_t pid = fork();
-			
-			if (pid > 0) {
-				processIDS.push_back(pid);  //create map from line number to pid so you can append files in correct order later
-				process++;
-			}else if (pid == 0){
-				num = driver(lines[process], alignFileName + toString(m->mothurGetpid(process)) + ".temp", reportFileName + toString(m->mothurGetpid(process)) + ".temp", accnosFName + m->mothurGetpid(process) + ".temp", filename);
-				
-				//pass numSeqs to parent
-				ofstream out;
-				string tempFile = alignFileName + toString(m->mothurGetpid(process)) + ".num.temp";
-				m->openOutputFile(tempFile, out);
-				out << num << endl;
-				out.close();
-				
-				exit(0);
-			}else { 
-				m->mothurOut("[ERROR]: unable to spawn the number of processes you requested, reducing number to " + toString(process) + "\n"); processors = process;
-                for (int i = 0; i < processIDS.size(); i++) { kill (processIDS[i], SIGINT); }
-                //wait to die
-                for (int i=0;i<processIDS.size();i++) {
-                    int temp = processIDS[i];
-                    wait(&temp);
-                }
-                m->control_pressed = false;
-                recalc = true;
-				break;
-			}
-		}
-		
-        if (recalc) {
-            //test line, also set recalc to true.
-            //for (int i = 0; i < processIDS.size(); i++) { kill (processIDS[i], SIGINT); } for (int i=0;i<processIDS.size();i++) { int temp = processIDS[i]; wait(&temp); } m->control_pressed = false;  processors=3; m->mothurOut("[ERROR]: unable to spawn the number of processes you requested, reducing number to " + toString(processors) + "\n");
-            for (int i = 0; i < lines.size(); i++) {  delete lines[i];  }  lines.clear();
-            vector<unsigned long long> positions;
-			positions = m->divideFile(filename, processors);
-			for (int i = 0; i < (positions.size()-1); i++) {	lines.push_back(new linePair(positions[i], positions[(i+1)]));	}
-            
-            num = 0;
-            processIDS.resize(0);
-            process = 1;
-            
-            while (process != processors) {
-                pid_t pid = fork();
-                
-                if (pid > 0) {
-                    processIDS.push_back(pid);  //create map from line number to pid so you can append files in correct order later
-                    process++;
-                }else if (pid == 0){
-                    num = driver(lines[process], alignFileName + toString(m->mothurGetpid(process)) + ".temp", reportFileName + toString(m->mothurGetpid(process)) + ".temp", accnosFName + m->mothurGetpid(process) + ".temp", filename);
-                    
-                    //pass numSeqs to parent
-                    ofstream out;
-                    string tempFile = alignFileName + toString(m->mothurGetpid(process)) + ".num.temp";
-                    m->openOutputFile(tempFile, out);
-                    out << num << endl;
-                    out.close();
-                    
-                    exit(0);
-                }else {
-                    m->mothurOut("[ERROR]: unable to spawn the necessary processes."); m->mothurOutEndLine();
-                    for (int i = 0; i < processIDS.size(); i++) { kill (processIDS[i], SIGINT); }
-                    exit(0);
-                }
-            }
-        }
-        
-		//do my part
-		num = driver(lines[0], alignFileName, reportFileName, accnosFName, filename);
+		ofstream alignmentFile;
+		m->openOutputFile(alignFileName, alignmentFile);
 		
-		//force parent to wait until all the processes are done
-		for (int i=0;i<processIDS.size();i++) { 
-			int temp = processIDS[i];
-			wait(&temp);
-		}
+		ofstream reportFile;
+		m->openOutputFile(reportFileName, reportFile);
+		NastReport report;
+		reportFile << report.getHeaders();
 		
-		vector<string> nonBlankAccnosFiles;
-		if (!(m->isBlank(accnosFName))) { nonBlankAccnosFiles.push_back(accnosFName); }
-		else { m->mothurRemove(accnosFName); } //remove so other files can be renamed to it
-			
-		for (int i = 0; i < processIDS.size(); i++) {
-			ifstream in;
-			string tempFile =  alignFileName + toString(processIDS[i]) + ".num.temp";
-			m->openInputFile(tempFile, in);
-			if (!in.eof()) { int tempNum = 0; in >> tempNum; num += tempNum; }
-			in.close(); m->mothurRemove(tempFile);
-			
-			m->appendFiles((alignFileName + toString(processIDS[i]) + ".temp"), alignFileName);
-			m->mothurRemove((alignFileName + toString(processIDS[i]) + ".temp"));
-			
-			appendReportFiles((reportFileName + toString(processIDS[i]) + ".temp"), reportFileName);
-			m->mothurRemove((reportFileName + toString(processIDS[i]) + ".temp"));
-			
-			if (!(m->isBlank(accnosFName + toString(processIDS[i]) + ".temp"))) {
-				nonBlankAccnosFiles.push_back(accnosFName + toString(processIDS[i]) + ".temp");
-			}else { m->mothurRemove((accnosFName + toString(processIDS[i]) + ".temp"));  }
-			
-		}
+		ofstream accnosFile;
+		m->openOutputFile(accnosFName, accnosFile);
 		
-		//append accnos files
-		if (nonBlankAccnosFiles.size() != 0) { 
-			rename(nonBlankAccnosFiles[0].c_str(), accnosFName.c_str());
-			
-			for (int h=1; h < nonBlankAccnosFiles.size(); h++) {
-				m->appendFiles(nonBlankAccnosFiles[h], accnosFName);
-				m->mothurRemove(nonBlankAccnosFiles[h]);
-			}
-		}else { //recreate the accnosfile if needed
-			ofstream out;
-			m->openOutputFile(accnosFName, out);
-			out.close();
-		}
-#else
-		//////////////////////////////////////////////////////////////////////////////////////////////////////
-		//Windows version shared memory, so be careful when passing variables through the alignData struct. 
-		//Above fork() will clone, so memory is separate, but that's not the case with windows, 
-		//////////////////////////////////////////////////////////////////////////////////////////////////////
+		vector<ostream*> files;
+		files.push_back(&alignmentFile); files.push_back(&reportFile); files.push_back(&accnosFile);
+		OutputSink sink(files, true);
 		
-		vector<alignData*> pDataArray; 
-		DWORD   dwThreadIdArray[processors-1];
-		HANDLE  hThreadArray[processors-1]; 
+		ThreadPool pool(processors);
 		
-		//Create processor worker threads.
-		for( int i=0; i<processors-1; i++ ){
-			//copy templateDb
-			//AlignmentDB* tempDB = new AlignmentDB(*templateDB);
-			
-			// Allocate memory for thread data.
-			string extension = "";
-			if (i != 0) { extension = toString(i) + ".temp"; }
-			
-			alignData* tempalign = new alignData(templateFileName, (alignFileName + extension), (reportFileName + extension), (accnosFName + extension), filename, align, search, kmerSize, m, lines[i]->start, lines[i]->end, flip, match, misMatch, gapOpen, gapExtend, threshold, i);
-			pDataArray.push_back(tempalign);
-			processIDS.push_back(i);
-				
-			//MySeqSumThreadFunction is in header. It must be global or static to work with the threads.
-			//default security attributes, thread function name, argument to thread function, use default creation flags, returns the thread identifier
-			hThreadArray[i] = CreateThread(NULL, 0, MyAlignThreadFunction, pDataArray[i], 0, &dwThreadIdArray[i]);   
+		//each processor needs its own alignment matrix
+		vector<Alignment*> alignments;
+		int longestBase = templateDB->getLongestBase();
+		if (m->debug) { m->mothurOut("[DEBUG]: template longest base = "  + toString(longestBase) + " \n"); }
+		for (int i = 0; i < pool.getNumProcessors(); i++) {
+			if(align == "gotoh")			{	alignments.push_back(new GotohOverlap(gapOpen, gapExtend, match, misMatch, longestBase));		}
+			else if(align == "needleman")	{	alignments.push_back(new NeedlemanOverlap(gapOpen, match, misMatch, longestBase));				}
+			else if(align == "needleman-simd")	{	alignments.push_back(new NeedlemanSIMD(gapOpen, match, misMatch, longestBase, band));			}
+			else if(align == "blast")		{	alignments.push_back(new BlastAlignment(gapOpen, gapExtend, match, misMatch));					}
+			else							{	alignments.push_back(new NoAlign());															}
 		}
 		
-		//need to check for line ending error
 		ifstream inFASTA;
 		m->openInputFile(filename, inFASTA);
-		inFASTA.seekg(lines[processors-1]->start-1);
-		char c = inFASTA.peek();
-		
-		if (c != '>') { //we need to move back
-			lines[processors-1]->start--; 
-		}
-		
-		//using the main process as a worker saves time and memory
-		//do my part - do last piece because windows is looking for eof
-		num = driver(lines[processors-1], (alignFileName + toString(processors-1) + ".temp"), (reportFileName + toString(processors-1) + ".temp"), (accnosFName + toString(processors-1) + ".temp"), filename);
-		
-		//Wait until all threads have terminated.
-		WaitForMultipleObjects(processors-1, hThreadArray, TRUE, INFINITE);
-		
-		//Close all thread handles and free memory allocations.
-		for(int i=0; i < pDataArray.size(); i++){
-            if (pDataArray[i]->count != pDataArray[i]->end) {
-                m->mothurOut("[ERROR]: process " + toString(i) + " only processed " + toString(pDataArray[i]->count) + " of " + toString(pDataArray[i]->end) + " sequences assigned to it, quitting. \n"); m->control_pressed = true; 
-            }
-			num += pDataArray[i]->count;
-			CloseHandle(hThreadArray[i]);
-			delete pDataArray[i];
-		}
-		
-		vector<string> nonBlankAccnosFiles;
-		if (!(m->isBlank(accnosFName))) { nonBlankAccnosFiles.push_back(accnosFName); }
-		else { m->mothurRemove(accnosFName); } //remove so other files can be renamed to it
 		
-		for (int i = 1; i < processors; i++) {
-			m->appendFiles((alignFileName + toString(i) + ".temp"), alignFileName);
-			m->mothurRemove((alignFileName + toString(i) + ".temp"));
+		int numBlocks = 0;
+		while (!inFASTA.eof()) {
+			if (m->control_pressed) { break; }
 			
-			appendReportFiles((reportFileName + toString(i) + ".temp"), reportFileName);
-			m->mothurRemove((reportFileName + toString(i) + ".temp"));
+			vector<Sequence*>* block = new vector<Sequence*>();
+			while (!inFASTA.eof() && (block->size() < 100)) {
+				Sequence* candidateSeq = new Sequence(inFASTA);  m->gobble(inFASTA);
+				if (candidateSeq->getName() != "") { block->push_back(candidateSeq); } //incase there is a commented sequence at the end of a file
+				else { delete candidateSeq; }
+			}
 			
-			if (!(m->isBlank(accnosFName + toString(i) + ".temp"))) {
-				nonBlankAccnosFiles.push_back(accnosFName + toString(i) + ".temp");
-			}else { m->mothurRemove((accnosFName + toString(i) + ".temp"));  }
+			int blockNum = numBlocks; numBlocks++;
+			pool.submit([this, block, blockNum, &alignments, &sink](int processor) {
+				vector<string> output;
+				int count = driver(*block, alignments[processor], output);
+				sink.write(blockNum, output, count);
+				for (int i = 0; i < block->size(); i++) { delete (*block)[i]; }
+				delete block;
+			});
+			
+			//keeps the number of blocks in memory bounded, the ones running and the ones waiting to be written
+			pool.waitForSlot(pool.getNumProcessors() * 4, &sink);
 		}
+		pool.wait();
+		inFASTA.close();
 		
-		//append accnos files
-		if (nonBlankAccnosFiles.size() != 0) { 
-			rename(nonBlankAccnosFiles[0].c_str(), accnosFName.c_str());
-			
-			for (int h=1; h < nonBlankAccnosFiles.size(); h++) {
-				m->appendFiles(nonBlankAccnosFiles[h], accnosFName);
-				m->mothurRemove(nonBlankAccnosFiles[h]);
-			}
-		}else { //recreate the accnosfile if needed
-			ofstream out;
-			m->openOutputFile(accnosFName, out);
-			out.close();
-		}	
-#endif	
-		
-		return num;
-	}
-	catch(exception& e) {
-		m->errorOut(e, "AlignCommand", "createProcesses");
-		exit(1);
-	}
-}
-//**********************************************************************************************************************
-
-void AlignCommand::appendReportFiles(string temp, string filename) {
-	try{
+		for (int i = 0; i < alignments.size(); i++) { delete alignments[i]; }
 		
-		ofstream output;
-		ifstream input;
-		m->openOutputFileAppend(filename, output);
-		m->openInputFile(temp, input);
-
-		while (!input.eof())	{	char c = input.get(); if (c == 10 || c == 13){	break;	}	} // get header line
-				
-        char buffer[4096];        
-        while (!input.eof()) {
-            input.read(buffer, 4096);
-            output.write(buffer, input.gcount());
-        }
+		alignmentFile.close();
+		reportFile.close();
+		accnosFile.close();
 		
-		input.close();
-		output.close();
+		return sink.getNumWritten();
 	}
 	catch(exception& e) {
-		m->errorOut(e, "AlignCommand", "appendReportFiles");
+		m->errorOut(e, "AlignCommand", "createProcesses");
 		exit(1);
 	}
 }
@@ -404,9 +404,8 @@ int BinSeqCommand::process(ListVector* list) {
             
             if (m->control_pressed) {  return 1; }
             
-            string binnames = list->get(i);
             vector<string> names;
-            m->splitAtComma(binnames, names);
+            SeqNameTable::getInstance()->getNames(list->getIds(i), names);
             for (int j = 0; j < names.size(); j++) {
                 string name = names[j];
                 
@@ -12,7 +12,6 @@
 //#include "uc.h"
 #include "sequence.hpp"
 #include "referencedb.h"
-#include "systemcommand.h"
 
 //**********************************************************************************************************************
 vector<string> ChimeraUchimeCommand::setParameters(){	
@@ -572,53 +571,6 @@ ChimeraUchimeCommand::ChimeraUchimeCommand(string option)  {
 			if (hasName && (templatefile != "self")) { m->mothurOut("You have provided a namefile and the reference parameter is not set to self. I am not sure what reference you are trying to use, aborting."); m->mothurOutEndLine(); abort=true; }
             if (hasCount && (templatefile != "self")) { m->mothurOut("You have provided a countfile and the reference parameter is not set to self. I am not sure what reference you are trying to use, aborting."); m->mothurOutEndLine(); abort=true; }
 			if (hasGroup && (templatefile != "self")) { m->mothurOut("You have provided a group file and the reference parameter is not set to self. I am not sure what reference you are trying to use, aborting."); m->mothurOutEndLine(); abort=true; }
-			
-			//look for uchime exe
-			path = m->argv;
-			string tempPath = path;
-			for (int i = 0; i < path.length(); i++) { tempPath[i] = tolower(path[i]); }
-			path = path.substr(0, (tempPath.find_last_of('m')));
-			
-			string uchimeCommand;
-#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
-			uchimeCommand = path + "uchime";	//	format the database, -o option gives us the ability
-            if (m->debug) { 
-                m->mothurOut("[DEBUG]: Uchime location using \"which uchime\" = "); 
-                Command* newCommand = new SystemCommand("which uchime"); m->mothurOutEndLine();
-                newCommand->execute();
-                delete newCommand;
-                m->mothurOut("[DEBUG]: Mothur's location using \"which mothur\" = "); 
-                newCommand = new SystemCommand("which mothur"); m->mothurOutEndLine();
-                newCommand->execute();
-                delete newCommand;
-            }
-#else
-			uchimeCommand = path + "uchime.exe";
-#endif
-        
-			//test to make sure uchime exists
-			ifstream in;
-			uchimeCommand = m->getFullPathName(uchimeCommand);
-			int ableToOpen = m->openInputFile(uchimeCommand, in, "no error"); in.close();
-			if(ableToOpen == 1) {	
-                m->mothurOut(uchimeCommand + " file does not exist. Checking path... \n");
-                //check to see if uchime is in the path??
-                
-                string uLocation = m->findProgramPath("uchime");
-                
-                
-                ifstream in2;
-#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
-                ableToOpen = m->openInputFile(uLocation, in2, "no error"); in2.close();
-#else
-                ableToOpen = m->openInputFile((uLocation + ".exe"), in2, "no error"); in2.close();
-#endif
-
-                if(ableToOpen == 1) { m->mothurOut("[ERROR]: " + uLocation + " file does not exist. mothur requires the uchime executable."); m->mothurOutEndLine(); abort = true; } 
-                else {  m->mothurOut("Found uchime in your path, using " + uLocation + "\n");uchimeLocation = uLocation; }
-            }else {  uchimeLocation = uchimeCommand; }
-            
-            uchimeLocation = m->getFullPathName(uchimeLocation);
         }
 	}
 	catch(exception& e) {
@@ -649,7 +601,6 @@ int ChimeraUchimeCommand::execute(){
 			string outputFileName = getOutputFileName("chimera", variables);
 			string accnosFileName = getOutputFileName("accnos", variables);
 			string alnsFileName = getOutputFileName("alns", variables);
-			string newFasta = m->getRootName(fastaFileNames[s]) + "temp";
             string newCountFile = "";
 				
 			//you provided a groupfile
@@ -663,6 +614,10 @@ int ChimeraUchimeCommand::execute(){
                 newCountFile = getOutputFileName("count", variables);
             }
 			
+			//the uchime options are shared by all the searches
+			UchimeSetOptions(getUchimeOptions());
+			
+			vector<seqPriorityNode> nameMapCount;
 			if ((templatefile == "self") && (!hasGroup)) { //you want to run uchime with a template=self and no groups
 
 				if (processors != 1) { m->mothurOut("When using template=self, mothur can only use 1 processor, continuing."); m->mothurOutEndLine(); processors = 1; }
@@ -674,8 +629,7 @@ int ChimeraUchimeCommand::execute(){
 				readFasta(fastaFileNames[s], seqs);  if (m->control_pressed) { for (int j = 0; j < outputNames.size(); j++) {	m->mothurRemove(outputNames[j]);	}  return 0; }
 
 				//read namefile
-				vector<seqPriorityNode> nameMapCount;
-                int error;
+                int error = 0;
                 if (hasCount) {
                     CountTable ct;
                     ct.readTable(nameFile, true, false);
@@ -693,8 +647,7 @@ int ChimeraUchimeCommand::execute(){
 				if (error == 1) { for (int j = 0; j < outputNames.size(); j++) {	m->mothurRemove(outputNames[j]);	}  return 0; }
 				if (seqs.size() != nameMapCount.size()) { m->mothurOut( "The number of sequences in your fastafile does not match the number of sequences in your namefile, aborting."); m->mothurOutEndLine(); for (int j = 0; j < outputNames.size(); j++) {	m->mothurRemove(outputNames[j]);	}  return 0; }
 				
-				printFile(nameMapCount, newFasta);
-				fastaFileNames[s] = newFasta;
+				sort(nameMapCount.begin(), nameMapCount.end(), compareSeqPriorityNodes);
 			}
 			
 			if (m->control_pressed) {  for (int j = 0; j < outputNames.size(); j++) {	m->mothurRemove(outputNames[j]);	}  return 0;	}				
@@ -719,33 +672,7 @@ int ChimeraUchimeCommand::execute(){
 					
 				if (m->control_pressed) { for (int j = 0; j < outputNames.size(); j++) {	m->mothurRemove(outputNames[j]);	}  return 0; }
 								
-				//clears files
-				ofstream out, out1, out2;
-				m->openOutputFile(outputFileName, out); out.close(); 
-				m->openOutputFile(accnosFileName, out1); out1.close();
-				if (chimealns) { m->openOutputFile(alnsFileName, out2); out2.close(); }
-				int totalSeqs = 0;
-				
-				if(processors == 1)	{	totalSeqs = driverGroups(outputFileName, newFasta, accnosFileName, alnsFileName, newCountFile, 0, groups.size(), groups);
-                    
-                    if (hasCount && dups) {
-                        CountTable c; c.readTable(nameFile, true, false);
-                        if (!m->isBlank(newCountFile)) {
-                            ifstream in2;
-                            m->openInputFile(newCountFile, in2);
-                            
-                            string name, group;
-                            while (!in2.eof()) {
-                                in2 >> name >> group; m->gobble(in2);
-                                c.setAbund(name, group, 0);
-                            }
-                            in2.close();
-                        }
-                        m->mothurRemove(newCountFile);
-                        c.printTable(newCountFile);
-                    }
-
-                }else{	totalSeqs = createProcessesGroups(outputFileName, newFasta, accnosFileName, alnsFileName, newCountFile, groups, nameFile, groupFile, fastaFileNames[s]);			}
+				int totalSeqs = createProcessesGroups(outputFileName, accnosFileName, alnsFileName, newCountFile, groups, nameFile);
 
 				if (m->control_pressed) {  for (int j = 0; j < outputNames.size(); j++) {	m->mothurRemove(outputNames[j]);	}  return 0;	}				
                
@@ -790,23 +717,19 @@ int ChimeraUchimeCommand::execute(){
 				int numSeqs = 0;
 				int numChimeras = 0;
 
-				if(processors == 1){ numSeqs = driver(outputFileName, fastaFileNames[s], accnosFileName, alnsFileName, numChimeras); }
-				else{	numSeqs = createProcesses(outputFileName, fastaFileNames[s], accnosFileName, alnsFileName, numChimeras); }
-				
-				//add headings
-				ofstream out;
-				m->openOutputFile(outputFileName+".temp", out); 
-				out << "Score\tQuery\tParentA\tParentB\tIdQM\tIdQA\tIdQB\tIdAB\tIdQT\tLY\tLN\tLA\tRY\tRN\tRA\tDiv\tYN\n";
-				out.close();
-				
-				m->appendFiles(outputFileName, outputFileName+".temp");
-				m->mothurRemove(outputFileName); rename((outputFileName+".temp").c_str(), outputFileName.c_str());
+				if (templatefile == "self") {
+					vector<string> output, chimeras;
+					numSeqs = driver(nameMapCount, output, chimeras);
+					numChimeras = chimeras.size();
+					
+					ofstream out, out1, out2;
+					m->openOutputFile(outputFileName, out); out << getHeaders() << output[0]; out.close();
+					m->openOutputFile(accnosFileName, out1); out1 << output[1]; out1.close();
+					if (chimealns) { m->openOutputFile(alnsFileName, out2); out2 << output[2]; out2.close(); }
+				}else{	numSeqs = createProcesses(outputFileName, fastaFileNames[s], accnosFileName, alnsFileName, numChimeras); }
 				
 				if (m->control_pressed) { for (int j = 0; j < outputNames.size(); j++) {	m->mothurRemove(outputNames[j]);	} return 0; }
 			
-				//remove file made for uchime
-				if (templatefile == "self") {  m->mothurRemove(fastaFileNames[s]); }
-			
 				m->mothurOutEndLine(); m->mothurOut("It took " + toString(time(NULL) - start) + " secs to check " + toString(numSeqs) + " sequences. " + toString(numChimeras) + " chimeras were found.");	m->mothurOutEndLine();
 			}
 			
@@ -1104,28 +1027,6 @@ int ChimeraUchimeCommand::deconvoluteResults(map<string, string>& uniqueNames, s
 	}
 }	
 //**********************************************************************************************************************
-int ChimeraUchimeCommand::printFile(vector<seqPriorityNode>& nameMapCount, string filename){
-	try {
-		
-		sort(nameMapCount.begin(), nameMapCount.end(), compareSeqPriorityNodes);
-		
-		ofstream out;
-		m->openOutputFile(filename, out);
-		
-		//print new file in order of
-		for (int i = 0; i < nameMapCount.size(); i++) {
-			out << ">" << nameMapCount[i].name  << "/ab=" << nameMapCount[i].numIdentical << "/" << endl << nameMapCount[i].seq << endl;
-		}
-		out.close();
-		
-		return 0;
-	}
-	catch(exception& e) {
-		m->errorOut(e, "ChimeraUchimeCommand", "printFile");
-		exit(1);
-	}
-}	
-//**********************************************************************************************************************
 int ChimeraUchimeCommand::readFasta(string filename, map<string, string>& seqs){
 	try {
 		//create input file for uchime
@@ -1183,384 +1084,69 @@ string ChimeraUchimeCommand::getNamesFile(string& inputFile){
 	}
 }
 //**********************************************************************************************************************
-int ChimeraUchimeCommand::driverGroups(string outputFName, string filename, string accnos, string alns, string countlist, int start, int end, vector<string> groups){
+//the options chimera.uchime passes on to uchime
+vector<string> ChimeraUchimeCommand::getUchimeOptions(){
 	try {
-		
-		int totalSeqs = 0;
-		int numChimeras = 0;
-        
-        
-        ofstream outCountList;
-        if (hasCount && dups) { m->openOutputFile(countlist, outCountList); }
-        
-		for (int i = start; i < end; i++) {
-			int start = time(NULL);	 if (m->control_pressed) {  outCountList.close(); m->mothurRemove(countlist); return 0; }
-            
-			int error;
-            if (hasCount) { error = cparser->getSeqs(groups[i], filename, true); if ((error == 1) || m->control_pressed) {  return 0; } }
-            else { error = sparser->getSeqs(groups[i], filename, true); if ((error == 1) || m->control_pressed) {  return 0; } }
-			
-			int numSeqs = driver((outputFName + groups[i]), filename, (accnos+groups[i]), (alns+ groups[i]), numChimeras);
-			totalSeqs += numSeqs;
-			
-			if (m->control_pressed) { return 0; }
-			
-			//remove file made for uchime
-			if (!m->debug) {  m->mothurRemove(filename);  }
-            else { m->mothurOut("[DEBUG]: saving file: " + filename + ".\n"); }
-			
-            //if we provided a count file with group info and set dereplicate=t, then we want to create a *.pick.count_table
-            //This table will zero out group counts for seqs determined to be chimeric by that group.
-            if (dups) {
-                if (!m->isBlank(accnos+groups[i])) {
-                    ifstream in;
-                    m->openInputFile(accnos+groups[i], in);
-                    string name;
-                    if (hasCount) {
-                        while (!in.eof()) {
-                            in >> name; m->gobble(in);
-                            outCountList << name << '\t' << groups[i] << endl;
-                        }
-                        in.close();
-                    }else {
-                        map<string, string> thisnamemap = sparser->getNameMap(groups[i]);
-                        map<string, string>::iterator itN;
-                        ofstream out;
-                        m->openOutputFile(accnos+groups[i]+".temp", out);
-                        while (!in.eof()) {
-                            in >> name; m->gobble(in); 
-                            itN = thisnamemap.find(name);
-                            if (itN != thisnamemap.end()) {
-                                vector<string> tempNames; m->splitAtComma(itN->second, tempNames); 
-                                for (int j = 0; j < tempNames.size(); j++) { out << tempNames[j] << endl; }
-                                
-                            }else { m->mothurOut("[ERROR]: parsing cannot find " + name + ".\n"); m->control_pressed = true; }
-                        }
-                        out.close();
-                        in.close();
-                        m->renameFile(accnos+groups[i]+".temp", accnos+groups[i]);
-                    }
-                   
-                }
-            }
-            
-			//append files
-			m->appendFiles((outputFName+groups[i]), outputFName); m->mothurRemove((outputFName+groups[i]));
-			m->appendFiles((accnos+groups[i]), accnos); m->mothurRemove((accnos+groups[i]));
-			if (chimealns) { m->appendFiles((alns+groups[i]), alns); m->mothurRemove((alns+groups[i])); }
-			
-			m->mothurOutEndLine(); m->mothurOut("It took " + toString(time(NULL) - start) + " secs to check " + toString(numSeqs) + " sequences from group " + groups[i] + ".");	m->mothurOutEndLine();					
+		vector<string> options;
+		
+		if (strand != "")		{ options.push_back("--strand");			options.push_back(strand);			}
+		if (useAbskew)			{ options.push_back("--abskew");			options.push_back(abskew);			}
+		if (useMinH)			{ options.push_back("--minh");				options.push_back(minh);			}
+		if (useMindiv)			{ options.push_back("--mindiv");			options.push_back(mindiv);			}
+		if (useXn)				{ options.push_back("--xn");				options.push_back(xn);				}
+		if (useDn)				{ options.push_back("--dn");				options.push_back(dn);				}
+		if (useXa)				{ options.push_back("--xa");				options.push_back(xa);				}
+		if (useChunks)			{ options.push_back("--chunks");			options.push_back(chunks);			}
+		if (useMinchunk)		{ options.push_back("--minchunk");			options.push_back(minchunk);		}
+		if (useIdsmoothwindow)	{ options.push_back("--idsmoothwindow");	options.push_back(idsmoothwindow);	}
+		if (useMaxp)			{ options.push_back("--maxp");				options.push_back(maxp);			}
+		if (!skipgaps)			{ options.push_back("--noskipgaps");											}
+		if (!skipgaps2)			{ options.push_back("--noskipgaps2");											}
+		if (useMinlen)			{ options.push_back("--minlen");			options.push_back(minlen);			}
+		if (useMaxlen)			{ options.push_back("--maxlen");			options.push_back(maxlen);			}
+		if (ucl)				{ options.push_back("--ucl");													}
+		if (useQueryfract)		{ options.push_back("--queryfract");		options.push_back(queryfract);		}
+		
+		if (m->debug) { 
+			string commandString = "";
+			for (int i = 0; i < options.size(); i++) { commandString += options[i] + " "; }
+			m->mothurOut("[DEBUG]: uchime options = " + commandString + ".\n"); 
 		}
-
-        if (hasCount && dups) { outCountList.close(); }
-        
-        return totalSeqs;
 		
+		return options;
 	}
 	catch(exception& e) {
-		m->errorOut(e, "ChimeraUchimeCommand", "driverGroups");
+		m->errorOut(e, "ChimeraUchimeCommand", "getUchimeOptions");
 		exit(1);
 	}
-}	
+}
 //**********************************************************************************************************************
-
-int ChimeraUchimeCommand::driver(string outputFName, string filename, string accnos, string alns, int& numChimeras){
+//checks the seqs against the reference, or de novo when there is none. output is the uchime report, the accnos and the
+//alignments, chimeras the names of the seqs found to be chimeric. returns the number of seqs checked
+int ChimeraUchimeCommand::driver(SeqDB* db, vector<string>& labels, vector<string>& seqs, vector<string>& output, vector<string>& chimeras){
 	try {
-		
-		outputFName = m->getFullPathName(outputFName);
-		filename = m->getFullPathName(filename);
-		alns = m->getFullPathName(alns);
-		
-		//to allow for spaces in the path
-		outputFName = "\"" + outputFName + "\"";
-		filename = "\"" + filename + "\"";
-		alns = "\"" + alns + "\"";
-				
-		vector<char*> cPara;
-		
-		string uchimeCommand = uchimeLocation;
-        uchimeCommand = "\"" + uchimeCommand + "\" ";
-        
-        char* tempUchime;
-		tempUchime= new char[uchimeCommand.length()+1]; 
-		*tempUchime = '\0';
-		strncat(tempUchime, uchimeCommand.c_str(), uchimeCommand.length());
-		cPara.push_back(tempUchime);
-		
-        //are you using a reference file
-		if (templatefile != "self") {
-            string outputFileName = filename.substr(1, filename.length()-2) + ".uchime_formatted";
-            prepFile(filename.substr(1, filename.length()-2), outputFileName);
-            filename = outputFileName;
-            filename = "\"" + filename + "\"";
-			//add reference file
-			char* tempRef = new char[5]; 
-			//strcpy(tempRef, "--db"); 
-			*tempRef = '\0'; strncat(tempRef, "--db", 4);
-			cPara.push_back(tempRef);  
-			char* tempR = new char[templatefile.length()+1];
-			//strcpy(tempR, templatefile.c_str());
-			*tempR = '\0'; strncat(tempR, templatefile.c_str(), templatefile.length());
-			cPara.push_back(tempR);
-		}
-		
-		char* tempIn = new char[8]; 
-		*tempIn = '\0'; strncat(tempIn, "--input", 7);
-		//strcpy(tempIn, "--input"); 
-		cPara.push_back(tempIn);
-		char* temp = new char[filename.length()+1];
-		*temp = '\0'; strncat(temp, filename.c_str(), filename.length());
-		//strcpy(temp, filename.c_str());
-		cPara.push_back(temp);
-		
-		char* tempO = new char[12]; 
-		*tempO = '\0'; strncat(tempO, "--uchimeout", 11);
-		//strcpy(tempO, "--uchimeout"); 
-		cPara.push_back(tempO);
-		char* tempout = new char[outputFName.length()+1];
-		//strcpy(tempout, outputFName.c_str());
-		*tempout = '\0'; strncat(tempout, outputFName.c_str(), outputFName.length());
-		cPara.push_back(tempout);
-		
-		if (chimealns) {
-			char* tempA = new char[13]; 
-			*tempA = '\0'; strncat(tempA, "--uchimealns", 12);
-			//strcpy(tempA, "--uchimealns"); 
-			cPara.push_back(tempA);
-			char* tempa = new char[alns.length()+1];
-			//strcpy(tempa, alns.c_str());
-			*tempa = '\0'; strncat(tempa, alns.c_str(), alns.length());
-			cPara.push_back(tempa);
-		}
-        
-        if (strand != "") {
-			char* tempA = new char[9]; 
-			*tempA = '\0'; strncat(tempA, "--strand", 8);
-			cPara.push_back(tempA);
-			char* tempa = new char[strand.length()+1];
-			*tempa = '\0'; strncat(tempa, strand.c_str(), strand.length());
-			cPara.push_back(tempa);
-		}
-		
-		if (useAbskew) {
-			char* tempskew = new char[9];
-			*tempskew = '\0'; strncat(tempskew, "--abskew", 8);
-			//strcpy(tempskew, "--abskew"); 
-			cPara.push_back(tempskew);
-			char* tempSkew = new char[abskew.length()+1];
-			//strcpy(tempSkew, abskew.c_str());
-			*tempSkew = '\0'; strncat(tempSkew, abskew.c_str(), abskew.length());
-			cPara.push_back(tempSkew);
-		}
-		
-		if (useMinH) {
-			char* tempminh = new char[7]; 
-			*tempminh = '\0'; strncat(tempminh, "--minh", 6);
-			//strcpy(tempminh, "--minh"); 
-			cPara.push_back(tempminh);
-			char* tempMinH = new char[minh.length()+1];
-			*tempMinH = '\0'; strncat(tempMinH, minh.c_str(), minh.length());
-			//strcpy(tempMinH, minh.c_str());
-			cPara.push_back(tempMinH);
-		}
-		
-		if (useMindiv) {
-			char* tempmindiv = new char[9]; 
-			*tempmindiv = '\0'; strncat(tempmindiv, "--mindiv", 8);
-			//strcpy(tempmindiv, "--mindiv"); 
-			cPara.push_back(tempmindiv);
-			char* tempMindiv = new char[mindiv.length()+1];
-			*tempMindiv = '\0'; strncat(tempMindiv, mindiv.c_str(), mindiv.length());
-			//strcpy(tempMindiv, mindiv.c_str());
-			cPara.push_back(tempMindiv);
-		}
-		
-		if (useXn) {
-			char* tempxn = new char[5]; 
-			//strcpy(tempxn, "--xn"); 
-			*tempxn = '\0'; strncat(tempxn, "--xn", 4);
-			cPara.push_back(tempxn);
-			char* tempXn = new char[xn.length()+1];
-			//strcpy(tempXn, xn.c_str());
-			*tempXn = '\0'; strncat(tempXn, xn.c_str(), xn.length());
-			cPara.push_back(tempXn);
-		}
-		
-		if (useDn) {
-			char* tempdn = new char[5]; 
-			//strcpy(tempdn, "--dn"); 
-			*tempdn = '\0'; strncat(tempdn, "--dn", 4);
-			cPara.push_back(tempdn);
-			char* tempDn = new char[dn.length()+1];
-			*tempDn = '\0'; strncat(tempDn, dn.c_str(), dn.length());
-			//strcpy(tempDn, dn.c_str());
-			cPara.push_back(tempDn);
-		}
-		
-		if (useXa) {
-			char* tempxa = new char[5]; 
-			//strcpy(tempxa, "--xa"); 
-			*tempxa = '\0'; strncat(tempxa, "--xa", 4);
-			cPara.push_back(tempxa);
-			char* tempXa = new char[xa.length()+1];
-			*tempXa = '\0'; strncat(tempXa, xa.c_str(), xa.length());
-			//strcpy(tempXa, xa.c_str());
-			cPara.push_back(tempXa);
-		}
-		
-		if (useChunks) {
-			char* tempchunks = new char[9]; 
-			//strcpy(tempchunks, "--chunks"); 
-			*tempchunks = '\0'; strncat(tempchunks, "--chunks", 8);
-			cPara.push_back(tempchunks);
-			char* tempChunks = new char[chunks.length()+1];
-			*tempChunks = '\0'; strncat(tempChunks, chunks.c_str(), chunks.length());
-			//strcpy(tempChunks, chunks.c_str());
-			cPara.push_back(tempChunks);
-		}
-		
-		if (useMinchunk) {
-			char* tempminchunk = new char[11]; 
-			//strcpy(tempminchunk, "--minchunk"); 
-			*tempminchunk = '\0'; strncat(tempminchunk, "--minchunk", 10);
-			cPara.push_back(tempminchunk);
-			char* tempMinchunk = new char[minchunk.length()+1];
-			*tempMinchunk = '\0'; strncat(tempMinchunk, minchunk.c_str(), minchunk.length());
-			//strcpy(tempMinchunk, minchunk.c_str());
-			cPara.push_back(tempMinchunk);
-		}
-		
-		if (useIdsmoothwindow) {
-			char* tempidsmoothwindow = new char[17]; 
-			*tempidsmoothwindow = '\0'; strncat(tempidsmoothwindow, "--idsmoothwindow", 16);
-			//strcpy(tempidsmoothwindow, "--idsmoothwindow"); 
-			cPara.push_back(tempidsmoothwindow);
-			char* tempIdsmoothwindow = new char[idsmoothwindow.length()+1];
-			*tempIdsmoothwindow = '\0'; strncat(tempIdsmoothwindow, idsmoothwindow.c_str(), idsmoothwindow.length());
-			//strcpy(tempIdsmoothwindow, idsmoothwindow.c_str());
-			cPara.push_back(tempIdsmoothwindow);
-		}
-		
-		/*if (useMinsmoothid) {
-			char* tempminsmoothid = new char[14]; 
-			//strcpy(tempminsmoothid, "--minsmoothid"); 
-			*tempminsmoothid = '\0'; strncat(tempminsmoothid, "--minsmoothid", 13);
-			cPara.push_back(tempminsmoothid);
-			char* tempMinsmoothid = new char[minsmoothid.length()+1];
-			*tempMinsmoothid = '\0'; strncat(tempMinsmoothid, minsmoothid.c_str(), minsmoothid.length());
-			//strcpy(tempMinsmoothid, minsmoothid.c_str());
-			cPara.push_back(tempMinsmoothid);
-		}*/
-		
-		if (useMaxp) {
-			char* tempmaxp = new char[7]; 
-			//strcpy(tempmaxp, "--maxp"); 
-			*tempmaxp = '\0'; strncat(tempmaxp, "--maxp", 6);
-			cPara.push_back(tempmaxp);
-			char* tempMaxp = new char[maxp.length()+1];
-			*tempMaxp = '\0'; strncat(tempMaxp, maxp.c_str(), maxp.length());
-			//strcpy(tempMaxp, maxp.c_str());
-			cPara.push_back(tempMaxp);
-		}
-		
-		if (!skipgaps) {
-			char* tempskipgaps = new char[13]; 
-			//strcpy(tempskipgaps, "--[no]skipgaps");
-			*tempskipgaps = '\0'; strncat(tempskipgaps, "--noskipgaps", 12);
-			cPara.push_back(tempskipgaps);
-		}
-		
-		if (!skipgaps2) {
-			char* tempskipgaps2 = new char[14]; 
-			//strcpy(tempskipgaps2, "--[no]skipgaps2"); 
-			*tempskipgaps2 = '\0'; strncat(tempskipgaps2, "--noskipgaps2", 13);
-			cPara.push_back(tempskipgaps2);
-		}
-		
-		if (useMinlen) {
-			char* tempminlen = new char[9]; 
-			*tempminlen = '\0'; strncat(tempminlen, "--minlen", 8);
-			//strcpy(tempminlen, "--minlen"); 
-			cPara.push_back(tempminlen);
-			char* tempMinlen = new char[minlen.length()+1];
-			//strcpy(tempMinlen, minlen.c_str());
-			*tempMinlen = '\0'; strncat(tempMinlen, minlen.c_str(), minlen.length());
-			cPara.push_back(tempMinlen);
-		}
-		
-		if (useMaxlen) {
-			char* tempmaxlen = new char[9]; 
-			//strcpy(tempmaxlen, "--maxlen"); 
-			*tempmaxlen = '\0'; strncat(tempmaxlen, "--maxlen", 8);
-			cPara.push_back(tempmaxlen);
-			char* tempMaxlen = new char[maxlen.length()+1];
-			*tempMaxlen = '\0'; strncat(tempMaxlen, maxlen.c_str(), maxlen.length());
-			//strcpy(tempMaxlen, maxlen.c_str());
-			cPara.push_back(tempMaxlen);
-		}
-		
-		if (ucl) {
-			char* tempucl = new char[5]; 
-			strcpy(tempucl, "--ucl"); 
-			cPara.push_back(tempucl);
-		}
-		
-		if (useQueryfract) {
-			char* tempqueryfract = new char[13]; 
-			*tempqueryfract = '\0'; strncat(tempqueryfract, "--queryfract", 12);
-			//strcpy(tempqueryfract, "--queryfract"); 
-			cPara.push_back(tempqueryfract);
-			char* tempQueryfract = new char[queryfract.length()+1];
-			*tempQueryfract = '\0'; strncat(tempQueryfract, queryfract.c_str(), queryfract.length());
-			//strcpy(tempQueryfract, queryfract.c_str());
-			cPara.push_back(tempQueryfract);
-		}
-		
-		
-		char** uchimeParameters;
-		uchimeParameters = new char*[cPara.size()];
-		string commandString = "";
-		for (int i = 0; i < cPara.size(); i++) {  uchimeParameters[i] = cPara[i];  commandString += toString(cPara[i]) + " "; } 
-		//int numArgs = cPara.size();
-		
-		//uchime_main(numArgs, uchimeParameters); 
-		//cout << "commandString = " << commandString << endl;
-#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
-#else
-		commandString = "\"" + commandString + "\"";
-#endif
-        if (m->debug) { m->mothurOut("[DEBUG]: uchime command = " + commandString + ".\n"); }
-		system(commandString.c_str());
-		
-		//free memory
-		for(int i = 0; i < cPara.size(); i++)  {  delete cPara[i];  }
-		delete[] uchimeParameters; 
-		
-		//remove "" from filenames
-		outputFName = outputFName.substr(1, outputFName.length()-2);
-		filename = filename.substr(1, filename.length()-2);
-		alns = alns.substr(1, alns.length()-2);
+		output.assign(3, "");
+		chimeras.clear();
 		
 		if (m->control_pressed) { return 0; }
 		
-		//create accnos file from uchime results
-		ifstream in; 
-		m->openInputFile(outputFName, in);
-		
-		ofstream out;
-		m->openOutputFile(accnos, out);
+		string* alns = NULL;
+		if (chimealns) { alns = &output[2]; }
+		string error = "";
+		UchimeSearch(db, labels, seqs, output[0], alns, error);
+		if (error != "") { m->mothurOut("[ERROR]: " + error + "\n"); m->control_pressed = true; return 0; }
 		
+		//create accnos from uchime results
+		istringstream in(output[0]);
+		string line;
 		int num = 0;
-		numChimeras = 0;
-		while(!in.eof()) {
+		while (getline(in, line)) {
 			
 			if (m->control_pressed) { break; }
 			
 			string name = "";
 			string chimeraFlag = "";
-			//in >> chimeraFlag >> name;
 			
-            string line = m->getline(in);
             vector<string> pieces = m->splitWhiteSpace(line);
             if (pieces.size() > 2) { 
                 name = pieces[1];
@@ -1572,17 +1158,11 @@ int ChimeraUchimeCommand::driver(string outputFName, string filename, string acc
                 
                 chimeraFlag = pieces[pieces.size()-1];
 			}
-			//for (int i = 0; i < 15; i++) {  in >> chimeraFlag; }
-			m->gobble(in);
 			
-			if (chimeraFlag == "Y") {  out << name << endl; numChimeras++; }
+			if (chimeraFlag == "Y") {  output[1] += name + "\n"; chimeras.push_back(name); }
 			num++;
 		}
-		in.close();
-		out.close();
 		
-        //if (templatefile != "self") {  m->mothurRemove(filename); }
-        
 		return num;
 	}
 	catch(exception& e) {
@@ -1590,199 +1170,91 @@ int ChimeraUchimeCommand::driver(string outputFName, string filename, string acc
 		exit(1);
 	}
 }
-/**************************************************************************************************/
-//uchime can't handle some of the things allowed in mothurs fasta files. This functions "cleans up" the file.
-int ChimeraUchimeCommand::prepFile(string filename, string output) {
+//**********************************************************************************************************************
+//de novo check of seqs sorted by abundance, labeled with their abundance as uchime expects
+int ChimeraUchimeCommand::driver(vector<seqPriorityNode>& nameMapCount, vector<string>& output, vector<string>& chimeras){
 	try {
-        
-        ifstream in;
-        m->openInputFile(filename, in);
-        
-        ofstream out;
-        m->openOutputFile(output, out);
-        
-        while (!in.eof()) {
-            if (m->control_pressed) { break;  }
-            
-            Sequence seq(in); m->gobble(in);
-            
-            if (seq.getName() != "") { seq.printSequence(out); }
-        }
-        in.close();
-        out.close();
-        
-        return 0;
-    }
+		vector<string> labels, seqs;
+		for (int i = 0; i < nameMapCount.size(); i++) {
+			labels.push_back(nameMapCount[i].name + "/ab=" + toString(nameMapCount[i].numIdentical) + "/");
+			seqs.push_back(nameMapCount[i].seq);
+		}
+		
+		return driver(NULL, labels, seqs, output, chimeras);
+	}
 	catch(exception& e) {
-		m->errorOut(e, "ChimeraUchimeCommand", "prepFile");
+		m->errorOut(e, "ChimeraUchimeCommand", "driver");
 		exit(1);
 	}
 }
 /**************************************************************************************************/
-
+//the processors share the reference. The fasta file is read in blocks of 100 sequences, and
+//the results are written in the order they were read, so the output does not depend on processors.
 int ChimeraUchimeCommand::createProcesses(string outputFileName, string filename, string accnos, string alns, int& numChimeras) {
 	try {
+		string error = "";
+		SeqDB* db = UchimeLoadDB(templatefile, error);
+		if (db == NULL) { m->mothurOut("[ERROR]: " + error + " in " + templatefile + "\n"); m->control_pressed = true; return 0; }
 		
-		processIDS.clear();
-		int process = 1;
-		int num = 0;
-		vector<string> files;
-		
-#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)		
-		//break up file into multiple files
-		m->divideFile(filename, processors, files);
-		
-		if (m->control_pressed) {  return 0;  }
-				
-		//loop through and create all the processes you want
-		while (process != processors) {
-			pid_t pid = fork();
-			
-			if (pid > 0) {
-				processIDS.push_back(pid);  //create map from line number to pid so you can append files in correct order later
-				process++;
-			}else if (pid == 0){
-				num = driver(outputFileName + toString(m->mothurGetpid(process)) + ".temp", files[process], accnos + toString(m->mothurGetpid(process)) + ".temp", alns + toString(m->mothurGetpid(process)) + ".temp", numChimeras);
-				
-				//pass numSeqs to parent
-				ofstream out;
-				string tempFile = outputFileName + toString(m->mothurGetpid(process)) + ".num.temp";
-				m->openOutputFile(tempFile, out);
-				out << num << endl;
-				out << numChimeras << endl;
-				out.close();
-				
-				exit(0);
-            }else {
-                m->mothurOut("[ERROR]: unable to spawn the necessary processes."); m->mothurOutEndLine();
-                for (int i = 0; i < processIDS.size(); i++) { kill (processIDS[i], SIGINT); }
-                exit(0);
-            }
-		}
-		
-		//do my part
-		num = driver(outputFileName, files[0], accnos, alns, numChimeras);
+		ofstream out;
+		m->openOutputFile(outputFileName, out);
+		out << getHeaders();
 		
-		//force parent to wait until all the processes are done
-		for (int i=0;i<processIDS.size();i++) { 
-			int temp = processIDS[i];
-			wait(&temp);
-		}
+		ofstream outAccnos;
+		m->openOutputFile(accnos, outAccnos);
 		
-		for (int i = 0; i < processIDS.size(); i++) {
-			ifstream in;
-			string tempFile =  outputFileName + toString(processIDS[i]) + ".num.temp";
-			m->openInputFile(tempFile, in);
-			if (!in.eof()) { 
-				int tempNum = 0; 
-				in >> tempNum; m->gobble(in);
-				num += tempNum; 
-				in >> tempNum;
-				numChimeras += tempNum;
-			}
-			in.close(); m->mothurRemove(tempFile);
-		}
-#else
-		//////////////////////////////////////////////////////////////////////////////////////////////////////
-		//Windows version shared memory, so be careful when passing variables through the preClusterData struct. 
-		//Above fork() will clone, so memory is separate, but that's not the case with windows, 
-		//////////////////////////////////////////////////////////////////////////////////////////////////////
+		vector<ostream*> files;
+		files.push_back(&out); files.push_back(&outAccnos);
 		
-		//divide file
-		int count = 0;
-		int spot = 0;
-		map<int, ofstream*> filehandles;
-		map<int, ofstream*>::iterator it3;
+		ofstream outAlns;
+		if (chimealns) { m->openOutputFile(alns, outAlns); files.push_back(&outAlns); }
+		OutputSink sink(files, true);
 		
-		ofstream* temp;
-		for (int i = 0; i < processors; i++) {
-			temp = new ofstream;
-			filehandles[i] = temp;
-			m->openOutputFile(filename+toString(i)+".temp", *(temp));
-			files.push_back(filename+toString(i)+".temp");
-		}
+		ThreadPool pool(processors);
+		mutex countLock;
+		numChimeras = 0;
 		
 		ifstream in;
 		m->openInputFile(filename, in);
 		
-		while(!in.eof()) {
-			
-			if (m->control_pressed) { in.close(); for (it3 = filehandles.begin(); it3 != filehandles.end(); it3++) { (*(it3->second)).close(); delete it3->second; } return 0; }
-			
-			Sequence tempSeq(in); m->gobble(in); 
+		int numBlocks = 0;
+		while (!in.eof()) {
+			if (m->control_pressed) { break; }
 			
-			if (tempSeq.getName() != "") {
-				tempSeq.printSequence(*(filehandles[spot])); 
-				spot++; count++;
-				if (spot == processors) { spot = 0; }
+			//labels as uchime reads them from a fasta file
+			vector<string> labels, seqs;
+			while (!in.eof() && (labels.size() < 100)) {
+				Sequence seq(in); m->gobble(in);
+				if (seq.getName() != "") { 
+					labels.push_back(seq.getName() + seq.getComment());
+					if (seq.getIsAligned()) { seqs.push_back(seq.getAligned()); }
+					else { seqs.push_back(seq.getUnaligned()); }
+				}
 			}
-		}
-		in.close();
-		
-		//delete memory
-		for (it3 = filehandles.begin(); it3 != filehandles.end(); it3++) {
-			(*(it3->second)).close();
-			delete it3->second;
-		}
-		
-		//sanity check for number of processors
-		if (count < processors) { processors = count; }
-		
-		vector<uchimeData*> pDataArray; 
-		DWORD   dwThreadIdArray[processors-1];
-		HANDLE  hThreadArray[processors-1]; 
-		vector<string> dummy; //used so that we can use the same struct for MyUchimeSeqsThreadFunction and MyUchimeThreadFunction
-		
-		//Create processor worker threads.
-		for( int i=1; i<processors; i++ ){
-			// Allocate memory for thread data.
-			string extension = toString(i) + ".temp";
-			
-			uchimeData* tempUchime = new uchimeData(outputFileName+extension, uchimeLocation, templatefile, files[i], "", "", "", accnos+extension, alns+extension, "", dummy, m, 0, 0,  i);
-			tempUchime->setBooleans(dups, useAbskew, chimealns, useMinH, useMindiv, useXn, useDn, useXa, useChunks, useMinchunk, useIdsmoothwindow, useMinsmoothid, useMaxp, skipgaps, skipgaps2, useMinlen, useMaxlen, ucl, useQueryfract, hasCount);
-			tempUchime->setVariables(abskew, minh, mindiv, xn, dn, xa, chunks, minchunk, idsmoothwindow, minsmoothid, maxp, minlen, maxlen, queryfract, strand);
 			
-			pDataArray.push_back(tempUchime);
-			processIDS.push_back(i);
+			int blockNum = numBlocks; numBlocks++;
+			pool.submit([this, db, labels, seqs, blockNum, &sink, &countLock, &numChimeras](int processor) mutable {
+				vector<string> output, chimeras;
+				int count = driver(db, labels, seqs, output, chimeras);
+				sink.write(blockNum, output, count);
+				
+				lock_guard<mutex> guard(countLock);
+				numChimeras += chimeras.size();
+			});
 			
-			//MySeqSumThreadFunction is in header. It must be global or static to work with the threads.
-			//default security attributes, thread function name, argument to thread function, use default creation flags, returns the thread identifier
-			hThreadArray[i-1] = CreateThread(NULL, 0, MyUchimeSeqsThreadFunction, pDataArray[i-1], 0, &dwThreadIdArray[i-1]);   
+			//keeps the number of blocks in memory bounded, the ones running and the ones waiting to be written
+			pool.waitForSlot(pool.getNumProcessors() * 4, &sink);
 		}
+		pool.wait();
+		in.close();
 		
+		UchimeFreeDB(db);
 		
-		//using the main process as a worker saves time and memory
-		num = driver(outputFileName, files[0], accnos, alns, numChimeras);
-		
-		//Wait until all threads have terminated.
-		WaitForMultipleObjects(processors-1, hThreadArray, TRUE, INFINITE);
-		
-		//Close all thread handles and free memory allocations.
-		for(int i=0; i < pDataArray.size(); i++){
-			num += pDataArray[i]->count;
-			numChimeras += pDataArray[i]->numChimeras;
-			CloseHandle(hThreadArray[i]);
-			delete pDataArray[i];
-		}
-#endif		
-		
-		//append output files
-		for(int i=0;i<processIDS.size();i++){
-			m->appendFiles((outputFileName + toString(processIDS[i]) + ".temp"), outputFileName);
-			m->mothurRemove((outputFileName + toString(processIDS[i]) + ".temp"));
-			
-			m->appendFiles((accnos + toString(processIDS[i]) + ".temp"), accnos);
-			m->mothurRemove((accnos + toString(processIDS[i]) + ".temp"));
-			
-			if (chimealns) {
-				m->appendFiles((alns + toString(processIDS[i]) + ".temp"), alns);
-				m->mothurRemove((alns + toString(processIDS[i]) + ".temp"));
-			}
-		}
+		out.close();
+		outAccnos.close();
+		if (chimealns) { outAlns.close(); }
 		
-		//get rid of the file pieces.
-		for (int i = 0; i < files.size(); i++) { m->mothurRemove(files[i]); }
-		return num;	
+		return sink.getNumWritten();
 	}
 	catch(exception& e) {
 		m->errorOut(e, "ChimeraUchimeCommand", "createProcesses");
@@ -1790,173 +1262,82 @@ int ChimeraUchimeCommand::createProcesses(string outputFileName, string filename
 	}
 }
 /**************************************************************************************************/
-
-int ChimeraUchimeCommand::createProcessesGroups(string outputFName, string filename, string accnos, string alns, string newCountFile, vector<string> groups, string nameFile, string groupFile, string fastaFile) {
+//each group is checked de novo on its own. The groups are shared between the processors, and their
+//results are written in the order of the groups.
+int ChimeraUchimeCommand::createProcessesGroups(string outputFName, string accnos, string alns, string newCountFile, vector<string> groups, string nameFile) {
 	try {
+		ofstream out;
+		m->openOutputFile(outputFName, out);
 		
-		processIDS.clear();
-		int process = 1;
-		int num = 0;
-        
-        CountTable newCount;
-        if (hasCount && dups) { newCount.readTable(nameFile, true, false); }
+		ofstream outAccnos;
+		m->openOutputFile(accnos, outAccnos);
 		
-		//sanity check
-		if (groups.size() < processors) { processors = groups.size(); }
+		vector<ostream*> files;
+		files.push_back(&out); files.push_back(&outAccnos);
 		
-		//divide the groups between the processors
-		vector<linePair> lines;
-        int remainingPairs = groups.size();
-        int startIndex = 0;
-        for (int remainingProcessors = processors; remainingProcessors > 0; remainingProcessors--) {
-            int numPairs = remainingPairs; //case for last processor
-            if (remainingProcessors != 1) { numPairs = ceil(remainingPairs / remainingProcessors); }
-            lines.push_back(linePair(startIndex, (startIndex+numPairs))); //startIndex, endIndex
-            startIndex = startIndex + numPairs;
-            remainingPairs = remainingPairs - numPairs;
-        }
-
-#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)		
-				
-		//loop through and create all the processes you want
-		while (process != processors) {
-			pid_t pid = fork();
-			
-			if (pid > 0) {
-				processIDS.push_back(pid);  //create map from line number to pid so you can append files in correct order later
-				process++;
-			}else if (pid == 0){
-				num = driverGroups(outputFName + toString(m->mothurGetpid(process)) + ".temp", filename + toString(m->mothurGetpid(process)) + ".temp", accnos + toString(m->mothurGetpid(process)) + ".temp", alns + toString(m->mothurGetpid(process)) + ".temp", accnos + ".byCount." + toString(m->mothurGetpid(process)) + ".temp", lines[process].start, lines[process].end, groups);
+		ofstream outAlns;
+		if (chimealns) { m->openOutputFile(alns, outAlns); files.push_back(&outAlns); }
+		OutputSink sink(files, false);
+		
+		ThreadPool pool(processors);
+		vector< vector<string> > groupChimeras(groups.size());
+		
+		for (int i = 0; i < groups.size(); i++) {
+			pool.submit([this, i, &groups, &groupChimeras, &sink](int processor) {
+				int start = time(NULL);
+				vector<string> output(3, "");
+				int numSeqs = 0;
 				
-				//pass numSeqs to parent
-				ofstream out;
-				string tempFile = outputFName + toString(m->mothurGetpid(process)) + ".num.temp";
-				m->openOutputFile(tempFile, out);
-				out << num << endl;
-				out.close();
+				vector<seqPriorityNode> nameVector;
+				int error;
+				if (hasCount) { error = cparser->getSeqs(groups[i], nameVector); }
+				else { error = sparser->getSeqs(groups[i], nameVector); }
 				
-				exit(0);
-            }else {
-                m->mothurOut("[ERROR]: unable to spawn the necessary processes."); m->mothurOutEndLine();
-                for (int i = 0; i < processIDS.size(); i++) { kill (processIDS[i], SIGINT); }
-                exit(0);
-            }
+				if (error == 1) { m->control_pressed = true; }
+				else {
+					numSeqs = driver(nameVector, output, groupChimeras[i]);
 
+					//each group's alns are written without the blank line uchime starts them with, as appending the group files did
+					output[2].erase(0, output[2].find_first_not_of(" \t\r\n"));
+
+					//with dereplicate=t and a namefile, every seq the chimeric uniques represent in this group is removed
+					if (dups && !hasCount) {
+						map<string, string> thisnamemap = sparser->getNameMap(groups[i]);
+						map<string, string>::iterator itN;
+						output[1] = "";
+						for (int j = 0; j < groupChimeras[i].size(); j++) {
+							itN = thisnamemap.find(groupChimeras[i][j]);
+							if (itN != thisnamemap.end()) {
+								vector<string> tempNames; m->splitAtComma(itN->second, tempNames); 
+								for (int k = 0; k < tempNames.size(); k++) { output[1] += tempNames[k] + "\n"; }
+							}else { m->mothurOut("[ERROR]: parsing cannot find " + groupChimeras[i][j] + ".\n"); m->control_pressed = true; }
+						}
+					}
+				}
+				
+				//every group is written, so the groups after it are not held back
+				sink.write(i, output, numSeqs);
+				
+				if (!m->control_pressed) { m->mothurOut("\nIt took " + toString(time(NULL) - start) + " secs to check " + toString(numSeqs) + " sequences from group " + groups[i] + ".\n"); }
+			});
 		}
-		m->mothurOut(toString( getpid() ) + " here\n");
-            
-		//do my part
-		num = driverGroups(outputFName, filename, accnos, alns, accnos + ".byCount", lines[0].start, lines[0].end, groups);
-		
-		//force parent to wait until all the processes are done
-		for (int i=0;i<processIDS.size();i++) { 
-			int temp = processIDS[i];
-			wait(&temp);
-		}
-        
-		for (int i = 0; i < processIDS.size(); i++) {
-			ifstream in;
-			string tempFile =  outputFName + toString(processIDS[i]) + ".num.temp";
-			m->openInputFile(tempFile, in);
-			if (!in.eof()) { int tempNum = 0; in >> tempNum; num += tempNum; }
-			in.close(); m->mothurRemove(tempFile);
-        }
-        
-#else
-		//////////////////////////////////////////////////////////////////////////////////////////////////////
-		//Windows version shared memory, so be careful when passing variables through the uchimeData struct. 
-		//Above fork() will clone, so memory is separate, but that's not the case with windows, 
-		//////////////////////////////////////////////////////////////////////////////////////////////////////
-		
-		vector<uchimeData*> pDataArray; 
-		DWORD   dwThreadIdArray[processors-1];
-		HANDLE  hThreadArray[processors-1]; 
-		
-		//Create processor worker threads.
-		for( int i=1; i<processors; i++ ){
-			// Allocate memory for thread data.
-			string extension = toString(i) + ".temp";
-			
-			uchimeData* tempUchime = new uchimeData(outputFName+extension, uchimeLocation, templatefile, filename+extension, fastaFile, nameFile, groupFile, accnos+extension, alns+extension, accnos+".byCount."+extension, groups, m, lines[i].start, lines[i].end,  i);
-			tempUchime->setBooleans(dups, useAbskew, chimealns, useMinH, useMindiv, useXn, useDn, useXa, useChunks, useMinchunk, useIdsmoothwindow, useMinsmoothid, useMaxp, skipgaps, skipgaps2, useMinlen, useMaxlen, ucl, useQueryfract, hasCount);
-			tempUchime->setVariables(abskew, minh, mindiv, xn, dn, xa, chunks, minchunk, idsmoothwindow, minsmoothid, maxp, minlen, maxlen, queryfract, strand);
-			
-			pDataArray.push_back(tempUchime);
-			processIDS.push_back(i);
-			
-			//MyUchimeThreadFunction is in header. It must be global or static to work with the threads.
-			//default security attributes, thread function name, argument to thread function, use default creation flags, returns the thread identifier
-			hThreadArray[i-1] = CreateThread(NULL, 0, MyUchimeThreadFunction, pDataArray[i-1], 0, &dwThreadIdArray[i-1]);   
-		}
-		
-		
-		//using the main process as a worker saves time and memory
-		num = driverGroups(outputFName, filename, accnos, alns, accnos + ".byCount", lines[0].start, lines[0].end, groups);
-		
-		//Wait until all threads have terminated.
-		WaitForMultipleObjects(processors-1, hThreadArray, TRUE, INFINITE);
+		pool.wait();
 		
-		//Close all thread handles and free memory allocations.
-		for(int i=0; i < pDataArray.size(); i++){
-			num += pDataArray[i]->count;
-			CloseHandle(hThreadArray[i]);
-			delete pDataArray[i];
-		}
-        
-        
-#endif		
-      
-        //read my own
-        if (hasCount && dups) {
-            if (!m->isBlank(accnos + ".byCount")) {
-                ifstream in2;
-                m->openInputFile(accnos + ".byCount", in2);
-                
-                string name, group;
-                while (!in2.eof()) {
-                    in2 >> name >> group; m->gobble(in2);
-                    newCount.setAbund(name, group, 0);
-                }
-                in2.close();
-            }
-            m->mothurRemove(accnos + ".byCount");
-        }
-       
-		//append output files
-		for(int i=0;i<processIDS.size();i++){
-			m->appendFiles((outputFName + toString(processIDS[i]) + ".temp"), outputFName);
-			m->mothurRemove((outputFName + toString(processIDS[i]) + ".temp"));
-			
-			m->appendFiles((accnos + toString(processIDS[i]) + ".temp"), accnos);
-			m->mothurRemove((accnos + toString(processIDS[i]) + ".temp"));
-			
-			if (chimealns) {
-				m->appendFiles((alns + toString(processIDS[i]) + ".temp"), alns);
-				m->mothurRemove((alns + toString(processIDS[i]) + ".temp"));
+		out.close();
+		outAccnos.close();
+		if (chimealns) { outAlns.close(); }
+		
+		//if we provided a count file with group info and set dereplicate=t, then we want to create a *.pick.count_table
+		//This table will zero out group counts for seqs determined to be chimeric by that group.
+		if (hasCount && dups && !m->control_pressed) {
+			CountTable newCount; newCount.readTable(nameFile, true, false);
+			for (int i = 0; i < groups.size(); i++) {
+				for (int j = 0; j < groupChimeras[i].size(); j++) { newCount.setAbund(groupChimeras[i][j], groups[i], 0); }
 			}
-            
-            if (hasCount && dups) {
-                if (!m->isBlank(accnos + ".byCount." + toString(processIDS[i]) + ".temp")) {
-                    ifstream in2;
-                    m->openInputFile(accnos + ".byCount." + toString(processIDS[i]) + ".temp", in2);
-                    
-                    string name, group;
-                    while (!in2.eof()) {
-                        in2 >> name >> group; m->gobble(in2);
-                        newCount.setAbund(name, group, 0);
-                    }
-                    in2.close();
-                }
-                m->mothurRemove(accnos + ".byCount." + toString(processIDS[i]) + ".temp");
-            }
-
+			newCount.printTable(newCountFile);
 		}
-        
-        //print new *.pick.count_table
-        if (hasCount && dups) {  newCount.printTable(newCountFile);   }
- 		
-		return num;	
 		
+		return sink.getNumWritten();
 	}
 	catch(exception& e) {
 		m->errorOut(e, "ChimeraUchimeCommand", "createProcessesGroups");
@@ -14,7 +14,7 @@
 //**********************************************************************************************************************
 vector<string> ClassifyRFSharedCommand::setParameters(){	
 	try {
-		//CommandParameter pprocessors("processors", "Number", "", "1", "", "", "",false,false); parameters.push_back(pprocessors);        
+		CommandParameter pprocessors("processors", "Number", "", "1", "", "", "","",false,false,true); parameters.push_back(pprocessors);
         CommandParameter pshared("shared", "InputTypes", "", "", "none", "none", "none","summary",false,true,true); parameters.push_back(pshared);		
         CommandParameter pdesign("design", "InputTypes", "", "", "none", "none", "none","",false,true,true); parameters.push_back(pdesign);	
         CommandParameter potupersplit("otupersplit", "Multiple", "log2-squareroot", "log2", "", "", "","",false,false); parameters.push_back(potupersplit);
@@ -49,9 +49,10 @@ string ClassifyRFSharedCommand::getHelpString(){
 	try {
 		string helpString = "";
 		helpString += "The classify.rf command allows you to ....\n";
-		helpString += "The classify.rf command parameters are: shared, design, label, groups, otupersplit.\n";
+		helpString += "The classify.rf command parameters are: shared, design, label, groups, otupersplit, numtrees, processors.\n";
         helpString += "The label parameter is used to analyze specific labels in your input.\n";
 		helpString += "The groups parameter allows you to specify which of the groups in your designfile you would like analyzed.\n";
+		helpString += "The processors parameter allows you to specify the number of processors to use while building the trees. The default is 1. A seed gives the same forest whatever the number of processors.\n";
 		helpString += "The classify.rf should be in the following format: \n";
 		helpString += "classify.rf(shared=yourSharedFile, design=yourDesignFile)\n";
 		return helpString;
@@ -179,6 +180,10 @@ ClassifyRFSharedCommand::ClassifyRFSharedCommand(string option) {
         temp = validParameter.validFile(parameters, "numtrees", false); if (temp == "not found"){	temp = "100";	}
         m->mothurConvert(temp, numDecisionTrees);
         
+        temp = validParameter.validFile(parameters, "processors", false);	if (temp == "not found"){	temp = m->getProcessors();	}
+        m->setProcessors(temp);
+        m->mothurConvert(temp, processors);
+        
             // parameters for pruning
         temp = validParameter.validFile(parameters, "prune", false);
         if (temp == "not found") { temp = "f"; }
@@ -376,7 +381,7 @@ void ClassifyRFSharedCommand::processSharedAndDesignData(vector<SharedRAbundVect
             dataSet[i][j] = treatmentToIntMap[treatmentName];
         }
         
-        RandomForest randomForest(dataSet, numDecisionTrees, treeSplitCriterion, doPruning, pruneAggressiveness, discardHighErrorTrees, highErrorTreeDiscardThreshold, optimumFeatureSubsetSelectionCriteria, featureStandardDeviationThreshold);
+        RandomForest randomForest(dataSet, numDecisionTrees, treeSplitCriterion, doPruning, pruneAggressiveness, discardHighErrorTrees, highErrorTreeDiscardThreshold, optimumFeatureSubsetSelectionCriteria, featureStandardDeviationThreshold, processors);
         
         randomForest.populateDecisionTrees();
         randomForest.calcForrestErrorRate();
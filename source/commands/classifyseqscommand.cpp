@@ -604,17 +604,15 @@ ClassifySeqsCommand::ClassifySeqsCommand(string option)  {
 }
 
 //**********************************************************************************************************************
-ClassifySeqsCommand::~ClassifySeqsCommand(){	
-	if (abort == false) {
-		for (int i = 0; i < lines.size(); i++) {  delete lines[i];  }  lines.clear();
-	}
-}
+ClassifySeqsCommand::~ClassifySeqsCommand(){}
 //**********************************************************************************************************************
 
 int ClassifySeqsCommand::execute(){
 	try {
 		if (abort == true) { if (calledHelp) { return 0; }  return 2;	}
         
+        Profiler::getInstance()->startPhase("read");
+        
         string outputMethodTag = method;
 		if(method == "wang"){	classify = new Bayesian(taxonomyFileName, templateFileName, search, kmerSize, cutoff, iters, rand(), flip, writeShortcuts);	}
 		else if(method == "knn"){	classify = new Knn(taxonomyFileName, templateFileName, search, kmerSize, gapOpen, gapExtend, match, misMatch, numWanted, rand());				}
@@ -632,6 +630,8 @@ int ClassifySeqsCommand::execute(){
 		if (m->control_pressed) { delete classify; return 0; }
 				
 		for (int s = 0; s < fastaFileNames.size(); s++) {
+			
+			Profiler::getInstance()->startPhase("compute");
 		
 			m->mothurOut("Classifying sequences from " + fastaFileNames[s] + " ..." ); m->mothurOutEndLine();
 			
@@ -668,7 +668,6 @@ int ClassifySeqsCommand::execute(){
 			
 			int start = time(NULL);
 			int numFastaSeqs = 0;
-			for (int i = 0; i < lines.size(); i++) {  delete lines[i];  }  lines.clear();
 			
 #ifdef USE_MPI	
 				int pid, numSeqsPerProcessor; 
@@ -760,31 +759,7 @@ int ClassifySeqsCommand::execute(){
 				
 #else
 		
-			vector<unsigned long long> positions; 
-#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
-			positions = m->divideFile(fastaFileNames[s], processors);
-			for (int i = 0; i < (positions.size()-1); i++) {	lines.push_back(new linePair(positions[i], positions[(i+1)]));	}
-#else
-			if (processors == 1) {
-				lines.push_back(new linePair(0, 1000));
-			}else {
-				positions = m->setFilePosFasta(fastaFileNames[s], numFastaSeqs); 
-                if (positions.size() < processors) { processors = positions.size(); }
-				
-				//figure out how many sequences you have to process
-				int numSeqsPerProcessor = numFastaSeqs / processors;
-				for (int i = 0; i < processors; i++) {
-					int startIndex =  i * numSeqsPerProcessor;
-					if(i == (processors - 1)){	numSeqsPerProcessor = numFastaSeqs - i * numSeqsPerProcessor; 	}
-					lines.push_back(new linePair(positions[startIndex], numSeqsPerProcessor));
-				}
-			}
-#endif
-			if(processors == 1){
-				numFastaSeqs = driver(lines[0], newTaxonomyFile, tempTaxonomyFile, newaccnosFile, fastaFileNames[s]);
-			}else{
-				numFastaSeqs = createProcesses(newTaxonomyFile, tempTaxonomyFile, newaccnosFile, fastaFileNames[s]); 
-			}
+			numFastaSeqs = createProcesses(newTaxonomyFile, tempTaxonomyFile, newaccnosFile, fastaFileNames[s]);
 #endif
 			
 			if (!m->isBlank(newaccnosFile)) { m->mothurOutEndLine(); m->mothurOut("[WARNING]: mothur reversed some your sequences for a better classification.  If you would like to take a closer look, please check " + newaccnosFile + " for the list of the sequences."); m->mothurOutEndLine(); 
@@ -795,6 +770,8 @@ int ClassifySeqsCommand::execute(){
 		m->mothurOut("It took " + toString(time(NULL) - start) + " secs to classify " + toString(numFastaSeqs) + " sequences."); m->mothurOutEndLine(); m->mothurOutEndLine();
 		start = time(NULL);
 		
+		Profiler::getInstance()->startPhase("write");
+		
 		
 
 		#ifdef USE_MPI	
@@ -963,176 +940,61 @@ string ClassifySeqsCommand::addUnclassifieds(string tax, int maxlevel) {
 }
 
 /**************************************************************************************************/
-
+//the processors share the classifier. The fasta file is read in blocks of 100 sequences, and
+//the classified blocks are written in the order they were read, so the output does not depend on processors.
 int ClassifySeqsCommand::createProcesses(string taxFileName, string tempTaxFile, string accnos, string filename) {
 	try {
+		ofstream outTax;
+		m->openOutputFile(taxFileName, outTax);
 		
-		int num = 0;
-		processIDS.clear();
-        bool recalc = false;
-		
-#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
-		int process = 1;
-		
-		//loop through and create all the processes you want
-		while (process != processors) {
-			pid_t pid = fork();
-			
-			if (pid > 0) {
-				processIDS.push_back(pid);  //create map from line number to pid so you can append files in correct order later
-				process++;
-			}else if (pid == 0){
-				num = driver(lines[process], taxFileName + m->mothurGetpid(process) + ".temp", tempTaxFile + m->mothurGetpid(process) + ".temp", accnos + m->mothurGetpid(process) + ".temp", filename);
-
-				//pass numSeqs to parent
-				ofstream out;
-				string tempFile = filename + m->mothurGetpid(process) + ".num.temp";
-				m->openOutputFile(tempFile, out);
-				out << num << endl;
-				out.close();
-
-				exit(0);
-            }else {
-                m->mothurOut("[ERROR]: unable to spawn the number of processes you requested, reducing number to " + toString(process) + "\n"); processors = process;
-                for (int i = 0; i < processIDS.size(); i++) { kill (processIDS[i], SIGINT); }
-                //wait to die
-                for (int i=0;i<processIDS.size();i++) {
-                    int temp = processIDS[i];
-                    wait(&temp);
-                }
-                m->control_pressed = false;
-                recalc = true;
-                break;
-            }
-		}
-        
-        if (recalc) {
-            //test line, also set recalc to true.
-            //for (int i = 0; i < processIDS.size(); i++) { kill (processIDS[i], SIGINT); } for (int i=0;i<processIDS.size();i++) { int temp = processIDS[i]; wait(&temp); } m->control_pressed = false;  processors=3; m->mothurOut("[ERROR]: unable to spawn the number of processes you requested, reducing number to " + toString(processors) + "\n");
-            for (int i = 0; i < lines.size(); i++) {  delete lines[i];  }  lines.clear();
-            vector<unsigned long long> positions = m->divideFile(filename, processors);
-            for (int i = 0; i < (positions.size()-1); i++) {	lines.push_back(new linePair(positions[i], positions[(i+1)]));	}
-            
-            num = 0;
-            processIDS.resize(0);
-            process = 1;
-            
-            while (process != processors) {
-                pid_t pid = fork();
-                
-                if (pid > 0) {
-                    processIDS.push_back(pid);  //create map from line number to pid so you can append files in correct order later
-                    process++;
-                }else if (pid == 0){
-                    num = driver(lines[process], taxFileName + m->mothurGetpid(process) + ".temp", tempTaxFile + m->mothurGetpid(process) + ".temp", accnos + m->mothurGetpid(process) + ".temp", filename);
-                    
-                    //pass numSeqs to parent
-                    ofstream out;
-                    string tempFile = filename + m->mothurGetpid(process) + ".num.temp";
-                    m->openOutputFile(tempFile, out);
-                    out << num << endl;
-                    out.close();
-                    
-                    exit(0);
-                }else {
-                    m->mothurOut("[ERROR]: unable to spawn the necessary processes."); m->mothurOutEndLine();
-                    for (int i = 0; i < processIDS.size(); i++) { kill (processIDS[i], SIGINT); }
-                    exit(0);
-                }
-            }
-        }
-
+		ofstream outTaxSimple;
+		m->openOutputFile(tempTaxFile, outTaxSimple);
 		
-		//parent does its part
-		num = driver(lines[0], taxFileName, tempTaxFile, accnos, filename);
+		ofstream outAcc;
+		m->openOutputFile(accnos, outAcc);
 		
-		//force parent to wait until all the processes are done
-		for (int i=0;i<processIDS.size();i++) { 
-			int temp = processIDS[i];
-			wait(&temp);
-		}
+		vector<ostream*> files;
+		files.push_back(&outTax); files.push_back(&outTaxSimple); files.push_back(&outAcc);
+		OutputSink sink(files, true);
 		
-		for (int i = 0; i < processIDS.size(); i++) {
-			ifstream in;
-			string tempFile =  filename + toString(processIDS[i]) + ".num.temp";
-			m->openInputFile(tempFile, in);
-			if (!in.eof()) { int tempNum = 0; in >> tempNum; num += tempNum; }
-			in.close(); m->mothurRemove(m->getFullPathName(tempFile));
-		}
-#else
-		//////////////////////////////////////////////////////////////////////////////////////////////////////
-		//Windows version shared memory, so be careful when passing variables through the alignData struct. 
-		//Above fork() will clone, so memory is separate, but that's not the case with windows, 
-		//////////////////////////////////////////////////////////////////////////////////////////////////////
+		ThreadPool pool(processors);
 		
-		vector<classifyData*> pDataArray; 
-		DWORD   dwThreadIdArray[processors-1];
-		HANDLE  hThreadArray[processors-1]; 
+		ifstream inFASTA;
+		m->openInputFile(filename, inFASTA);
 		
-		//Create processor worker threads.
-		for( int i=0; i<processors-1; i++ ){
-			// Allocate memory for thread data.
-			string extension = "";
-			if (i != 0) { extension = toString(i) + ".temp"; processIDS.push_back(i); }
+		int numBlocks = 0;
+		while (!inFASTA.eof()) {
+			if (m->control_pressed) { break; }
 			
-			classifyData* tempclass = new classifyData((accnos + extension), probs, method, templateFileName, taxonomyFileName, (taxFileName + extension), (tempTaxFile + extension), filename, search, kmerSize, iters, numWanted, m, lines[i]->start, lines[i]->end, match, misMatch, gapOpen, gapExtend, cutoff, i, flip, writeShortcuts);
-			pDataArray.push_back(tempclass);
+			//seeds are drawn here in input order, so each sequence's bootstrap is the same for any processors
+			vector<Sequence*>* block = new vector<Sequence*>();
+			vector<unsigned> seeds;
+			while (!inFASTA.eof() && (block->size() < 100)) {
+				Sequence* candidateSeq = new Sequence(inFASTA); m->gobble(inFASTA);
+				if (candidateSeq->getName() != "") { block->push_back(candidateSeq); seeds.push_back(rand()); }
+				else { delete candidateSeq; }
+			}
 			
-			//MySeqSumThreadFunction is in header. It must be global or static to work with the threads.
-			//default security attributes, thread function name, argument to thread function, use default creation flags, returns the thread identifier
-			hThreadArray[i] = CreateThread(NULL, 0, MyClassThreadFunction, pDataArray[i], 0, &dwThreadIdArray[i]);  
+			int blockNum = numBlocks; numBlocks++;
+			pool.submit([this, block, seeds, blockNum, &sink](int processor) mutable {
+				vector<string> output;
+				int count = driver(*block, seeds, output);
+				sink.write(blockNum, output, count);
+				for (int i = 0; i < block->size(); i++) { delete (*block)[i]; }
+				delete block;
+			});
 			
+			//keeps the number of blocks in memory bounded, the ones running and the ones waiting to be written
+			pool.waitForSlot(pool.getNumProcessors() * 4, &sink);
 		}
+		pool.wait();
 		
-		//parent does its part
-		num = driver(lines[processors-1], taxFileName + toString(processors-1) + ".temp", tempTaxFile + toString(processors-1) + ".temp", accnos + toString(processors-1) + ".temp", filename);
-		processIDS.push_back((processors-1));
-		
-		//Wait until all threads have terminated.
-		WaitForMultipleObjects(processors-1, hThreadArray, TRUE, INFINITE);
-		
-		//Close all thread handles and free memory allocations.
-		for(int i=0; i < pDataArray.size(); i++){
-			num += pDataArray[i]->count;
-            if (pDataArray[i]->count != pDataArray[i]->end) {
-                m->mothurOut("[ERROR]: process " + toString(i) + " only processed " + toString(pDataArray[i]->count) + " of " + toString(pDataArray[i]->end) + " sequences assigned to it, quitting. \n"); m->control_pressed = true; 
-            }
-			CloseHandle(hThreadArray[i]);
-			delete pDataArray[i];
-		}
-		
-	#endif	
-        vector<string> nonBlankAccnosFiles;
-		if (!(m->isBlank(accnos))) { nonBlankAccnosFiles.push_back(accnos); }
-		else { m->mothurRemove(accnos); } //remove so other files can be renamed to it
-        
-		for(int i=0;i<processIDS.size();i++){
-			m->appendFiles((taxFileName + toString(processIDS[i]) + ".temp"), taxFileName);
-			m->appendFiles((tempTaxFile + toString(processIDS[i]) + ".temp"), tempTaxFile);
-            if (!(m->isBlank(accnos + toString(processIDS[i]) + ".temp"))) {
-				nonBlankAccnosFiles.push_back(accnos + toString(processIDS[i]) + ".temp");
-			}else { m->mothurRemove((accnos + toString(processIDS[i]) + ".temp"));  }
-
-			m->mothurRemove((m->getFullPathName(taxFileName) + toString(processIDS[i]) + ".temp"));
-			m->mothurRemove((m->getFullPathName(tempTaxFile) + toString(processIDS[i]) + ".temp"));
-		}
-		
-        //append accnos files
-		if (nonBlankAccnosFiles.size() != 0) { 
-			rename(nonBlankAccnosFiles[0].c_str(), accnos.c_str());
-			
-			for (int h=1; h < nonBlankAccnosFiles.size(); h++) {
-				m->appendFiles(nonBlankAccnosFiles[h], accnos);
-				m->mothurRemove(nonBlankAccnosFiles[h]);
-			}
-		}else { //recreate the accnosfile if needed
-			ofstream out;
-			m->openOutputFile(accnos, out);
-			out.close();
-		}
-
-		return num;
+		inFASTA.close();
+		outTax.close();
+		outTaxSimple.close();
+		outAcc.close();
 		
+		return sink.getNumWritten();
 	}
 	catch(exception& e) {
 		m->errorOut(e, "ClassifySeqsCommand", "createProcesses");
@@ -1140,78 +1002,44 @@ int ClassifySeqsCommand::createProcesses(string taxFileName, string tempTaxFile,
 	}
 }
 //**********************************************************************************************************************
-
-int ClassifySeqsCommand::driver(linePair* filePos, string taxFName, string tempTFName, string accnos, string filename){
+//classifies a block of sequences, output holds the taxonomy, simple taxonomy and accnos lines for the block.
+//several processors run driver at once, so it only reads from the command and the classifier. seeds has one per sequence
+int ClassifySeqsCommand::driver(vector<Sequence*>& seqs, vector<unsigned>& seeds, vector<string>& output){
 	try {
-		ofstream outTax;
-		m->openOutputFile(taxFName, outTax);
-		
-		ofstream outTaxSimple;
-		m->openOutputFile(tempTFName, outTaxSimple);
-		
-		ofstream outAcc;
-		m->openOutputFile(accnos, outAcc);
-	
-		ifstream inFASTA;
-		m->openInputFile(filename, inFASTA);
-		
-		string taxonomy;
-
-		inFASTA.seekg(filePos->start);
-
-		bool done = false;
+		ostringstream outTax, outTaxSimple, outAcc;
 		int count = 0;
 		
-		while (!done) {
-			if (m->control_pressed) { 
-				inFASTA.close();
-				outTax.close();
-				outTaxSimple.close();
-				outAcc.close(); return 0; }
+		for (int i = 0; i < seqs.size(); i++) {
+			if (m->control_pressed) { break; }
 		
-			Sequence* candidateSeq = new Sequence(inFASTA); m->gobble(inFASTA);
+			Sequence* candidateSeq = seqs[i];
 			
-			if (candidateSeq->getName() != "") {
+			string simpleTax;
+			bool flipped;
+			string taxonomy = classify->getTaxonomy(candidateSeq, simpleTax, flipped, seeds[i]);
 			
-				taxonomy = classify->getTaxonomy(candidateSeq);
-				
-				if (m->control_pressed) { delete candidateSeq; return 0; }
-				
-				if (taxonomy == "unknown;") { m->mothurOut("[WARNING]: " + candidateSeq->getName() + " could not be classified. You can use the remove.lineage command with taxon=unknown; to remove such sequences."); m->mothurOutEndLine(); }
-				
-				//output confidence scores or not
-				if (probs) {
-					outTax << candidateSeq->getName() << '\t' << taxonomy << endl;
-				}else{
-					outTax << candidateSeq->getName() << '\t' << classify->getSimpleTax() << endl;
-				}
-				
-				if (classify->getFlipped()) { outAcc << candidateSeq->getName() << endl; }
-				
-				outTaxSimple << candidateSeq->getName() << '\t' << classify->getSimpleTax() << endl;
-				
-				count++;
+			if (m->control_pressed) { break; }
+			
+			if (taxonomy == "unknown;") { m->mothurOut("[WARNING]: " + candidateSeq->getName() + " could not be classified. You can use the remove.lineage command with taxon=unknown; to remove such sequences."); m->mothurOutEndLine(); }
+			
+			//output confidence scores or not
+			if (probs) {
+				outTax << candidateSeq->getName() << '\t' << taxonomy << endl;
+			}else{
+				outTax << candidateSeq->getName() << '\t' << simpleTax << endl;
 			}
-			delete candidateSeq;
 			
-			#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
-				unsigned long long pos = inFASTA.tellg();
-				if ((pos == -1) || (pos >= filePos->end)) { break; }
-			#else
-				if (inFASTA.eof()) { break; }
-			#endif
+			if (flipped) { outAcc << candidateSeq->getName() << endl; }
 			
-			//report progress
-			if((count) % 100 == 0){	m->mothurOutJustToScreen("Processing sequence: " + toString(count) +"\n"); 		}
+			outTaxSimple << candidateSeq->getName() << '\t' << simpleTax << endl;
 			
+			count++;
 		}
-		//report progress
-		if((count) % 100 != 0){	m->mothurOutJustToScreen("Processing sequence: " + toString(count)+"\n"); 		}
-			
-		inFASTA.close();
-		outTax.close();
-		outTaxSimple.close();
-		outAcc.close();
+		
+		output.clear();
+		output.push_back(outTax.str());
+		output.push_back(outTaxSimple.str());
+		output.push_back(outAcc.str());
 		
 		return count;
 	}
@@ -10,6 +10,7 @@
 #include "clustercommand.h"
 #include "readphylip.h"
 #include "readcolumn.h"
+#include "readbinary.h"
 #include "readmatrix.hpp"
 #include "clusterdoturcommand.h"
 
@@ -47,6 +48,7 @@ string ClusterCommand::getHelpString(){
 	try {
 		string helpString = "";
 		helpString += "The cluster command parameter options are phylip, column, name, count, method, cuttoff, hard, precision, sim, showabund and timing. Phylip or column and name are required, unless you have a valid current file.\n";
+		helpString += "The column parameter also accepts the binary distance file created by dist.seqs output=binary, the name or count file is optional with a binary file.\n";
 		//helpString += "The adjust parameter is used to handle missing distances.  If you set a cutoff, adjust=f by default.  If not, adjust=t by default. Adjust=f, means ignore missing distances and adjust cutoff as needed with the average neighbor method.  Adjust=t, will treat missing distances as 1.0. You can also set the value the missing distances should be set to, adjust=0.5 would give missing distances a value of 0.5.\n";
         helpString += "The cluster command should be in the following format: \n";
 		helpString += "cluster(method=yourMethod, cutoff=yourCutoff, precision=yourPrecision) \n";
@@ -171,7 +173,11 @@ ClusterCommand::ClusterCommand(string option)  {
 			columnfile = validParameter.validFile(parameters, "column", true);
 			if (columnfile == "not open") { columnfile = ""; abort = true; }	
 			else if (columnfile == "not found") { columnfile = ""; }
-			else {  distfile = columnfile; format = "column"; m->setColumnFile(columnfile);	}
+			else {  
+                distfile = columnfile; format = "column"; 
+                if (BinaryDistFile::isBinary(columnfile)) { format = "binary"; } //created by dist.seqs output=binary
+                else { m->setColumnFile(columnfile); }
+            }
 			
 			namefile = validParameter.validFile(parameters, "name", true);
 			if (namefile == "not open") { abort = true; }	
@@ -199,7 +205,7 @@ ClusterCommand::ClusterCommand(string option)  {
 			}
 			else if ((phylipfile != "") && (columnfile != "")) { m->mothurOut("When executing a cluster command you must enter ONLY ONE of the following: phylip or column."); m->mothurOutEndLine(); abort = true; }
 			
-			if (columnfile != "") {
+			if ((columnfile != "") && (format != "binary")) { //the binary file contains the names of all the sequences
 				if ((namefile == "") && (countfile == "")){ 
 					namefile = m->getNameFile(); 
 					if (namefile != "") {  m->mothurOut("Using " + namefile + " as input file for the name parameter."); m->mothurOutEndLine(); }
@@ -305,6 +311,7 @@ int ClusterCommand::execute(){
 		ReadMatrix* read;
 		if (format == "column") { read = new ReadColumnMatrix(columnfile, sim); }	//sim indicates whether its a similarity matrix
 		else if (format == "phylip") { read = new ReadPhylipMatrix(phylipfile, sim); }
+		else if (format == "binary") { read = new ReadBinaryMatrix(columnfile, sim); }
 		
 		read->setCutoff(cutoff);
 		
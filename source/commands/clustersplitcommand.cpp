@@ -59,6 +59,7 @@ string ClusterSplitCommand::getHelpString(){
 		helpString += "You will also need to set the taxlevel you want to split by. mothur will split the sequence into distinct taxonomy groups, and create distance files for each grouping. \n";
         helpString += "The file option allows you to enter your file containing your list of column and names/count files as well as the singleton file.  This file is mothur generated, when you run cluster.split() with the cluster=f parameter.  This can be helpful when you have a large dataset that you may be able to use all your processors for the splitting step, but have to reduce them for the cluster step due to RAM constraints. For example: cluster.split(fasta=yourFasta, taxonomy=yourTax, count=yourCount, taxlevel=3, cluster=f, processors=8) then cluster.split(file=yourFile, processors=4).  This allows your to maximize your processors during the splitting step.  Also, if you are unsure if the cluster step will have RAM issue with multiple processors, you can avoid running the first part of the command multiple times.\n";
 		helpString += "The phylip and column parameter allow you to enter your distance file. \n";
+		helpString += "The column parameter also accepts the binary distance file created by dist.seqs output=binary, which is converted to column format before splitting. \n";
 		helpString += "The fasta parameter allows you to enter your aligned fasta file. \n";
 		helpString += "The name parameter allows you to enter your name file. \n";
         helpString += "The count parameter allows you to enter your count file. \n A count or name file is required if your distance file is in column format";
@@ -234,7 +235,11 @@ ClusterSplitCommand::ClusterSplitCommand(string option)  {
 			columnfile = validParameter.validFile(parameters, "column", true);
 			if (columnfile == "not open") { abort = true; }	
 			else if (columnfile == "not found") { columnfile = ""; }
-			else {  distfile = columnfile; format = "column";	m->setColumnFile(columnfile); }
+			else {  
+				distfile = columnfile; format = "column";	
+				if (BinaryDistFile::isBinary(columnfile)) { format = "binary"; } //created by dist.seqs output=binary
+				else { m->setColumnFile(columnfile); }
+			}
 			
 			namefile = validParameter.validFile(parameters, "name", true);
 			if (namefile == "not open") { abort = true; namefile = "";}	
@@ -278,7 +283,7 @@ ClusterSplitCommand::ClusterSplitCommand(string option)  {
             
             if ((countfile != "") && (namefile != "")) { m->mothurOut("When executing a cluster.split command you must enter ONLY ONE of the following: count or name."); m->mothurOutEndLine(); abort = true; }
             
-			if (columnfile != "") {
+			if ((columnfile != "") && (format != "binary")) { //the binary file contains the names of all the sequences
 				if ((namefile == "") && (countfile == "")) { 
 					namefile = m->getNameFile(); 
 					if (namefile != "") {  m->mothurOut("Using " + namefile + " as input file for the name parameter."); m->mothurOutEndLine(); }
@@ -450,15 +455,15 @@ int ClusterSplitCommand::execute(){
 
 #endif
                 
-                //if user gave a phylip file convert to column file
-                if (format == "phylip") {
+                //if user gave a phylip or binary file convert to column file
+                if ((format == "phylip") || (format == "binary")) {
                     estart = time(NULL);
                     m->mothurOut("Converting to column format..."); m->mothurOutEndLine();
                     
                     ReadCluster* convert = new ReadCluster(distfile, cutoff, outputDir, false);
                     
                     NameAssignment* nameMap = NULL;
-                    convert->setFormat("phylip");
+                    convert->setFormat(format);
                     convert->read(nameMap);
                     
                     if (m->control_pressed) {  delete convert;  return 0;  }
@@ -470,6 +475,7 @@ int ClusterSplitCommand::execute(){
                     if ((namefile == "") && (countfile == "")) {  //you need to make a namefile for split matrix
                         ofstream out;
                         namefile = phylipfile + ".names";
+                        if (format == "binary") { namefile = columnfile + ".names"; }
                         m->openOutputFile(namefile, out);
                         for (int i = 0; i < listToMakeNameFile->getNumBins(); i++) {
                             string bin = listToMakeNameFile->get(i);
@@ -959,8 +965,9 @@ int ClusterSplitCommand::mergeLists(vector<string> listNames, map<float, int> us
 			if (listSingle != NULL) {
 				for (int j = 0; j < listSingle->getNumBins(); j++) {
 					//outList << listSingle->get(j) << '\t';
-                    completeList.push_back(listSingle->get(j));
-					if (countfile == "") { rabund->push_back(m->getNumNames(listSingle->get(j))); }
+                    vector<int> binIds = listSingle->getIds(j);
+                    completeList.push_back(binIds);
+					if (countfile == "") { rabund->push_back(listSingle->getBinSize(j)); }
 				}
 			}
 			
@@ -977,8 +984,9 @@ int ClusterSplitCommand::mergeLists(vector<string> listNames, map<float, int> us
 				else {		
 					for (int j = 0; j < list->getNumBins(); j++) {
 						//outList << list->get(j) << '\t';
-                        completeList.push_back(list->get(j));
-						if (countfile == "") { rabund->push_back(m->getNumNames(list->get(j))); }
+                        vector<int> binIds = list->getIds(j);
+                        completeList.push_back(binIds);
+						if (countfile == "") { rabund->push_back(list->getBinSize(j)); }
 					}
 					delete list;
 				}
@@ -0,0 +1,337 @@
+/*
+ *  convertdistscommand.cpp
+ *  Mothur
+ *
+ *  Copyright 2026 Schloss Lab. All rights reserved.
+ *
+ */
+
+#include "convertdistscommand.h"
+#include "readcluster.h"
+#include "nameassignment.hpp"
+#include "counttable.h"
+
+//**********************************************************************************************************************
+vector<string> ConvertDistsCommand::setParameters(){	
+	try {
+		CommandParameter pcolumn("column", "InputTypes", "", "", "PhylipColumn", "PhylipColumn", "none","column-phylip-binary",false,false,true); parameters.push_back(pcolumn);
+		CommandParameter pphylip("phylip", "InputTypes", "", "", "PhylipColumn", "PhylipColumn", "none","binary",false,false,true); parameters.push_back(pphylip);
+		CommandParameter pname("name", "InputTypes", "", "", "NameCount", "none", "none","",false,false,true); parameters.push_back(pname);
+        CommandParameter pcount("count", "InputTypes", "", "", "NameCount", "none", "none","",false,false,true); parameters.push_back(pcount);
+		CommandParameter poutput("output", "Multiple", "column-lt-square-binary", "", "", "", "","",false,false); parameters.push_back(poutput);
+		CommandParameter pcutoff("cutoff", "Number", "", "1.0", "", "", "","",false,false); parameters.push_back(pcutoff);
+        CommandParameter pseed("seed", "Number", "", "0", "", "", "","",false,false); parameters.push_back(pseed);
+        CommandParameter pinputdir("inputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(pinputdir);
+		CommandParameter poutputdir("outputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(poutputdir);
+		
+		vector<string> myArray;
+		for (int i = 0; i < parameters.size(); i++) {	myArray.push_back(parameters[i].name);		}
+		return myArray;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ConvertDistsCommand", "setParameters");
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
+string ConvertDistsCommand::getHelpString(){	
+	try {
+		string helpString = "";
+		helpString += "The convert.dists command converts the binary distance file created by dist.seqs output=binary to the column and phylip formats, and column or phylip files to the binary format.\n";
+		helpString += "The convert.dists command parameters are column, phylip, name, count, output and cutoff. column or phylip is required.\n";
+		helpString += "The column parameter allows you to enter a column or binary distance file.\n";
+		helpString += "The name and count parameters allow you to add the sequences without distances to the binary file made from a column file.\n";
+		helpString += "The output parameter allows you to specify the format of the new file. Options are column, lt, square and binary. The default is column for a binary file and binary otherwise.\n";
+		helpString += "The cutoff parameter allows you to specify maximum distance to keep when converting a binary file to column format. The default is 1.0.\n";
+		helpString += "Distances not in a binary file are set to 1.0 in the lt and square formats.\n";
+		helpString += "The convert.dists command should be in the following format: convert.dists(column=yourDistanceFile, output=yourOutput).\n";
+		helpString += "Example convert.dists(column=final.bdist, output=column).\n";
+		helpString += "Note: No spaces between parameter labels (i.e. column), '=' and parameters (i.e.yourDistanceFile).\n";
+		return helpString;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ConvertDistsCommand", "getHelpString");
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
+string ConvertDistsCommand::getOutputPattern(string type) {
+    try {
+        string pattern = "";
+        
+        if (type == "phylip") {  pattern = "[filename],[outputtag],dist"; } 
+        else if (type == "column") { pattern = "[filename],dist"; }
+        else if (type == "binary") { pattern = "[filename],bdist"; }
+        else { m->mothurOut("[ERROR]: No definition for type " + type + " output pattern.\n"); m->control_pressed = true;  }
+        
+        return pattern;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "ConvertDistsCommand", "getOutputPattern");
+        exit(1);
+    }
+}
+//**********************************************************************************************************************
+ConvertDistsCommand::ConvertDistsCommand(){	
+	try {
+		abort = true; calledHelp = true; 
+		setParameters();
+		vector<string> tempOutNames;
+		outputTypes["phylip"] = tempOutNames;
+		outputTypes["column"] = tempOutNames;
+		outputTypes["binary"] = tempOutNames;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ConvertDistsCommand", "ConvertDistsCommand");
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
+ConvertDistsCommand::ConvertDistsCommand(string option)  {
+	try {
+		abort = false; calledHelp = false;   
+		
+		//allow user to run help
+		if(option == "help") { help(); abort = true; calledHelp = true; }
+		else if(option == "citation") { citation(); abort = true; calledHelp = true;}
+		
+		else {
+			vector<string> myArray = setParameters();
+			
+			OptionParser parser(option);
+			map<string,string> parameters = parser.getParameters();
+			
+			ValidParameters validParameter;
+			map<string,string>::iterator it;
+			
+			//check to make sure all parameters are valid for command
+			for (it = parameters.begin(); it != parameters.end(); it++) { 
+				if (validParameter.isValidParameter(it->first, myArray, it->second) != true) {  abort = true;  }
+			}
+			
+			//initialize outputTypes
+			vector<string> tempOutNames;
+			outputTypes["phylip"] = tempOutNames;
+			outputTypes["column"] = tempOutNames;
+			outputTypes["binary"] = tempOutNames;
+			
+			//if the user changes the input directory command factory will send this info to us in the output parameter 
+			string inputDir = validParameter.validFile(parameters, "inputdir", false);		
+			if (inputDir == "not found"){	inputDir = "";		}
+			else {
+				string path;
+				it = parameters.find("column");
+				//user has given a template file
+				if(it != parameters.end()){ 
+					path = m->hasPath(it->second);
+					//if the user has not given a path then, add inputdir. else leave path alone.
+					if (path == "") {	parameters["column"] = inputDir + it->second;		}
+				}
+				
+				it = parameters.find("phylip");
+				//user has given a template file
+				if(it != parameters.end()){ 
+					path = m->hasPath(it->second);
+					//if the user has not given a path then, add inputdir. else leave path alone.
+					if (path == "") {	parameters["phylip"] = inputDir + it->second;		}
+				}
+				
+				it = parameters.find("name");
+				//user has given a template file
+				if(it != parameters.end()){ 
+					path = m->hasPath(it->second);
+					//if the user has not given a path then, add inputdir. else leave path alone.
+					if (path == "") {	parameters["name"] = inputDir + it->second;		}
+				}
+				
+				it = parameters.find("count");
+				//user has given a template file
+				if(it != parameters.end()){ 
+					path = m->hasPath(it->second);
+					//if the user has not given a path then, add inputdir. else leave path alone.
+					if (path == "") {	parameters["count"] = inputDir + it->second;		}
+				}
+			}
+			
+			//check for required parameters
+			columnfile = validParameter.validFile(parameters, "column", true);
+			if (columnfile == "not open") { columnfile = ""; abort = true; }	
+			else if (columnfile == "not found") { columnfile = ""; }
+			
+			phylipfile = validParameter.validFile(parameters, "phylip", true);
+			if (phylipfile == "not open") { phylipfile = ""; abort = true; }
+			else if (phylipfile == "not found") { phylipfile = ""; }	
+			
+			namefile = validParameter.validFile(parameters, "name", true);
+			if (namefile == "not open") { namefile = ""; abort = true; }	
+			else if (namefile == "not found") { namefile = ""; }
+			
+			countfile = validParameter.validFile(parameters, "count", true);
+			if (countfile == "not open") { countfile = ""; abort = true; }	
+			else if (countfile == "not found") { countfile = ""; }
+			
+			if ((phylipfile == "") && (columnfile == "")) { m->mothurOut("You must provide a column or phylip file."); m->mothurOutEndLine(); abort = true; }
+			else if ((phylipfile != "") && (columnfile != "")) { m->mothurOut("When executing a convert.dists command you must enter ONLY ONE of the following: phylip or column."); m->mothurOutEndLine(); abort = true; }
+			
+			if ((countfile != "") && (namefile != "")) { m->mothurOut("When executing a convert.dists command you must enter ONLY ONE of the following: count or name."); m->mothurOutEndLine(); abort = true; }
+			
+			binaryInput = false;
+			if (columnfile != "") { binaryInput = BinaryDistFile::isBinary(columnfile); }
+			
+			//if the user changes the output directory command factory will send this info to us in the output parameter 
+			outputDir = validParameter.validFile(parameters, "outputdir", false);		if (outputDir == "not found"){	
+				outputDir = "";	
+				if (columnfile != "") { outputDir += m->hasPath(columnfile); }
+				else { outputDir += m->hasPath(phylipfile); }
+			}
+			
+			output = validParameter.validFile(parameters, "output", false);
+			if (output == "not found") { 
+				if (binaryInput) { output = "column"; }
+				else { output = "binary"; }
+			}
+			if (output == "phylip") { output = "lt";  }
+			
+			if ((output != "column") && (output != "lt") && (output != "square") && (output != "binary")) { m->mothurOut(output + " is not a valid output form. Options are column, lt, square and binary."); m->mothurOutEndLine(); abort = true; }
+			
+			if (binaryInput && (output == "binary")) { m->mothurOut(columnfile + " is already a binary distance file."); m->mothurOutEndLine(); abort = true; }
+			if (!binaryInput && (output != "binary")) { m->mothurOut("The convert.dists command converts column and phylip files to the binary format, please use output=binary."); m->mothurOutEndLine(); abort = true; }
+			
+			string temp = validParameter.validFile(parameters, "cutoff", false);		if(temp == "not found"){	temp = "1.0"; }
+			m->mothurConvert(temp, cutoff); 
+		}
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ConvertDistsCommand", "ConvertDistsCommand");
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
+
+int ConvertDistsCommand::execute(){
+	try {
+		
+		if (abort == true) { if (calledHelp) { return 0; }  return 2;	}
+		
+		int startTime = time(NULL);
+		
+		string inputFile = columnfile;
+		if (phylipfile != "") { inputFile = phylipfile; }
+		
+		map<string, string> variables; 
+        variables["[filename]"] = outputDir + m->getRootName(m->getSimpleName(inputFile));
+		
+		if (binaryInput) { convertFromBinary(inputFile); }
+		else { 
+			string outputFile = getOutputFileName("binary", variables);
+			outputNames.push_back(outputFile); outputTypes["binary"].push_back(outputFile);
+			convertToBinary(outputFile);
+		}
+		
+		if (m->control_pressed) { for (int i = 0; i < outputNames.size(); i++) {	m->mothurRemove(outputNames[i]);  } outputTypes.clear(); return 0; }
+		
+		//set phylip file as new current phylipfile
+		string current = "";
+		itTypes = outputTypes.find("phylip");
+		if (itTypes != outputTypes.end()) {
+			if ((itTypes->second).size() != 0) { current = (itTypes->second)[0]; m->setPhylipFile(current); }
+		}
+		
+		//set column file as new current columnfile
+		itTypes = outputTypes.find("column");
+		if (itTypes != outputTypes.end()) {
+			if ((itTypes->second).size() != 0) { current = (itTypes->second)[0]; m->setColumnFile(current); }
+		}
+		
+		m->mothurOutEndLine();
+		m->mothurOut("It took " + toString(time(NULL) - startTime) + " seconds to convert the distances."); m->mothurOutEndLine();
+		m->mothurOutEndLine();
+		m->mothurOut("Output File Names: "); m->mothurOutEndLine();
+		for (int i = 0; i < outputNames.size(); i++) {	m->mothurOut(outputNames[i]); m->mothurOutEndLine();	}
+		m->mothurOutEndLine();
+		
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ConvertDistsCommand", "execute");
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
+
+int ConvertDistsCommand::convertFromBinary(string inputFile){
+	try {
+		BinaryDistFile binary;
+		if (!binary.open(inputFile)) { m->control_pressed = true; return 0; }
+		
+		map<string, string> variables; 
+        variables["[filename]"] = outputDir + m->getRootName(m->getSimpleName(inputFile));
+		
+		string outputFile;
+		if (output == "column") {
+			outputFile = getOutputFileName("column", variables);
+			outputNames.push_back(outputFile); outputTypes["column"].push_back(outputFile);
+			binary.convertToColumn(outputFile, cutoff);
+		}else {
+			if (output == "lt") { variables["[outputtag]"] = "phylip"; }
+			else { variables["[outputtag]"] = "square"; }
+			outputFile = getOutputFileName("phylip", variables);
+			outputNames.push_back(outputFile); outputTypes["phylip"].push_back(outputFile);
+			binary.convertToPhylip(outputFile, (output == "square"));
+		}
+		
+		binary.close();
+		
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ConvertDistsCommand", "convertFromBinary");
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
+
+int ConvertDistsCommand::convertToBinary(string outputFile){
+	try {
+		//names of sequences that may not have distances
+		vector<string> names;
+		if (namefile != "") {
+			NameAssignment nameMap(namefile);
+			nameMap.readMap();
+			names.resize(nameMap.size());
+			for (map<string, int>::iterator it = nameMap.begin(); it != nameMap.end(); it++) { names[it->second] = it->first; }
+		}else if (countfile != "") {
+			CountTable ct;
+			ct.readTable(countfile, false, false);
+			names = ct.getNamesOfSeqs();
+		}
+		
+		string distFile = columnfile;
+		if (phylipfile != "") { //convert to column first, the names come from the matrix
+			ReadCluster* convert = new ReadCluster(phylipfile, 1e6, outputDir, false);
+			NameAssignment* nameMap = NULL;
+			convert->setFormat("phylip");
+			convert->read(nameMap);
+			
+			if (m->control_pressed) {  delete convert;  return 0;  }
+			
+			distFile = convert->getOutputFile();
+			ListVector* matrixNames = convert->getListVector();
+			names.clear();
+			for (int i = 0; i < matrixNames->getNumBins(); i++) { names.push_back(matrixNames->get(i)); }
+			delete matrixNames; delete nameMap;
+			delete convert;
+		}
+		
+		BinaryDistFile::convertFromColumn(distFile, outputFile, names);
+		
+		if (phylipfile != "") { m->mothurRemove(distFile); }
+		
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ConvertDistsCommand", "convertToBinary");
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
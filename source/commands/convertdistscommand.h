@@ -0,0 +1,47 @@
+#ifndef CONVERTDISTSCOMMAND_H
+#define CONVERTDISTSCOMMAND_H
+
+/*
+ *  convertdistscommand.h
+ *  Mothur
+ *
+ *  Copyright 2026 Schloss Lab. All rights reserved.
+ *
+ */
+
+#include "mothur.h"
+#include "command.hpp"
+#include "binarydistfile.h"
+
+/**************************************************************************************************/
+//converts between the binary distance file created by dist.seqs output=binary and the column and phylip formats
+class ConvertDistsCommand : public Command {
+public:
+	ConvertDistsCommand(string);
+	ConvertDistsCommand();
+	~ConvertDistsCommand(){}
+	
+	vector<string> setParameters();
+	string getCommandName()			{ return "convert.dists";	}
+	string getCommandCategory()		{ return "General";		}
+	string getHelpString();	
+    string getOutputPattern(string);	
+	string getCitation() { return "http://www.mothur.org/wiki/Convert.dists"; }
+	string getDescription()		{ return "converts distance files between the binary, column and phylip formats"; }
+	
+	int execute(); 
+	void help() { m->mothurOut(getHelpString()); }	
+	
+private:
+	bool abort, binaryInput;
+	string columnfile, phylipfile, namefile, countfile, output, outputDir;
+	float cutoff;
+	vector<string> outputNames;
+	
+	int convertFromBinary(string);
+	int convertToBinary(string);
+};
+
+/**************************************************************************************************/
+
+#endif
@@ -15,7 +15,7 @@ vector<string> DistanceCommand::setParameters(){
 		CommandParameter pcolumn("column", "InputTypes", "", "", "none", "none", "OldFastaColumn","column",false,false); parameters.push_back(pcolumn);
 		CommandParameter poldfasta("oldfasta", "InputTypes", "", "", "none", "none", "OldFastaColumn","",false,false); parameters.push_back(poldfasta);
 		CommandParameter pfasta("fasta", "InputTypes", "", "", "none", "none", "none","phylip-column",false,true, true); parameters.push_back(pfasta);
-		CommandParameter poutput("output", "Multiple", "column-lt-square-phylip", "column", "", "", "","phylip-column",false,false, true); parameters.push_back(poutput);
+		CommandParameter poutput("output", "Multiple", "column-lt-square-phylip-binary", "column", "", "", "","phylip-column",false,false, true); parameters.push_back(poutput);
 		CommandParameter pcalc("calc", "Multiple", "nogaps-eachgap-onegap", "onegap", "", "", "","",false,false); parameters.push_back(pcalc);
 		CommandParameter pcountends("countends", "Boolean", "", "T", "", "", "","",false,false); parameters.push_back(pcountends);
 		CommandParameter pcompress("compress", "Boolean", "", "F", "", "", "","",false,false); parameters.push_back(pcompress);
@@ -45,9 +45,10 @@ string DistanceCommand::getHelpString(){
 		helpString += "The calc parameter allows you to specify the method of calculating the distances.  Your options are: nogaps, onegap or eachgap. The default is onegap.\n";
 		helpString += "The countends parameter allows you to specify whether to include terminal gaps in distance.  Your options are: T or F. The default is T.\n";
 		helpString += "The cutoff parameter allows you to specify maximum distance to keep. The default is 1.0.\n";
-		helpString += "The output parameter allows you to specify format of your distance matrix. Options are column, lt, and square. The default is column.\n";
+		helpString += "The output parameter allows you to specify format of your distance matrix. Options are column, lt, square and binary. The default is column.\n";
+		helpString += "The binary output holds the same distances as the column format without the text formatting, and can be read by the cluster, cluster.split and hcluster commands using the column parameter.\n";
 		helpString += "The processors parameter allows you to specify number of processors to use.  The default is 1.\n";
-		helpString += "The compress parameter allows you to indicate that you want the resulting distance file compressed.  The default is false.\n";
+		helpString += "The compress parameter allows you to indicate that you want the resulting distance file compressed.  The default is false. It is ignored with output=binary.\n";
 		helpString += "The dist.seqs command should be in the following format: \n";
 		helpString += "dist.seqs(fasta=yourFastaFile, calc=yourCalc, countends=yourEnds, cutoff= yourCutOff, processors=yourProcessors) \n";
 		helpString += "Example dist.seqs(fasta=amazon.fasta, calc=eachgap, countends=F, cutoff= 2.0, processors=3).\n";
@@ -66,6 +67,7 @@ string DistanceCommand::getOutputPattern(string type) {
         
         if (type == "phylip") {  pattern = "[filename],[outputtag],dist"; } 
         else if (type == "column") { pattern = "[filename],dist"; }
+        else if (type == "binary") { pattern = "[filename],bdist"; }
         else { m->mothurOut("[ERROR]: No definition for type " + type + " output pattern.\n"); m->control_pressed = true;  }
         
         return pattern;
@@ -83,6 +85,7 @@ DistanceCommand::DistanceCommand(){
 		vector<string> tempOutNames;
 		outputTypes["phylip"] = tempOutNames;
 		outputTypes["column"] = tempOutNames;
+		outputTypes["binary"] = tempOutNames;
 	}
 	catch(exception& e) {
 		m->errorOut(e, "DistanceCommand", "DistanceCommand");
@@ -117,6 +120,7 @@ DistanceCommand::DistanceCommand(string option) {
 			vector<string> tempOutNames;
 			outputTypes["phylip"] = tempOutNames;
 			outputTypes["column"] = tempOutNames;
+			outputTypes["binary"] = tempOutNames;
 		
 			//if the user changes the input directory command factory will send this info to us in the output parameter 
 			string inputDir = validParameter.validFile(parameters, "inputdir", false);		
@@ -148,6 +152,8 @@ DistanceCommand::DistanceCommand(string option) {
 				}
 			}
 
+			Profiler::getInstance()->startPhase("read");
+			
 			//check for required parameters
 			fastafile = validParameter.validFile(parameters, "fasta", true);
 			if (fastafile == "not found") { 				
@@ -212,7 +218,14 @@ DistanceCommand::DistanceCommand(string option) {
 			
 			if ((column != "") && (oldfastafile != "") && (output != "column")) { m->mothurOut("You have provided column and oldfasta, indicating you want to append distances to your column file. Your output must be in column format to do so."); m->mothurOutEndLine(); abort=true; }
 			
-			if ((output != "column") && (output != "lt") && (output != "square")) { m->mothurOut(output + " is not a valid output form. Options are column, lt and square. I will use column."); m->mothurOutEndLine(); output = "column"; }
+			if ((output != "column") && (output != "lt") && (output != "square") && (output != "binary")) { m->mothurOut(output + " is not a valid output form. Options are column, lt, square and binary. I will use column."); m->mothurOutEndLine(); output = "column"; }
+            
+            #ifdef USE_MPI
+            if (output == "binary") { m->mothurOut("The binary output is not available with MPI. I will use column."); m->mothurOutEndLine(); output = "column"; }
+            #endif
+            
+            //the commands that read binary distances can not read them compressed
+            if ((output == "binary") && m->isTrue(compress)) { m->mothurOut("[WARNING]: The binary output can not be compressed. I will ignore compress."); m->mothurOutEndLine(); compress = "F"; }
 
 		}
 				
@@ -244,6 +257,18 @@ int DistanceCommand::execute(){
 		
 		if (!alignDB.sameLength()) {  m->mothurOut("[ERROR]: your sequences are not the same length, aborting."); m->mothurOutEndLine(); return 0; }
 		
+		Profiler::getInstance()->startPhase("compute");
+		
+		//each sequence is compared to all the others, so it is only encoded once
+		encodedDB.resize(numSeqs);
+		for (int i = 0; i < numSeqs; i++) {
+			Sequence seq = alignDB.get(i);
+			encodedDB[i].encode(seq);
+		}
+		
+		kmerFilter = false;
+		if ((output == "column") || (output == "binary")) { setKmerFilter(); }
+		
 		string outputFile;
         
         map<string, string> variables; 
@@ -265,6 +290,10 @@ int DistanceCommand::execute(){
 			}
 			
 			m->mothurRemove(outputFile);
+		}else if (output == "binary") { //user wants binary column format
+			outputFile = getOutputFileName("binary", variables);
+			m->mothurRemove(outputFile);
+			outputTypes["binary"].push_back(outputFile);
 		}else { //assume square
 			variables["[outputtag]"] = "square";
 			outputFile = getOutputFileName("phylip", variables);
@@ -272,6 +301,22 @@ int DistanceCommand::execute(){
 			outputTypes["phylip"].push_back(outputFile);
 		}
 		
+		//the distances are compressed as they are written, unless the old distances are added to them afterwards
+		bool compressOutput = false;
+	#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+	#ifdef USE_COMPRESSION
+	#ifndef USE_MPI
+		if (m->isTrue(compress) && (oldfastafile == "")) {
+			compressOutput = true;
+			for (map<string, vector<string> >::iterator it = outputTypes.begin(); it != outputTypes.end(); it++) {
+				for (int i = 0; i < (it->second).size(); i++) { if ((it->second)[i] == outputFile) { (it->second)[i] += ".gz"; } }
+			}
+			outputFile += ".gz";
+			m->mothurRemove(outputFile);
+		}
+	#endif
+	#endif
+	#endif
 
 #ifdef USE_MPI
 		
@@ -404,19 +449,7 @@ int DistanceCommand::execute(){
         
 #else
 				
-	//#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
-		//if you don't need to fork anything
-		if(processors == 1){
-			if (output != "square") {  driver(0, numSeqs, outputFile, cutoff); }
-			else { driver(0, numSeqs, outputFile, "square");  }
-		}else{ //you have multiple processors
-			createProcesses(outputFile, numSeqs);
-		}
-	//#else
-		//ifstream inFASTA;
-		//if (output != "square") {  driver(0, numSeqs, outputFile, cutoff); }
-		//else { driver(0, numSeqs, outputFile, "square");  }
-	//#endif
+		createProcesses(outputFile, numSeqs);
 	
 #endif
 		if (m->control_pressed) { outputTypes.clear();  m->mothurRemove(outputFile); return 0; }
@@ -430,14 +463,15 @@ int DistanceCommand::execute(){
 		//if (output == "square") {  convertMatrix(outputFile); }
 		
 		ifstream fileHandle;
-		fileHandle.open(outputFile.c_str());
-		if(fileHandle) {
+		if(m->openInputFile(outputFile, fileHandle, "no error") == 0) {
 			m->gobble(fileHandle);
 			if (fileHandle.eof()) { m->mothurOut(outputFile + " is blank. This can result if there are no distances below your cutoff.");  m->mothurOutEndLine(); }
 		}
 		
 		//append the old column file to the new one
 		if ((oldfastafile != "") && (column != ""))  {
+			Profiler::getInstance()->startPhase("merge");
+			
 			//we had to rename the column file so we didnt overwrite above, but we want to keep old name
 			if (outputFile == column) { 
 				string tempcolumn = column + ".old";
@@ -484,10 +518,20 @@ int DistanceCommand::execute(){
 		m->mothurOut("It took " + toString(time(NULL) - startTime) + " seconds to calculate the distances for " + toString(numSeqs) + " sequences."); m->mothurOutEndLine();
 
 
-		if (m->isTrue(compress)) {
+		if (m->isTrue(compress) && !compressOutput) {
 			m->mothurOut("Compressing..."); m->mothurOutEndLine();
 			m->mothurOut("(Replacing " + outputFile + " with " + outputFile + ".gz)"); m->mothurOutEndLine();
+		#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+		#ifdef USE_COMPRESSION
+			m->mothurRemove(outputFile + ".gz");
+			m->appendFiles(outputFile, outputFile + ".gz");
+			m->mothurRemove(outputFile);
+		#else
 			system(("gzip -v " + outputFile).c_str());
+		#endif
+		#else
+			system(("gzip -v " + outputFile).c_str());
+		#endif
 			outputNames.push_back(outputFile + ".gz");
 		}else { outputNames.push_back(outputFile); }
 
@@ -500,169 +544,72 @@ int DistanceCommand::execute(){
 	}
 }
 /**************************************************************************************************/
+//the rows are split into blocks with about the same number of distances, several per processor so the work stays
+//balanced. The processors share alignDB, and the blocks are written in order, so the file does not depend on processors.
 void DistanceCommand::createProcesses(string filename, int numSeqs) {
 	try {
-        unsigned long long numDists = 0;
-        
-        if (output == "square") {
-            numDists = numSeqs * numSeqs;
-        }else {
-            for(int i=0;i<numSeqs;i++){
-                for(int j=0;j<i;j++){
-                    numDists++;
-                    if (numDists > processors) { break; }
-                }
-            }
-        }
-        
-        if (numDists < processors) { processors = numDists; }
-        
-        for (int i = 0; i < processors; i++) {
-            distlinePair tempLine;
-            lines.push_back(tempLine);
-            if (output != "square") {
-                lines[i].start = int (sqrt(float(i)/float(processors)) * numSeqs);
-                lines[i].end = int (sqrt(float(i+1)/float(processors)) * numSeqs);
-            }else{
-                lines[i].start = int ((float(i)/float(processors)) * numSeqs);
-                lines[i].end = int ((float(i+1)/float(processors)) * numSeqs);
-            }
-            
-        }
-
-#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
-		int process = 1;
-		processIDS.clear();
-        bool recalc = false;
-		
-		//loop through and create all the processes you want
-		while (process != processors) {
-			pid_t pid = fork();
-			
-			if (pid > 0) {
-                processIDS.push_back(pid);  //create map from line number to pid so you can append files in correct order later
-                process++;
-                if (m->debug) { m->mothurOut("[DEBUG]: parent process is saving child pid " + toString(pid) + ".\n"); }
-            }else if (pid == 0){
-				if (output != "square") {  driver(lines[process].start, lines[process].end, filename + m->mothurGetpid(process) + ".temp", cutoff); }
-				else { driver(lines[process].start, lines[process].end, filename + m->mothurGetpid(process) + ".temp", "square"); }
-				exit(0);
-			}else { 
-                m->mothurOut("[ERROR]: unable to spawn the number of processes you requested, reducing number to " + toString(process) + "\n"); processors = process;
-                for (int i = 0; i < processIDS.size(); i++) { kill (processIDS[i], SIGINT); }
-                //wait to die
-                for (int i=0;i<processIDS.size();i++) {
-                    int temp = processIDS[i];
-                    wait(&temp);
-                }
-                for (int i=0;i<processIDS.size();i++) {
-                    m->mothurRemove(filename + (toString(processIDS[i]) + ".temp"));
-                }
-                m->control_pressed = false;
-                recalc = true;
-                break;
-			}
-		}
-        
-        if (recalc) {
-            //test line, also set recalc to true.
-            //for (int i = 0; i < processIDS.size(); i++) { kill (processIDS[i], SIGINT); } for (int i=0;i<processIDS.size();i++) { int temp = processIDS[i]; wait(&temp); } for (int i=0;i<processIDS.size();i++) {m->mothurRemove(filename + (toString(processIDS[i]) + ".temp"));}m->control_pressed = false;  processors=3; m->mothurOut("[ERROR]: unable to spawn the number of processes you requested, reducing number to " + toString(processors) + "\n");
-            
-            processIDS.resize(0);
-            process = 1;
-            lines.clear();
-            
-            for (int i = 0; i < processors; i++) {
-                distlinePair tempLine;
-                lines.push_back(tempLine);
-                if (output != "square") {
-                    lines[i].start = int (sqrt(float(i)/float(processors)) * numSeqs);
-                    lines[i].end = int (sqrt(float(i+1)/float(processors)) * numSeqs);
-                }else{
-                    lines[i].start = int ((float(i)/float(processors)) * numSeqs);
-                    lines[i].end = int ((float(i+1)/float(processors)) * numSeqs);
-                }
-            }
-            
-            //loop through and create all the processes you want
-            while (process != processors) {
-                pid_t pid = fork();
-                
-                if (pid > 0) {
-                    processIDS.push_back(pid);  //create map from line number to pid so you can append files in correct order later
-                    process++;
-                    if (m->debug) { m->mothurOut("[DEBUG]: parent process is saving child pid " + toString(pid) + ".\n"); }
-                }else if (pid == 0){
-                    if (output != "square") {  driver(lines[process].start, lines[process].end, filename + m->mothurGetpid(process) + ".temp", cutoff); }
-                    else { driver(lines[process].start, lines[process].end, filename + m->mothurGetpid(process) + ".temp", "square"); }
-                    exit(0);
-                }else {
-                    m->mothurOut("[ERROR]: unable to spawn the necessary processes. Error code: " + toString(pid)); m->mothurOutEndLine();
-                    perror(" : ");
-                    for (int i=0;i<processIDS.size();i++) {  int temp = processIDS[i]; kill (temp, SIGINT); }
-                    exit(0);
-                }
-            }
-        }
-		
-		//parent does its part
-		if (output != "square") {  driver(lines[0].start, lines[0].end, filename, cutoff); }
-		else { driver(lines[0].start, lines[0].end, filename, "square"); }
-		
-		
-		//force parent to wait until all the processes are done
-		for (int i=0;i<processIDS.size();i++) { 
-			int temp = processIDS[i];
-			wait(&temp);
-		}
-#else
-		//////////////////////////////////////////////////////////////////////////////////////////////////////
-		//Windows version shared memory, so be careful when passing variables through the distanceData struct. 
-		//Above fork() will clone, so memory is separate, but that's not the case with windows, 
-		//that's why the distance calculator was moved inside of the driver to make separate copies.
-		//////////////////////////////////////////////////////////////////////////////////////////////////////
-		
-		vector<distanceData*> pDataArray; //[processors-1];
-		DWORD   dwThreadIdArray[processors-1];
-		HANDLE  hThreadArray[processors-1]; 
-		
-		//Create processor-1 worker threads.
-		for( int i=0; i<processors-1; i++ ){
-			
-			// Allocate memory for thread data.
-			distanceData* tempDist = new distanceData(lines[i+1].start, lines[i+1].end, (filename + toString(i) + ".temp"), cutoff, alignDB, Estimators, m, output, numNewFasta, countends);
-			pDataArray.push_back(tempDist);
-			processIDS.push_back(i);
-			
-			//MyDistThreadFunction is in header. It must be global or static to work with the threads.
-			//default security attributes, thread function name, argument to thread function, use default creation flags, returns the thread identifier
-			hThreadArray[i] = CreateThread(NULL, 0, MyDistThreadFunction, pDataArray[i], 0, &dwThreadIdArray[i]);   
+		ofstream outFile;
+		if (output == "binary") { m->openOutputFileBinary(filename, outFile); }
+		else { m->openOutputFile(filename, outFile); }
+		
+		if ((output == "lt") || (output == "square")) {	outFile << alignDB.getNumSeqs() << endl;	}
+		else if (output == "binary") {
+			vector<string> names;
+			for (int i = 0; i < alignDB.getNumSeqs(); i++) { names.push_back(alignDB.get(i).getName()); }
+			BinaryDistFile::writeHeader(outFile, names);
 		}
 		
-		//do your part
-		if (output != "square") {  driver(lines[0].start, lines[0].end, filename, cutoff); }
-		else { driver(lines[0].start, lines[0].end, filename, "square"); }
+		vector<ostream*> files; files.push_back(&outFile);
+		OutputSink sink(files, false);
 		
-		//Wait until all threads have terminated.
-		WaitForMultipleObjects(processors-1, hThreadArray, TRUE, INFINITE);
+		ThreadPool pool(processors);
 		
-		//Close all thread handles and free memory allocations.
-		for(int i=0; i < pDataArray.size(); i++){
-            if (pDataArray[i]->count != (pDataArray[i]->endLine-pDataArray[i]->startLine)) {
-                m->mothurOut("[ERROR]: process " + toString(i) + " only processed " + toString(pDataArray[i]->count) + " of " + toString(pDataArray[i]->endLine-pDataArray[i]->startLine) + " sequences assigned to it, quitting. \n"); m->control_pressed = true; 
-            }
-			CloseHandle(hThreadArray[i]);
-			delete pDataArray[i];
-		}
-#endif
+		//each processor needs its own calculator
+		vector<Dist*> distCalculators;
+		for (int i = 0; i < pool.getNumProcessors(); i++) { distCalculators.push_back(getCalculator()); }
+		
+		//the distances above the cutoff are not written to column or binary files, so they do not need to be finished
+		if ((output == "column") || (output == "binary")) { for (int i = 0; i < distCalculators.size(); i++) { distCalculators[i]->setCutoff(cutoff); } }
 		
-		//append and remove temp files
-		for (int i=0;i<processIDS.size();i++) {
-            if (m->debug) { m->mothurOut("[DEBUG]: parent process is appending child pid " + toString(processIDS[i]) + ".\n"); }
-			m->appendFiles((filename + toString(processIDS[i]) + ".temp"), filename);
-			m->mothurRemove((filename + toString(processIDS[i]) + ".temp"));
+		progressStart = time(NULL);
+		
+		int numBlocks = pool.getNumProcessors() * 50;
+		if (numBlocks > numSeqs) { numBlocks = numSeqs; }
+		
+		for (int i = 0; i < numBlocks; i++) {
+			if (m->control_pressed) { break; }
+			
+			int startLine, endLine;
+			if (output != "square") {
+				startLine = int (sqrt(float(i)/float(numBlocks)) * numSeqs);
+				endLine = int (sqrt(float(i+1)/float(numBlocks)) * numSeqs);
+			}else{
+				startLine = int ((float(i)/float(numBlocks)) * numSeqs);
+				endLine = int ((float(i+1)/float(numBlocks)) * numSeqs);
+			}
+			if (i == (numBlocks-1)) { endLine = numSeqs; }
+			
+			pool.submit([this, i, startLine, endLine, &distCalculators, &sink](int processor) {
+				ostringstream out;
+				out.setf(ios::fixed, ios::showpoint);
+				out << setprecision(4);
+				
+				if (output != "square") {  driver(startLine, endLine, out, distCalculators[processor], cutoff); }
+				else { driver(startLine, endLine, out, distCalculators[processor], "square"); }
+				
+				vector<string> blockOutput; blockOutput.push_back(out.str());
+				sink.write(i, blockOutput, endLine-startLine);
+			});
+			
+			//keeps the number of blocks in memory bounded, the ones running and the ones waiting to be written
+			pool.waitForSlot(pool.getNumProcessors() * 2, &sink);
 		}
+		pool.wait();
 		
+		m->mothurOutJustToScreen(toString(numSeqs-1) + "\t" + toString(time(NULL) - progressStart)+"\n");
+		
+		for (int i = 0; i < distCalculators.size(); i++) { delete distCalculators[i]; }
+		outFile.close();
 	}
 	catch(exception& e) {
 		m->errorOut(e, "DistanceCommand", "createProcesses");
@@ -670,8 +617,7 @@ void DistanceCommand::createProcesses(string filename, int numSeqs) {
 	}
 }
 /**************************************************************************************************/
-/////// need to fix to work with calcs and sequencedb
-int DistanceCommand::driver(int startLine, int endLine, string dFileName, float cutoff){
+Dist* DistanceCommand::getCalculator(){
 	try {
 		ValidCalculators validCalculator;
 		Dist* distCalculator;
@@ -693,16 +639,83 @@ int DistanceCommand::driver(int startLine, int endLine, string dFileName, float
 			}
 		}
 		
-		int startTime = time(NULL);
+		return distCalculator;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "DistanceCommand", "getCalculator");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//A kmer of one sequence that does not touch a difference in the alignment is also in the other sequence, and each
+//difference touches at most kmerSize kmers. With calc=eachgap and countends=T every gap column is a difference and the
+//length is at most the bases of one sequence plus the differences, so a sequence of n bases within the cutoff c of
+//another shares at least n - kmerSize + 1 - kmerSize * c * n / (1 - c) of its kmers with it. The other calculators
+//count a run of gaps once or not at all, so a pair can be within the cutoff and share few kmers, and are not filtered.
+void DistanceCommand::setKmerFilter() {
+	try {
+		kmerFilter = false;
+		kmerSize = 7;
+		if (cutoff >= 1.0) { return; }
+		
+		Dist* test = getCalculator();
+		bool eachGap = (dynamic_cast<eachGapDist*>(test) != NULL);
+		delete test;
+		if (!eachGap) { return; }
+		
+		kmerFilter = true;
+		double slack = cutoff + 0.000001; //so rounding the distance never puts a pair the filter skipped within the cutoff
+		Kmer kmer(kmerSize);
+		
+		seqKmers.resize(alignDB.getNumSeqs());
+		kmerThresholds.resize(alignDB.getNumSeqs(), 0);
+		for (int i = 0; i < alignDB.getNumSeqs(); i++) {
+			if (m->control_pressed) { break; }
+			
+			string unaligned = alignDB.get(i).getUnaligned();
+			int numBases = unaligned.length();
+			kmer.getKmerNumbers(unaligned, seqKmers[i]);
+			kmerThresholds[i] = numBases - kmerSize + 1 - kmerSize * slack * numBases / (1.0 - slack);
+		}
+	}
+	catch(exception& e) {
+		m->errorOut(e, "DistanceCommand", "setKmerFilter");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//rowKmers are the kmers in sequence i
+bool DistanceCommand::beyondKmerCutoff(vector<bool>& rowKmers, int i, int j) {
+	try {
+		const EncodedSequence& seqI = encodedDB[i];
+		const EncodedSequence& seqJ = encodedDB[j];
 		
-		//column file
-		ofstream outFile(dFileName.c_str(), ios::trunc);
-		outFile.setf(ios::fixed, ios::showpoint);
-		outFile << setprecision(4);
+		//the bound needs the calculator to compare all the bases of both sequences. It stops at a column of '.'s in
+		//both, so the sequences must overlap and only have '.'s at their ends
+		if (!seqI.isEncoded() || !seqJ.isEncoded() || seqI.hasInteriorDots() || seqJ.hasInteriorDots()) { return false; }
+		if ((seqJ.getFirstResidue() > seqI.getLastResidue() + 1) || (seqI.getFirstResidue() > seqJ.getLastResidue() + 1)) { return false; }
 		
-		if((output == "lt") && startLine == 0){	outFile << alignDB.getNumSeqs() << endl;	}
+		int shared = 0;
+		const vector<int>& kmers = seqKmers[j];
+		for (int k = 0; k < kmers.size(); k++) { if (rowKmers[kmers[k]]) { shared++; } }
+		
+		return (shared < kmerThresholds[j]);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "DistanceCommand", "beyondKmerCutoff");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//several processors run driver at once, so it only reads from the command and alignDB
+int DistanceCommand::driver(int startLine, int endLine, ostream& outFile, Dist* distCalculator, float cutoff){
+	try {
+		vector<bool> rowKmers;
+		if (kmerFilter) { rowKmers.resize((int)pow(4.0, (double)kmerSize) + 1, false); }
 		
 		for(int i=startLine;i<endLine;i++){
+			if (kmerFilter) { for (int k = 0; k < seqKmers[i].size(); k++) { rowKmers[seqKmers[i][k]] = true; } }
+			
 			if(output == "lt")	{	
 				string name = alignDB.get(i).getName();
 				if (name.length() < 10) { //pad with spaces to make compatible
@@ -712,32 +725,33 @@ int DistanceCommand::driver(int startLine, int endLine, string dFileName, float
 			}
 			for(int j=0;j<i;j++){
 				
-				if (m->control_pressed) { delete distCalculator; outFile.close(); return 0;  }
+				if (m->control_pressed) { return 0;  }
                 
 				//if there was a column file given and we are appending, we don't want to calculate the distances that are already in the column file
 				//the alignDB contains the new sequences and then the old, so if i an oldsequence and j is an old sequence then break out of this loop
 				if ((i >= numNewFasta) && (j >= numNewFasta)) { break; }
 				
-				distCalculator->calcDist(alignDB.get(i), alignDB.get(j));
+				if (kmerFilter && beyondKmerCutoff(rowKmers, i, j)) { continue; }
+				
+				distCalculator->calcDist(encodedDB[i], encodedDB[j]);
 				double dist = distCalculator->getDist();
 				
 				if(dist <= cutoff){
 					if (output == "column") { outFile << alignDB.get(i).getName() << ' ' << alignDB.get(j).getName() << ' ' << dist << endl; }
+					else if (output == "binary") { BinaryDistFile::writeDist(outFile, i, j, dist); }
 				}
                 if (output == "lt") {  outFile  << '\t' << dist; }
 			}
 			
 			if (output == "lt") { outFile << endl; }
+			
+			if (kmerFilter) { for (int k = 0; k < seqKmers[i].size(); k++) { rowKmers[seqKmers[i][k]] = false; } }
             
             if(i % 100 == 0){
-				m->mothurOutJustToScreen(toString(i) + "\t" + toString(time(NULL) - startTime)+"\n"); 
+				m->mothurOutJustToScreen(toString(i) + "\t" + toString(time(NULL) - progressStart)+"\n"); 
 			}
 			
 		}
-		m->mothurOutJustToScreen(toString(endLine-1) + "\t" + toString(time(NULL) - startTime)+"\n");
-		
-		outFile.close();
-		delete distCalculator;
 		
 		return 1;
 	}
@@ -747,38 +761,8 @@ int DistanceCommand::driver(int startLine, int endLine, string dFileName, float
 	}
 }
 /**************************************************************************************************/
-/////// need to fix to work with calcs and sequencedb
-int DistanceCommand::driver(int startLine, int endLine, string dFileName, string square){
+int DistanceCommand::driver(int startLine, int endLine, ostream& outFile, Dist* distCalculator, string square){
 	try {
-		ValidCalculators validCalculator;
-		Dist* distCalculator;
-		if (m->isTrue(countends) == true) {
-			for (int i=0; i<Estimators.size(); i++) {
-				if (validCalculator.isValidCalculator("distance", Estimators[i]) == true) { 
-					if (Estimators[i] == "nogaps")			{	distCalculator = new ignoreGaps();	}
-					else if (Estimators[i] == "eachgap")	{	distCalculator = new eachGapDist();	}
-					else if (Estimators[i] == "onegap")		{	distCalculator = new oneGapDist();	}
-				}
-			}
-		}else {
-			for (int i=0; i<Estimators.size(); i++) {
-				if (validCalculator.isValidCalculator("distance", Estimators[i]) == true) { 
-					if (Estimators[i] == "nogaps")		{	distCalculator = new ignoreGaps();					}
-					else if (Estimators[i] == "eachgap"){	distCalculator = new eachGapIgnoreTermGapDist();	}
-					else if (Estimators[i] == "onegap")	{	distCalculator = new oneGapIgnoreTermGapDist();		}
-				}
-			}
-		}
-		
-		int startTime = time(NULL);
-		
-		//column file
-		ofstream outFile(dFileName.c_str(), ios::trunc);
-		outFile.setf(ios::fixed, ios::showpoint);
-		outFile << setprecision(4);
-		
-		if(startLine == 0){	outFile << alignDB.getNumSeqs() << endl;	}
-		
 		for(int i=startLine;i<endLine;i++){
 				
 			string name = alignDB.get(i).getName();
@@ -789,9 +773,9 @@ int DistanceCommand::driver(int startLine, int endLine, string dFileName, string
 			
 			for(int j=0;j<alignDB.getNumSeqs();j++){
 				
-				if (m->control_pressed) { delete distCalculator; outFile.close(); return 0;  }
+				if (m->control_pressed) { return 0;  }
 				
-				distCalculator->calcDist(alignDB.get(i), alignDB.get(j));
+				distCalculator->calcDist(encodedDB[i], encodedDB[j]);
 				double dist = distCalculator->getDist();
 				
 				outFile << dist << '\t'; 
@@ -800,14 +784,10 @@ int DistanceCommand::driver(int startLine, int endLine, string dFileName, string
 			outFile << endl; 
 			
 			if(i % 100 == 0){
-				m->mothurOutJustToScreen(toString(i) + "\t" + toString(time(NULL) - startTime)+"\n");
+				m->mothurOutJustToScreen(toString(i) + "\t" + toString(time(NULL) - progressStart)+"\n");
 			}
 			
 		}
-		m->mothurOutJustToScreen(toString(endLine-1) + "\t" + toString(time(NULL) - startTime)+"\n");
-		
-		outFile.close();
-		delete distCalculator;
 		
 		return 1;
 	}
@@ -843,12 +823,19 @@ int DistanceCommand::driverMPI(int startLine, int endLine, MPI_File& outMPI, flo
 		}
 		
 		
+		distCalculator->setCutoff(cutoff);
+		
+		vector<bool> rowKmers;
+		if (kmerFilter) { rowKmers.resize((int)pow(4.0, (double)kmerSize) + 1, false); }
+		
 		MPI_Status status;
 		int startTime = time(NULL);
 		
 		string outputString = "";
 		
 		for(int i=startLine;i<endLine;i++){
+			
+			if (kmerFilter) { for (int k = 0; k < seqKmers[i].size(); k++) { rowKmers[seqKmers[i][k]] = true; } }
 	
 			for(int j=0;j<i;j++){
 				
@@ -858,7 +845,9 @@ int DistanceCommand::driverMPI(int startLine, int endLine, MPI_File& outMPI, flo
 				//the alignDB contains the new sequences and then the old, so if i an oldsequence and j is an old sequence then break out of this loop
 				if ((i >= numNewFasta) && (j >= numNewFasta)) { break; }
 				
-				distCalculator->calcDist(alignDB.get(i), alignDB.get(j));
+				if (kmerFilter && beyondKmerCutoff(rowKmers, i, j)) { continue; }
+				
+				distCalculator->calcDist(encodedDB[i], encodedDB[j]);
 				double dist = distCalculator->getDist();
 				
 				if(dist <= cutoff){
@@ -866,6 +855,8 @@ int DistanceCommand::driverMPI(int startLine, int endLine, MPI_File& outMPI, flo
 				}
 			}
 			
+			if (kmerFilter) { for (int k = 0; k < seqKmers[i].size(); k++) { rowKmers[seqKmers[i][k]] = false; } }
+			
 			if(i % 100 == 0){
 				m->mothurOutJustToScreen(toString(i) + "\t" + toString(time(NULL) - startTime)+"\n"); 
 			}
@@ -950,7 +941,7 @@ int DistanceCommand::driverMPI(int startLine, int endLine, string file, unsigned
 				
 				if (m->control_pressed) { delete distCalculator; return 0;  }
 				
-				distCalculator->calcDist(alignDB.get(i), alignDB.get(j));
+				distCalculator->calcDist(encodedDB[i], encodedDB[j]);
 				double dist = distCalculator->getDist();
 				
 				outputString += "\t" + toString(dist);
@@ -1043,7 +1034,7 @@ int DistanceCommand::driverMPI(int startLine, int endLine, string file, unsigned
 				
 				if (m->control_pressed) { delete distCalculator; return 0;  }
 				
-				distCalculator->calcDist(alignDB.get(i), alignDB.get(j));
+				distCalculator->calcDist(encodedDB[i], encodedDB[j]);
 				double dist = distCalculator->getDist();
 				
 				outputString += "\t" + toString(dist);
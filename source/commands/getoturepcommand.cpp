@@ -666,13 +666,10 @@ int GetOTURepCommand::readDist() {
 		//list bin 0 = first name read in distance matrix, list bin 1 = second name read in distance matrix
 		if (list != NULL) {
 			vector<string> names;
-			string binnames;
+			SeqNameTable* nameTable = SeqNameTable::getInstance();
 			//map names to rows in sparsematrix
 			for (int i = 0; i < list->size(); i++) {
-				names.clear();
-				binnames = list->get(i);
-				
-				m->splitAtComma(binnames, names);
+				nameTable->getNames(list->getIds(i), names);
 				
 				for (int j = 0; j < names.size(); j++) {
 					nameToIndex[names[j]] = i;
@@ -997,9 +994,8 @@ int GetOTURepCommand::process(ListVector* processList) {
 				return 0; 
 			}
 			
-			string temp = processList->get(i);
 			vector<string> namesInBin;
-			m->splitAtComma(temp, namesInBin);
+			SeqNameTable::getInstance()->getNames(processList->getIds(i), namesInBin);
 			
 			if (Groups.size() == 0) {
 				nameRep = findRep(namesInBin, "");
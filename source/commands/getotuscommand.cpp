@@ -374,36 +374,24 @@ int GetOtusCommand::processList(ListVector*& list, GroupMap*& groupMap, ofstream
 			if (m->control_pressed) { return 0; }
 			
 			//parse out names that are in accnos file
-			string binnames = list->get(i);
+			vector<int> binIds = list->getIds(i);
+			vector<string> names;
+			SeqNameTable::getInstance()->getNames(binIds, names);
 			
 			bool keepBin = false;
 			string groupFileOutput = "";
 			
-			//parse names
-			string individual = "";
-			int length = binnames.length();
-			for(int j=0;j<length;j++){
-				if(binnames[j] == ','){
-					string group = groupMap->getGroup(individual);
-					if (group == "not found") { m->mothurOut("[ERROR]: " + individual + " is not in your groupfile. please correct."); m->mothurOutEndLine(); group = "NOTFOUND"; }
-					
-					if (m->inUsersGroups(group, Groups)) {  keepBin = true; }
-					groupFileOutput += individual + "\t" + group + "\n";
-					individual = "";	
-					
-				}
-				else{  individual += binnames[j];  }
+			for(int j=0;j<names.size();j++){
+				string group = groupMap->getGroup(names[j]);
+				if (group == "not found") { m->mothurOut("[ERROR]: " + names[j] + " is not in your groupfile. please correct."); m->mothurOutEndLine(); group = "NOTFOUND"; }
+				
+				if (m->inUsersGroups(group, Groups)) {  keepBin = true; }
+				groupFileOutput += names[j] + "\t" + group + "\n";
 			}
 			
-			string group = groupMap->getGroup(individual);
-			if (group == "not found") { m->mothurOut("[ERROR]: " + individual + " is not in your groupfile. please correct."); m->mothurOutEndLine(); group = "NOTFOUND"; }
-			
-			if (m->inUsersGroups(group, Groups)) {  keepBin = true; }
-			groupFileOutput += individual + "\t" + group + "\n";
-			
 			//if there are sequences from the groups we want in this bin add to new list, output to groupfile
 			if (keepBin) {  
-				newList.push_back(binnames);
+				newList.push_back(binIds);
                 newBinLabels.push_back(binLabels[i]);
 				outGroup << groupFileOutput;
 				numOtus++;
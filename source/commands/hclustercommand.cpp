@@ -22,6 +22,8 @@ vector<string> HClusterCommand::setParameters(){
 		CommandParameter psorted("sorted", "Boolean", "", "F", "", "", "","",false,false); parameters.push_back(psorted);
 		CommandParameter pshowabund("showabund", "Boolean", "", "T", "", "", "","",false,false); parameters.push_back(pshowabund);
 		CommandParameter ptiming("timing", "Boolean", "", "F", "", "", "","",false,false); parameters.push_back(ptiming);		
+		CommandParameter pprocessors("processors", "Number", "", "1", "", "", "","",false,false,true); parameters.push_back(pprocessors);
+		CommandParameter psortmemory("sortmemory", "Number", "", "512", "", "", "","",false,false); parameters.push_back(psortmemory);
 		CommandParameter pseed("seed", "Number", "", "0", "", "", "","",false,false); parameters.push_back(pseed);
         CommandParameter pinputdir("inputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(pinputdir);
 		CommandParameter poutputdir("outputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(poutputdir);
@@ -39,9 +41,11 @@ vector<string> HClusterCommand::setParameters(){
 string HClusterCommand::getHelpString(){	
 	try {
 		string helpString = "";
-		helpString += "The hcluster command parameter options are cutoff, precision, method, phylip, column, name, showabund, timing and sorted. Phylip or column and name are required, unless you have valid current files.\n";
+		helpString += "The hcluster command parameter options are cutoff, precision, method, phylip, column, name, showabund, timing, sorted, processors and sortmemory. Phylip or column and name are required, unless you have valid current files.\n";
 		helpString += "The phylip and column parameter allow you to enter your distance file, and sorted indicates whether your column distance file is already sorted. \n";
 		helpString += "The name parameter allows you to enter your name file and is required if your distance file is in column format. \n";
+		helpString += "The column parameter also accepts the binary distance file created by dist.seqs output=binary, which is converted to a sorted column file. \n";
+		helpString += "The processors and sortmemory parameters set the number of processors and the megabytes of memory used to sort the column file. The defaults are 1 and 512.\n";
 		helpString += "The hcluster command should be in the following format: \n";
 		helpString += "hcluster(column=youDistanceFile, name=yourNameFile, method=yourMethod, cutoff=yourCutoff, precision=yourPrecision) \n";
 		helpString += "The acceptable hcluster methods are furthest, nearest, weighted and average.\n";	
@@ -159,7 +163,11 @@ HClusterCommand::HClusterCommand(string option)  {
 			columnfile = validParameter.validFile(parameters, "column", true);
 			if (columnfile == "not open") { abort = true; }	
 			else if (columnfile == "not found") { columnfile = ""; }
-			else {  distfile = columnfile; format = "column";	m->setColumnFile(columnfile); }
+			else {  
+				distfile = columnfile; format = "column";	
+				if (BinaryDistFile::isBinary(columnfile)) { format = "binary"; } //created by dist.seqs output=binary
+				else { m->setColumnFile(columnfile); }
+			}
 			
 			namefile = validParameter.validFile(parameters, "name", true);
 			if (namefile == "not open") { abort = true; }	
@@ -182,7 +190,7 @@ HClusterCommand::HClusterCommand(string option)  {
 			}
 			else if ((phylipfile != "") && (columnfile != "")) { m->mothurOut("When executing a hcluster command you must enter ONLY ONE of the following: phylip or column."); m->mothurOutEndLine(); abort = true; }
 		
-			if (columnfile != "") {
+			if ((columnfile != "") && (format != "binary")) { //the binary file contains the names of all the sequences
 				if (namefile == "") { 
 					namefile = m->getNameFile(); 
 					if (namefile != "") {  m->mothurOut("Using " + namefile + " as input file for the name parameter."); m->mothurOutEndLine(); }
@@ -227,6 +235,13 @@ HClusterCommand::HClusterCommand(string option)  {
 			timing = validParameter.validFile(parameters, "timing", false);
 			if (timing == "not found") { timing = "F"; }
 			
+			temp = validParameter.validFile(parameters, "processors", false);	if (temp == "not found"){	temp = m->getProcessors();	}
+			m->setProcessors(temp);
+			m->mothurConvert(temp, processors);
+			
+			temp = validParameter.validFile(parameters, "sortmemory", false);	if (temp == "not found"){	temp = "512";	}
+			m->mothurConvert(temp, sortMemory);
+			
 				
 			if (abort == false) {
 				
@@ -277,9 +292,10 @@ int HClusterCommand::execute(){
 		
 		time_t estart = time(NULL);
 		
-		if (!sorted) {
+		if ((!sorted) || (format == "binary")) {
 			read = new ReadCluster(distfile, cutoff, outputDir, true); 	
 			read->setFormat(format);
+			read->setSortOptions(processors, sortMemory);
 			read->read(nameMap);
 			
 			if (m->control_pressed) {  
@@ -59,7 +59,7 @@ private:
 	bool abort, sorted, print_start, hard;
 	string method, fileroot, tag, distfile, format, phylipfile, columnfile, namefile, sort, showabund, timing, outputDir;
 	double cutoff;
-	int precision, length;
+	int precision, length, processors, sortMemory;
 	ofstream sabundFile, rabundFile, listFile;
 	time_t start;
 	unsigned long loops;
@@ -25,6 +25,8 @@ vector<string> MGClusterCommand::setParameters(){
 		CommandParameter pmerge("merge", "Boolean", "", "T", "", "", "","",false,false); parameters.push_back(pmerge);
         CommandParameter padjust("adjust", "String", "", "F", "", "", "","",false,false); parameters.push_back(padjust);
 		CommandParameter phcluster("hcluster", "Boolean", "", "F", "", "", "","",false,false); parameters.push_back(phcluster);
+		CommandParameter pprocessors("processors", "Number", "", "1", "", "", "","",false,false,true); parameters.push_back(pprocessors);
+		CommandParameter psortmemory("sortmemory", "Number", "", "512", "", "", "","",false,false); parameters.push_back(psortmemory);
 		CommandParameter pseed("seed", "Number", "", "0", "", "", "","",false,false); parameters.push_back(pseed);
         CommandParameter pinputdir("inputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(pinputdir);
 		CommandParameter poutputdir("outputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(poutputdir);
@@ -42,7 +44,7 @@ vector<string> MGClusterCommand::setParameters(){
 string MGClusterCommand::getHelpString(){	
 	try {
 		string helpString = "";
-		helpString += "The mgcluster command parameter options are blast, name, cutoff, precision, hard,  method, merge, min, length, penalty, adjust and hcluster. The blast parameter is required.\n";
+		helpString += "The mgcluster command parameter options are blast, name, cutoff, precision, hard,  method, merge, min, length, penalty, adjust, hcluster, processors and sortmemory. The blast parameter is required.\n";
 		helpString += "The mgcluster command reads a blast and name file and clusters the sequences into OPF units similar to the OTUs.\n";
 		helpString += "This command outputs a .list, .rabund and .sabund file that can be used with mothur other commands to estimate richness.\n";
 		helpString += "The cutoff parameter is used to specify the maximum distance you would like to cluster to. The default is 0.70.\n";
@@ -54,6 +56,7 @@ string MGClusterCommand::getHelpString(){
 		helpString += "The penalty parameter is used to adjust the error rate.  The default is 0.10.\n";
 		helpString += "The merge parameter allows you to shut off merging based on overlaps and just cluster.  By default merge is true, meaning you want to merge.\n";
 		helpString += "The hcluster parameter allows you to use the hcluster algorithm when clustering.  This may be necessary if your file is too large to fit into RAM. The default is false.\n";
+		helpString += "The processors and sortmemory parameters set the number of processors and the megabytes of memory used to sort the distances for the hcluster algorithm. The defaults are 1 and 512.\n";
 		helpString += "The mgcluster command should be in the following format: \n";
 		helpString += "mgcluster(blast=yourBlastfile, name=yourNameFile, cutoff=yourCutOff).\n";
 		helpString += "Note: No spaces between parameter labels (i.e. balst), '=' and parameters (i.e.yourBlastfile).\n";
@@ -215,6 +218,13 @@ MGClusterCommand::MGClusterCommand(string option) {
 			temp = validParameter.validFile(parameters, "hcluster", false);			if (temp == "not found") { temp = "false"; }
 			hclusterWanted = m->isTrue(temp); 
 			
+			temp = validParameter.validFile(parameters, "processors", false);	if (temp == "not found"){	temp = m->getProcessors();	}
+			m->setProcessors(temp);
+			m->mothurConvert(temp, processors);
+			
+			temp = validParameter.validFile(parameters, "sortmemory", false);	if (temp == "not found"){	temp = "512";	}
+			m->mothurConvert(temp, sortMemory);
+			
 			temp = validParameter.validFile(parameters, "hard", false);			if (temp == "not found") { temp = "T"; }
 			hard = m->isTrue(temp);
             
@@ -708,7 +718,7 @@ ListVector* MGClusterCommand::mergeOPFs(map<string, int> binInfo, float dist){
 					string names = newList->get(binRemove);
 		
 					//merge bins into name1s bin
-					newList->set(binKeep, newList->get(binRemove)+','+newList->get(binKeep));
+					newList->merge(binKeep, binRemove, binKeep);
 					newList->set(binRemove, "");	
 					
 					//update binInfo
@@ -739,13 +749,15 @@ ListVector* MGClusterCommand::mergeOPFs(map<string, int> binInfo, float dist){
 //**********************************************************************************************************************
 void MGClusterCommand::sortHclusterFiles(string unsortedDist, string unsortedOverlap) {
 	try {
+		DistanceSorter sorter(processors, sortMemory);
+		
 		//sort distFile
-		string sortedDistFile = m->sortFile(unsortedDist, outputDir);
+		string sortedDistFile = sorter.sortFile(unsortedDist, outputDir);
 		m->mothurRemove(unsortedDist);  //delete unsorted file
 		distFile = sortedDistFile;
 		
 		//sort overlap file
-		string sortedOverlapFile = m->sortFile(unsortedOverlap, outputDir);
+		string sortedOverlapFile = sorter.sortFile(unsortedOverlap, outputDir);
 		m->mothurRemove(unsortedOverlap);  //delete unsorted file
 		overlapFile = sortedOverlapFile;
 	}
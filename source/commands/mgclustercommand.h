@@ -18,6 +18,7 @@
 #include "rabundvector.hpp"
 #include "sabundvector.hpp"
 #include "counttable.h"
+#include "distancesorter.h"
 
 /**********************************************************************/
 
@@ -57,7 +58,7 @@ private:
 	ofstream sabundFile, rabundFile, listFile;
 	double cutoff;
 	float penalty, adjust;
-	int precision, length, precisionLength;
+	int precision, length, precisionLength, processors, sortMemory;
 	bool abort, minWanted, hclusterWanted, merge, hard, cutoffSet;
 	
 	void printData(ListVector*, map<string, int>&);
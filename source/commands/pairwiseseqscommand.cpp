@@ -724,7 +724,8 @@ int PairwiseSeqsCommand::driver(int startLine, int endLine, string dFileName, fl
 				seqI.setAligned(alignment->getSeqAAln());
 				seqJ.setAligned(alignment->getSeqBAln());
                 
-				distCalculator->calcDist(seqI, seqJ);
+				EncodedSequence encodedI(seqI), encodedJ(seqJ);
+				distCalculator->calcDist(encodedI, encodedJ);
 				double dist = distCalculator->getDist();
                 
                 if (m->debug) { m->mothurOut("[DEBUG]: " + seqI.getName() + '\t' +  alignment->getSeqAAln() + '\n' + seqJ.getName() + alignment->getSeqBAln() + '\n' + "distance = " + toString(dist) + "\n"); }
@@ -823,7 +824,8 @@ int PairwiseSeqsCommand::driver(int startLine, int endLine, string dFileName, st
 				seqI.setAligned(alignment->getSeqAAln());
 				seqJ.setAligned(alignment->getSeqBAln());
 				
-				distCalculator->calcDist(seqI, seqJ);
+				EncodedSequence encodedI(seqI), encodedJ(seqJ);
+				distCalculator->calcDist(encodedI, encodedJ);
 				double dist = distCalculator->getDist();
 								
 				outFile << '\t' << dist;
@@ -909,7 +911,8 @@ int PairwiseSeqsCommand::driverMPI(int startLine, int endLine, MPI_File& outMPI,
 				seqI.setAligned(alignment->getSeqAAln());
 				seqJ.setAligned(alignment->getSeqBAln());
 				
-				distCalculator->calcDist(seqI, seqJ);
+				EncodedSequence encodedI(seqI), encodedJ(seqJ);
+				distCalculator->calcDist(encodedI, encodedJ);
 				double dist = distCalculator->getDist();
                 
                 if (m->debug) { cout << ("[DEBUG]: " + seqI.getName() + '\t' +  alignment->getSeqAAln() + '\n' + seqJ.getName() + alignment->getSeqBAln() + '\n' + "distance = " + toString(dist) + "\n"); }
@@ -1019,7 +1022,8 @@ int PairwiseSeqsCommand::driverMPI(int startLine, int endLine, string file, unsi
 				seqI.setAligned(alignment->getSeqAAln());
 				seqJ.setAligned(alignment->getSeqBAln());
 				
-				distCalculator->calcDist(seqI, seqJ);
+				EncodedSequence encodedI(seqI), encodedJ(seqJ);
+				distCalculator->calcDist(encodedI, encodedJ);
 				double dist = distCalculator->getDist();
                 
                 if (m->debug) { cout << ("[DEBUG]: " + seqI.getName() + '\t' +  alignment->getSeqAAln() + '\n' + seqJ.getName() + alignment->getSeqBAln() + '\n' + "distance = " + toString(dist) + "\n"); }
@@ -1124,7 +1128,8 @@ int PairwiseSeqsCommand::driverMPI(int startLine, int endLine, string file, unsi
 				seqI.setAligned(alignment->getSeqAAln());
 				seqJ.setAligned(alignment->getSeqBAln());
 				
-				distCalculator->calcDist(seqI, seqJ);
+				EncodedSequence encodedI(seqI), encodedJ(seqJ);
+				distCalculator->calcDist(encodedI, encodedJ);
 				double dist = distCalculator->getDist();
 				
 				outputString +=  + "\t" + toString(dist);
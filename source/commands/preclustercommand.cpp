@@ -664,6 +664,14 @@ int PreClusterCommand::process(string newMapFile){
 		int count = 0;
 		int numSeqs = alignSeqs.size();
 		
+		//aligned seqs are only compared to the seqs that can be within diffs of them
+		MisMatchIndex* index = NULL;
+		if (method == "aligned") {
+			vector<string> seqs;
+			for (int i = 0; i < numSeqs; i++) { seqs.push_back(alignSeqs[i].seq.getAligned()); }
+			index = new MisMatchIndex(seqs, diffs);
+		}
+		
         if (topdown) {
             //think about running through twice...
             for (int i = 0; i < numSeqs; i++) {
@@ -673,13 +681,15 @@ int PreClusterCommand::process(string newMapFile){
                     string chunk = alignSeqs[i].seq.getName() + "\t" + toString(alignSeqs[i].numIdentical) + "\t" + toString(0) + "\t" + alignSeqs[i].seq.getAligned() + "\n";
                     
                     //try to merge it with all smaller seqs
-                    for (int j = i+1; j < numSeqs; j++) {
+                    vector<int> candidates = getCandidates(index, i);
+                    for (int k = 0; k < candidates.size(); k++) {
+                        int j = candidates[k];
                         
-                        if (m->control_pressed) { out.close(); return 0; }
+                        if (m->control_pressed) { delete index; out.close(); return 0; }
                         
                         if (alignSeqs[j].active) {  //this sequence has not been merged yet
                             //are you within "diff" bases
-                            int mismatch = calcMisMatches(alignSeqs[i].seq.getAligned(), alignSeqs[j].seq.getAligned());
+                            int mismatch = getMisMatches(index, i, j);
                             
                             if (mismatch <= diffs) {
                                 //merge
@@ -705,21 +715,22 @@ int PreClusterCommand::process(string newMapFile){
             }
         }else {
             map<int, string> mapFile;
-            map<int, int> originalCount;
-            map<int, int>::iterator itCount;
+            vector<int> originalCount(numSeqs, 0); //0 once merged
             for (int i = 0; i < numSeqs; i++) { mapFile[i] = ""; originalCount[i] = alignSeqs[i].numIdentical; }
             
             //think about running through twice...
             for (int i = 0; i < numSeqs; i++) {
                 
                 //try to merge it into larger seqs
-                for (int j = i+1; j < numSeqs; j++) {
+                vector<int> candidates = getCandidates(index, i);
+                for (int k = 0; k < candidates.size(); k++) {
+                    int j = candidates[k];
                     
-                    if (m->control_pressed) { out.close(); return 0; }
+                    if (m->control_pressed) { delete index; out.close(); return 0; }
                     
                     if (originalCount[j] > originalCount[i]) {  //this sequence is more abundant than I am
                         //are you within "diff" bases
-                        int mismatch = calcMisMatches(alignSeqs[i].seq.getAligned(), alignSeqs[j].seq.getAligned());
+                        int mismatch = getMisMatches(index, i, j);
                         
                         if (mismatch <= diffs) {
                             //merge
@@ -728,10 +739,10 @@ int PreClusterCommand::process(string newMapFile){
                             
                             mapFile[j] = alignSeqs[i].seq.getName() + "\t" + toString(alignSeqs[i].numIdentical) + "\t" + toString(mismatch) + "\t" + alignSeqs[i].seq.getAligned() + "\n" + mapFile[i];
                             alignSeqs[i].numIdentical = 0;
-                            originalCount.erase(i);
+                            originalCount[i] = 0;
                             mapFile[i] = "";
                             count++;
-                            j+=numSeqs; //exit search, we merged this one in.
+                            break; //exit search, we merged this one in.
                         }
                     }//end abundance check
                 }//end for loop j
@@ -747,6 +758,7 @@ int PreClusterCommand::process(string newMapFile){
             
         }
 		out.close();
+		delete index;
 		
 		if(numSeqs % 100 != 0)	{ m->mothurOut(toString(numSeqs) + "\t" + toString(numSeqs - count) + "\t" + toString(count)); m->mothurOutEndLine();	}	
 		
@@ -871,6 +883,36 @@ int PreClusterCommand::loadSeqs(map<string, string>& thisName, vector<Sequence>&
 	}
 }
 				
+/**************************************************************************************************/
+//the seqs after i, in order, that may be within diffs of it
+vector<int> PreClusterCommand::getCandidates(MisMatchIndex* index, int i){
+	try {
+		if (index != NULL) { return index->getCandidates(i); }
+		
+		vector<int> candidates;
+		for (int j = i+1; j < alignSeqs.size(); j++) { candidates.push_back(j); }
+		return candidates;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "PreClusterCommand", "getCandidates");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//same as calcMisMatches, length if they are more than diffs apart
+int PreClusterCommand::getMisMatches(MisMatchIndex* index, int i, int j){
+	try {
+		if (index == NULL) { return calcMisMatches(alignSeqs[i].seq.getAligned(), alignSeqs[j].seq.getAligned()); }
+		
+		int mismatch = index->countMisMatches(i, j);
+		if (mismatch > diffs) { mismatch = length; } //to far to cluster
+		return mismatch;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "PreClusterCommand", "getMisMatches");
+		exit(1);
+	}
+}
 /**************************************************************************************************/
 
 int PreClusterCommand::calcMisMatches(string seq1, string seq2){
@@ -21,6 +21,7 @@
 #include "needlemanoverlap.hpp"
 #include "blastalign.hpp"
 #include "noalign.hpp"
+#include "mismatchindex.h"
 
 
 /************************************************************/
@@ -93,6 +94,8 @@ private:
 	void readNameFile();
 	//int readNamesFASTA();
 	int calcMisMatches(string, string);
+	vector<int> getCandidates(MisMatchIndex*, int);
+	int getMisMatches(MisMatchIndex*, int, int);
 	void printData(string, string, string); //fasta filename, names file name
 	int process(string);
 	int loadSeqs(map<string, string>&, vector<Sequence>&, string);
@@ -41,6 +41,7 @@ vector<string> RareFactCommand::setParameters(){
         CommandParameter palpha("alpha", "Multiple", "0-1-2", "1", "", "", "","",false,false,true); parameters.push_back(palpha);
 		CommandParameter pprocessors("processors", "Number", "", "1", "", "", "","",false,false,true); parameters.push_back(pprocessors);
 		CommandParameter pgroupmode("groupmode", "Boolean", "", "T", "", "", "","",false,false); parameters.push_back(pgroupmode);
+		CommandParameter pmethod("method", "Multiple", "shuffle-hypergeometric-analytic", "shuffle", "", "", "","",false,false); parameters.push_back(pmethod);
 		CommandParameter pseed("seed", "Number", "", "0", "", "", "","",false,false); parameters.push_back(pseed);
         CommandParameter pinputdir("inputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(pinputdir);
 		CommandParameter poutputdir("outputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(poutputdir);
@@ -59,8 +60,9 @@ string RareFactCommand::getHelpString(){
 	try {
 		ValidCalculators validCalculator;
 		string helpString = "";
-		helpString += "The rarefaction.single command parameters are list, sabund, rabund, shared, label, iters, freq, calc, processors, groupmode and abund.  list, sabund, rabund or shared is required unless you have a valid current file. \n";
+		helpString += "The rarefaction.single command parameters are list, sabund, rabund, shared, label, iters, freq, calc, method, processors, groupmode and abund.  list, sabund, rabund or shared is required unless you have a valid current file. \n";
 		helpString += "The freq parameter is used indicate when to output your data, by default it is set to 100. But you can set it to a percentage of the number of sequence. For example freq=0.10, means 10%. \n";
+		helpString += "The method parameter allows you to choose how the curves are found. Options are shuffle, hypergeometric and analytic. The default is shuffle, which shuffles the sequences iters times. The hypergeometric method draws the sequences from the OTU abundances without listing every sequence, which is faster for large samples. The analytic method computes the expected sobs curve and its 95% confidence interval without iterations, and only supports the sobs and nseqs calculators.\n";
 		helpString += "The processors parameter allows you to specify the number of processors to use. The default is 1.\n";
 		helpString += "The rarefaction.single command should be in the following format: \n";
 		helpString += "rarefaction.single(label=yourLabel, iters=yourIters, freq=yourFreq, calc=yourEstimators).\n";
@@ -306,6 +308,16 @@ RareFactCommand::RareFactCommand(string option)  {
 			
 			temp = validParameter.validFile(parameters, "groupmode", false);		if (temp == "not found") { temp = "T"; }
 			groupMode = m->isTrue(temp);
+			
+			method = validParameter.validFile(parameters, "method", false);		if (method == "not found") { method = "shuffle"; }
+			
+			if ((method != "shuffle") && (method != "hypergeometric") && (method != "analytic")) { m->mothurOut("[ERROR]: " + method + " is not a valid method. Valid methods are shuffle, hypergeometric and analytic."); m->mothurOutEndLine(); abort=true; }
+			
+			if (method == "analytic") {
+				for (int i = 0; i < Estimators.size(); i++) {
+					if ((Estimators[i] != "sobs") && (Estimators[i] != "nseqs")) { m->mothurOut("[ERROR]: The analytic method only supports the sobs and nseqs calculators, not " + Estimators[i] + "."); m->mothurOutEndLine(); abort=true; }
+				}
+			}
 		}
 		
 	}
@@ -405,7 +417,7 @@ int RareFactCommand::execute(){
 			if (rDisplays.size() == 0) { for(int i=0;i<rDisplays.size();i++){	delete rDisplays[i];	}  return 0; }
 			
 			input = new InputData(inputFileNames[p], format);			
-			order = input->getOrderVector();
+			order = getVector("");
 			string lastLabel = order->getLabel();
 			
 			//if the users enters label "0.06" and there is no "0.06" in their file use the next lowest label.
@@ -426,7 +438,7 @@ int RareFactCommand::execute(){
                     map<string, set<int> >::iterator itEndings = labelToEnds.find(order->getLabel());
                     set<int> ends;
                     if (itEndings != labelToEnds.end()) { ends = itEndings->second; }
-					rCurve = new Rarefact(order, rDisplays, processors, ends);
+					rCurve = getRarefact(ends);
 					rCurve->getCurve(freq, nIters);
 					delete rCurve;
 					
@@ -438,13 +450,13 @@ int RareFactCommand::execute(){
 					string saveLabel = order->getLabel();
 					
 					delete order;
-					order = (input->getOrderVector(lastLabel));
+					order = getVector(lastLabel);
 					
 					m->mothurOut(order->getLabel()); m->mothurOutEndLine();
 					map<string, set<int> >::iterator itEndings = labelToEnds.find(order->getLabel());
                     set<int> ends;
                     if (itEndings != labelToEnds.end()) { ends = itEndings->second; }
-					rCurve = new Rarefact(order, rDisplays, processors, ends);
+					rCurve = getRarefact(ends);
 
 					rCurve->getCurve(freq, nIters);
 					delete rCurve;
@@ -459,7 +471,7 @@ int RareFactCommand::execute(){
 				lastLabel = order->getLabel();		
 				
 				delete order;
-				order = (input->getOrderVector());
+				order = getVector("");
 			}
 			
 			if (m->control_pressed) { for(int i=0;i<rDisplays.size();i++){	delete rDisplays[i];	}  delete input;   for (int i = 0; i < outputNames.size(); i++) {	m->mothurRemove(outputNames[i]); } return 0; }
@@ -482,13 +494,13 @@ int RareFactCommand::execute(){
 			//run last label if you need to
 			if (needToRun == true)  {
 				if (order != NULL) {	delete order;	}
-				order = (input->getOrderVector(lastLabel));
+				order = getVector(lastLabel);
 				
 				m->mothurOut(order->getLabel()); m->mothurOutEndLine();
 				map<string, set<int> >::iterator itEndings = labelToEnds.find(order->getLabel());
                 set<int> ends;
                 if (itEndings != labelToEnds.end()) { ends = itEndings->second; }
-                rCurve = new Rarefact(order, rDisplays, processors, ends);
+                rCurve = getRarefact(ends);
 
 				rCurve->getCurve(freq, nIters);
 				delete rCurve;
@@ -681,6 +693,34 @@ vector<string> RareFactCommand::createGroupFile(vector<string>& outputNames, map
 	}
 }
 //**********************************************************************************************************************
+//the hypergeometric and analytic methods only need the otu abundances, so they skip making the order vector
+DataVector* RareFactCommand::getVector(string thisLabel) {
+	try {
+		if (method == "shuffle") {
+			if (thisLabel == "") { return input->getOrderVector(); }
+			return input->getOrderVector(thisLabel);
+		}
+		
+		if (thisLabel == "") { return input->getSAbundVector(); }
+		return input->getSAbundVector(thisLabel);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "RareFactCommand", "getVector");
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
+Rarefact* RareFactCommand::getRarefact(set<int>& ends) {
+	try {
+		if (method == "shuffle") { return new Rarefact((OrderVector*)order, rDisplays, processors, ends); }
+		return new Rarefact((SAbundVector*)order, rDisplays, processors, ends, method);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "RareFactCommand", "getRarefact");
+		exit(1);
+	}
+}
+//**********************************************************************************************************************
 vector<string> RareFactCommand::parseSharedFile(string filename, map<string, set<int> >& label2Ends) {
 	try {
 		vector<string> filenames;
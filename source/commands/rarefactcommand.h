@@ -38,7 +38,7 @@ public:
 private:
 	
 	vector<Display*> rDisplays;
-	OrderVector* order;
+	DataVector* order;		//the order vector, or the sabund vector when the method does not shuffle
 	InputData* input;
 	Rarefact* rCurve;
 	int nIters, abund, processors, alpha;
@@ -46,7 +46,7 @@ private:
 	
 	bool abort, allLines, groupMode;
 	set<string> labels; //holds labels to be used
-	string label, calc, sharedfile, listfile, rabundfile, sabundfile, format, inputfile;
+	string label, calc, sharedfile, listfile, rabundfile, sabundfile, format, inputfile, method;
 	vector<string>  Estimators;
 	vector<string> inputFileNames, outputNames;
 	vector<string> groups;
@@ -54,6 +54,8 @@ private:
 	
 	vector<string> parseSharedFile(string, map<string, set<int> >&);
 	vector<string> createGroupFile(vector<string>&, map<int, string>);
+	DataVector* getVector(string);		//the label to read, "" for the next one
+	Rarefact* getRarefact(set<int>&);
 };
 
 #endif
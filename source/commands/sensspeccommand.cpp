@@ -381,23 +381,10 @@ int SensSpecCommand::fillSeqMap(map<string, int>& seqMap, ListVector*& list){
 			
 			if (m->control_pressed) { return 0; }
 			
-			string seqList = list->get(i);
-			int seqListLength = seqList.length();
-			string seqName = "";
-			
-			//parse bin by name, mapping each name to its otu number
-			for(int j=0;j<seqListLength;j++){
-				
-				if(seqList[j] == ','){
-					seqMap[seqName] = i;
-					seqName = "";
-				}
-				else{
-					seqName += seqList[j];
-				}
-				
-			}
-			seqMap[seqName] = i;
+			//map each name in the bin to its otu number
+			vector<string> names;
+			SeqNameTable::getInstance()->getNames(list->getIds(i), names);
+			for(int j=0;j<names.size();j++){ seqMap[names[j]] = i; }
 		}
 		
 		return 0;
@@ -418,8 +405,7 @@ int SensSpecCommand::fillSeqPairSet(set<string>& seqPairSet, ListVector*& list){
 			if (m->control_pressed) { return 0; }
 			
 			vector<string> seqNameVector;
-			string bin = list->get(i);
-			m->splitAtComma(bin, seqNameVector);
+			SeqNameTable::getInstance()->getNames(list->getIds(i), seqNameVector);
 			
 			numSeqs += seqNameVector.size();
 			
@@ -801,21 +787,19 @@ string SensSpecCommand::preProcessList(){
 			for (int i = 0; i < list.getNumBins(); i++) {
                 
 				//parse out names that are in accnos file
-				string binnames = list.get(i);
+				vector<int> binIds = list.getIds(i);
                 vector<string> bnames;
-                m->splitAtComma(binnames, bnames);
+                SeqNameTable::getInstance()->getNames(binIds, bnames);
 				
-				string newNames = "";
+				vector<int> newIds;
                 for (int j = 0; j < bnames.size(); j++) {
-					string name = bnames[j];
 					//if that name is in the .accnos file, add it
-					if (uniqueNames.count(name) != 0) {  newNames += name + ",";  }
+					if (uniqueNames.count(bnames[j]) != 0) {  newIds.push_back(binIds[j]);  }
 				}
                 
 				//if there are names in this bin add to new list
-				if (newNames != "") { 
-					newNames = newNames.substr(0, newNames.length()-1); //rip off extra comma
-					newList.push_back(newNames);
+				if (newIds.size() != 0) { 
+					newList.push_back(newIds);
                     newLabels.push_back(binLabels[i]);
 				}
 			}
@@ -0,0 +1,95 @@
+/*
+ *  setprofilecommand.cpp
+ *  Mothur
+ *
+ *  Copyright 2026 Schloss Lab. All rights reserved.
+ *
+ */
+
+#include "setprofilecommand.h"
+
+//**********************************************************************************************************************
+vector<string> SetProfileCommand::setParameters(){
+    try {
+        CommandParameter pprofile("profile", "Boolean", "", "T", "", "", "","",false,false); parameters.push_back(pprofile);
+        CommandParameter pinputdir("inputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(pinputdir);
+        CommandParameter poutputdir("outputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(poutputdir);
+        
+        vector<string> myArray;
+        for (int i = 0; i < parameters.size(); i++) {	myArray.push_back(parameters[i].name);		}
+        return myArray;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "SetProfileCommand", "setParameters");
+        exit(1);
+    }
+}
+//**********************************************************************************************************************
+string SetProfileCommand::getHelpString(){
+    try {
+        string helpString = "";
+        helpString += "The set.profile command reports the resources used by each of the commands that follow it.\n";
+        helpString += "The set.profile command parameter is profile. Set profile=F to stop profiling, default=T.\n";
+        helpString += "The report is a tab separated file written next to the logfile, named like the logfile with a .profile extension. You can also start mothur with the --profile option to profile every command.\n";
+        helpString += "Each command has a row with its wall time, cpu time, peak memory in KB and the bytes it read and wrote, followed by a row for each phase the command reports, such as read, compute, write or merge.\n";
+        helpString += "Example set.profile(profile=T).\n";
+        helpString += "Note: No spaces between parameter labels (i.e. profile), '=' and parameters (i.e.T).\n";
+        return helpString;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "SetProfileCommand", "getHelpString");
+        exit(1);
+    }
+}
+//**********************************************************************************************************************
+
+SetProfileCommand::SetProfileCommand(string option)  {
+    try {
+        abort = false; calledHelp = false;
+        
+        //allow user to run help
+        if(option == "help") { help(); abort = true; calledHelp = true; }
+        else if(option == "citation") { citation(); abort = true; calledHelp = true;}
+        
+        else {
+            vector<string> myArray = setParameters();
+            
+            OptionParser parser(option);
+            map<string, string> parameters = parser.getParameters();
+            
+            ValidParameters validParameter;
+            //check to make sure all parameters are valid for command
+            for (map<string,string>::iterator it = parameters.begin(); it != parameters.end(); it++) {
+                if (validParameter.isValidParameter(it->first, myArray, it->second) != true) {  abort = true;  }
+            }
+            
+            string temp = validParameter.validFile(parameters, "profile", false);
+            if (temp == "not found") { temp = "T"; }
+            profile = m->isTrue(temp);
+        }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "SetProfileCommand", "SetProfileCommand");
+        exit(1);
+    }
+}
+//**********************************************************************************************************************
+
+int SetProfileCommand::execute(){
+    try {
+        
+        if (abort == true) { if (calledHelp) { return 0; }  return 2;	}
+        
+        Profiler::getInstance()->setActive(profile);
+        
+        if (profile) { m->mothurOut("Profiling the commands that follow. The report will be written next to the logfile.\n\n"); }
+        else { m->mothurOut("Profiling stopped.\n\n"); }
+       
+        return 0;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "SetProfileCommand", "execute");
+        exit(1);
+    }
+}
+//**********************************************************************************************************************/
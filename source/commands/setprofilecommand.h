@@ -0,0 +1,43 @@
+#ifndef SETPROFILECOMMAND_H
+#define SETPROFILECOMMAND_H
+
+/*
+ *  setprofilecommand.h
+ *  Mothur
+ *
+ *  Copyright 2026 Schloss Lab. All rights reserved.
+ *
+ */
+
+#include "command.hpp"
+#include "profiler.h"
+
+/**********************************************************/
+
+class SetProfileCommand : public Command {
+    
+public:
+    SetProfileCommand(string);
+    SetProfileCommand() { abort = true; calledHelp = true; setParameters(); }
+    ~SetProfileCommand(){}
+    
+    vector<string> setParameters();
+    string getCommandName()			{ return "set.profile";		}
+    string getCommandCategory()		{ return "General";		}
+    
+    string getHelpString();
+    string getOutputPattern(string){ return ""; }
+    string getCitation() { return "http://www.mothur.org/wiki/Set.profile"; }
+    string getDescription()		{ return "report the time, memory and file sizes used by each command"; }
+    
+    int execute();
+    void help() { m->mothurOut(getHelpString()); }
+    
+private:
+    bool abort, profile;
+    vector<string> outputNames;
+};
+
+/**********************************************************/
+
+#endif
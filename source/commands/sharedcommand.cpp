@@ -1130,10 +1130,8 @@ int SharedCommand::ListGroupSameSeqs(vector<string>& groupMapsSeqs, SharedListVe
 		for (int i = 0; i < SharedList->getNumBins(); i++) {
 			if (m->control_pressed) { return 0; }
 
-			string names = SharedList->get(i);
-
 			vector<string> listNames;
-			m->splitAtComma(names, listNames);
+			SeqNameTable::getInstance()->getNames(SharedList->getIds(i), listNames);
 
 			for (int j = 0; j < listNames.size(); j++) {
 				int num = groupNamesSeqs.count(listNames[j]);
@@ -42,6 +42,7 @@ string ShhherCommand::getHelpString(){
         helpString += "The shhh.flows command parameters are flow, file, lookup, cutoff, processors, large, maxiter, sigma, mindelta and order.\n";
         helpString += "The flow parameter is used to input your flow file.\n";
         helpString += "The file parameter is used to input the *flow.files file created by trim.flows.\n";
+        helpString += "The processors parameter allows you to specify the number of processors to use. The files are split between the processors, and when there are fewer files than processors the processors left over work together on each file. Default=1.\n";
         helpString += "The lookup parameter is used specify the lookup file you would like to use. http://www.mothur.org/wiki/Lookup_files.\n";
         helpString += "The order parameter options are A, B or I.  Default=A. A = TACG and B = TACGTACGTACGATGTAGTCGAGCATCATCTGACGCAGTACGTGCATGATCTCAGTCAGCAGCTATGTCAGTGCATGCAGTGACTGATCGTCATCAGCTAGCATCGACTGCATAGATCGCATGACGATCGCATATCGTCAGTGCATGTAGTCGAGCATCATCTGACGCAGTACGTGCATGATCTCAGTCAGCAGCTATGTCAGTGCATGCATAGATCGCATGACGATCGCATATCGTCAGTGCAGTGACTGATCGTCATCAGCTAGCATCGACTGCATGTAGTCGAGCATCATCTGACGCAGTACGTGCATAGATCGCATGACGATCGCATATCGTCAGTGCATGATCTCAGTCAGCAGCTATGTCAGTGCATGCAGTGACTGATCGTCATCAGCTAGCATCGACTGCATGTAGTCGAGCATCATCTGACGCAGTACGTGCAGTGACTGATCGTCATCAGCTAGCATCGACTGCATAGATCGCATGACGATCGCATATCGTCAGTGCATGATCTCAGTCAGCAGCTATGTCAGTGCATGCATGTAGTCGAGCATCATCTGACGCAGTACGTGCATAGATCGCATGACGATCGCATATCGTCAGTGCAGTGACTGATCGTCATCAGCTAGCATCGACTGCATGATCTCAGTCAGCAGCTATGTCAGTGCATGCAGTGACTGATCGTCATCAGCTAGCATCGACTGCATAGATCGCATGACGATCGCATATCGTCAGTGCATGATCTCAGTCAGCAGCTATGTCAGTGCATGCATGTAGTCGAGCATCATCTGACGCAGTACGTGCATAGATCGCATGACGATCGCATATCGTCAGTGCATGATCTCAGTCAGCAGCTATGTCAGTGCATGCAGTGACTGATCGTCATCAGCTAGCATCGACTGCATGTAGTCGAGCATCATCTGACGCAGTACGTGCATGATCTCAGTCAGCAGCTATGTCAGTGCATGCATAGATCGCATGACGATCGCATATCGTCAGTGCATGTAGTCGAGCATCATCTGACGCAGTACGTGCAGTGACTGATCGTCATCAGCTAGCATCGACTGCATAGATCGCATGACGATCGCATATCGTCAGTGCATGTAGTCGAGCATCATCTGACGCAGTACGTGCATGATCTCAGTCAGCAGCTATGTCAGTGCATGCAGTGACTGATCGTCATCAGCTAGCATCGACTGCATGATCTCAGTCAGCAGCTATGTCAGTGCATGCAGTGACTGATCGTCATCAGCTAGCATCGACTGCATAGATCGCATGACGATCGCATATCGTCAGTGCATGTAGTCGAGCATCATCTGACGCAGTACGTGCATGATCTCAGTCAGCAGCTATGTCAGTGCATGCATGTAGTCGAGCATCATCTGACGCAGTACGTGCAGTGACTGATCGTCATCAGCTAGCATCGACTGCATAGATCGCATGACGATCGCATATCGTCAGTGCAGTGACTGATCGTCATCAGCTAGCATCGACTGCATGTAGTCGAGCATCATCTGACGCAGTACGTGCATAGATCGCATGACGATCGCATATCGTCAGTGCATGATCTCAGTCAGCAGCTATGTCAGTGCATGCAGTGACTGATCGTCATCAGCTAGCATCGACTGCATGTAGTCGAGCATCATCTGACGCAGTACGTGCATGATCTCAGTCAGCAGCTATGTCAGTGCATGCATAGATCGCATGACGATCGCATATCGTCAGTGCAGTGACTGATCGTCATCAGCTAGCATCGACTGCATGATCTCAGTCAGCAGC and I = TACGTACGTCTGAGCATCGATCGATGTACAGCTACGTACGTCTGAGCATCGATCGATGTACAGCTACGTACGTCTGAGCATCGATCGATGTACAGCTACGTACGTCTGAGCATCGATCGATGTACAGCTACGTACGTCTGAGCATCGATCGATGTACAGCTACGTACGTCTGAGCATCGATCGATGTACAGCTACGTACGTCTGAGCATCGATCGATGTACAGCTACGTACGTCTGAGCATCGATCGATGTACAGCTACGTACGTCTGAGCATCGATCGATGTACAGCTACGTACGTCTGAGCATCGATCGATGTACAGCTACGTACGTCTGAGCATCGATCGATGTACAGCTACGTACGTCTGAGCATCGATCGATGTACAGCTACGTACGTCTGAGCATCGATCGATGTACAGCTACGTACGTCTGAGCATCGATCGATGTACAGCTACGTACGTCTGAGCATCGATCGATGTACAGCTACGTACGTCTGAGCATCGATCGATGTACAGCTACGTACGTCTGAGCATCGATCGATGTACAGCTACGTACGTCTGAGCATCGATCGATGTACAGCTACGTACGTCTGAGCATCGATCGATGTACAGCTACGTACGTCTGAGCATCGATCGATGTACAGC.\n";
 		return helpString;
@@ -1964,12 +1965,15 @@ int ShhherCommand::execute(){
 		
         int numFiles = flowFileVector.size();
 		
-        if (numFiles < processors) { processors = numFiles; }
-        
 #if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+        //the processors left over when there are fewer files than processors share the work on each file
+        threadsPerFile = 1;
+        if (numFiles < processors) { threadsPerFile = processors / numFiles; processors = numFiles; }
+        
         if (processors == 1) { driver(flowFileVector, compositeFASTAFileName, compositeNamesFileName); }
         else { createProcesses(flowFileVector); } //each processor processes one file
 #else
+        threadsPerFile = processors;
         driver(flowFileVector, compositeFASTAFileName, compositeNamesFileName);
 #endif
         
@@ -2287,6 +2291,8 @@ int ShhherCommand::driver(vector<string> filenames, string thisCompositeFASTAFil
         
         int numCompleted = 0;
         
+        ThreadPool pool(threadsPerFile);
+        
         for(int i=0;i<filenames.size();i++){
 			
 			if (m->control_pressed) { break; }
@@ -2334,7 +2340,7 @@ int ShhherCommand::driver(vector<string> filenames, string thisCompositeFASTAFil
                 begTime = time(NULL);
                
                 
-                flowDistParentFork(numFlowCells, distFileName, numUniques, mapUniqueToSeq, mapSeqToUnique, lengths, flowDataPrI, flowDataIntI);
+                flowDistParentFork(pool, numFlowCells, distFileName, numUniques, mapUniqueToSeq, mapSeqToUnique, lengths, flowDataPrI, flowDataIntI);
                 
                 m->mothurOutEndLine();
                 m->mothurOut("Total time: " + toString(time(NULL) - begTime) + '\t' + toString((clock() - begClock)/CLOCKS_PER_SEC) + '\n');
@@ -2414,15 +2420,15 @@ int ShhherCommand::driver(vector<string> filenames, string thisCompositeFASTAFil
                     
                     if (m->control_pressed) { break; }
                     
-                    calcCentroidsDriver(numOTUs, cumNumSeqs, nSeqsPerOTU, seqIndex, change, centroids, singleTau, mapSeqToUnique, uniqueFlowgrams, flowDataIntI, lengths, numFlowCells, seqNumber);
+                    calcCentroids(pool, numOTUs, cumNumSeqs, nSeqsPerOTU, seqIndex, change, centroids, singleTau, mapSeqToUnique, uniqueFlowgrams, flowDataIntI, lengths, numFlowCells, seqNumber);
                     
                     if (m->control_pressed) { break; }
                     
-                    maxDelta = getNewWeights(numOTUs, cumNumSeqs, nSeqsPerOTU, singleTau, seqNumber, weight);  
+                    maxDelta = getNewWeights(pool, numOTUs, cumNumSeqs, nSeqsPerOTU, singleTau, seqNumber, weight);  
                     
                     if (m->control_pressed) { break; }
                     
-                    double nLL = getLikelihood(numSeqs, numOTUs, nSeqsPerOTU, seqNumber, cumNumSeqs, seqIndex, dist, weight); 
+                    double nLL = getLikelihood(pool, numSeqs, numOTUs, nSeqsPerOTU, seqNumber, cumNumSeqs, seqIndex, dist, weight); 
                     
                     if (m->control_pressed) { break; }
                     
@@ -2430,7 +2436,7 @@ int ShhherCommand::driver(vector<string> filenames, string thisCompositeFASTAFil
                     
                     if (m->control_pressed) { break; }
                     
-                    calcNewDistances(numSeqs, numOTUs, nSeqsPerOTU,  dist, weight, change, centroids, aaP, singleTau, aaI, seqNumber, seqIndex, uniqueFlowgrams, flowDataIntI, numFlowCells, lengths);
+                    calcNewDistances(pool, numSeqs, numOTUs, nSeqsPerOTU,  dist, weight, change, centroids, aaP, singleTau, aaI, seqNumber, seqIndex, uniqueFlowgrams, flowDataIntI, numFlowCells, lengths);
                     
                     if (m->control_pressed) { break; }
                     
@@ -2458,9 +2464,9 @@ int ShhherCommand::driver(vector<string> filenames, string thisCompositeFASTAFil
                 vector<int> otuCounts(numOTUs, 0);
                 for(int j=0;j<numSeqs;j++)	{	otuCounts[otuData[j]]++;	}
                 
-                calcCentroidsDriver(numOTUs, cumNumSeqs, nSeqsPerOTU, seqIndex, change, centroids, singleTau, mapSeqToUnique, uniqueFlowgrams, flowDataIntI, lengths, numFlowCells, seqNumber);
+                calcCentroids(pool, numOTUs, cumNumSeqs, nSeqsPerOTU, seqIndex, change, centroids, singleTau, mapSeqToUnique, uniqueFlowgrams, flowDataIntI, lengths, numFlowCells, seqNumber);
                 
-                if (m->debug) { m->mothurOut("[DEBUG]: done calcCentroidsDriver().\n"); }
+                if (m->debug) { m->mothurOut("[DEBUG]: done calcCentroids().\n"); }
                 
                 if (m->control_pressed) { break; }
                 
@@ -2587,7 +2593,49 @@ int ShhherCommand::getFlowData(string filename, vector<string>& thisSeqNameVecto
 }
 /**************************************************************************************************/
 
-int ShhherCommand::flowDistParentFork(int numFlowCells, string distFileName, int stopSeq, vector<int>& mapUniqueToSeq, vector<int>& mapSeqToUnique, vector<int>& lengths, vector<double>& flowDataPrI, vector<short>& flowDataIntI){
+int ShhherCommand::flowDistParentFork(ThreadPool& pool, int numFlowCells, string distFileName, int stopSeq, vector<int>& mapUniqueToSeq, vector<int>& mapSeqToUnique, vector<int>& lengths, vector<double>& flowDataPrI, vector<short>& flowDataIntI){
+	try{		
+		
+		int begTime = time(NULL);
+		double begClock = clock();
+		
+		ofstream distFile(distFileName.c_str());
+		vector<ostream*> files; files.push_back(&distFile);
+		OutputSink sink(files, false);
+		
+		//blocks of 100 rows, written to the file in order as they are finished
+		int numBlocks = 0;
+		for(int start=0;start<stopSeq;start+=100){
+			int end = min(start + 100, stopSeq);
+			
+			int blockNum = numBlocks; numBlocks++;
+			pool.submit([this, &sink, &mapUniqueToSeq, &mapSeqToUnique, &lengths, &flowDataPrI, &flowDataIntI, numFlowCells, start, end, blockNum, begTime, begClock](int) {
+				vector<string> output(1, flowDistDriver(numFlowCells, start, end, mapUniqueToSeq, mapSeqToUnique, lengths, flowDataPrI, flowDataIntI));
+				sink.write(blockNum, output, end - start);
+				
+				m->mothurOutJustToScreen(toString(start) + "\t" + toString(time(NULL) - begTime));
+				m->mothurOutJustToScreen("\t" + toString((clock()-begClock)/CLOCKS_PER_SEC)+"\n");
+			});
+		}
+		pool.wait();
+		distFile.close();
+		
+		if (m->control_pressed) {}
+		else {
+			m->mothurOutJustToScreen(toString(stopSeq-1) + "\t" + toString(time(NULL) - begTime));
+			m->mothurOutJustToScreen("\t" + toString((clock()-begClock)/CLOCKS_PER_SEC)+"\n");
+		}
+        
+        return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ShhherCommand", "flowDistParentFork");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//the distances of the uniques from startSeq to stopSeq to the uniques before them
+string ShhherCommand::flowDistDriver(int numFlowCells, int startSeq, int stopSeq, vector<int>& mapUniqueToSeq, vector<int>& mapSeqToUnique, vector<int>& lengths, vector<double>& flowDataPrI, vector<short>& flowDataIntI){
 	try{		
         
 		ostringstream outStream;
@@ -2596,10 +2644,7 @@ int ShhherCommand::flowDistParentFork(int numFlowCells, string distFileName, int
 		outStream.setf(ios::showpoint);
 		outStream.precision(6);
 		
-		int begTime = time(NULL);
-		double begClock = clock();
-        
-		for(int i=0;i<stopSeq;i++){
+		for(int i=startSeq;i<stopSeq;i++){
 			
 			if (m->control_pressed) { break; }
 			
@@ -2613,26 +2658,12 @@ int ShhherCommand::flowDistParentFork(int numFlowCells, string distFileName, int
 					outStream << mapUniqueToSeq[i] << '\t' << mapUniqueToSeq[j] << '\t' << flowDistance << endl;
 				}
 			}
-			if(i % 100 == 0){
-				m->mothurOutJustToScreen(toString(i) + "\t" + toString(time(NULL) - begTime));
-				m->mothurOutJustToScreen("\t" + toString((clock()-begClock)/CLOCKS_PER_SEC)+"\n");
-			}
 		}
 		
-		ofstream distFile(distFileName.c_str());
-		distFile << outStream.str();		
-		distFile.close();
-		
-		if (m->control_pressed) {}
-		else {
-			m->mothurOutJustToScreen(toString(stopSeq-1) + "\t" + toString(time(NULL) - begTime));
-			m->mothurOutJustToScreen("\t" + toString((clock()-begClock)/CLOCKS_PER_SEC)+"\n");
-		}
-        
-        return 0;
+        return outStream.str();
 	}
 	catch(exception& e) {
-		m->errorOut(e, "ShhherCommand", "flowDistParentFork");
+		m->errorOut(e, "ShhherCommand", "flowDistDriver");
 		exit(1);
 	}
 }
@@ -2643,21 +2674,17 @@ float ShhherCommand::calcPairwiseDist(int numFlowCells, int seqA, int seqB, vect
 		int minLength = lengths[mapSeqToUnique[seqA]];
 		if(lengths[seqB] < minLength){	minLength = lengths[mapSeqToUnique[seqB]];	}
 		
-		int ANumFlowCells = seqA * numFlowCells;
-		int BNumFlowCells = seqB * numFlowCells;
+		const short* flowAIntI = &flowDataIntI[seqA * numFlowCells];
+		const short* flowBIntI = &flowDataIntI[seqB * numFlowCells];
+		const double* flowAPrI = &flowDataPrI[seqA * numFlowCells];
+		const double* flowBPrI = &flowDataPrI[seqB * numFlowCells];
+		const double* lookUp = &jointLookUp[0];
 		
+		//summed in flow order in a float, as before, so the distances do not change
 		float dist = 0;
 		
 		for(int i=0;i<minLength;i++){
-			
-			if (m->control_pressed) { break; }
-			
-			int flowAIntI = flowDataIntI[ANumFlowCells + i];
-			float flowAPrI = flowDataPrI[ANumFlowCells + i];
-			
-			int flowBIntI = flowDataIntI[BNumFlowCells + i];
-			float flowBPrI = flowDataPrI[BNumFlowCells + i];
-			dist += jointLookUp[flowAIntI * NUMBINS + flowBIntI] - flowAPrI - flowBPrI;
+			dist += lookUp[flowAIntI[i] * NUMBINS + flowBIntI[i]] - (float)flowAPrI[i] - (float)flowBPrI[i];
 		}
 		
 		dist /= (float) minLength;
@@ -2927,7 +2954,57 @@ int ShhherCommand::getOTUData(int numSeqs, string fileName,  vector<int>& otuDat
 }
 /**************************************************************************************************/
 
-int ShhherCommand::calcCentroidsDriver(int numOTUs, 
+//several blocks for each processor, so the processors that finish their blocks early take on more
+vector<linePair> ShhherCommand::getBlocks(int num, ThreadPool& pool){
+	try{
+		vector<linePair> blocks;
+		int blockSize = num / (pool.getNumProcessors() * 8) + 1;
+		for(int start=0;start<num;start+=blockSize){
+			blocks.push_back(linePair(start, min(start + blockSize, num)));
+		}
+		return blocks;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ShhherCommand", "getBlocks");
+		exit(1);	
+	}		
+}
+/**************************************************************************************************/
+
+int ShhherCommand::calcCentroids(ThreadPool& pool, int numOTUs, 
+                                          vector<int>& cumNumSeqs,
+                                          vector<int>& nSeqsPerOTU,
+                                          vector<int>& seqIndex,
+                                          vector<short>& change,		//did the centroid sequence change? 0 = no; 1 = yes
+                                          vector<int>& centroids,		//the representative flowgram for each cluster m
+                                          vector<double>& singleTau,	//tMaster->adTau:	1-D Tau vector (1xnumSeqs)
+                                          vector<int>& mapSeqToUnique,
+                                          vector<short>& uniqueFlowgrams,
+                                          vector<short>& flowDataIntI,
+                                          vector<int>& lengths,
+                                          int numFlowCells,
+                                          vector<int>& seqNumber){                          
+	try{
+		//each otu's centroid only depends on its own seqs
+		vector<linePair> blocks = getBlocks(numOTUs, pool);
+		for(int i=0;i<blocks.size();i++){
+			int start = blocks[i].start; int finish = blocks[i].end;
+			pool.submit([&, start, finish](int) {
+				calcCentroidsDriver(start, finish, cumNumSeqs, nSeqsPerOTU, seqIndex, change, centroids, singleTau, mapSeqToUnique, uniqueFlowgrams, flowDataIntI, lengths, numFlowCells, seqNumber);
+			});
+		}
+		pool.wait();
+        
+        return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ShhherCommand", "calcCentroids");
+		exit(1);	
+	}		
+}
+/**************************************************************************************************/
+
+int ShhherCommand::calcCentroidsDriver(int start, int finish, 
                                           vector<int>& cumNumSeqs,
                                           vector<int>& nSeqsPerOTU,
                                           vector<int>& seqIndex,
@@ -2946,7 +3023,7 @@ int ShhherCommand::calcCentroidsDriver(int numOTUs,
 	
 	try{
 		
-		for(int i=0;i<numOTUs;i++){
+		for(int i=start;i<finish;i++){
 			
 			if (m->control_pressed) { break; }
 			
@@ -3025,15 +3102,14 @@ double ShhherCommand::getDistToCentroid(int cent, int flow, int length, vector<s
                                         vector<short>& flowDataIntI, int numFlowCells){
 	try{
 		
-		int flowAValue = cent * numFlowCells;
-		int flowBValue = flow * numFlowCells;
+		const short* flowA = &uniqueFlowgrams[cent * numFlowCells];
+		const short* flowB = &flowDataIntI[flow * numFlowCells];
+		const double* lookUp = &singleLookUp[0];
 		
 		double dist = 0;
         
 		for(int i=0;i<length;i++){
-			dist += singleLookUp[uniqueFlowgrams[flowAValue] * NUMBINS + flowDataIntI[flowBValue]];
-			flowAValue++;
-			flowBValue++;
+			dist += lookUp[flowA[i] * NUMBINS + flowB[i]];
 		}
 		
 		return dist / (double)length;
@@ -3045,26 +3121,38 @@ double ShhherCommand::getDistToCentroid(int cent, int flow, int length, vector<s
 }
 /**************************************************************************************************/
 
-double ShhherCommand::getNewWeights(int numOTUs, vector<int>& cumNumSeqs, vector<int>& nSeqsPerOTU, vector<double>& singleTau, vector<int>& seqNumber, vector<double>& weight){
+double ShhherCommand::getNewWeights(ThreadPool& pool, int numOTUs, vector<int>& cumNumSeqs, vector<int>& nSeqsPerOTU, vector<double>& singleTau, vector<int>& seqNumber, vector<double>& weight){
 	try{
 		
-		double maxChange = 0;
+		vector<linePair> blocks = getBlocks(numOTUs, pool);
+		vector<double> maxChanges(blocks.size(), 0);
 		
-		for(int i=0;i<numOTUs;i++){
-			
-			if (m->control_pressed) { break; }
-			
-			double difference = weight[i];
-			weight[i] = 0;
-			
-			for(int j=0;j<nSeqsPerOTU[i];j++){
-				int index = cumNumSeqs[i] + j;
-				double tauValue = singleTau[seqNumber[index]];
-				weight[i] += tauValue;
-			}
-			
-			difference = fabs(weight[i] - difference);
-			if(difference > maxChange){	maxChange = difference;	}
+		for(int b=0;b<blocks.size();b++){
+			int start = blocks[b].start; int finish = blocks[b].end;
+			pool.submit([&, b, start, finish](int) {
+				for(int i=start;i<finish;i++){
+					
+					if (m->control_pressed) { break; }
+					
+					double difference = weight[i];
+					weight[i] = 0;
+					
+					for(int j=0;j<nSeqsPerOTU[i];j++){
+						int index = cumNumSeqs[i] + j;
+						double tauValue = singleTau[seqNumber[index]];
+						weight[i] += tauValue;
+					}
+					
+					difference = fabs(weight[i] - difference);
+					if(difference > maxChanges[b]){	maxChanges[b] = difference;	}
+				}
+			});
+		}
+		pool.wait();
+		
+		double maxChange = 0;
+		for(int b=0;b<maxChanges.size();b++){
+			if(maxChanges[b] > maxChange){	maxChange = maxChanges[b];	}
 		}
 		return maxChange;
 	}
@@ -3076,30 +3164,49 @@ double ShhherCommand::getNewWeights(int numOTUs, vector<int>& cumNumSeqs, vector
 
 /**************************************************************************************************/
 
-double ShhherCommand::getLikelihood(int numSeqs, int numOTUs, vector<int>& nSeqsPerOTU, vector<int>& seqNumber, vector<int>& cumNumSeqs, vector<int>& seqIndex, vector<double>& dist, vector<double>& weight){
+double ShhherCommand::getLikelihood(ThreadPool& pool, int numSeqs, int numOTUs, vector<int>& nSeqsPerOTU, vector<int>& seqNumber, vector<int>& cumNumSeqs, vector<int>& seqIndex, vector<double>& dist, vector<double>& weight){
 	
 	try{
 		
 		vector<long double> P(numSeqs, 0);
 		int effNumOTUs = 0;
+		int total = 0;
 		
 		for(int i=0;i<numOTUs;i++){
 			if(weight[i] > MIN_WEIGHT){
 				effNumOTUs++;
 			}
+			total += nSeqsPerOTU[i];
+		}
+		
+		//the terms are found in blocks of otus, then added to P in the same order as before so nLL does not change
+		vector<double> terms(total, 0);
+		vector<linePair> blocks = getBlocks(numOTUs, pool);
+		for(int b=0;b<blocks.size();b++){
+			int start = blocks[b].start; int finish = blocks[b].end;
+			pool.submit([&, start, finish](int) {
+				for(int i=start;i<finish;i++){
+					
+					if (m->control_pressed) { break; }
+					
+					for(int j=0;j<nSeqsPerOTU[i];j++){
+						int index = cumNumSeqs[i] + j;
+						double singleDist = dist[seqNumber[index]];
+						
+						terms[index] = weight[i] * exp(-singleDist * sigma);
+					}
+				}
+			});
 		}
+		pool.wait();
 		
-		string hold;
 		for(int i=0;i<numOTUs;i++){
 			
 			if (m->control_pressed) { break; }
 			
 			for(int j=0;j<nSeqsPerOTU[i];j++){
 				int index = cumNumSeqs[i] + j;
-				int nI = seqIndex[index];
-				double singleDist = dist[seqNumber[index]];
-				
-				P[nI] += weight[i] * exp(-singleDist * sigma);
+				P[seqIndex[index]] += terms[index];
 			}
 		}
 		double nLL = 0.00;
@@ -3160,7 +3267,7 @@ int ShhherCommand::checkCentroids(int numOTUs, vector<int>& centroids, vector<do
 }
 /**************************************************************************************************/
 
-void ShhherCommand::calcNewDistances(int numSeqs, int numOTUs, vector<int>& nSeqsPerOTU, vector<double>& dist, 
+void ShhherCommand::calcNewDistances(ThreadPool& pool, int numSeqs, int numOTUs, vector<int>& nSeqsPerOTU, vector<double>& dist, 
                                      vector<double>& weight, vector<short>& change, vector<int>& centroids,
                                      vector<vector<int> >& aaP,	vector<double>& singleTau, vector<vector<int> >& aaI,	
                                      vector<int>& seqNumber, vector<int>& seqIndex,
@@ -3169,12 +3276,66 @@ void ShhherCommand::calcNewDistances(int numSeqs, int numOTUs, vector<int>& nSeq
 	
 	try{
 		
+		//the taus are found in blocks of seqs, then added to the otus in seq order as before
+		vector<linePair> blocks = getBlocks(numSeqs, pool);
+		vector< vector<int> > otuIndexes(blocks.size());
+		vector< vector<int> > seqIndexes(blocks.size());
+		vector< vector<double> > taus(blocks.size());
+		
+		for(int b=0;b<blocks.size();b++){
+			int start = blocks[b].start; int finish = blocks[b].end;
+			pool.submit([&, b, start, finish](int) {
+				calcNewDistancesChild(start, finish, numOTUs, dist, weight, change, centroids, uniqueFlowgrams, flowDataIntI, numFlowCells, lengths, otuIndexes[b], seqIndexes[b], taus[b]);
+			});
+		}
+		pool.wait();
+		
+		if (m->control_pressed) { return; }
+		
 		int total = 0;
-		vector<double> newTau(numOTUs,0);
-		vector<double> norms(numSeqs, 0);
+		for(int b=0;b<taus.size();b++){ total += taus[b].size(); }
+		
+		if(total != 0){
+			singleTau.resize(total, 0);
+			seqNumber.resize(total, 0);
+			seqIndex.resize(total, 0);
+		}
+		
+		total = 0;
 		nSeqsPerOTU.assign(numOTUs, 0);
+		
+		for(int b=0;b<taus.size();b++){
+			for(int k=0;k<taus[b].size();k++){
+				int j = otuIndexes[b][k];
+				
+				singleTau[total] = taus[b][k];
+				
+				aaP[j][nSeqsPerOTU[j]] = total;
+				aaI[j][nSeqsPerOTU[j]] = seqIndexes[b][k];
+				nSeqsPerOTU[j]++;
+				
+				total++;
+			}
+		}
         
-		for(int i=0;i<numSeqs;i++){
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ShhherCommand", "calcNewDistances");
+		exit(1);	
+	}		
+}
+/**************************************************************************************************/
+//the new distances of seqs startSeq to stopSeq to the centroids, and the otus they are now in with their taus
+void ShhherCommand::calcNewDistancesChild(int startSeq, int stopSeq, int numOTUs, vector<double>& dist, 
+                                          vector<double>& weight, vector<short>& change, vector<int>& centroids,
+                                          vector<short>& uniqueFlowgrams, vector<short>& flowDataIntI, int numFlowCells, vector<int>& lengths,
+                                          vector<int>& otuIndex, vector<int>& seqIndex, vector<double>& tau){
+	
+	try{
+		
+		vector<double> newTau(numOTUs,0);
+        
+		for(int i=startSeq;i<stopSeq;i++){
 			
 			if (m->control_pressed) { break; }
 			
@@ -3193,10 +3354,11 @@ void ShhherCommand::calcNewDistances(int numSeqs, int numOTUs, vector<int>& nSeq
 				}
 			}
             
+			double norm = 0;
 			for(int j=0;j<numOTUs;j++){
 				if(weight[j] > MIN_WEIGHT){
 					newTau[j] = exp(sigma * (-dist[indexOffset + j] + offset)) * weight[j];
-					norms[i] += newTau[j];
+					norm += newTau[j];
 				}
 				else{
 					newTau[j] = 0.0;
@@ -3204,25 +3366,12 @@ void ShhherCommand::calcNewDistances(int numSeqs, int numOTUs, vector<int>& nSeq
 			}
             
 			for(int j=0;j<numOTUs;j++){
-				newTau[j] /= norms[i];
-			}
-            
-			for(int j=0;j<numOTUs;j++){
+				newTau[j] /= norm;
+				
 				if(newTau[j] > MIN_TAU){
-					
-					int oldTotal = total;
-					
-					total++;
-					
-					singleTau.resize(total, 0);
-					seqNumber.resize(total, 0);
-					seqIndex.resize(total, 0);
-					
-					singleTau[oldTotal] = newTau[j];
-					
-					aaP[j][nSeqsPerOTU[j]] = oldTotal;
-					aaI[j][nSeqsPerOTU[j]] = i;
-					nSeqsPerOTU[j]++;
+					otuIndex.push_back(j);
+					seqIndex.push_back(i);
+					tau.push_back(newTau[j]);
 				}
 			}
             
@@ -3230,7 +3379,7 @@ void ShhherCommand::calcNewDistances(int numSeqs, int numOTUs, vector<int>& nSeq
         
 	}
 	catch(exception& e) {
-		m->errorOut(e, "ShhherCommand", "calcNewDistances");
+		m->errorOut(e, "ShhherCommand", "calcNewDistancesChild");
 		exit(1);	
 	}		
 }
@@ -18,6 +18,7 @@
 #include "sabundvector.hpp"
 #include "listvector.hpp"
 #include "cluster.hpp"
+#include "threadpool.h"
 #include <cfloat>
 
 //**********************************************************************************************************************
@@ -53,7 +54,7 @@ private:
 	bool abort, large;
 	string outputDir, flowFileName, flowFilesFileName, lookupFileName, compositeFASTAFileName, compositeNamesFileName;
 
-	int processors, maxIters, largeSize;
+	int processors, threadsPerFile, maxIters, largeSize;
 	float cutoff, sigma, minDelta;
 	string flowOrder;
     
@@ -67,18 +68,22 @@ private:
     int createProcesses(vector<string>);
     int getFlowData(string, vector<string>&, vector<int>&, vector<short>&, map<string, int>&, int&);
     int getUniques(int, int, vector<short>&, vector<int>&, vector<int>&, vector<int>&, vector<int>&, vector<int>&, vector<double>&, vector<short>&);
-    int flowDistParentFork(int, string, int, vector<int>&, vector<int>&, vector<int>&, vector<double>&, vector<short>&);
+    int flowDistParentFork(ThreadPool&, int, string, int, vector<int>&, vector<int>&, vector<int>&, vector<double>&, vector<short>&);
+    string flowDistDriver(int, int, int, vector<int>&, vector<int>&, vector<int>&, vector<double>&, vector<short>&);
     float calcPairwiseDist(int, int, int, vector<int>&, vector<int>&, vector<double>&, vector<short>&);
     int createNamesFile(int, int, string, vector<string>&, vector<int>&, vector<int>&);
     int cluster(string, string, string);
     int getOTUData(int numSeqs, string,  vector<int>&, vector<int>&, vector<int>&, vector<vector<int> >&, vector<vector<int> >&, vector<int>&, vector<int>&,map<string, int>&);
-    int calcCentroidsDriver(int numOTUs, vector<int>&, vector<int>&, vector<int>&, vector<short>&, vector<int>&, vector<double>&, vector<int>&, vector<short>&, vector<short>&, vector<int>&, int, vector<int>&);
+    int calcCentroids(ThreadPool&, int numOTUs, vector<int>&, vector<int>&, vector<int>&, vector<short>&, vector<int>&, vector<double>&, vector<int>&, vector<short>&, vector<short>&, vector<int>&, int, vector<int>&);
+    int calcCentroidsDriver(int, int, vector<int>&, vector<int>&, vector<int>&, vector<short>&, vector<int>&, vector<double>&, vector<int>&, vector<short>&, vector<short>&, vector<int>&, int, vector<int>&);
     double getDistToCentroid(int, int, int, vector<short>&, vector<short>&, int);
-    double getNewWeights(int, vector<int>&, vector<int>&, vector<double>&, vector<int>&, vector<double>&);
+    double getNewWeights(ThreadPool&, int, vector<int>&, vector<int>&, vector<double>&, vector<int>&, vector<double>&);
     
-    double getLikelihood(int, int, vector<int>&, vector<int>&, vector<int>&, vector<int>&, vector<double>&, vector<double>&);
+    double getLikelihood(ThreadPool&, int, int, vector<int>&, vector<int>&, vector<int>&, vector<int>&, vector<double>&, vector<double>&);
     int checkCentroids(int, vector<int>&, vector<double>&);
-    void calcNewDistances(int, int, vector<int>& , vector<double>&,vector<double>& , vector<short>& change, vector<int>&,vector<vector<int> >&,	vector<double>&, vector<vector<int> >&, vector<int>&, vector<int>&, vector<short>&, vector<short>&, int, vector<int>&);
+    void calcNewDistances(ThreadPool&, int, int, vector<int>& , vector<double>&,vector<double>& , vector<short>& change, vector<int>&,vector<vector<int> >&,	vector<double>&, vector<vector<int> >&, vector<int>&, vector<int>&, vector<short>&, vector<short>&, int, vector<int>&);
+    void calcNewDistancesChild(int, int, int, vector<double>&, vector<double>&, vector<short>&, vector<int>&, vector<short>&, vector<short>&, int, vector<int>&, vector<int>&, vector<int>&, vector<double>&);
+    vector<linePair> getBlocks(int, ThreadPool&);
     int fill(int, vector<int>&, vector<int>&, vector<int>&, vector<int>&, vector<vector<int> >&, vector<vector<int> >&);
     void setOTUs(int, int, vector<int>&, vector<int>&, vector<int>&, vector<int>&,
                  vector<int>&, vector<double>&, vector<double>&, vector<vector<int> >&, vector<vector<int> >&);
@@ -712,14 +712,16 @@ int UnifracUnweightedCommand::runRandomCalcs(Tree* thisTree, vector<double> user
         Unweighted unweighted(includeRoot);
         
         //get unweighted scores for random trees - if random is false iters = 0
+        //the labels are only swapped between the leaves of each combination, and all the random trees are scored at once
+        vector<EstOutput> randomScores = unweighted.getRandomValues(thisTree, iters, processors);
+        
+        if (m->control_pressed) { return 0; }
+        
         for (int j = 0; j < iters; j++) {
             
-            //we need a different getValues because when we swap the labels we only want to swap those in each pairwise comparison
-            randomData = unweighted.getValues(thisTree, "", "", processors, outputDir);
-            
-            if (m->control_pressed) { return 0; }
-			
             for(int k = 0; k < numComp; k++) {	
+                randomData[k] = randomScores[k][j];
+                
                 //add trees unweighted score to map of scores
                 map<float,float>::iterator it = rscoreFreq[k].find(randomData[k]);
                 if (it != rscoreFreq[k].end()) {//already have that score
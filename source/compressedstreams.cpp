@@ -0,0 +1,402 @@
+/*
+ *  compressedstreams.cpp
+ *  Mothur
+ *
+ *  Copyright 2026 Schloss Lab. All rights reserved.
+ *
+ */
+
+#include "compressedstreams.h"
+
+#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+#ifdef USE_COMPRESSION
+
+#include <zlib.h>
+#include <bzlib.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <poll.h>
+
+#define BGZF_BLOCKSIZE 65280		//the largest block whose stored form still fits in a 64K BGZF block
+#define BZIP2_BLOCKSIZE 900000
+#define PIPE_BUFFERSIZE 65536
+
+//the empty block samtools and htslib expect at the end of a BGZF file
+static const unsigned char bgzfEOF[28] = { 0x1f, 0x8b, 0x08, 0x04, 0, 0, 0, 0, 0, 0xff, 0x06, 0, 0x42, 0x43, 0x02, 0, 0x1b, 0, 0x03, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+
+/**************************************************************************************************/
+
+CompressedStreams* CompressedStreams::getInstance() {
+	if (myInstance == NULL) {
+		myInstance = new CompressedStreams();
+	}
+	return myInstance;
+}
+/**************************************************************************************************/
+
+CompressedStreams::CompressedStreams() {
+	m = MothurOut::getInstance();
+	numCompressors = 0;
+
+	static bool registered = false;
+	if (!registered) { pthread_atfork(NULL, NULL, forgetAfterFork); registered = true; }
+}
+/**************************************************************************************************/
+//the child of a fork has only the thread that forked, so the parent's writers and compression threads are left
+//behind, and the child gets a new instance the first time it opens a compressed file
+void CompressedStreams::forgetAfterFork() {
+	myInstance = NULL;
+}
+/**************************************************************************************************/
+
+bool CompressedStreams::isCompressed(string fileName) {
+	if ((fileName.length() > 3) && (fileName.compare(fileName.length() - 3, 3, ".gz") == 0)) { return true; }
+	if ((fileName.length() > 4) && (fileName.compare(fileName.length() - 4, 4, ".bz2") == 0)) { return true; }
+	return false;
+}
+/**************************************************************************************************/
+//the pipe is opened through /dev/fd, so the caller's stream has its own descriptor, and closing it ends the pipe
+bool CompressedStreams::openInput(string fileName, ifstream& file, ios_base::openmode mode) {
+	try {
+		wait(fileName);
+
+		bool bzip2 = (fileName.compare(fileName.length() - 4, 4, ".bz2") == 0);
+		gzFile gz = NULL;
+		FILE* bz = NULL;
+		if (bzip2)	{ bz = fopen(fileName.c_str(), "rb");		if (bz == NULL) { return false; } }
+		else		{ gz = gzopen(fileName.c_str(), "rb");		if (gz == NULL) { return false; } }
+
+		int ends[2];
+		if (pipe(ends) != 0) {
+			m->mothurOut("[ERROR]: Could not create a pipe to read " + fileName + ".\n");
+			if (bzip2) { fclose(bz); } else { gzclose(gz); }
+			return false;
+		}
+		fcntl(ends[0], F_SETFD, FD_CLOEXEC); fcntl(ends[1], F_SETFD, FD_CLOEXEC);
+
+		file.open(("/dev/fd/" + toString(ends[0])).c_str(), mode);
+		close(ends[0]);
+		if (!file) {
+			close(ends[1]);
+			if (bzip2) { fclose(bz); } else { gzclose(gz); }
+			return false;
+		}
+
+		if (bzip2)	{ thread(&CompressedStreams::decompressBZ2, this, fileName, bz, ends[1]).detach();			}
+		else		{ thread(&CompressedStreams::decompressGZ, this, fileName, (void*)gz, ends[1]).detach();	}
+
+		return true;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "CompressedStreams", "openInput");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+
+bool CompressedStreams::openOutput(string fileName, ofstream& file, ios_base::openmode mode) {
+	try {
+		wait(fileName);
+
+		ofstream* compressed = new ofstream(fileName.c_str(), ios::binary | ((mode & ios::app) ? ios::app : ios::trunc));
+		if (!(*compressed)) { delete compressed; return false; }
+
+		int ends[2];
+		if (pipe(ends) != 0) {
+			m->mothurOut("[ERROR]: Could not create a pipe to write " + fileName + ".\n");
+			delete compressed;
+			return false;
+		}
+		fcntl(ends[0], F_SETFD, FD_CLOEXEC); fcntl(ends[1], F_SETFD, FD_CLOEXEC);
+
+		file.open(("/dev/fd/" + toString(ends[1])).c_str(), mode);
+		close(ends[1]);
+		if (!file) { close(ends[0]); delete compressed; return false; }
+
+		lock_guard<mutex> guard(lock);
+
+		//the compression threads are started with the first compressed output
+		if (numCompressors == 0) {
+			numCompressors = max((int)thread::hardware_concurrency(), 1);
+			for (int i = 0; i < numCompressors; i++) { thread(&CompressedStreams::compressBlocks, this).detach(); }
+		}
+
+		writers.insert(make_pair(fileName, make_pair(new thread(&CompressedStreams::writeFile, this, fileName, compressed, ends[0]), ends[0])));
+
+		return true;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "CompressedStreams", "openOutput");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+
+void CompressedStreams::wait(string fileName) {
+	try {
+		vector< pair<thread*, int> > finishing;
+		{
+			lock_guard<mutex> guard(lock);
+			pair<multimap<string, pair<thread*, int> >::iterator, multimap<string, pair<thread*, int> >::iterator> range = writers.equal_range(fileName);
+			for (multimap<string, pair<thread*, int> >::iterator it = range.first; it != range.second; it++) { finishing.push_back(it->second); }
+			writers.erase(range.first, range.second);
+		}
+		for (int i = 0; i < finishing.size(); i++) { finishing[i].first->join(); delete finishing[i].first; close(finishing[i].second); }
+	}
+	catch(exception& e) {
+		m->errorOut(e, "CompressedStreams", "wait");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//the read end of a pipe hangs up once every write end is closed. a file whose stream is still open, like one kept by
+//a command between runs, is left to finish when it is closed instead of waiting on it forever
+void CompressedStreams::waitAll() {
+	try {
+		vector< pair<thread*, int> > finishing;
+		{
+			lock_guard<mutex> guard(lock);
+			multimap<string, pair<thread*, int> >::iterator it = writers.begin();
+			while (it != writers.end()) {
+				struct pollfd end;
+				end.fd = it->second.second; end.events = 0; end.revents = 0;
+				poll(&end, 1, 0);
+
+				if (end.revents & (POLLHUP | POLLERR | POLLNVAL)) { finishing.push_back(it->second); writers.erase(it++); }
+				else {
+					if (m->debug) { m->mothurOut("[DEBUG]: " + it->first + " is still open, it will be complete once it is closed.\n"); }
+					it++;
+				}
+			}
+		}
+		for (int i = 0; i < finishing.size(); i++) { finishing[i].first->join(); delete finishing[i].first; close(finishing[i].second); }
+	}
+	catch(exception& e) {
+		m->errorOut(e, "CompressedStreams", "waitAll");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//gzread reads every member of a multi-member file, like a BGZF file, and reads files that are not compressed as is
+void CompressedStreams::decompressGZ(string fileName, void* file, int pipeEnd) {
+	try {
+		ignorePipeSignal();
+
+		gzFile gz = (gzFile)file;
+		gzbuffer(gz, 131072);
+
+		vector<char> buffer(PIPE_BUFFERSIZE);
+		while (true) {
+			int numRead = gzread(gz, &buffer[0], buffer.size());
+			if (numRead < 0) { int error; m->mothurOut("[ERROR]: Could not decompress " + fileName + ": " + string(gzerror(gz, &error)) + ".\n"); break; }
+			if (numRead == 0) { break; }
+			if (!writeAll(pipeEnd, &buffer[0], numRead)) { break; }		//the reader closed its stream early
+		}
+
+		gzclose(gz);
+		close(pipeEnd);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "CompressedStreams", "decompressGZ");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//a file may be several bzip2 streams one after the other, like the ones written here or by pbzip2
+void CompressedStreams::decompressBZ2(string fileName, FILE* file, int pipeEnd) {
+	try {
+		ignorePipeSignal();
+
+		vector<char> in(PIPE_BUFFERSIZE), out(PIPE_BUFFERSIZE);
+		bz_stream stream;
+		memset(&stream, 0, sizeof(stream));
+		BZ2_bzDecompressInit(&stream, 0, 0);
+
+		bool open = true;
+		while (open) {
+			if (stream.avail_in == 0) {
+				size_t numRead = fread(&in[0], 1, in.size(), file);
+				if (numRead == 0) { break; }
+				stream.next_in = &in[0]; stream.avail_in = numRead;
+			}
+
+			stream.next_out = &out[0]; stream.avail_out = out.size();
+			int result = BZ2_bzDecompress(&stream);
+			if ((result != BZ_OK) && (result != BZ_STREAM_END)) { m->mothurOut("[ERROR]: Could not decompress " + fileName + ", it is not a valid bzip2 file.\n"); break; }
+
+			size_t numOut = out.size() - stream.avail_out;
+			if ((numOut != 0) && !writeAll(pipeEnd, &out[0], numOut)) { break; }	//the reader closed its stream early
+
+			if (result == BZ_STREAM_END) {
+				//keep the unused input for the next stream
+				char* next = stream.next_in; unsigned int left = stream.avail_in;
+				BZ2_bzDecompressEnd(&stream);
+				memset(&stream, 0, sizeof(stream));
+				BZ2_bzDecompressInit(&stream, 0, 0);
+				stream.next_in = next; stream.avail_in = left;
+				if ((left == 0) && feof(file)) { open = false; }
+			}
+		}
+
+		BZ2_bzDecompressEnd(&stream);
+		fclose(file);
+		close(pipeEnd);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "CompressedStreams", "decompressBZ2");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//reads the caller's output in blocks, queues them for the compression threads, and writes them to the file in order.
+//A few blocks per compression thread are kept in flight, so the caller is only slowed when they all are busy.
+void CompressedStreams::writeFile(string fileName, ofstream* file, int pipeEnd) {
+	try {
+		bool bzip2 = (fileName.compare(fileName.length() - 4, 4, ".bz2") == 0);
+		size_t blockSize = bzip2 ? BZIP2_BLOCKSIZE : BGZF_BLOCKSIZE;
+		size_t maxPending = 2 * numCompressors;
+
+		deque<Block*> pending;
+		bool done = false;
+		while (!done || !pending.empty()) {
+			if (!done && (pending.size() < maxPending)) {
+				Block* block = new Block();
+				block->bzip2 = bzip2; block->done = false;
+				block->data.resize(blockSize);
+				size_t numRead = readAll(pipeEnd, &block->data[0], blockSize);
+				block->data.resize(numRead);
+				if (numRead < blockSize) { done = true; }
+
+				if (numRead == 0) { delete block; }
+				else {
+					pending.push_back(block);
+					lock_guard<mutex> guard(blockLock);
+					blocks.push_back(block);
+					blockQueued.notify_one();
+				}
+				continue;
+			}
+
+			Block* block = pending.front();
+			{
+				unique_lock<mutex> guard(blockLock);
+				while (!block->done) { blockDone.wait(guard); }
+			}
+			file->write(block->compressed.c_str(), block->compressed.length());
+			pending.pop_front();
+			delete block;
+		}
+
+		if (!bzip2) { file->write((const char*)bgzfEOF, 28); }
+		if (!(*file)) { m->mothurOut("[ERROR]: Could not write " + fileName + ".\n"); }
+
+		file->close();
+		delete file;		//the pipe is closed once the thread is joined, so waitAll can still poll it
+	}
+	catch(exception& e) {
+		m->errorOut(e, "CompressedStreams", "writeFile");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+
+void CompressedStreams::compressBlocks() {
+	try {
+		while (true) {
+			Block* block;
+			{
+				unique_lock<mutex> guard(blockLock);
+				while (blocks.empty()) { blockQueued.wait(guard); }
+				block = blocks.front();
+				blocks.pop_front();
+			}
+
+			if (block->bzip2)	{ compressBZ2(block->data, block->compressed);	}
+			else				{ compressBGZF(block->data, block->compressed);	}
+			string().swap(block->data);
+
+			lock_guard<mutex> guard(blockLock);
+			block->done = true;
+			blockDone.notify_all();
+		}
+	}
+	catch(exception& e) {
+		m->errorOut(e, "CompressedStreams", "compressBlocks");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//a gzip member with the BC extra field, which holds the size of the block
+void CompressedStreams::compressBGZF(const string& data, string& block) {
+	unsigned long bound = compressBound(data.length());
+	block.resize(18 + bound + 8);
+	unsigned char* out = (unsigned char*)&block[0];
+
+	size_t size = 0;
+	for (int level = Z_DEFAULT_COMPRESSION; ; level = 0) {		//if it does not fit, the data is stored
+		z_stream stream;
+		memset(&stream, 0, sizeof(stream));
+		deflateInit2(&stream, level, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY);
+		stream.next_in = (Bytef*)data.c_str(); stream.avail_in = data.length();
+		stream.next_out = out + 18; stream.avail_out = bound;
+		deflate(&stream, Z_FINISH);
+		size = stream.total_out;
+		deflateEnd(&stream);
+		if ((18 + size + 8 <= 65536) || (level == 0)) { break; }
+	}
+
+	unsigned int blockSize = 18 + size + 8 - 1;
+	const unsigned char header[16] = { 0x1f, 0x8b, 0x08, 0x04, 0, 0, 0, 0, 0, 0xff, 0x06, 0, 0x42, 0x43, 0x02, 0 };
+	memcpy(out, header, 16);
+	out[16] = blockSize & 0xff; out[17] = (blockSize >> 8) & 0xff;
+
+	unsigned long crc = crc32(crc32(0L, Z_NULL, 0), (const Bytef*)data.c_str(), data.length());
+	unsigned long length = data.length();
+	unsigned char* trailer = out + 18 + size;
+	for (int i = 0; i < 4; i++) { trailer[i] = (crc >> (8*i)) & 0xff; trailer[4+i] = (length >> (8*i)) & 0xff; }
+
+	block.resize(18 + size + 8);
+}
+/**************************************************************************************************/
+
+void CompressedStreams::compressBZ2(const string& data, string& block) {
+	unsigned int size = data.length() + data.length() / 100 + 600;
+	block.resize(size);
+	BZ2_bzBuffToBuffCompress(&block[0], &size, (char*)data.c_str(), data.length(), 9, 0, 0);
+	block.resize(size);
+}
+/**************************************************************************************************/
+
+bool CompressedStreams::writeAll(int fd, const char* data, size_t length) {
+	while (length != 0) {
+		ssize_t numWritten = write(fd, data, length);
+		if (numWritten < 0) { if (errno == EINTR) { continue; } return false; }
+		data += numWritten; length -= numWritten;
+	}
+	return true;
+}
+/**************************************************************************************************/
+//reads until the buffer is full or the pipe is closed
+size_t CompressedStreams::readAll(int fd, char* data, size_t length) {
+	size_t total = 0;
+	while (total < length) {
+		ssize_t numRead = read(fd, data + total, length - total);
+		if (numRead < 0) { if (errno == EINTR) { continue; } break; }
+		if (numRead == 0) { break; }
+		total += numRead;
+	}
+	return total;
+}
+/**************************************************************************************************/
+//when the reader closes its stream before the end of the file, the write fails instead of stopping mothur
+void CompressedStreams::ignorePipeSignal() {
+	sigset_t signals;
+	sigemptyset(&signals);
+	sigaddset(&signals, SIGPIPE);
+	pthread_sigmask(SIG_BLOCK, &signals, NULL);
+}
+/**************************************************************************************************/
+
+#endif
+#endif
+
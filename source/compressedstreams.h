@@ -0,0 +1,87 @@
+#ifndef COMPRESSEDSTREAMS_H
+#define COMPRESSEDSTREAMS_H
+
+/*
+ *  compressedstreams.h
+ *  Mothur
+ *
+ *  Copyright 2026 Schloss Lab. All rights reserved.
+ *
+ */
+
+/* When mothur is built with USE_COMPRESSION, the files ending in .gz or .bz2 are read and written by MothurOut's
+ openInputFile and openOutputFile functions as if they were text, so every reader and writer gets them without change.
+ The stream the caller opens is one end of a pipe, and a thread at the other end decompresses the file into it, or
+ compresses what the caller writes into the file.
+
+ The .gz files are written as BGZF, blocks of at most 64K that are each a complete gzip member, and the .bz2 files as
+ one bzip2 stream per 900K block. The blocks are compressed by a pool of threads shared by all the files being
+ written, and gzip, zcat, bzcat and samtools read the files as usual. Appending to a compressed file adds new blocks.
+
+ A file is complete once the caller has closed its stream and the thread has written the last block. MothurOut waits
+ for that before it opens, renames or removes the file, and the Engine waits for every file whose stream has been
+ closed after each command. A file whose stream is still open is finished once the stream is closed or destroyed.
+
+ A forked child has none of the parent's threads, so the child starts over with an instance of its own.
+
+ A compressed file has no positions to seek to, so the commands that split a file among processors by position ask
+ for it to be decompressed. */
+
+#include "mothur.h"
+#include "mothurout.h"
+
+#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+#ifdef USE_COMPRESSION
+
+/**************************************************************************************************/
+
+class CompressedStreams {
+
+public:
+	static CompressedStreams* getInstance();
+	static bool isCompressed(string);		//the file name ends in .gz or .bz2
+
+	bool openInput(string, ifstream&, ios_base::openmode);		//returns false if the file could not be opened
+	bool openOutput(string, ofstream&, ios_base::openmode);		//ios::app adds blocks to the end of the file
+	void wait(string);				//waits for the file to be written, if it is being written. its stream must be closed
+	void waitAll();					//waits for the files whose streams are closed
+
+private:
+	struct Block {
+		string data, compressed;
+		bool bzip2, done;
+	};
+
+	static CompressedStreams* myInstance;
+	CompressedStreams();
+	CompressedStreams(const CompressedStreams&){}		// Disable copy constructor
+	void operator=(const CompressedStreams&){}			// Disable assignment operator
+	~CompressedStreams(){}
+
+	MothurOut* m;
+	mutex lock;
+	multimap<string, pair<thread*, int> > writers;		//the threads writing each file, and the read end of their pipe
+
+	mutex blockLock;
+	condition_variable blockQueued, blockDone;
+	deque<Block*> blocks;					//waiting for a compression thread
+	int numCompressors;
+
+	static void forgetAfterFork();
+	void decompressGZ(string, void*, int);		//file name, gzFile, write end of the pipe
+	void decompressBZ2(string, FILE*, int);
+	void writeFile(string, ofstream*, int);		//file name, compressed file, read end of the pipe
+	void compressBlocks();
+	static void compressBGZF(const string&, string&);
+	static void compressBZ2(const string&, string&);
+	static bool writeAll(int, const char*, size_t);
+	static size_t readAll(int, char*, size_t);
+	static void ignorePipeSignal();
+};
+
+/**************************************************************************************************/
+
+#endif
+#endif
+
+#endif
@@ -78,32 +78,32 @@ void Alignment::traceBack(){			//	This traceback routine is used by the dynamic
 		//	seqAstart = 1;
 		//	seqAend = column;
 		
-		AlignmentCell currentCell = alignment[row][column];	//	Start the traceback from the bottom-right corner of the
+		char prevCell = getPrevCell(row, column);	//	Start the traceback from the bottom-right corner of the
 		//	matrix
 		
-		if(currentCell.prevCell == 'x'){	seqAaln = seqBaln = "NOALIGNMENT";		}//If there's an 'x' in the bottom-
+		if(prevCell == 'x'){	seqAaln = seqBaln = "NOALIGNMENT";		}//If there's an 'x' in the bottom-
 		else{	//	right corner bail out because it means nothing got aligned
             int count = 0;
-			while(currentCell.prevCell != 'x'){				//	while the previous cell isn't an 'x', keep going...
+			while(prevCell != 'x'){				//	while the previous cell isn't an 'x', keep going...
 				
-				if(currentCell.prevCell == 'u'){			//	if the pointer to the previous cell is 'u', go up in the
+				if(prevCell == 'u'){			//	if the pointer to the previous cell is 'u', go up in the
 					seqAaln = '-' + seqAaln;				//	matrix.  this indicates that we need to insert a gap in
 					seqBaln = seqB[row] + seqBaln;			//	seqA and a base in seqB
                     BBaseMap[row] = count;
-					currentCell = alignment[--row][column];
+					prevCell = getPrevCell(--row, column);
 				}
-				else if(currentCell.prevCell == 'l'){		//	if the pointer to the previous cell is 'l', go to the left
+				else if(prevCell == 'l'){		//	if the pointer to the previous cell is 'l', go to the left
 					seqBaln = '-' + seqBaln;				//	in the matrix.  this indicates that we need to insert a gap
 					seqAaln = seqA[column] + seqAaln;		//	in seqB and a base in seqA
                     ABaseMap[column] = count;
-					currentCell = alignment[row][--column];
+					prevCell = getPrevCell(row, --column);
 				}
 				else{
 					seqAaln = seqA[column] + seqAaln;		//	otherwise we need to go diagonally up and to the left,
 					seqBaln = seqB[row] + seqBaln;			//	here we add a base to both alignments
                     BBaseMap[row] = count;
                     ABaseMap[column] = count;
-					currentCell = alignment[--row][--column];
+					prevCell = getPrevCell(--row, --column);
 				}
                 count++;
 			}
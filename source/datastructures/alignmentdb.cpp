@@ -248,6 +248,21 @@ Sequence AlignmentDB::findClosestSequence(Sequence* seq) {
 	}
 }
 /**************************************************************************************************/
+Sequence AlignmentDB::findClosestSequence(Sequence* seq, float& searchScore) {
+	try{
+	
+		vector<int> spot = search->findClosestSequences(seq, 1, searchScore);
+	
+		if (spot.size() != 0)	{		return templateSequences[spot[0]];	}
+		else					{		return emptySequence;				}
+		
+	}
+	catch(exception& e) {
+		m->errorOut(e, "AlignmentDB", "findClosestSequence");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
 
 
 
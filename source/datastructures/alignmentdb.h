@@ -25,6 +25,7 @@ public:
 	~AlignmentDB();
 	
 	Sequence findClosestSequence(Sequence*);
+	Sequence findClosestSequence(Sequence*, float&);	//sets the search score instead of keeping it, for threads sharing the database
 	float getSearchScore()  {  return search->getSearchScore();  }
 	int getLongestBase()	{  return longest;  }
 	
@@ -26,6 +26,23 @@ Database::~Database(){}
 
 float Database::getSearchScore()	{	return searchScore;		}	//	we're assuming that the search is already done
 
+/**************************************************************************************************/
+//the search methods keep their results in the object, so threads sharing the database take turns
+vector<int> Database::findClosestSequences(Sequence* candidateSeq, int num, float& score){
+	try {
+		lock_guard<mutex> guard(searchLock);
+		
+		vector<int> topMatches = findClosestSequences(candidateSeq, num);
+		score = getSearchScore();
+		
+		return topMatches;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Database", "findClosestSequences");
+		exit(1);
+	}
+}
+
 
 /**************************************************************************************************/
 
@@ -50,6 +50,7 @@ public:
 	virtual void addSequence(Sequence) = 0;  //add sequence to search engine
 	virtual string getName(int) { return ""; }  
 	virtual vector<int> findClosestSequences(Sequence*, int) = 0;  // returns indexes of n closest sequences to query
+	virtual vector<int> findClosestSequences(Sequence*, int, float&);  // same as above and sets the search score, safe to call from several threads
 	virtual vector<int> findClosestMegaBlast(Sequence*, int, int){return results;}
 	virtual float getSearchScore();
 	virtual vector<float> getSearchScores() { return Scores; } //assumes you already called findClosestMegaBlast
@@ -66,6 +67,7 @@ protected:
 	float searchScore;
 	vector<int> results;
 	vector<float> Scores;
+	mutex searchLock;
 };
 /**************************************************************************************************/
 #endif
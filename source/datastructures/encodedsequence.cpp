@@ -0,0 +1,124 @@
+/*
+ *  encodedsequence.cpp
+ *  Mothur
+ *
+ *  Copyright 2026 Schloss Lab. All rights reserved.
+ *
+ */
+
+#include "encodedsequence.h"
+
+/**************************************************************************************************/
+
+EncodedSequence::EncodedSequence() {
+	length = 0;
+	numWords = 0;
+	encoded = false;
+	bits.resize(3, ~0ULL);
+	residues.resize(1, 0);
+	firstResidue = 0;
+	lastResidue = -1;
+	interiorDots = false;
+}
+/**************************************************************************************************/
+
+EncodedSequence::EncodedSequence(Sequence& seq) {
+	try {
+		length = 0;
+		numWords = 0;
+		encoded = false;
+		firstResidue = 0;
+		lastResidue = -1;
+		interiorDots = false;
+		encode(seq);
+	}
+	catch(exception& e) {
+		MothurOut::getInstance()->errorOut(e, "EncodedSequence", "EncodedSequence");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//255 marks the characters that can not be encoded
+vector<unsigned char> EncodedSequence::getCodes() {
+	vector<unsigned char> codes(256, 255);
+	codes['-'] = 0;	codes['A'] = 1;	codes['C'] = 2;	codes['G'] = 3;	codes['T'] = 4;	codes['N'] = 5;	codes['.'] = 7;
+	return codes;
+}
+/**************************************************************************************************/
+
+void EncodedSequence::encode(Sequence& seq) {
+	try {
+		static const vector<unsigned char> codes = getCodes();
+
+		string aligned = seq.getAligned();
+		length = aligned.length();
+		numWords = (length + 63) / 64;
+		encoded = true;
+		original = Sequence();
+
+		bits.assign(3 * max(numWords, 1), ~0ULL);
+
+		for (int w = 0; w < numWords; w++) {
+			unsigned long long plane0 = ~0ULL, plane1 = ~0ULL, plane2 = ~0ULL;	//columns past the end stay '.'
+			int end = min(64, length - 64 * w);
+			const char* column = aligned.c_str() + 64 * w;
+
+			for (int i = 0; i < end; i++) {
+				unsigned char code = codes[(unsigned char)column[i]];
+				if (code == 255) { encoded = false; break; }
+				unsigned long long bit = 1ULL << i;
+				if (!(code & 1)) { plane0 &= ~bit; }
+				if (!(code & 2)) { plane1 &= ~bit; }
+				if (!(code & 4)) { plane2 &= ~bit; }
+			}
+			if (!encoded) { break; }
+
+			bits[3*w] = plane0; bits[3*w+1] = plane1; bits[3*w+2] = plane2;
+		}
+
+		if (!encoded) { original = seq; return; }
+
+		//the residues are the columns between the first and last column that is not '.', other than the '-'s
+		size_t first = aligned.find_first_not_of('.');
+		if (first == string::npos)	{ firstResidue = length; lastResidue = -1; }
+		else						{ firstResidue = first; lastResidue = aligned.find_last_not_of('.'); }
+		interiorDots = false;
+
+		residues.assign(numWords + 1, 0);
+		for (int w = 0; w < numWords; w++) {
+			unsigned long long mask = (lastResidue < firstResidue) ? 0 : columns(w, firstResidue, lastResidue + 1);
+			const unsigned long long* word = &bits[3*w];
+			residues[w+1] = residues[w] + popCount(~gaps(word) & mask);
+			if (dots(word) & mask) { interiorDots = true; }
+		}
+	}
+	catch(exception& e) {
+		MothurOut::getInstance()->errorOut(e, "EncodedSequence", "encode");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+
+Sequence EncodedSequence::getSequence() const {
+	try {
+		if (!encoded) { return original; }
+		
+		static const char characters[8] = { '-', 'A', 'C', 'G', 'T', 'N', '?', '.' };
+		string aligned(length, '.');
+		for (int i = 0; i < length; i++) {
+			int w = i / 64;
+			int bit = i % 64;
+			int code = ((bits[3*w] >> bit) & 1) | (((bits[3*w+1] >> bit) & 1) << 1) | (((bits[3*w+2] >> bit) & 1) << 2);
+			aligned[i] = characters[code];
+		}
+		
+		Sequence seq;
+		seq.setAligned(aligned);
+		return seq;
+	}
+	catch(exception& e) {
+		MothurOut::getInstance()->errorOut(e, "EncodedSequence", "getSequence");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
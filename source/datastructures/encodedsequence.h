@@ -0,0 +1,106 @@
+#ifndef ENCODEDSEQUENCE_H
+#define ENCODEDSEQUENCE_H
+
+/*
+ *  encodedsequence.h
+ *  Mothur
+ *
+ *  Copyright 2026 Schloss Lab. All rights reserved.
+ *
+ *	An aligned sequence packed for the distance calculators.  Every column gets a 3 bit code, '-' = 0, A = 1, C = 2,
+ *	G = 3, T = 4, N = 5 and '.' = 7, and the codes are stored as three bit planes, 64 columns to a word.  So two columns
+ *	are the same character when none of their planes differ, and the gaps, terminal gaps and bases of 64 columns are
+ *	found with a few and / or operations.  The columns past the end of the alignment are coded as '.'.
+ *
+ *	Sequences containing any other character are not encoded, and the calculators use the original sequence instead.
+ *
+ *	The residues are the columns that are neither '-' nor part of the '.'s at either end.  The number left after each
+ *	word bounds how many more columns a distance calculator can count, so it can stop once a pair is beyond its cutoff.
+ *
+ */
+
+#include "mothur.h"
+#include "sequence.hpp"
+
+/**************************************************************************************************/
+
+class EncodedSequence {
+
+public:
+	EncodedSequence();
+	EncodedSequence(Sequence&);
+	~EncodedSequence() {}
+
+	void encode(Sequence&);
+	bool isEncoded() const					{	return encoded;		}
+	int getLength() const					{	return length;		}
+	int getNumWords() const					{	return numWords;	}
+	const unsigned long long* getWords() const	{	return &bits[0];	}	//the three planes of word w are at 3*w, 3*w+1 and 3*w+2
+	int getResiduesAfter(int w) const		{	return residues[numWords] - residues[w+1];	}	//residues in the words after word w
+	int getFirstResidue() const				{	return firstResidue;	}
+	int getLastResidue() const				{	return lastResidue;		}
+	bool hasInteriorDots() const			{	return interiorDots;	}	//a '.' between the first and last residue
+	Sequence getSequence() const;			//decodes the sequence, or returns the original if it could not be encoded
+
+	//masks of the 64 columns in a word
+	static unsigned long long dots(const unsigned long long* w)		{	return w[0] & w[1] & w[2];							}
+	static unsigned long long gaps(const unsigned long long* w)		{	return ~(w[0] | w[1] | w[2]);						}
+	static unsigned long long bases(const unsigned long long* w)	{	return (w[0] | w[1] | w[2]) & ~(w[0] & w[1] & w[2]);	}
+	static unsigned long long ns(const unsigned long long* w)		{	return w[0] & ~w[1] & w[2];							}
+	static unsigned long long differ(const unsigned long long* a, const unsigned long long* b) {
+		return (a[0] ^ b[0]) | (a[1] ^ b[1]) | (a[2] ^ b[2]);
+	}
+
+	//the columns of word w in [start, end)
+	static unsigned long long columns(int w, int start, int end) {
+		unsigned long long mask = ~0ULL;
+		int first = start - 64 * w;
+		int last = end - 64 * w;
+		if (first > 0)	{	mask <<= first;					}
+		if (last < 64)	{	mask &= (1ULL << last) - 1;		}
+		return mask;
+	}
+
+	static int popCount(unsigned long long x) {
+	#if defined (__GNUC__) || defined (__clang__)
+		return __builtin_popcountll(x);
+	#else
+		int count = 0;
+		while (x) { x &= x - 1; count++; }
+		return count;
+	#endif
+	}
+
+	static int lowestBit(unsigned long long x) {	//x must not be 0
+	#if defined (__GNUC__) || defined (__clang__)
+		return __builtin_ctzll(x);
+	#else
+		int bit = 0;
+		while (!(x & 1ULL)) { x >>= 1; bit++; }
+		return bit;
+	#endif
+	}
+
+	static int highestBit(unsigned long long x) {	//x must not be 0
+	#if defined (__GNUC__) || defined (__clang__)
+		return 63 - __builtin_clzll(x);
+	#else
+		int bit = 63;
+		while (!(x & (1ULL << 63))) { x <<= 1; bit--; }
+		return bit;
+	#endif
+	}
+
+private:
+	vector<unsigned long long> bits;
+	vector<int> residues;				//residues[w] is the number of residues in the words before word w
+	int length, numWords, firstResidue, lastResidue;
+	bool encoded, interiorDots;
+	Sequence original;
+
+	static vector<unsigned char> getCodes();
+};
+
+/**************************************************************************************************/
+
+#endif
@@ -67,7 +67,7 @@ vector< map<int, int> > Kmer::getKmerCounts(string sequence){	//	Calculate kmer
 	
 /**************************************************************************************************/
 
-int Kmer::getKmerNumber(string sequence, int index){
+int Kmer::getKmerNumber(const string& sequence, int index){
 	
 //	Here we convert a kmer to a number between 0 and maxKmer.  For example, AAAA would equal 0 and TTTT would equal 255.
 //	If there's an N in the kmer, it is set to 256 (if we are looking at 4mers).  The largest we can look at are 8mers,
@@ -98,6 +98,43 @@ int Kmer::getKmerNumber(string sequence, int index){
 }
 	
 /**************************************************************************************************/
+
+void Kmer::getKmerNumbers(const string& sequence, vector<int>& kmers){
+
+//	Each base is a 2 bit code, so the kmer at the next position is the last kmer shifted by 2 bits, plus the new base,
+//	with the base that fell out of the window masked off.  A kmer that includes an N is 4^kmerSize, and any other
+//	character counts as an A, like getKmerNumber.
+
+	int power4s[14] = { 1, 4, 16, 64, 256, 1024, 4096, 16384, 65536, 262144, 1048576, 4194304, 16777216, 67108864 };
+	
+	int length = sequence.length();
+	int numKmers = length - kmerSize + 1;
+	kmers.clear();
+	if (numKmers < 1) { return; }
+	kmers.resize(numKmers);
+	
+	int mask = power4s[kmerSize] - 1;
+	int kmer = 0;
+	int lastN = -1;							//	position of the last N seen
+	
+	for(int i=0;i<length;i++){
+		char base = toupper(sequence[i]);
+		int code = 0;
+		if(base == 'C')							{	code = 1;	}
+		else if(base == 'G')					{	code = 2;	}
+		else if((base == 'T') || (base == 'U'))	{	code = 3;	}
+		else if(base == 'N')					{	lastN = i;	}
+		
+		kmer = ((kmer << 2) | code) & mask;
+		
+		int start = i - kmerSize + 1;
+		if(start >= 0){
+			if(lastN >= start)	{	kmers[start] = power4s[kmerSize];	}
+			else				{	kmers[start] = kmer;				}
+		}
+	}
+}
+/**************************************************************************************************/
 	
 string Kmer::getKmerBases(int kmerNumber){
 	
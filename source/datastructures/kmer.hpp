@@ -20,7 +20,8 @@ public:
 	Kmer(int);
     ~Kmer() {}
 	string getKmerString(string);
-	int getKmerNumber(string, int);
+	int getKmerNumber(const string&, int);
+	void getKmerNumbers(const string&, vector<int>&);	//the kmer number at every position, the same as getKmerNumber gives
 	string getKmerBases(int);
 	int getReverseKmerNumber(int);
 	vector< map<int, int> > getKmerCounts(string sequence);  //for use in chimeraCheck
@@ -7,8 +7,8 @@
  *
  *	This class is a child class of the Database class, which stores the template sequences as a kmer table and provides
  *	a method of searching the kmer table for the sequence with the most kmers in common with a query sequence.
- *	kmerLocations is the primary storage variable that is a two-dimensional vector where each row represents the
- *	different number of kmers and each column contains the index to sequences that use that kmer.
+ *	kmerLocations collects the indices of the sequences that use each kmer as they are added, and is then packed into
+ *	the compressed index that is searched and written to the database file.
  *
  *	Construction of an object of this type will first look for an appropriately named database file and if it is found
  *	then will read in the database file (readKmerDB), otherwise it will generate one and store the data in memory
@@ -27,6 +27,10 @@
 #include "database.hpp"
 #include "kmerdb.hpp"
 
+#define KMERDB_TAG "MOTHURKM"
+#define KMERDB_VERSION 1
+#define KMERDB_HEADERSIZE 32
+
 /**************************************************************************************************/
 
 KmerDB::KmerDB(string fastaFileName, int kSize) : Database(), kmerSize(kSize) {
@@ -40,6 +44,8 @@ KmerDB::KmerDB(string fastaFileName, int kSize) : Database(), kmerSize(kSize) {
 		maxKmer = power4s[kmerSize];
 		kmerLocations.resize(maxKmer+1);
 		
+		kmerCounts = NULL; kmerOffsets = NULL; kmerPostings = NULL;
+		indexed = false;
 	}
 	catch(exception& e) {
 		m->errorOut(e, "KmerDB", "KmerDB");
@@ -48,7 +54,11 @@ KmerDB::KmerDB(string fastaFileName, int kSize) : Database(), kmerSize(kSize) {
 
 }
 /**************************************************************************************************/
-KmerDB::KmerDB() : Database() {}
+KmerDB::KmerDB() : Database() {
+	kmerSize = 0; maxKmer = 0; count = 0;
+	kmerCounts = NULL; kmerOffsets = NULL; kmerPostings = NULL;
+	indexed = false;
+}
 /**************************************************************************************************/
 
 KmerDB::~KmerDB(){}
@@ -56,6 +66,30 @@ KmerDB::~KmerDB(){}
 /**************************************************************************************************/
 
 vector<int> KmerDB::findClosestSequences(Sequence* candidateSeq, int num){
+	try {
+		return findClosestSequences(candidateSeq, num, searchScore, Scores);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "KmerDB", "findClosestSequences");
+		exit(1);
+	}	
+}
+/**************************************************************************************************/
+
+vector<int> KmerDB::findClosestSequences(Sequence* candidateSeq, int num, float& searchScore){
+	try {
+		vector<float> Scores;
+		return findClosestSequences(candidateSeq, num, searchScore, Scores);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "KmerDB", "findClosestSequences");
+		exit(1);
+	}	
+}
+/**************************************************************************************************/
+//the search state is kept in the arguments so threads can share the database, and the counts are per thread scratch
+//so a search does not allocate them
+vector<int> KmerDB::findClosestSequences(Sequence* candidateSeq, int num, float& searchScore, vector<float>& Scores){
 	try {
 		if (num > numSeqs) { m->mothurOut("[WARNING]: you requested " + toString(num) + " closest sequences, but the template only contains " + toString(numSeqs) + ", adjusting."); m->mothurOutEndLine(); num = numSeqs; }
 		
@@ -64,84 +98,125 @@ vector<int> KmerDB::findClosestSequences(Sequence* candidateSeq, int num){
 		searchScore = 0;
 		Scores.clear();
 		
-		vector<int> matches(numSeqs, 0);						//	a record of the sequences with shared kmers
-		vector<int> timesKmerFound(kmerLocations.size()+1, 0);	//	a record of the kmers that we have already found
+		static thread_local vector<int> matches;				//	a record of the sequences with shared kmers
+		static thread_local vector<char> timesKmerFound;		//	a record of the kmers that we have already found
+		static thread_local vector<int> queryKmers;
+		if (matches.size() < numSeqs)							{ matches.resize(numSeqs);								}
+		if (timesKmerFound.size() < maxKmer+1)					{ timesKmerFound.resize(maxKmer+1, 0);					}
+		fill(matches.begin(), matches.begin()+numSeqs, 0);
 		
-		int numKmers = candidateSeq->getNumBases() - kmerSize + 1;	
-	
-		for(int i=0;i<numKmers;i++){
-			int kmerNumber = kmer.getKmerNumber(candidateSeq->getUnaligned(), i);		//	go through the query sequence and get a kmer number
+		kmer.getKmerNumbers(candidateSeq->getUnaligned(), queryKmers);	//	go through the query sequence and get the kmer numbers
+		int numKmers = candidateSeq->getNumBases() - kmerSize + 1;
+		if (queryKmers.size() > max(numKmers, 0)) { queryKmers.resize(max(numKmers, 0)); }
+		
+		if (!indexed) { buildIndex(); }
+		
+		for(int i=0;i<queryKmers.size();i++){
+			int kmerNumber = queryKmers[i];
 			if(timesKmerFound[kmerNumber] == 0){				//	if we haven't seen it before...
-				for(int j=0;j<kmerLocations[kmerNumber].size();j++){//increase the count for each sequence that also has
-					matches[kmerLocations[kmerNumber][j]]++;	//	that kmer
+				const unsigned char* posting = kmerPostings + kmerOffsets[kmerNumber];
+				int seq = 0;
+				for(unsigned int j=0;j<kmerCounts[kmerNumber];j++){	//	increase the count for each sequence that also has
+					seq += readVarint(posting);					//	that kmer
+					matches[seq]++;
 				}
 			}
 			timesKmerFound[kmerNumber] = 1;						//	ok, we've seen the kmer now
 		}
+		for(int i=0;i<queryKmers.size();i++){ timesKmerFound[queryKmers[i]] = 0; }
 		
-		if (num != 1) {
-			vector<seqMatch> seqMatches; seqMatches.resize(numSeqs);
-			for(int i=0;i<numSeqs;i++){		
-				seqMatches[i].seq = i;
-				seqMatches[i].match = matches[i];
-			}
-			
-			//sorts putting largest matches first
-			sort(seqMatches.begin(), seqMatches.end(), compareSeqMatches);
-			
+		vector<seqMatch> seqMatches = getTopMatches(matches, num);
+		
+		if (seqMatches.size() != 0) {
 			searchScore = seqMatches[0].match;
 			searchScore = 100 * searchScore / (float) numKmers;		//	return the Sequence object corresponding to the db
+		}
 		
-			//save top matches
-			for (int i = 0; i < num; i++) {
-				topMatches.push_back(seqMatches[i].seq);
-				float thisScore = 100 * seqMatches[i].match / (float) numKmers;
-				Scores.push_back(thisScore);
-			}
-		}else{
+		//save top matches
+		for (int i = 0; i < seqMatches.size(); i++) {
+			topMatches.push_back(seqMatches[i].seq);
+			float thisScore = 100 * seqMatches[i].match / (float) numKmers;
+			Scores.push_back(thisScore);
+		}
+		
+		return topMatches;		
+	}
+	catch(exception& e) {
+		m->errorOut(e, "KmerDB", "findClosestSequences");
+		exit(1);
+	}	
+}
+/**************************************************************************************************/
+//The num sequences with the most shared kmers, largest first, and the lowest index first among ties. The counts are
+//at most the length of the query, so the smallest count that makes the top num is found from a histogram of the counts
+//instead of sorting every sequence.
+vector<seqMatch> KmerDB::getTopMatches(vector<int>& matches, int num){
+	try {
+		vector<seqMatch> top;
+		if (num < 1) { return top; }
+		
+		if (num == 1) {
 			int bestIndex = 0;
 			int bestMatch = -1;
-			for(int i=0;i<numSeqs;i++){	
-				
+			for(int i=0;i<numSeqs;i++){
 				if (matches[i] > bestMatch) {
 					bestIndex = i;
 					bestMatch = matches[i];
 				}
 			}
-			
-			searchScore = bestMatch;
-			searchScore = 100 * searchScore / (float) numKmers;		//	return the Sequence object corresponding to the db
-			topMatches.push_back(bestIndex);
-			Scores.push_back(searchScore);
+			top.push_back(seqMatch(bestIndex, bestMatch));
+			return top;
 		}
-		return topMatches;		
+		
+		int maxMatch = 0;
+		for(int i=0;i<numSeqs;i++){ if (matches[i] > maxMatch) { maxMatch = matches[i]; } }
+		
+		vector<int> numWithMatch(maxMatch+1, 0);
+		for(int i=0;i<numSeqs;i++){ numWithMatch[matches[i]]++; }
+		
+		//the sequences with more than threshold kmers all make it, and the rest come from the ones with threshold kmers
+		int threshold = maxMatch;
+		int numAbove = 0;
+		while ((threshold > 0) && (numAbove + numWithMatch[threshold] < num)) { numAbove += numWithMatch[threshold]; threshold--; }
+		int numAtThreshold = num - numAbove;
+		
+		top.reserve(num);
+		for(int i=0;i<numSeqs;i++){
+			if (matches[i] > threshold) { top.push_back(seqMatch(i, matches[i])); }
+			else if ((matches[i] == threshold) && (numAtThreshold > 0)) { top.push_back(seqMatch(i, matches[i])); numAtThreshold--; }
+		}
+		
+		stable_sort(top.begin(), top.end(), compareSeqMatches);
+		
+		return top;
 	}
 	catch(exception& e) {
-		m->errorOut(e, "KmerDB", "findClosestSequences");
+		m->errorOut(e, "KmerDB", "getTopMatches");
 		exit(1);
 	}	
 }
-
 /**************************************************************************************************/
 
 void KmerDB::generateDB(){
 	try {
 		
-		ofstream kmerFile;										//	once we have the kmerLocations folder print it out
-		m->openOutputFile(kmerDBName, kmerFile);					//	to a file
+		if (!indexed) { buildIndex(); }
 		
-		//output version
-		kmerFile << "#" << m->getVersion() << endl;
+		//the version line lets the commands check the file is current before they read it
+		string version = "#" + m->getVersion() + "\n";
+		char zeros[8];
+		memset(zeros, 0, 8);
 		
-		for(int i=0;i<maxKmer;i++){								//	step through all of the possible kmer numbers
-			kmerFile << i << ' ' << kmerLocations[i].size();	//	print the kmer number and the number of sequences with
-			for(int j=0;j<kmerLocations[i].size();j++){			//	that kmer.  then print out the indices of the sequences
-				kmerFile << ' ' << kmerLocations[i][j];			//	with that kmer.
-			}
-			kmerFile << endl;
-		}
+		//write to a temp file and move it, so other processes never map a partly written index
+		string tempFile = kmerDBName + ".temp";
+		ofstream kmerFile;
+		m->openOutputFileBinary(tempFile, kmerFile);
+		
+		kmerFile.write(version.c_str(), version.length());		kmerFile.write(zeros, padding(version.length()));
+		kmerFile.write((char*)&indexBuffer[0], getIndexBytes(kmerOffsets[maxKmer+1]));
 		kmerFile.close();
 		
+		m->renameFile(tempFile, kmerDBName);
 	}
 	catch(exception& e) {
 		m->errorOut(e, "KmerDB", "generateDB");
@@ -154,12 +229,12 @@ void KmerDB::addSequence(Sequence seq) {
 	try {
 		Kmer kmer(kmerSize);
 		
-		string unaligned = seq.getUnaligned();	//	...take the unaligned sequence...
-		int numKmers = unaligned.length() - kmerSize + 1;
+		vector<int> kmers;
+		kmer.getKmerNumbers(seq.getUnaligned(), kmers);	//	...take the unaligned sequence...
 			
 		vector<int> seenBefore(maxKmer+1,0);
-		for(int j=0;j<numKmers;j++){						//	...step though the sequence and get each kmer...
-			int kmerNumber = kmer.getKmerNumber(unaligned, j);
+		for(int j=0;j<kmers.size();j++){					//	...step though the sequence and get each kmer...
+			int kmerNumber = kmers[j];
 			if(seenBefore[kmerNumber] == 0){
 				kmerLocations[kmerNumber].push_back(count);		//	...insert the sequence index into kmerLocations for
 			}												//	the appropriate kmer number
@@ -176,6 +251,21 @@ void KmerDB::addSequence(Sequence seq) {
 /**************************************************************************************************/
 
 void KmerDB::readKmerDB(ifstream& kmerDBFile){
+	try {
+		
+		if (mapIndex()) { kmerDBFile.close(); return; }
+		
+		readTextKmerDB(kmerDBFile);
+		buildIndex();
+	}
+	catch(exception& e) {
+		m->errorOut(e, "KmerDB", "readKmerDB");
+		exit(1);
+	}	
+}
+/**************************************************************************************************/
+//the database files written before the index was packed
+void KmerDB::readTextKmerDB(ifstream& kmerDBFile){
 	try {
 					
 		kmerDBFile.seekg(0);									//	start at the beginning of the file
@@ -193,13 +283,132 @@ void KmerDB::readKmerDB(ifstream& kmerDBFile){
 			for(int j=0;j<numValues;j++){						//	for each kmer number get the...
 				kmerDBFile >> seqNumber;						//		1. number of sequences with the kmer number
 				kmerLocations[i].push_back(seqNumber);			//		2. sequence indices
+				count = max(count, seqNumber+1);
 			}
 		}
 		kmerDBFile.close();
 		
 	}
 	catch(exception& e) {
-		m->errorOut(e, "KmerDB", "readKmerDB");
+		m->errorOut(e, "KmerDB", "readTextKmerDB");
+		exit(1);
+	}	
+}
+/**************************************************************************************************/
+//maps the database file, returns false if it is not a packed index for this kmer size
+bool KmerDB::mapIndex(){
+	try {
+		if (!indexFile.open(kmerDBName)) { return false; }
+		
+		const char* data = indexFile.getData();
+		unsigned long long fileSize = indexFile.getSize();
+		
+		const char* lineEnd = (const char*)memchr(data, '\n', min(fileSize, (unsigned long long)1024));
+		if (lineEnd == NULL) { indexFile.close(); return false; }
+		unsigned long long start = (lineEnd - data) + 1;
+		start += padding(start);
+		if (start + KMERDB_HEADERSIZE > fileSize) { indexFile.close(); return false; }
+		
+		const char* header = data + start;
+		const unsigned int* fields = (const unsigned int*)(header + 8);
+		if (strncmp(header, KMERDB_TAG, 8) != 0)		{ indexFile.close(); return false; }
+		if (fields[0] != KMERDB_VERSION)				{ indexFile.close(); return false; }
+		if (fields[1] != kmerSize)						{ indexFile.close(); return false; }
+		if (fields[3] != maxKmer+1)						{ indexFile.close(); return false; }
+		
+		unsigned long long postingBytes = *((const unsigned long long*)(header + 24));
+		if (start + getIndexBytes(postingBytes) > fileSize) { m->mothurOut("[WARNING]: " + kmerDBName + " is truncated, ignoring it.\n"); indexFile.close(); return false; }
+		
+		count = fields[2];
+		kmerLocations.clear();
+		setIndex(header, postingBytes);
+		indexed = true;
+		
+		return true;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "KmerDB", "mapIndex");
+		exit(1);
+	}	
+}
+/**************************************************************************************************/
+//packs kmerLocations into indexBuffer, in the same layout as the file after the version line
+void KmerDB::buildIndex(){
+	try {
+		lock_guard<mutex> guard(indexLock);
+		if (indexed) { return; }
+		
+		int numKmers = maxKmer + 1;
+		vector<unsigned int> counts(numKmers, 0);
+		vector<unsigned long long> offsets(numKmers+1, 0);
+		vector<unsigned char> postings;
+		
+		for(int i=0;i<numKmers;i++){
+			counts[i] = kmerLocations[i].size();
+			offsets[i] = postings.size();
+			
+			int last = 0;
+			for(int j=0;j<kmerLocations[i].size();j++){		//	the sequences were added in order, so the differences are positive
+				unsigned int delta = kmerLocations[i][j] - last;
+				last = kmerLocations[i][j];
+				while (delta >= 128) { postings.push_back((unsigned char)((delta & 127) | 128)); delta >>= 7; }
+				postings.push_back((unsigned char)delta);
+			}
+			vector<int>().swap(kmerLocations[i]);				//	free the list once it is packed
+		}
+		offsets[numKmers] = postings.size();
+		
+		indexBuffer.assign((getIndexBytes(postings.size()) + 7) / 8, 0);
+		char* header = (char*)&indexBuffer[0];
+		unsigned int fields[4] = { KMERDB_VERSION, (unsigned int)kmerSize, (unsigned int)count, (unsigned int)numKmers };
+		unsigned long long postingBytes = postings.size();
+		memcpy(header, KMERDB_TAG, 8);
+		memcpy(header+8, fields, sizeof(fields));
+		memcpy(header+24, &postingBytes, sizeof(unsigned long long));
+		
+		unsigned long long countsStart = KMERDB_HEADERSIZE;
+		unsigned long long offsetsStart = countsStart + numKmers * sizeof(unsigned int);	offsetsStart += padding(offsetsStart);
+		unsigned long long postingsStart = offsetsStart + (numKmers+1) * sizeof(unsigned long long);
+		memcpy(header + countsStart, &counts[0], numKmers * sizeof(unsigned int));
+		memcpy(header + offsetsStart, &offsets[0], (numKmers+1) * sizeof(unsigned long long));
+		if (postingBytes != 0) { memcpy(header + postingsStart, &postings[0], postingBytes); }
+		
+		setIndex(header, postingBytes);
+		indexed = true;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "KmerDB", "buildIndex");
+		exit(1);
+	}	
+}
+/**************************************************************************************************/
+//bytes from the tag to the end of the postings
+unsigned long long KmerDB::getIndexBytes(unsigned long long postingBytes){
+	unsigned long long numKmers = maxKmer + 1;
+	unsigned long long bytes = KMERDB_HEADERSIZE + numKmers * sizeof(unsigned int);
+	bytes += padding(bytes);
+	bytes += (numKmers+1) * sizeof(unsigned long long);
+	return bytes + postingBytes;
+}
+/**************************************************************************************************/
+
+void KmerDB::setIndex(const char* header, unsigned long long postingBytes){
+	unsigned long long numKmers = maxKmer + 1;
+	unsigned long long offsetsStart = KMERDB_HEADERSIZE + numKmers * sizeof(unsigned int);
+	offsetsStart += padding(offsetsStart);
+	
+	kmerCounts = (const unsigned int*)(header + KMERDB_HEADERSIZE);
+	kmerOffsets = (const unsigned long long*)(header + offsetsStart);
+	kmerPostings = (const unsigned char*)(header + offsetsStart + (numKmers+1) * sizeof(unsigned long long));
+}
+/**************************************************************************************************/
+void KmerDB::setNumSeqs(int i) {
+	try {
+		numSeqs = i;
+		if (!indexed) { buildIndex(); }
+	}
+	catch(exception& e) {
+		m->errorOut(e, "KmerDB", "setNumSeqs");
 		exit(1);
 	}	
 }
@@ -209,7 +418,10 @@ int KmerDB::getCount(int kmer) {
 	try {
 		if (kmer < 0) { return 0; }  //if user gives negative number
 		else if (kmer > maxKmer) {	return 0;	}  //or a kmer that is bigger than maxkmer
-		else {	return kmerLocations[kmer].size();	}  // kmer is in vector range
+		else {	
+			if (!indexed) { buildIndex(); }
+			return kmerCounts[kmer];	
+		}  // kmer is in vector range
 	}
 	catch(exception& e) {
 		m->errorOut(e, "KmerDB", "getCount");
@@ -238,7 +450,13 @@ vector<int> KmerDB::getSequencesWithKmer(int kmer) {
 	
 		if (kmer < 0) { }  //if user gives negative number
 		else if (kmer > maxKmer) {	}  //or a kmer that is bigger than maxkmer
-		else {	seqs = kmerLocations[kmer];	}
+		else {	
+			if (!indexed) { buildIndex(); }
+			const unsigned char* posting = kmerPostings + kmerOffsets[kmer];
+			int seq = 0;
+			seqs.resize(kmerCounts[kmer]);
+			for (int i = 0; i < seqs.size(); i++) { seq += readVarint(posting); seqs[i] = seq; }
+		}
 		
 		return seqs;
 	}
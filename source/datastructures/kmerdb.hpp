@@ -10,17 +10,27 @@
  *
  *	This class is a child class of the Database class, which stores the template sequences as a kmer table and provides
  *	a method of searching the kmer table for the sequence with the most kmers in common with a query sequence.
- *	kmerLocations is the primary storage variable that is a two-dimensional vector where each row represents the
- *	different number of kmers and each column contains the index to sequences that use that kmer.
+ *	The sequences are added to kmerLocations, one vector of sequence indices per kmer, and then packed into a compressed
+ *	index: the number of sequences with each kmer, and where each kmer's list starts in the postings, where each index
+ *	is stored as the varint of its difference from the one before.  The index is what is searched.
  *
  *	Construction of an object of this type will first look for an appropriately named database file and if it is found
  *	then will read in the database file (readKmerDB), otherwise it will generate one and store the data in memory
- *	(generateKmerDB)
+ *	(generateKmerDB).  The database file is the index itself, after a "#version" line, so it is mapped into memory and
+ *	searched without reading it, and processes using the same template share it.
+ *
+ *	file:		"#version\n", padded with '\0' to an 8 byte boundary
+ *				8 byte tag "MOTHURKM", unsigned ints format version, kmer size, number of sequences and number of kmers
+ *				(4^k + 1, the last for kmers with an N), ull bytes of postings
+ *				unsigned int counts[numKmers], padded to an 8 byte boundary
+ *				ull offsets[numKmers+1]
+ *				unsigned char postings[]
 
  */
 
 #include "mothur.h"
 #include "database.hpp"
+#include "mappedfile.h"
 
 class KmerDB : public Database {
 	
@@ -31,7 +41,9 @@ public:
 	
 	void generateDB();
 	void addSequence(Sequence);
+	void setNumSeqs(int);		//called once the sequences are added or read, so it packs the index
 	vector<int> findClosestSequences(Sequence*, int);
+	vector<int> findClosestSequences(Sequence*, int, float&);
 	void readKmerDB(ifstream&);
 	int getCount(int);  //returns number of sequences with that kmer number
 	vector<int> getSequencesWithKmer(int);  //returns vector of sequences that contain kmer passed in
@@ -43,7 +55,32 @@ private:
 	int kmerSize;
 	int maxKmer, count;
 	string kmerDBName;
-	vector<vector<int> > kmerLocations;
+	vector<vector<int> > kmerLocations;		//the sequences with each kmer, until the index is packed
+	
+	const unsigned int* kmerCounts;
+	const unsigned long long* kmerOffsets;
+	const unsigned char* kmerPostings;
+	vector<unsigned long long> indexBuffer;	//the index when it is built here, laid out like the file
+	MappedFile indexFile;					//the index when it is read
+	atomic<bool> indexed;					//read without the lock, so it is only set once the index is ready
+	mutex indexLock;
+	
+	vector<int> findClosestSequences(Sequence*, int, float&, vector<float>&);
+	vector<seqMatch> getTopMatches(vector<int>&, int);
+	void buildIndex();
+	bool mapIndex();
+	void readTextKmerDB(ifstream&);
+	unsigned long long getIndexBytes(unsigned long long);
+	void setIndex(const char*, unsigned long long);
+	
+	static unsigned long long padding(unsigned long long bytes) { return (8 - (bytes % 8)) % 8; }
+	static unsigned int readVarint(const unsigned char*& p) {
+		unsigned int value = 0;
+		int shift = 0;
+		unsigned char byte;
+		do { byte = *p++; value |= (unsigned int)(byte & 127) << shift; shift += 7; } while (byte & 128);
+		return value;
+	}
 };
 
 #endif
@@ -13,27 +13,13 @@
 #include "ordervector.hpp"
 #include "listvector.hpp"
 
-//sorts highest to lowest
+//sorts the OTUs' indexes highest to lowest by size
 /***********************************************************************/
-inline bool abundNamesSort(string left, string right){
-    
-    int countLeft = 0;
-    if(left != ""){
-        countLeft = 1;
-        for(int i=0;i<left.size();i++){  if(left[i] == ','){  countLeft++;  }  }
-    }
-    
-    int countRight = 0;
-    if(right != ""){
-        countRight = 1;
-        for(int i=0;i<right.size();i++){  if(right[i] == ','){  countRight++;  }  }
-    }
-    
-	if (countLeft > countRight) {
-        return true;
-    }
-    return false;	
-}
+struct abundIdsSort {
+    vector<int>& sizes;
+    abundIdsSort(vector<int>& s) : sizes(s) {}
+    bool operator()(int left, int right) const { return (sizes[left] > sizes[right]); }
+};
 //sorts highest to lowest
 /***********************************************************************/
 inline bool abundNamesSort2(listCt left, listCt right){
@@ -48,19 +34,24 @@ inline bool abundNamesSort2(listCt left, listCt right){
 
 /***********************************************************************/
 
-ListVector::ListVector() : DataVector(), maxRank(0), numBins(0), numSeqs(0){}
+ListVector::ListVector() : DataVector(), numUnused(0), maxRank(0), numBins(0), numSeqs(0){}
 
 /***********************************************************************/
 
-ListVector::ListVector(int n):	DataVector(), data(n, "") , maxRank(0), numBins(0), numSeqs(0){}
+ListVector::ListVector(int n):	DataVector(), starts(n, 0), sizes(n, 0), numUnused(0), maxRank(0), numBins(0), numSeqs(0){}
 
 /***********************************************************************/
 
-ListVector::ListVector(string id, vector<string> lv) : DataVector(id), data(lv){
+ListVector::ListVector(string id, vector<string> lv) : DataVector(id), starts(lv.size(), 0), sizes(lv.size(), 0), numUnused(0), maxRank(0), numBins(0), numSeqs(0){
 	try {
-		for(int i=0;i<data.size();i++){
-			if(data[i] != ""){
-				int binSize = m->getNumNames(data[i]);
+		SeqNameTable* names = SeqNameTable::getInstance();
+		for(int i=0;i<lv.size();i++){
+			starts[i] = ids.size();
+			names->getIds(lv[i], ids);
+			sizes[i] = ids.size() - starts[i];
+			
+			if(sizes[i] != 0){
+				int binSize = sizes[i];
 				numBins = i+1;
 				if(binSize > maxRank)	{	maxRank = binSize;	}
 				numSeqs += binSize;
@@ -73,9 +64,49 @@ ListVector::ListVector(string id, vector<string> lv) : DataVector(id), data(lv){
 	}
 }
 
+/***********************************************************************/
+
+ListVector::ListVector(const ListVector& lv) : DataVector(lv.label), maxRank(lv.maxRank), numBins(lv.numBins), numSeqs(lv.numSeqs), binLabels(lv.binLabels) {
+	copyIds(lv);
+}
+
+/***********************************************************************/
+
+ListVector& ListVector::operator=(const ListVector& lv){
+	if (this != &lv) {
+		label = lv.label;
+		maxRank = lv.maxRank;
+		numBins = lv.numBins;
+		numSeqs = lv.numSeqs;
+		binLabels = lv.binLabels;
+		copyIds(lv);
+	}
+	return *this;
+}
+
+/***********************************************************************/
+//copies the OTUs leaving out the ids no OTU uses anymore, reusing the memory this list already has
+void ListVector::copyIds(const ListVector& lv){
+	try {
+		ids.clear();
+		ids.reserve(lv.ids.size() - lv.numUnused);
+		sizes = lv.sizes;
+		starts.resize(sizes.size());
+		for (int i = 0; i < sizes.size(); i++) {
+			starts[i] = ids.size();
+			ids.insert(ids.end(), lv.ids.begin()+lv.starts[i], lv.ids.begin()+lv.starts[i]+sizes[i]);
+		}
+		numUnused = 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ListVector", "copyIds");
+		exit(1);
+	}
+}
+
 /**********************************************************************/
 
-ListVector::ListVector(ifstream& f) : DataVector(), maxRank(0), numBins(0), numSeqs(0) {
+ListVector::ListVector(ifstream& f) : DataVector(), numUnused(0), maxRank(0), numBins(0), numSeqs(0) {
 	try {
 		int hold;
         
@@ -131,7 +162,8 @@ ListVector::ListVector(ifstream& f) : DataVector(), maxRank(0), numBins(0), numS
 	
         binLabels.assign(m->listBinLabelsInFile.begin(), m->listBinLabelsInFile.begin()+hold);
 		
-		data.assign(hold, "");
+		starts.assign(hold, 0);
+		sizes.assign(hold, 0);
 		string inputData = "";
 	
 		for(int i=0;i<hold;i++){
@@ -152,18 +184,59 @@ ListVector::ListVector(ifstream& f) : DataVector(), maxRank(0), numBins(0), numS
 
 void ListVector::set(int binNumber, string seqNames){
 	try {
-		int nNames_old = m->getNumNames(data[binNumber]);
-		data[binNumber] = seqNames;
-		int nNames_new = m->getNumNames(seqNames);
+		vector<int> newIds;
+		SeqNameTable::getInstance()->getIds(seqNames, newIds);
+		setIds(binNumber, newIds);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ListVector", "set");
+		exit(1);
+	}
+}
+
+/***********************************************************************/
+
+void ListVector::setIds(int binNumber, vector<int>& newIds){
+	try {
+		int nNames_old = sizes[binNumber];
+		int nNames_new = newIds.size();
+		
+		numUnused += nNames_old;
+		starts[binNumber] = ids.size();
+		sizes[binNumber] = nNames_new;
+		ids.insert(ids.end(), newIds.begin(), newIds.end());
 	
 		if(nNames_old == 0)			{	numBins++;				}
 		if(nNames_new == 0)			{	numBins--;				}
 		if(nNames_new > maxRank)	{	maxRank = nNames_new;	}
 	
 		numSeqs += (nNames_new - nNames_old);
+		
+		//once more than half the ids are unused
+		if (numUnused > (ids.size() - numUnused)) { pack(); }
 	}
 	catch(exception& e) {
-		m->errorOut(e, "ListVector", "set");
+		m->errorOut(e, "ListVector", "setIds");
+		exit(1);
+	}
+}
+
+/***********************************************************************/
+
+void ListVector::pack(){
+	try {
+		vector<int> packed;
+		packed.reserve(ids.size() - numUnused);
+		for (int i = 0; i < sizes.size(); i++) {
+			int start = packed.size();
+			packed.insert(packed.end(), ids.begin()+starts[i], ids.begin()+starts[i]+sizes[i]);
+			starts[i] = start;
+		}
+		ids.swap(packed);
+		numUnused = 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ListVector", "pack");
 		exit(1);
 	}
 }
@@ -171,7 +244,48 @@ void ListVector::set(int binNumber, string seqNames){
 /***********************************************************************/
 
 string ListVector::get(int index){
-	return data[index];
+	try {
+		string names = "";
+		if (sizes[index] != 0) { SeqNameTable::getInstance()->appendNames(&ids[starts[index]], sizes[index], names); }
+		return names;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ListVector", "get");
+		exit(1);
+	}
+}
+
+/***********************************************************************/
+
+int ListVector::getBinSize(int index){
+	return sizes[index];
+}
+
+/***********************************************************************/
+
+vector<int> ListVector::getIds(int index){
+	return vector<int>(ids.begin()+starts[index], ids.begin()+starts[index]+sizes[index]);
+}
+
+/***********************************************************************/
+//same as set(binNumber, get(first)+','+get(second)), where an empty OTU leaves an empty name
+void ListVector::merge(int binNumber, int first, int second){
+	try {
+		vector<int> newIds;
+		newIds.reserve(sizes[first] + sizes[second] + 1);
+		
+		if (sizes[first] == 0)	{	newIds.push_back(SeqNameTable::getInstance()->getId(""));	}
+		else					{	newIds.insert(newIds.end(), ids.begin()+starts[first], ids.begin()+starts[first]+sizes[first]);	}
+		
+		if (sizes[second] == 0)	{	newIds.push_back(SeqNameTable::getInstance()->getId(""));	}
+		else					{	newIds.insert(newIds.end(), ids.begin()+starts[second], ids.begin()+starts[second]+sizes[second]);	}
+		
+		setIds(binNumber, newIds);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ListVector", "merge");
+		exit(1);
+	}
 }
 /***********************************************************************/
 
@@ -195,7 +309,7 @@ vector<string> ListVector::getLabels(){
         string tagHeader = "Otu";
         if (m->sharedHeaderMode == "tax") { tagHeader = "PhyloType"; }
         
-        if (binLabels.size() < data.size()) {
+        if (binLabels.size() < sizes.size()) {
             string snumBins = toString(numBins);
             
             for (int i = 0; i < numBins; i++) {
@@ -232,8 +346,24 @@ vector<string> ListVector::getLabels(){
 
 void ListVector::push_back(string seqNames){
 	try {
-		data.push_back(seqNames);
-		int nNames = m->getNumNames(seqNames);
+		vector<int> newIds;
+		SeqNameTable::getInstance()->getIds(seqNames, newIds);
+		push_back(newIds);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ListVector", "push_back");
+		exit(1);
+	}
+}
+
+/***********************************************************************/
+
+void ListVector::push_back(vector<int>& newIds){
+	try {
+		starts.push_back(ids.size());
+		sizes.push_back(newIds.size());
+		ids.insert(ids.end(), newIds.begin(), newIds.end());
+		int nNames = newIds.size();
 	
 		numBins++;
 	
@@ -250,13 +380,15 @@ void ListVector::push_back(string seqNames){
 /***********************************************************************/
 
 void ListVector::resize(int size){
-	data.resize(size);		
+	for (int i = size; i < sizes.size(); i++) { numUnused += sizes[i]; }
+	starts.resize(size, 0);
+	sizes.resize(size, 0);
 }
 
 /***********************************************************************/
 
 int ListVector::size(){
-	return data.size();
+	return sizes.size();
 }
 /***********************************************************************/
 
@@ -264,7 +396,10 @@ void ListVector::clear(){
 	numBins = 0;
 	maxRank = 0;
 	numSeqs = 0;
-	return data.clear();
+	numUnused = 0;
+	ids.clear();
+	starts.clear();
+	return sizes.clear();
 	
 }
 
@@ -300,10 +435,10 @@ void ListVector::print(ostream& output, map<string, int>& ct){
 	
         
         vector<listCt> hold;
-        for (int i = 0; i < data.size(); i++) {
-            if (data[i] != "") {
+        for (int i = 0; i < sizes.size(); i++) {
+            if (sizes[i] != 0) {
                 vector<string> binNames;
-                string bin = data[i];
+                string bin = get(i);
                 m->splitAtComma(bin, binNames);
                 int total = 0;
                 for (int j = 0; j < binNames.size(); j++) {
@@ -312,7 +447,7 @@ void ListVector::print(ostream& output, map<string, int>& ct){
                         m->mothurOut("[ERROR]: " + binNames[j] + " is not in your count table. Please correct.\n"); m->control_pressed = true;
                     }else { total += ct[binNames[j]]; }
                 }
-                listCt temp(data[i], total);
+                listCt temp(bin, total);
                 hold.push_back(temp);
             }
         }
@@ -338,16 +473,18 @@ void ListVector::print(ostream& output){
     try {
         output << label << '\t' << numBins;
         
-        vector<string> hold = data;
-        sort(hold.begin(), hold.end(), abundNamesSort);
+        //sorted by size like the names would be, so the order is the same
+        vector<int> hold;
+        for (int i = 0; i < sizes.size(); i++) { hold.push_back(i); }
+        sort(hold.begin(), hold.end(), abundIdsSort(sizes));
         
         //find first non blank otu
         int start = 0;
-        for(int i=0;i<hold.size();i++){  if(hold[i] != ""){  start = i; break; } }
+        for(int i=0;i<hold.size();i++){  if(sizes[hold[i]] != 0){  start = i; break; } }
         
         for(int i=start;i<hold.size();i++){
-            if(hold[i] != ""){
-                output << '\t' << hold[i];
+            if(sizes[hold[i]] != 0){
+                output << '\t' << get(hold[i]);
             }
         }
         output << endl;
@@ -364,9 +501,8 @@ RAbundVector ListVector::getRAbundVector(){
 	try {
 		RAbundVector rav;
 	
-		for(int i=0;i<data.size();i++){
-			int binSize = m->getNumNames(data[i]);
-			rav.push_back(binSize);
+		for(int i=0;i<sizes.size();i++){
+			rav.push_back(sizes[i]);
 		}
 	
 	//  This was here before to output data in a nice format, but it screws up the name mapping steps
@@ -394,8 +530,8 @@ SAbundVector ListVector::getSAbundVector(){
 	try {
 		SAbundVector sav(maxRank+1);
 	
-		for(int i=0;i<data.size();i++){
-			int binSize = m->getNumNames(data[i]);	
+		for(int i=0;i<sizes.size();i++){
+			int binSize = sizes[i];	
 			sav.set(binSize, sav.get(binSize) + 1);	
 		}
 		sav.set(0, 0);
@@ -417,8 +553,8 @@ OrderVector ListVector::getOrderVector(map<string,int>* orderMap = NULL){
 		if(orderMap == NULL){
 			OrderVector ov;
 		
-			for(int i=0;i<data.size();i++){
-				int binSize = m->getNumNames(data[i]);		
+			for(int i=0;i<sizes.size();i++){
+				int binSize = sizes[i];		
 				for(int j=0;j<binSize;j++){
 					ov.push_back(i);
 				}
@@ -433,8 +569,8 @@ OrderVector ListVector::getOrderVector(map<string,int>* orderMap = NULL){
 		else{
 			OrderVector ov(numSeqs);
 		
-			for(int i=0;i<data.size();i++){
-				string listOTU = data[i];
+			for(int i=0;i<sizes.size();i++){
+				string listOTU = get(i);
 				int length = listOTU.size();
 				
 				string seqName="";
@@ -2,12 +2,14 @@
 #define LIST_H
 
 #include "datavector.hpp"
+#include "seqnametable.h"
 
 /*	DataStructure for a list file.
 	This class is a child to datavector.  It represents OTU information at a certain distance. 
 	A list vector can be converted into and ordervector, rabundvector or sabundvector.
-	Each member of the internal container "data" represents an individual OTU.
-	So data[0] = "a,b,c,d,e,f".
+	Each OTU is a list of sequence names, and get(0) = "a,b,c,d,e,f".
+	The names are kept once in the SeqNameTable and the OTUs only keep their ids, end to end in one vector,
+	so the names are only joined with commas when an OTU is asked for with get or printed.
 	example: listvector		=	a,b,c,d,e,f		g,h,i		j,k		l		m  
 			 rabundvector	=	6				3			2		1		1
 			 sabundvector	=	2		1		1		0		0		1
@@ -20,19 +22,25 @@ public:
 	ListVector(int);
 //	ListVector(const ListVector&);
 	ListVector(string, vector<string>);
-	ListVector(const ListVector& lv) : DataVector(lv.label), data(lv.data), maxRank(lv.maxRank), numBins(lv.numBins), numSeqs(lv.numSeqs), binLabels(lv.binLabels) {};
+	ListVector(const ListVector&);
 	ListVector(ifstream&);
 	~ListVector(){};
 	
+	ListVector& operator=(const ListVector&);
+	
 	int getNumBins()							{	return numBins;		}
 	int getNumSeqs()							{	return numSeqs;		}
 	int getMaxRank()							{	return maxRank;		}
 
 	void set(int, string);	
 	string get(int);
+	int getBinSize(int);			//number of names in the OTU
+	vector<int> getIds(int);		//the SeqNameTable ids of the names in the OTU
+	void merge(int, int, int);		//sets the OTU to the names of the second OTU followed by the third's
     vector<string> getLabels();
     void setLabels(vector<string>);
 	void push_back(string);
+	void push_back(vector<int>&);	//the SeqNameTable ids of the OTU's names
 	void resize(int);
 	void clear();
 	int size();
@@ -45,11 +53,18 @@ public:
 	OrderVector getOrderVector(map<string,int>*);
 	
 private:
-	vector<string> data;  //data[i] is a list of names of sequences in the ith OTU.
+	vector<int> ids;		//the ids of the names in the OTUs
+	vector<int> starts;		//OTU i is the sizes[i] ids from starts[i]
+	vector<int> sizes;
+	int numUnused;			//ids left behind by OTUs that were set again
 	int maxRank;
 	int numBins;
 	int numSeqs;
     vector<string> binLabels;
+	
+	void setIds(int, vector<int>&);
+	void pack();
+	void copyIds(const ListVector&);
 
 };
 
@@ -0,0 +1,87 @@
+/*
+ *  mappedfile.cpp
+ *  Mothur
+ *
+ *  Copyright 2026 Schloss Lab. All rights reserved.
+ *
+ */
+
+#include "mappedfile.h"
+
+#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+	#include <sys/mman.h>
+	#include <fcntl.h>
+#endif
+
+/***********************************************************************/
+
+MappedFile::MappedFile() {
+	m = MothurOut::getInstance();
+	data = NULL;
+	fileSize = 0;
+}
+/***********************************************************************/
+
+MappedFile::~MappedFile() { close(); }
+
+/***********************************************************************/
+
+bool MappedFile::open(string filename) {
+	try {
+		close();
+
+		ifstream test(filename.c_str(), ios::binary);
+		if (!test) { return false; }
+		test.close();
+
+	#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+		int fd = ::open(filename.c_str(), O_RDONLY);
+		if (fd == -1) { return false; }
+
+		struct stat st;
+		fstat(fd, &st);
+		fileSize = st.st_size;
+		if (fileSize == 0) { ::close(fd); return false; }
+
+		void* mapped = mmap(NULL, fileSize, PROT_READ, MAP_SHARED, fd, 0);
+		::close(fd);
+		if (mapped == MAP_FAILED) { m->mothurOut("[WARNING]: Could not map " + filename + " into memory, ignoring it.\n"); fileSize = 0; return false; }
+		data = (char*)mapped;
+	#else
+		ifstream in;
+		m->openInputFileBinary(filename, in);
+		in.seekg(0, ios::end);
+		fileSize = in.tellg();
+		in.seekg(0, ios::beg);
+		if (fileSize == 0) { in.close(); return false; }
+		buffer.resize(fileSize);
+		in.read(&buffer[0], fileSize);
+		in.close();
+		data = &buffer[0];
+	#endif
+
+		return true;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "MappedFile", "open");
+		exit(1);
+	}
+}
+/***********************************************************************/
+
+void MappedFile::close() {
+	try {
+	#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+		if (data != NULL) { munmap(data, fileSize); }
+	#else
+		buffer.clear();
+	#endif
+		data = NULL;
+		fileSize = 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "MappedFile", "close");
+		exit(1);
+	}
+}
+/***********************************************************************/
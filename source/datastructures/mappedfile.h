@@ -0,0 +1,48 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+/*
+ *  mappedfile.h
+ *  Mothur
+ *
+ *  Copyright 2026 Schloss Lab. All rights reserved.
+ *
+ */
+
+#include "mothur.h"
+#include "mothurout.h"
+
+/* A read only view of a whole file. On Mac and Linux the file is mapped shared, so every process reading the same file
+ uses the same pages, and nothing is read until it is used. Elsewhere the file is read into memory. */
+
+/******************************************************/
+
+class MappedFile {
+
+public:
+	MappedFile();
+	~MappedFile();
+
+	bool open(string);				//returns false if the file is missing or can not be mapped
+	void close();
+
+	const char* getData()				{ return data;		}
+	unsigned long long getSize()		{ return fileSize;	}
+	bool isOpen()						{ return (data != NULL);	}
+
+private:
+	MothurOut* m;
+	char* data;
+	unsigned long long fileSize;
+
+	#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+	#else
+	vector<char> buffer;
+	#endif
+
+	MappedFile(const MappedFile&){}				// Disable copy constructor
+	void operator=(const MappedFile&){}			// Disable assignment operator
+};
+
+/******************************************************/
+
+#endif
@@ -23,7 +23,6 @@ ReferenceDB* ReferenceDB::getInstance()  {
 void ReferenceDB::clearMemory()  {
 	referenceSeqs.clear();	
 	setSavedReference("");
-	for(int i = 0; i < wordGenusProb.size(); i++) { wordGenusProb[i].clear(); }
 	wordGenusProb.clear();
 	WordPairDiffArr.clear();
 	setSavedTaxonomy("");
@@ -25,7 +25,7 @@ class ReferenceDB {
 	
 		bool save;
 		vector<Sequence> referenceSeqs;
-		vector< vector<float> > wordGenusProb;
+		vector<float> wordGenusProb;
 		vector<diffPair> WordPairDiffArr;
 	
 		string getSavedReference()			{ return referencefile;		}
@@ -0,0 +1,172 @@
+/*
+ *  seqnametable.cpp
+ *  Mothur
+ *
+ *  Copyright 2026 Schloss Lab. All rights reserved.
+ *
+ */
+
+#include "seqnametable.h"
+
+/***********************************************************************/
+SeqNameTable* SeqNameTable::getInstance() {
+	if (myInstance == NULL) {
+		myInstance = new SeqNameTable();
+	}
+	return myInstance;
+}
+/***********************************************************************/
+void SeqNameTable::getIds(const string& names, vector<int>& ids) {
+	try {
+		if (names == "") { return; }
+
+		lock_guard<mutex> guard(lock);
+
+		const char* start = names.c_str();
+		const char* end = start + names.length();
+		while (true) {
+			const char* comma = start;
+			while ((comma != end) && (*comma != ',')) { comma++; }
+
+			ids.push_back(findId(start, comma - start));
+
+			if (comma == end) { break; }
+			start = comma + 1;
+		}
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SeqNameTable", "getIds");
+		exit(1);
+	}
+}
+/***********************************************************************/
+int SeqNameTable::getId(const string& name) {
+	try {
+		lock_guard<mutex> guard(lock);
+		return findId(name.c_str(), name.length());
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SeqNameTable", "getId");
+		exit(1);
+	}
+}
+/***********************************************************************/
+string SeqNameTable::getName(int id) {
+	try {
+		lock_guard<mutex> guard(lock);
+		return string(chars.data() + nameStarts[id], chars.data() + nameStarts[id+1]);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SeqNameTable", "getName");
+		exit(1);
+	}
+}
+/***********************************************************************/
+void SeqNameTable::getNames(const vector<int>& ids, vector<string>& names) {
+	try {
+		lock_guard<mutex> guard(lock);
+
+		names.resize(ids.size());
+		for (int i = 0; i < ids.size(); i++) { names[i].assign(chars.data() + nameStarts[ids[i]], chars.data() + nameStarts[ids[i]+1]); }
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SeqNameTable", "getNames");
+		exit(1);
+	}
+}
+/***********************************************************************/
+void SeqNameTable::appendNames(const int* ids, int numIds, string& names) {
+	try {
+		lock_guard<mutex> guard(lock);
+
+		unsigned long long length = names.length();
+		for (int i = 0; i < numIds; i++) { length += nameStarts[ids[i]+1] - nameStarts[ids[i]] + 1; }
+		names.reserve(length);
+
+		for (int i = 0; i < numIds; i++) {
+			if (i != 0) { names += ','; }
+			names.append(chars.data() + nameStarts[ids[i]], chars.data() + nameStarts[ids[i]+1]);
+		}
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SeqNameTable", "appendNames");
+		exit(1);
+	}
+}
+/***********************************************************************/
+int SeqNameTable::getNumNames() {
+	lock_guard<mutex> guard(lock);
+	return nameStarts.size() - 1;
+}
+/***********************************************************************/
+void SeqNameTable::clear() {
+	try {
+		lock_guard<mutex> guard(lock);
+
+		vector<char>().swap(chars);
+		vector<unsigned long long>(1, 0).swap(nameStarts);
+		vector<int>(1024, -1).swap(slots);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SeqNameTable", "clear");
+		exit(1);
+	}
+}
+/***********************************************************************/
+//the id of the name, adding it if it is not in the table yet. The caller holds the lock.
+int SeqNameTable::findId(const char* name, int length) {
+	try {
+		unsigned long long mask = slots.size() - 1;
+		unsigned long long slot = hashName(name, length) & mask;
+
+		while (slots[slot] != -1) {
+			int id = slots[slot];
+			unsigned long long start = nameStarts[id];
+			if (((nameStarts[id+1] - start) == length) && ((length == 0) || (memcmp(chars.data() + start, name, length) == 0))) { return id; }
+			slot = (slot + 1) & mask;
+		}
+
+		int id = nameStarts.size() - 1;
+		chars.insert(chars.end(), name, name + length);
+		nameStarts.push_back(chars.size());
+		slots[slot] = id;
+
+		//keeps the table at most half full
+		if ((nameStarts.size() - 1) * 2 > slots.size()) { growSlots(); }
+
+		return id;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SeqNameTable", "findId");
+		exit(1);
+	}
+}
+/***********************************************************************/
+unsigned long long SeqNameTable::hashName(const char* name, int length) {
+	unsigned long long hash = 14695981039346656037ULL;
+	for (int i = 0; i < length; i++) {
+		hash ^= (unsigned char)name[i];
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+/***********************************************************************/
+void SeqNameTable::growSlots() {
+	try {
+		slots.assign(slots.size() * 2, -1);
+		unsigned long long mask = slots.size() - 1;
+
+		int numNames = nameStarts.size() - 1;
+		for (int id = 0; id < numNames; id++) {
+			unsigned long long start = nameStarts[id];
+			unsigned long long slot = hashName(chars.data() + start, nameStarts[id+1] - start) & mask;
+			while (slots[slot] != -1) { slot = (slot + 1) & mask; }
+			slots[slot] = id;
+		}
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SeqNameTable", "growSlots");
+		exit(1);
+	}
+}
+/***********************************************************************/
@@ -0,0 +1,55 @@
+#ifndef SEQNAMETABLE_H
+#define SEQNAMETABLE_H
+
+/*
+ *  seqnametable.h
+ *  Mothur
+ *
+ *  Copyright 2026 Schloss Lab. All rights reserved.
+ *
+ */
+
+/* SeqNameTable keeps one copy of each sequence name a list vector has seen, and gives each name an id. The list
+ vectors keep the ids of their names, so the labels of a list file and the copies made while clustering share the
+ names instead of each holding its own comma separated strings. The names are kept end to end in one buffer and found
+ with an open addressing hash table of ids. The table is cleared by the engine between commands. */
+
+#include "mothur.h"
+#include "mothurout.h"
+
+/***********************************************************************/
+
+class SeqNameTable {
+
+public:
+	static SeqNameTable* getInstance();
+
+	void getIds(const string&, vector<int>&);		//adds the ids of the comma separated names to the vector, adding the new names to the table
+	int getId(const string&);
+	string getName(int);
+	void getNames(const vector<int>&, vector<string>&);	//the names of the ids, in order
+	void appendNames(const int*, int, string&);		//ids, number of ids, the names are added to the string separated by commas
+	int getNumNames();
+	void clear();
+
+private:
+	static SeqNameTable* myInstance;
+	SeqNameTable() { m = MothurOut::getInstance(); slots.assign(1024, -1); nameStarts.push_back(0); }
+	SeqNameTable(const SeqNameTable&){}
+	void operator=(const SeqNameTable&){}
+	~SeqNameTable(){ myInstance = 0; }
+
+	MothurOut* m;
+	vector<char> chars;							//the names, end to end
+	vector<unsigned long long> nameStarts;		//where each name starts in chars, and the end of the last one
+	vector<int> slots;							//ids of the names by hash, -1 if empty
+	mutex lock;
+
+	int findId(const char*, int);
+	unsigned long long hashName(const char*, int);
+	void growSlots();
+};
+
+/***********************************************************************/
+
+#endif
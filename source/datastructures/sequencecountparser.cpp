@@ -180,26 +180,8 @@ int SequenceCountParser::getSeqs(string g, string filename, bool uchimeFormat=fa
 				//>seqName /ab=numRedundantSeqs/
 				//sequence
 				
-				map<string, int> countForThisGroup = getCountTable(g);
-				map<string, int>::iterator itCount;
-				int error = 0;
-				
-				for (int i = 0; i < seqForThisGroup.size(); i++) {
-					itCount = countForThisGroup.find(seqForThisGroup[i].getName());
-					
-					if (itCount == countForThisGroup.end()){
-						error = 1;
-						m->mothurOut("[ERROR]: " + seqForThisGroup[i].getName() + " is in your fastafile, but is not in your count file, please correct."); m->mothurOutEndLine();
-					}else {
-                        seqPriorityNode temp(itCount->second, seqForThisGroup[i].getAligned(), seqForThisGroup[i].getName());
-						nameVector.push_back(temp);
-					}
-				}
-				
+				int error = getSeqs(g, nameVector);
 				if (error == 1) { out.close(); m->mothurRemove(filename); return 1; }
-				
-				//sort by num represented
-				sort(nameVector.begin(), nameVector.end(), compareSeqPriorityNodes);
                 
 				//print new file in order of
 				for (int i = 0; i < nameVector.size(); i++) {
@@ -229,6 +211,47 @@ int SequenceCountParser::getSeqs(string g, string filename, bool uchimeFormat=fa
 	}
 }
 
+/************************************************************/
+//unique sequences in a specific group sorted by the number of seqs they represent, the order uchime checks them in
+int SequenceCountParser::getSeqs(string g, vector<seqPriorityNode>& nameVector){ 
+	try {
+		nameVector.clear();
+		
+		map<string, vector<Sequence> >::iterator it = seqs.find(g);
+		if(it == seqs.end()) {
+			m->mothurOut("[ERROR]: No sequences available for group " + g + ", please correct."); m->mothurOutEndLine();
+			return 1;
+		}
+		
+		vector<Sequence>& seqForThisGroup = it->second;
+		map<string, int> countForThisGroup = getCountTable(g);
+		map<string, int>::iterator itCount;
+		int error = 0;
+		
+		for (int i = 0; i < seqForThisGroup.size(); i++) {
+			itCount = countForThisGroup.find(seqForThisGroup[i].getName());
+			
+			if (itCount == countForThisGroup.end()){
+				error = 1;
+				m->mothurOut("[ERROR]: " + seqForThisGroup[i].getName() + " is in your fastafile, but is not in your count file, please correct."); m->mothurOutEndLine();
+			}else {
+				seqPriorityNode temp(itCount->second, seqForThisGroup[i].getAligned(), seqForThisGroup[i].getName());
+				nameVector.push_back(temp);
+			}
+		}
+		
+		if (error == 1) { return 1; }
+		
+		//sort by num represented
+		sort(nameVector.begin(), nameVector.end(), compareSeqPriorityNodes);
+		
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SequenceCountParser", "getSeqs");
+		exit(1);
+	}
+}
 /************************************************************/
 map<string, int> SequenceCountParser::getCountTable(string g){ 
 	try {
@@ -38,6 +38,7 @@ public:
     vector<Sequence> getSeqs(string); //returns unique sequences in a specific group
     map<string, int> getCountTable(string); //returns seqName -> numberOfRedundantSeqs for a specific group - the count file format, but each line is parsed by group.
     
+    int getSeqs(string, vector<seqPriorityNode>&); //unique sequences in a specific group in the order uchime checks them - group, seqs. returns 1 on error
     int getSeqs(string, string, bool); //prints unique sequences in a specific group to a file - group, filename, uchimeFormat=false
     int getCountTable(string, string); //print seqName -> numberRedundantSeqs for a specific group - group, filename
     
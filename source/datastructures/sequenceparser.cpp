@@ -372,28 +372,8 @@ int SequenceParser::getSeqs(string g, string filename, bool uchimeFormat=false){
 				//>seqName /ab=numRedundantSeqs/
 				//sequence
 				
-				map<string, string> nameMapForThisGroup = getNameMap(g);
-				map<string, string>::iterator itNameMap;
-				int error = 0;
-				
-				for (int i = 0; i < seqForThisGroup.size(); i++) {
-					itNameMap = nameMapForThisGroup.find(seqForThisGroup[i].getName());
-					
-					if (itNameMap == nameMapForThisGroup.end()){
-						error = 1;
-						m->mothurOut("[ERROR]: " + seqForThisGroup[i].getName() + " is in your fastafile, but is not in your namesfile, please correct."); m->mothurOutEndLine();
-					}else {
-						int num = m->getNumNames(itNameMap->second);
-						
-						seqPriorityNode temp(num, seqForThisGroup[i].getAligned(), seqForThisGroup[i].getName());
-						nameVector.push_back(temp);
-					}
-				}
-				
+				int error = getSeqs(g, nameVector);
 				if (error == 1) { out.close(); m->mothurRemove(filename); return 1; }
-				
-				//sort by num represented
-				sort(nameVector.begin(), nameVector.end(), compareSeqPriorityNodes);
 
 				//print new file in order of
 				for (int i = 0; i < nameVector.size(); i++) {
@@ -423,6 +403,49 @@ int SequenceParser::getSeqs(string g, string filename, bool uchimeFormat=false){
 	}
 }
 
+/************************************************************/
+//unique sequences in a specific group sorted by the number of seqs they represent, the order uchime checks them in
+int SequenceParser::getSeqs(string g, vector<seqPriorityNode>& nameVector){ 
+	try {
+		nameVector.clear();
+		
+		map<string, vector<Sequence> >::iterator it = seqs.find(g);
+		if(it == seqs.end()) {
+			m->mothurOut("[ERROR]: No sequences available for group " + g + ", please correct."); m->mothurOutEndLine();
+			return 1;
+		}
+		
+		vector<Sequence>& seqForThisGroup = it->second;
+		map<string, string> nameMapForThisGroup = getNameMap(g);
+		map<string, string>::iterator itNameMap;
+		int error = 0;
+		
+		for (int i = 0; i < seqForThisGroup.size(); i++) {
+			itNameMap = nameMapForThisGroup.find(seqForThisGroup[i].getName());
+			
+			if (itNameMap == nameMapForThisGroup.end()){
+				error = 1;
+				m->mothurOut("[ERROR]: " + seqForThisGroup[i].getName() + " is in your fastafile, but is not in your namesfile, please correct."); m->mothurOutEndLine();
+			}else {
+				int num = m->getNumNames(itNameMap->second);
+				
+				seqPriorityNode temp(num, seqForThisGroup[i].getAligned(), seqForThisGroup[i].getName());
+				nameVector.push_back(temp);
+			}
+		}
+		
+		if (error == 1) { return 1; }
+		
+		//sort by num represented
+		sort(nameVector.begin(), nameVector.end(), compareSeqPriorityNodes);
+		
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SequenceParser", "getSeqs");
+		exit(1);
+	}
+}
 /************************************************************/
 map<string, string> SequenceParser::getNameMap(string g){ 
 	try {
@@ -41,6 +41,7 @@ class SequenceParser {
 		vector<Sequence> getSeqs(string); //returns unique sequences in a specific group
 		map<string, string> getNameMap(string); //returns seqName -> namesOfRedundantSeqs separated by commas for a specific group - the name file format, but each line is parsed by group.
 		
+		int getSeqs(string, vector<seqPriorityNode>&); //unique sequences in a specific group in the order uchime checks them - group, seqs. returns 1 on error
 		int getSeqs(string, string, bool); //prints unique sequences in a specific group to a file - group, filename, uchimeFormat=false
 		int getNameMap(string, string); //print seqName -> namesOfRedundantSeqs separated by commas for a specific group - group, filename
 		
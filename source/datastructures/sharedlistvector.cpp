@@ -16,14 +16,14 @@
 
 /***********************************************************************/
 
-SharedListVector::SharedListVector() : DataVector(), maxRank(0), numBins(0), numSeqs(0){ groupmap = NULL; countTable = NULL; }
+SharedListVector::SharedListVector() : DataVector(){ groupmap = NULL; countTable = NULL; }
 
 /***********************************************************************/
 
-SharedListVector::SharedListVector(int n):	DataVector(), data(n, "") , maxRank(0), numBins(0), numSeqs(0){ groupmap = NULL; countTable = NULL; }
+SharedListVector::SharedListVector(int n):	DataVector(), otus(n){ groupmap = NULL; countTable = NULL; }
 
 /***********************************************************************/
-SharedListVector::SharedListVector(ifstream& f) : DataVector(), maxRank(0), numBins(0), numSeqs(0) {
+SharedListVector::SharedListVector(ifstream& f) : DataVector() {
 	try {
         groupmap = NULL; countTable = NULL;
 		//set up groupmap for later.
@@ -89,7 +89,7 @@ SharedListVector::SharedListVector(ifstream& f) : DataVector(), maxRank(0), numB
         
         binLabels.assign(m->listBinLabelsInFile.begin(), m->listBinLabelsInFile.begin()+hold);
 		
-		data.assign(hold, "");
+		otus.resize(hold);
 		string inputData = "";
         
 		for(int i=0;i<hold;i++){
@@ -110,17 +110,7 @@ SharedListVector::SharedListVector(ifstream& f) : DataVector(), maxRank(0), numB
 /***********************************************************************/
 void SharedListVector::set(int binNumber, string seqNames){
 	try {
-		int nNames_old = m->getNumNames(data[binNumber]);
-		data[binNumber] = seqNames;
-		int nNames_new = m->getNumNames(seqNames);
-	
-		if(nNames_old == 0)			{	numBins++;				}
-		if(nNames_new == 0)			{	numBins--;				}
-		if(nNames_new > maxRank)	{	maxRank = nNames_new;	}
-	
-		numSeqs += (nNames_new - nNames_old);
-		
-			 
+		otus.set(binNumber, seqNames);
 	}
 	catch(exception& e) {
 		m->errorOut(e, "SharedListVector", "set");
@@ -131,7 +121,7 @@ void SharedListVector::set(int binNumber, string seqNames){
 /***********************************************************************/
 
 string SharedListVector::get(int index){
-	return data[index];
+	return otus.get(index);
 }
 /***********************************************************************/
 
@@ -154,7 +144,8 @@ vector<string> SharedListVector::getLabels(){
         string tagHeader = "Otu";
         if (m->sharedHeaderMode == "tax") { tagHeader = "PhyloType"; }
         
-        if (binLabels.size() < data.size()) {
+        int numBins = otus.getNumBins();
+        if (binLabels.size() < otus.size()) {
             string snumBins = toString(numBins);
             
             for (int i = 0; i < numBins; i++) {
@@ -190,14 +181,7 @@ vector<string> SharedListVector::getLabels(){
 
 void SharedListVector::push_back(string seqNames){
 	try {
-		data.push_back(seqNames);
-		int nNames = m->getNumNames(seqNames);
-	
-		numBins++;
-	
-		if(nNames > maxRank)	{	maxRank = nNames;	}
-	
-		numSeqs += nNames;
+		otus.push_back(seqNames);
 	}
 	catch(exception& e) {
 		m->errorOut(e, "SharedListVector", "push_back");
@@ -208,33 +192,29 @@ void SharedListVector::push_back(string seqNames){
 /***********************************************************************/
 
 void SharedListVector::resize(int size){
-	data.resize(size);		
+	otus.resize(size);
 }
 
 /***********************************************************************/
 
 int SharedListVector::size(){
-	return data.size();
+	return otus.size();
 }
 /***********************************************************************/
 
 void SharedListVector::clear(){
-	numBins = 0;
-	maxRank = 0;
-	numSeqs = 0;
-	return data.clear();
-	
+	return otus.clear();
 }
 
 /***********************************************************************/
 
 void SharedListVector::print(ostream& output){
 	try {
-		output << label << '\t' << numBins;
+		output << label << '\t' << otus.getNumBins();
 	
-		for(int i=0;i<data.size();i++){
-			if(data[i] != ""){
-				output << '\t' << data[i];
+		for(int i=0;i<otus.size();i++){
+			if(otus.getBinSize(i) != 0){
+				output << '\t' << otus.get(i);
 			}
 		}
 		output << endl;
@@ -252,9 +232,8 @@ RAbundVector SharedListVector::getRAbundVector(){
 	try {
 		RAbundVector rav;
 	
-		for(int i=0;i<data.size();i++){
-			int binSize = m->getNumNames(data[i]);
-			rav.push_back(binSize);
+		for(int i=0;i<otus.size();i++){
+			rav.push_back(otus.getBinSize(i));
 		}
 	
 	//  This was here before to output data in a nice format, but it screws up the name mapping steps
@@ -280,10 +259,10 @@ RAbundVector SharedListVector::getRAbundVector(){
 
 SAbundVector SharedListVector::getSAbundVector(){
 	try {
-		SAbundVector sav(maxRank+1);
+		SAbundVector sav(otus.getMaxRank()+1);
 	
-		for(int i=0;i<data.size();i++){
-			int binSize = m->getNumNames(data[i]);	
+		for(int i=0;i<otus.size();i++){
+			int binSize = otus.getBinSize(i);
 			sav.set(binSize, sav.get(binSize) + 1);	
 		}
 		sav.set(0, 0);
@@ -303,11 +282,11 @@ SharedOrderVector* SharedListVector::getSharedOrderVector(){
 		SharedOrderVector* order = new SharedOrderVector();
 		order->setLabel(label);
 	
-		for(int i=0;i<numBins;i++){
-			int binSize = m->getNumNames(get(i));	//find number of individual in given bin	
-			string names = get(i);
+		SeqNameTable* nameTable = SeqNameTable::getInstance();
+		for(int i=0;i<otus.getNumBins();i++){
+			int binSize = otus.getBinSize(i);	//find number of individual in given bin	
             vector<string> binNames;
-            m->splitAtComma(names, binNames);
+            nameTable->getNames(otus.getIds(i), binNames);
             if (m->groupMode != "group") {
                 binSize = 0;
                 for (int j = 0; j < binNames.size(); j++) {  binSize += countTable->getNumSeqs(binNames[i]);  }
@@ -345,12 +324,12 @@ SharedRAbundVector SharedListVector::getSharedRAbundVector(string groupName) {
 	try {
         m->currentSharedBinLabels = binLabels;
         
-		SharedRAbundVector rav(data.size());
+		SharedRAbundVector rav(otus.size());
 		
-		for(int i=0;i<numBins;i++){
-			string names = get(i);
+		SeqNameTable* nameTable = SeqNameTable::getInstance();
+		for(int i=0;i<otus.getNumBins();i++){
             vector<string> binNames;
-            m->splitAtComma(names, binNames);
+            nameTable->getNames(otus.getIds(i), binNames);
             for (int j = 0; j < binNames.size(); j++) { 
 				if (m->control_pressed) { return rav; }
                 if (m->groupMode == "group") {
@@ -397,7 +376,7 @@ vector<SharedRAbundVector*> SharedListVector::getSharedRAbundVector() {
 		delete util;
 
 		for (int i = 0; i < allGroups.size(); i++) {
-			SharedRAbundVector* temp = new SharedRAbundVector(data.size());
+			SharedRAbundVector* temp = new SharedRAbundVector(otus.size());
 			finder[allGroups[i]] = temp;
 			finder[allGroups[i]]->setLabel(label);
 			finder[allGroups[i]]->setGroup(allGroups[i]);
@@ -409,10 +388,10 @@ vector<SharedRAbundVector*> SharedListVector::getSharedRAbundVector() {
 		}
 	
 		//fill vectors
-		for(int i=0;i<numBins;i++){
-			string names = get(i);  
+		SeqNameTable* nameTable = SeqNameTable::getInstance();
+		for(int i=0;i<otus.getNumBins();i++){
 			vector<string> binNames;
-            m->splitAtComma(names, binNames);
+            nameTable->getNames(otus.getIds(i), binNames);
             for (int j = 0; j < binNames.size(); j++) { 
                 if (m->groupMode == "group") {
                     string group = groupmap->getGroup(binNames[j]);
@@ -461,10 +440,10 @@ OrderVector SharedListVector::getOrderVector(map<string,int>* orderMap = NULL){
 		if(orderMap == NULL){
 			OrderVector ov;
 		
-			for(int i=0;i<data.size();i++){
-                string names = data[i];
+			SeqNameTable* nameTable = SeqNameTable::getInstance();
+			for(int i=0;i<otus.size();i++){
                 vector<string> binNames;
-                m->splitAtComma(names, binNames);
+                nameTable->getNames(otus.getIds(i), binNames);
 				int binSize = binNames.size();	
                 if (m->groupMode != "group") {
                     binSize = 0;
@@ -482,12 +461,12 @@ OrderVector SharedListVector::getOrderVector(map<string,int>* orderMap = NULL){
 		
 		}
 		else{
-			OrderVector ov(numSeqs);
+			OrderVector ov(otus.getNumSeqs());
 		
-			for(int i=0;i<data.size();i++){
-				string listOTU = data[i];
+			SeqNameTable* nameTable = SeqNameTable::getInstance();
+			for(int i=0;i<otus.size();i++){
 				vector<string> binNames;
-                m->splitAtComma(listOTU, binNames);
+                nameTable->getNames(otus.getIds(i), binNames);
                 for (int j = 0; j < binNames.size(); j++) { 
                     if(orderMap->count(binNames[j]) == 0){
                         m->mothurOut(binNames[j] + " not found, check *.names file\n");
@@ -11,6 +11,7 @@
  */
 
 #include "datavector.hpp"
+#include "listvector.hpp"
 #include "groupmap.h"
 #include "counttable.h"
 #include "sharedrabundvector.h"
@@ -19,9 +20,9 @@
 /* This class is a child to datavector.  It represents OTU information at a certain distance. 
 	A sharedlistvector can be converted into a sharedordervector, sharedrabundvector or sharedsabundvectorand 
 	as well as an ordervector, rabundvector or sabundvector.
-	Each member of the internal container "data" represents an individual OTU.
+	The OTUs are kept in a ListVector, as ids of the names in the SeqNameTable.
 	Each individual in the OTU belongs to a group.
-	So data[0] = "a,b,c,d,e,f".
+	So get(0) = "a,b,c,d,e,f".
 	example: listvector		=	a,b,c,d,e,f		g,h,i		j,k		l		m  
 			 rabundvector	=	6				3			2		1		1
 			 sabundvector	=	2		1		1		0		0		1
@@ -33,15 +34,17 @@ public:
 	SharedListVector();
 	SharedListVector(int);
 	SharedListVector(ifstream&);
-	SharedListVector(const SharedListVector& lv) : DataVector(lv.label), data(lv.data), maxRank(lv.maxRank), numBins(lv.numBins), numSeqs(lv.numSeqs), binLabels(lv.binLabels) { groupmap = NULL; countTable = NULL; };
+	SharedListVector(const SharedListVector& lv) : DataVector(lv.label), otus(lv.otus), binLabels(lv.binLabels) { groupmap = NULL; countTable = NULL; };
 	~SharedListVector(){ if (groupmap != NULL) { delete groupmap; } if (countTable != NULL) { delete countTable; } };
 	
-	int getNumBins()							{	return numBins;		}
-	int getNumSeqs()							{	return numSeqs;		}
-	int getMaxRank()							{	return maxRank;		}
+	int getNumBins()							{	return otus.getNumBins();	}
+	int getNumSeqs()							{	return otus.getNumSeqs();	}
+	int getMaxRank()							{	return otus.getMaxRank();	}
 
 	void set(int, string);	
 	string get(int);
+	int getBinSize(int index)					{	return otus.getBinSize(index);	}	//number of names in the OTU
+	vector<int> getIds(int index)				{	return otus.getIds(index);		}	//the SeqNameTable ids of the names in the OTU
     vector<string> getLabels();
     void setLabels(vector<string>);
 	void push_back(string);
@@ -59,12 +62,9 @@ public:
 	vector<SharedRAbundVector*> getSharedRAbundVector(); //returns sharedRabundVectors for all the users groups
 	
 private:
-	vector<string> data;  //data[i] is a list of names of sequences in the ith OTU.
+	ListVector otus;
 	GroupMap* groupmap;
     CountTable* countTable;
-	int maxRank;
-	int numBins;
-	int numSeqs;
     vector<string> binLabels;
 
 };
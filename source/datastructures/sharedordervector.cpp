@@ -16,9 +16,8 @@ SharedOrderVector::SharedOrderVector() : DataVector(), maxRank(0), numBins(0), n
 
 /***********************************************************************/
 
-SharedOrderVector::SharedOrderVector(string id, vector<individual>  ov) : 
-											DataVector(id), data(ov)
-{
+SharedOrderVector::SharedOrderVector(string id, vector<individual>  ov) : DataVector(id) {
+		for (int i = 0; i < ov.size(); i++) { push_back(ov[i].bin, ov[i].abundance, ov[i].group); }
 		updateStats();
 }
 
@@ -160,7 +159,7 @@ int SharedOrderVector::getMaxRank(){
 
 void SharedOrderVector::set(int index, int binNumber, int abund, string groupName){
 	
-	data[index].group = groupName;
+	data[index].group = getGroupIndex(groupName);
 	data[index].bin = binNumber;
 	data[index].abundance = abund;
 	//if (abund > maxRank) { maxRank = abund; }
@@ -170,15 +169,33 @@ void SharedOrderVector::set(int index, int binNumber, int abund, string groupNam
 /***********************************************************************/
 
 individual SharedOrderVector::get(int index){
-	return data[index];			
+	individual newGuy;
+	newGuy.group = groupNames[data[index].group];
+	newGuy.bin = data[index].bin;
+	newGuy.abundance = data[index].abundance;
+	return newGuy;
+}
+/***********************************************************************/
+
+int SharedOrderVector::getGroupIndex(string groupName){
+	//the seqs of a group are usually added together
+	if ((groupNames.size() != 0) && (groupNames.back() == groupName)) { return groupNames.size()-1; }
+	
+	map<string, int>::iterator it = groupIndexes.find(groupName);
+	if (it != groupIndexes.end()) { return it->second; }
+	
+	int index = groupNames.size();
+	groupIndexes[groupName] = index;
+	groupNames.push_back(groupName);
+	return index;
 }
 
 
 /***********************************************************************/
 //commented updateStats out to improve speed, but whoever calls this must remember to update when they are done with all the pushbacks they are doing 
 void SharedOrderVector::push_back(int binNumber, int abund, string groupName){
-	individual newGuy;
-	newGuy.group = groupName;
+	individualIndex newGuy;
+	newGuy.group = getGroupIndex(groupName);
 	newGuy.abundance = abund;
 	newGuy.bin = binNumber;
 	data.push_back(newGuy);
@@ -213,6 +230,8 @@ void SharedOrderVector::clear(){
 	maxRank = 0;
 	numSeqs = 0;
 	data.clear();
+	groupNames.clear();
+	groupIndexes.clear();
 }
 /***********************************************************************/
 
@@ -223,13 +242,13 @@ void SharedOrderVector::resize(int){
 /***********************************************************************/
 
 
-vector<individual>::iterator SharedOrderVector::begin(){
+vector<individualIndex>::iterator SharedOrderVector::begin(){
 	return data.begin();	
 }
 
 /***********************************************************************/
 
-vector<individual>::iterator SharedOrderVector::end(){
+vector<individualIndex>::iterator SharedOrderVector::end(){
 	return data.end();		
 }
 
@@ -302,9 +321,13 @@ SharedRAbundVector SharedOrderVector::getSharedRAbundVector(string group) {
 		sharedRav.setLabel(label);
 		sharedRav.setGroup(group);
 		
+		map<string, int>::iterator it = groupIndexes.find(group);
+		if (it == groupIndexes.end()) { return sharedRav; }
+		int index = it->second;
+		
 		for (int i = 0; i < data.size(); i++) {
-			if (data[i].group == group) {
-				sharedRav.set(data[i].abundance, sharedRav.getAbundance(data[i].abundance) + 1, data[i].group);
+			if (data[i].group == index) {
+				sharedRav.set(data[i].abundance, sharedRav.getAbundance(data[i].abundance) + 1, group);
 			}
 		}
 		return sharedRav;
@@ -12,7 +12,8 @@
  /* This class is a child to datavector.  It represents OTU information at a certain distance. 
 	It is similiar to an order vector except each member of data knows which group it belongs to.
 	Each member of the internal container "data" represents is an individual which knows the OTU from which it came, 
-	the group it is in and the abundance is equal to the OTU number.  */
+	the group it is in and the abundance is equal to the OTU number.  The members keep the index of their group's name, 
+	so each name is stored once instead of once per sequence.  */
 
 
 #include "datavector.hpp"
@@ -27,6 +28,14 @@ struct individual {
 	individual() {  group = ""; bin = 0; abundance = 0; }
 };
 
+//an individual whose group is an index into its vector's group names
+struct individualIndex {
+		int group;
+		int bin;
+		int abundance;
+	individualIndex() { group = 0; bin = 0; abundance = 0; }
+};
+
 struct individualFloat {
 		string group;
 		int bin;
@@ -49,7 +58,7 @@ class SharedOrderVector : public DataVector {
 public:
 	SharedOrderVector();
 //	SharedOrderVector(int ns, int nb=0, int mr=0)	: DataVector(), data(ns, -1), maxRank(0), numBins(0), numSeqs(0) {};
-	SharedOrderVector(const SharedOrderVector& ov)	: DataVector(ov.label), data(ov.data), maxRank(ov.maxRank), numBins(ov.numBins), numSeqs(ov.numSeqs), needToUpdate(ov.needToUpdate) {if(needToUpdate == 1){	updateStats();}};
+	SharedOrderVector(const SharedOrderVector& ov)	: DataVector(ov.label), data(ov.data), groupNames(ov.groupNames), groupIndexes(ov.groupIndexes), maxRank(ov.maxRank), numBins(ov.numBins), numSeqs(ov.numSeqs), needToUpdate(ov.needToUpdate) {if(needToUpdate == 1){	updateStats();}};
 
 	SharedOrderVector(string, vector<individual>);
 	SharedOrderVector(ifstream&);
@@ -60,8 +69,8 @@ public:
 	void resize(int);
 	int size();
 	void print(ostream&);
-	vector<individual>::iterator begin();
-	vector<individual>::iterator end();
+	vector<individualIndex>::iterator begin();
+	vector<individualIndex>::iterator end();
 	void push_back(int, int, string);  //OTU, abundance, group  MUST CALL UPDATE STATS AFTER PUSHBACK!!!
 	void updateStats();
 	void clear();
@@ -80,13 +89,15 @@ public:
 	
 private:
 	GroupMap* groupmap;
-	vector<individual>  data; 
-	map< int, vector<individual> >::iterator it;
+	vector<individualIndex>  data; 
+	vector<string> groupNames;
+	map<string, int> groupIndexes;		//group name -> index in groupNames
 	int maxRank;
 	int numBins;
 	int numSeqs;
 	bool needToUpdate;
 	void set(int, int, int, string);	//index, OTU, abundance, group
+	int getGroupIndex(string);			//adds the group if it is new
 	
 };
 
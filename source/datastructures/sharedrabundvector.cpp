@@ -24,15 +24,7 @@ SharedRAbundVector::~SharedRAbundVector() {
 
 /***********************************************************************/
 
-SharedRAbundVector::SharedRAbundVector(int n) : DataVector(), maxRank(0), numBins(n), numSeqs(0) {
-		individual newGuy;
-		//initialize data
-		for (int i=0; i< n; i++) {
-			newGuy.bin = i;
-			newGuy.abundance = 0;
-			data.push_back(newGuy);
-		}
-}
+SharedRAbundVector::SharedRAbundVector(int n) : DataVector(), data(n, 0), maxRank(0), numBins(n), numSeqs(0) {}
 
 /***********************************************************************
 
@@ -62,10 +54,9 @@ SharedRAbundVector::SharedRAbundVector(ifstream& f) : DataVector(), maxRank(0),
 		m->clearAllGroups();
 		vector<string> allGroups;
 		
-		int num, inputData, count;
+		int num, count;
 		count = 0;  
 		string holdLabel, nextLabel, groupN;
-		individual newguy;
 		
 		for (int i = 0; i < lookup.size(); i++) {  delete lookup[i]; lookup[i] = NULL; }  lookup.clear();
 		
@@ -138,15 +129,7 @@ SharedRAbundVector::SharedRAbundVector(ifstream& f) : DataVector(), maxRank(0),
 		allGroups.push_back(groupN);
 		
 		//fill vector.  data = first sharedrabund in file
-		for(int i=0;i<num;i++){
-			f >> inputData;
-            if (m->debug) { m->mothurOut("[DEBUG]: OTU" + toString(i+1)+ '\t' +toString(inputData)); }
-			
-			lookup[0]->push_back(inputData, groupN); //abundance, bin, group
-			push_back(inputData, groupN);
-			
-			if (inputData > maxRank) { maxRank = inputData; }
-		}
+		lookup[0]->readAbundances(f, num, groupN);
 		
 		m->gobble(f);
 		
@@ -167,12 +150,7 @@ SharedRAbundVector::SharedRAbundVector(ifstream& f) : DataVector(), maxRank(0),
 			lookup[count]->setGroup(groupN);
 
 			//fill vector.  
-			for(int i=0;i<num;i++){
-				f >> inputData;
-                if (m->debug) { m->mothurOut("[DEBUG]: OTU" + toString(i+1)+ '\t' +toString(inputData)); }
-				
-				lookup[count]->push_back(inputData, groupN); //abundance, bin, group
-			}
+			lookup[count]->readAbundances(f, num, groupN);
 			
 			m->gobble(f);
 				
@@ -187,13 +165,37 @@ SharedRAbundVector::SharedRAbundVector(ifstream& f) : DataVector(), maxRank(0),
 	}
 }
 
+/***********************************************************************/
+//reads the rest of a row of a shared file, which is faster than extracting each abundance from the stream
+void SharedRAbundVector::readAbundances(ifstream& f, int num, string groupName){
+	try {
+		string line;
+		getline(f, line);
+		
+		data.reserve(num);
+		const char* pos = line.c_str();
+		for(int i=0;i<num;i++){
+			char* end;
+			int inputData = strtol(pos, &end, 10);
+			if (end == pos) { m->mothurOut("[ERROR]: expected " + toString(num) + " abundances for group " + groupName + " but found " + toString(i) + ", please correct.\n"); m->control_pressed = true; break; }
+			pos = end;
+            if (m->debug) { m->mothurOut("[DEBUG]: OTU" + toString(i+1)+ '\t' +toString(inputData)); }
+			
+			push_back(inputData, groupName); //abundance, group
+		}
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SharedRAbundVector", "readAbundances");
+		exit(1);
+	}
+}
 /***********************************************************************/
 
 void SharedRAbundVector::set(int binNumber, int newBinSize, string groupname){
 	try {
-		int oldBinSize = data[binNumber].abundance;
-		data[binNumber].abundance = newBinSize;
-		data[binNumber].group = groupname;
+		int oldBinSize = data[binNumber];
+		data[binNumber] = newBinSize;
+		if (group == "") { group = groupname; }
 	
 		if(newBinSize > maxRank)	{	maxRank = newBinSize;	}
 	
@@ -207,24 +209,20 @@ void SharedRAbundVector::set(int binNumber, int newBinSize, string groupname){
 /***********************************************************************/
 
 void SharedRAbundVector::setData(vector <individual> newData){
-	data = newData;
+	data.resize(newData.size());
+	for (int i = 0; i < newData.size(); i++) { data[i] = newData[i].abundance; }
 }
 
 /***********************************************************************/
 
 int SharedRAbundVector::getAbundance(int index){
-	return data[index].abundance;
+	return data[index];
 	
 }
 /***********************************************************************/
 //returns vector of abundances 
 vector<int> SharedRAbundVector::getAbundances(){
-    vector<int> abunds;
-    for (int i = 0; i < data.size(); i++) {
-        abunds.push_back(data[i].abundance);
-    }
-    
-	return abunds;
+	return data;
 }
 
 
@@ -233,26 +231,34 @@ vector<int> SharedRAbundVector::getAbundances(){
 int SharedRAbundVector::numNZ(){
 	int sum = 0;
 	for(int i = 1; i < numBins; i++)
-		if(data[i].abundance > 0)
+		if(data[i] > 0)
 			sum++;
 	return sum;
 }
 /***********************************************************************/
 
 void SharedRAbundVector::sortD(){
-	struct individual indObj;
-	sort(data.begin()+1, data.end(), indObj);
+	sort(data.begin()+1, data.end(), greater<int>());
 }
 /***********************************************************************/
 
 individual SharedRAbundVector::get(int index){
-	return data[index];
-	
+	individual newGuy;
+	newGuy.group = group;
+	newGuy.bin = index;
+	newGuy.abundance = data[index];
+	return newGuy;
 }
 /***********************************************************************/
 
 vector <individual> SharedRAbundVector::getData(){
-	return data;
+	vector<individual> individuals(data.size());
+	for (int i = 0; i < data.size(); i++) {
+		individuals[i].group = group;
+		individuals[i].bin = i;
+		individuals[i].abundance = data[i];
+	}
+	return individuals;
 }
 /***********************************************************************/
 
@@ -268,12 +274,9 @@ void SharedRAbundVector::clear(){
 
 void SharedRAbundVector::push_back(int binSize, string groupName){
 	try {
-		individual newGuy;
-		newGuy.abundance = binSize;
-		newGuy.group = groupName;
-		newGuy.bin = data.size();
+		if (group == "") { group = groupName; }
 		
-		data.push_back(newGuy);
+		data.push_back(binSize);
 		numBins++;
 	
 		if(binSize > maxRank){
@@ -292,12 +295,9 @@ void SharedRAbundVector::push_back(int binSize, string groupName){
 
 void SharedRAbundVector::insert(int binSize, int otu, string groupName){
 	try {
-		individual newGuy;
-		newGuy.abundance = binSize;
-		newGuy.group = groupName;
-		newGuy.bin = otu;
+		if (group == "") { group = groupName; }
 		
-		data.insert(data.begin()+otu, newGuy);
+		data.insert(data.begin()+otu, binSize);
 		numBins++;
 	
 		if(binSize > maxRank){
@@ -316,12 +316,9 @@ void SharedRAbundVector::insert(int binSize, int otu, string groupName){
 
 void SharedRAbundVector::push_front(int binSize, int otu, string groupName){
 	try {
-		individual newGuy;
-		newGuy.abundance = binSize;
-		newGuy.group = groupName;
-		newGuy.bin = otu;
+		if (group == "") { group = groupName; }
 		
-		data.insert(data.begin(), newGuy);
+		data.insert(data.begin(), binSize);
 		numBins++;
 	
 		if(binSize > maxRank){
@@ -338,7 +335,7 @@ void SharedRAbundVector::push_front(int binSize, int otu, string groupName){
 
 /***********************************************************************/
 void SharedRAbundVector::pop_back(){
-	numSeqs -= data[data.size()-1].abundance;
+	numSeqs -= data[data.size()-1];
 	numBins--;
 	return data.pop_back();
 }
@@ -346,13 +343,13 @@ void SharedRAbundVector::pop_back(){
 /***********************************************************************/
 
 
-vector<individual>::reverse_iterator SharedRAbundVector::rbegin(){
+vector<int>::reverse_iterator SharedRAbundVector::rbegin(){
 	return data.rbegin();				
 }
 
 /***********************************************************************/
 
-vector<individual>::reverse_iterator SharedRAbundVector::rend(){
+vector<int>::reverse_iterator SharedRAbundVector::rend(){
 	return data.rend();					
 }
 
@@ -419,7 +416,7 @@ void SharedRAbundVector::print(ostream& output) {
 	try {
 		output << numBins;
 	
-		for(int i=0;i<data.size();i++){		output  << '\t' << data[i].abundance;		}
+		for(int i=0;i<data.size();i++){		output  << '\t' << data[i];		}
 		output << endl;
 	}
 	catch(exception& e) {
@@ -592,8 +589,8 @@ RAbundVector SharedRAbundVector::getRAbundVector() {
 		RAbundVector rav;
 		
 		for (int i = 0; i < data.size(); i++) {
-			if(data[i].abundance != 0) {
-				rav.push_back(data[i].abundance);
+			if(data[i] != 0) {
+				rav.push_back(data[i]);
 			}
 		}
 		
@@ -611,8 +608,8 @@ RAbundVector SharedRAbundVector::getRAbundVector2() {
 	try {
 		RAbundVector rav;
 		for(int i = 0; i < numBins; i++)
-			if(data[i].abundance != 0)
-				rav.push_back(data[i].abundance-1);
+			if(data[i] != 0)
+				rav.push_back(data[i]-1);
 		return rav;
 	}
 	catch(exception& e) {
@@ -627,7 +624,7 @@ SharedSAbundVector SharedRAbundVector::getSharedSAbundVector(){
 		SharedSAbundVector sav(maxRank+1);
 		
 		for(int i=0;i<data.size();i++){
-			int abund = data[i].abundance;
+			int abund = data[i];
 			sav.set(abund, sav.getAbundance(abund) + 1, group);
 		}
 		
@@ -649,7 +646,7 @@ SAbundVector SharedRAbundVector::getSAbundVector() {
 		SAbundVector sav(maxRank+1);
 		
 		for(int i=0;i<data.size();i++){
-			int abund = data[i].abundance;
+			int abund = data[i];
 			sav.set(abund, sav.get(abund) + 1);
 		}
 		sav.set(0, 0);
@@ -669,8 +666,8 @@ SharedOrderVector SharedRAbundVector::getSharedOrderVector() {
 		SharedOrderVector ov;
 	
 		for(int i=0;i<data.size();i++){
-			for(int j=0;j<data[i].abundance;j++){
-				ov.push_back(data[i].bin, data[i].abundance, data[i].group);
+			for(int j=0;j<data[i];j++){
+				ov.push_back(i, data[i], group);
 			}
 		}
 		random_shuffle(ov.begin(), ov.end());
@@ -691,7 +688,7 @@ OrderVector SharedRAbundVector::getOrderVector(map<string,int>* nameMap = NULL)
 	try {
 		OrderVector ov;
 		for(int i=0;i<numBins;i++){
-			for(int j=0;j<data[i].abundance;j++){
+			for(int j=0;j<data[i];j++){
 				ov.push_back(i);
 			}
 		}
@@ -19,10 +19,10 @@
 
 /*  DataStructure for a shared file.
 	This class is a child to datavector.  It represents OTU information at a certain distance. 
-	It is similiar to an rabundvector except each member of data knows which group it belongs to.
-	Each member of the internal container "data" is a struct of type individual. 
-	An individual which knows the OTU from which it came, 
-	the group it is in and its abundance.  */
+	It is similiar to an rabundvector except it knows which group it belongs to.
+	The internal container "data" holds the abundance of each OTU, and the group is kept once for the vector, 
+	so a large shared file costs an int per cell.  get and getData return individuals, 
+	which know the OTU from which they came, the group they are in and their abundance.  */
 
 
 class SharedRAbundVector : public DataVector {
@@ -60,8 +60,8 @@ public:
 	void resize(int);
 	int size();
 	void clear();
-	vector<individual>::reverse_iterator rbegin();
-	vector<individual>::reverse_iterator rend();
+	vector<int>::reverse_iterator rbegin();
+	vector<int>::reverse_iterator rend();
 	
 	void print(ostream&);
 	void printHeaders(ostream&);
@@ -77,7 +77,7 @@ public:
 	vector<SharedRAbundFloatVector*> getSharedRAbundFloatVectors(vector<SharedRAbundVector*>);
 	
 private:
-	vector<individual>  data; 
+	vector<int>  data; 
 	vector<SharedRAbundVector*> lookup;
 	//GlobalData* globaldata;
 	//GroupMap* groupmap;
@@ -88,6 +88,7 @@ private:
 	int index;	
 	
 	int eliminateZeroOTUS(vector<SharedRAbundVector*>&);
+	void readAbundances(ifstream&, int, string);	//file, number of otus, group
 };
 
 
@@ -175,17 +175,6 @@ SAbundVector SharedSAbundVector::getSAbundVector(){
 	}
 }
 
-/***********************************************************************/
-
-bool compareMembers (individual member, individual member2){
-
-  if(member.abundance < member2.abundance){
-    return true;   }   
-  else{
-	return false; 
-  }
-}
-
 /***********************************************************************/
 SharedRAbundVector SharedSAbundVector::getSharedRAbundVector(){
 	try {
@@ -196,7 +185,7 @@ SharedRAbundVector SharedSAbundVector::getSharedRAbundVector(){
 				rav.push_back(i, data[i].group);
 			}
 		}
-		sort(rav.rbegin(), rav.rend(), compareMembers);
+		sort(rav.rbegin(), rav.rend());
 	
 		rav.setLabel(label);
 		rav.setGroup(group);
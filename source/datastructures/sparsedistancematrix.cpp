@@ -11,7 +11,7 @@
 
 /***********************************************************************/
 
-SparseDistanceMatrix::SparseDistanceMatrix() : numNodes(0), smallDist(1e6){  m = MothurOut::getInstance(); sorted=false; aboveCutoff = 1e6; }
+SparseDistanceMatrix::SparseDistanceMatrix() : numNodes(0), smallDist(1e6){  m = MothurOut::getInstance(); sorted=false; aboveCutoff = 1e6; heapBuilt = false; }
 
 /***********************************************************************/
 
@@ -23,6 +23,8 @@ int SparseDistanceMatrix::getNNodes(){
 void SparseDistanceMatrix::clear(){
     for (int i = 0; i < seqVec.size(); i++) {  seqVec[i].clear();  }
     seqVec.clear();
+    minHeap.clear(); rowMinDist.clear(); rowMinCol.clear(); rowVersion.clear(); rowDirty.clear(); dirtyRows.clear();
+    heapBuilt = false;
 }
 
 /***********************************************************************/
@@ -45,6 +47,8 @@ int SparseDistanceMatrix::updateCellCompliment(ull row, ull col){
        
         seqVec[vrow][vcol].dist = seqVec[row][col].dist;
         
+        updateRowMin(row, vrow, seqVec[row][col].dist);
+        
         return 0;
     }
 	catch(exception& e) {
@@ -66,6 +70,8 @@ int SparseDistanceMatrix::rmCell(ull row, ull col){
         
         seqVec[vrow].erase(seqVec[vrow].begin()+vcol);
         seqVec[row].erase(seqVec[row].begin()+col);
+        
+        removeRowMin(row, vrow);
  
 		return(0);
     }
@@ -83,6 +89,8 @@ void SparseDistanceMatrix::addCell(ull row, PDistCell cell){
         seqVec[row].push_back(cell);
         PDistCell temp(row, cell.dist);
         seqVec[cell.index].push_back(temp);
+        
+        updateRowMin(row, cell.index, cell.dist);
 	}
 	catch(exception& e) {
 		m->errorOut(e, "SparseDistanceMatrix", "addCell");
@@ -102,6 +110,8 @@ int SparseDistanceMatrix::addCellSorted(ull row, PDistCell cell){
         sortSeqVec(row);
         sortSeqVec(cell.index);
         
+        updateRowMin(row, cell.index, cell.dist);
+        
         int location = -1; //find location of new cell when sorted
         for (int i = 0; i < seqVec[row].size(); i++) {  if (seqVec[row][i].index == cell.index) { location = i; break; } }
         
@@ -118,38 +128,36 @@ int SparseDistanceMatrix::addCellSorted(ull row, PDistCell cell){
 ull SparseDistanceMatrix::getSmallestCell(ull& row){
 	try {
         if (!sorted) { sortSeqVec(); sorted = true; }
+        if (!heapBuilt) { buildMinHeap(); }
+        
+        //rescan the rows whose smallest cell was removed or increased
+        for (int i = 0; i < dirtyRows.size(); i++) {
+            if (m->control_pressed) { return smallDist; }
+            findRowMin(dirtyRows[i]);
+        }
+        dirtyRows.clear();
+        
+        //too many stale entries, start over from the cached row mins
+        if (minHeap.size() > (4*seqVec.size()+100)) { 
+            minHeap.clear();
+            for (ull i = 0; i < seqVec.size(); i++) { if (rowMinCol[i] > i) { minHeap.push_back(PDistRowMin(rowMinDist[i], i, rowVersion[i])); } }
+            make_heap(minHeap.begin(), minHeap.end(), compareRowMins);
+        }
+        
+        //discard stale entries
+        while (minHeap.size() != 0) {
+            PDistRowMin top = minHeap.front();
+            if ((top.version == rowVersion[top.row]) && (rowMinCol[top.row] > top.row)) { break; }
+            pop_heap(minHeap.begin(), minHeap.end(), compareRowMins);
+            minHeap.pop_back();
+        }
         
-        vector<PDistCellMin> mins;
         smallDist = 1e6;
-       
-        for (int i = 0; i < seqVec.size(); i++) {
-            for (int j = 0; j < seqVec[i].size(); j++) {
-                
-                if (m->control_pressed) { return smallDist; }
-                
-                //already checked everyone else in row
-                if (i < seqVec[i][j].index) {  
-			    
-                    float dist = seqVec[i][j].dist;
-                  
-                    if(dist < smallDist){  //found a new smallest distance
-                        mins.clear();
-                        smallDist = dist;
-                        PDistCellMin temp(i, seqVec[i][j].index);
-                        mins.push_back(temp);  
-                    }
-                    else if(dist == smallDist){  //if a subsequent distance is the same as mins distance add the new iterator to the mins vector
-                        PDistCellMin temp(i, seqVec[i][j].index);
-                        mins.push_back(temp); 
-                    }
-                }else { j+=seqVec[i].size(); } //stop looking 
-			}
-		}
-        
-		//random_shuffle(mins.begin(), mins.end());  //randomize the order of the iterators in the mins vector
-        
-        row = mins[0].row;
-        ull col = mins[0].col;
+        if (minHeap.size() == 0) { row = 0; return 0; }
+        
+        row = minHeap.front().row;
+        smallDist = rowMinDist[row];
+        ull col = rowMinCol[row];
 
 		return col;
 	}
@@ -160,6 +168,123 @@ ull SparseDistanceMatrix::getSmallestCell(ull& row){
 }
 /***********************************************************************/
 
+int SparseDistanceMatrix::buildMinHeap(){
+	try {
+        ull numRows = seqVec.size();
+        rowMinDist.assign(numRows, 1e6);
+        rowMinCol.assign(numRows, 0);
+        rowVersion.assign(numRows, 0);
+        rowDirty.assign(numRows, false);
+        dirtyRows.clear();
+        minHeap.clear();
+        
+        heapBuilt = true;
+        for (ull i = 0; i < numRows; i++) {
+            if (m->control_pressed) { break; }
+            findRowMin(i);
+        }
+        
+        return 0;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "SparseDistanceMatrix", "buildMinHeap");
+		exit(1);
+	}
+}
+/***********************************************************************/
+//finds the smallest cell in the upper triangle of the row. Ties go to the largest column, 
+//which is the first one found when the row is sorted by compareIndexes
+int SparseDistanceMatrix::findRowMin(ull row){
+	try {
+        rowDirty[row] = false;
+        rowMinDist[row] = 1e6;
+        rowMinCol[row] = 0;
+        
+        for (int j = 0; j < seqVec[row].size(); j++) {
+            ull col = seqVec[row][j].index;
+            if (col > row) {
+                float dist = seqVec[row][j].dist;
+                if ((rowMinCol[row] <= row) || (dist < rowMinDist[row]) || ((dist == rowMinDist[row]) && (col > rowMinCol[row]))) {
+                    rowMinDist[row] = dist;
+                    rowMinCol[row] = col;
+                }
+            }
+        }
+        
+        pushRowMin(row);
+        
+        return 0;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "SparseDistanceMatrix", "findRowMin");
+		exit(1);
+	}
+}
+/***********************************************************************/
+
+int SparseDistanceMatrix::pushRowMin(ull row){
+	try {
+        rowVersion[row]++;
+        
+        if (rowMinCol[row] > row) {
+            minHeap.push_back(PDistRowMin(rowMinDist[row], row, rowVersion[row]));
+            push_heap(minHeap.begin(), minHeap.end(), compareRowMins);
+        }
+        
+        return 0;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "SparseDistanceMatrix", "pushRowMin");
+		exit(1);
+	}
+}
+/***********************************************************************/
+//the distance between seqA and seqB was added or changed
+int SparseDistanceMatrix::updateRowMin(ull seqA, ull seqB, float dist){
+	try {
+        if (!heapBuilt) { return 0; }
+        
+        ull row = seqA; ull col = seqB;
+        if (seqA > seqB) { row = seqB; col = seqA; }
+        
+        if (rowDirty[row]) { return 0; } //will be rescanned
+        
+        if (rowMinCol[row] == col) {
+            if (dist < rowMinDist[row]) { rowMinDist[row] = dist; pushRowMin(row); }
+            else if (dist > rowMinDist[row]) { rowDirty[row] = true; dirtyRows.push_back(row); }
+        }else if ((rowMinCol[row] <= row) || (dist < rowMinDist[row]) || ((dist == rowMinDist[row]) && (col > rowMinCol[row]))) {
+            rowMinDist[row] = dist;
+            rowMinCol[row] = col;
+            pushRowMin(row);
+        }
+        
+        return 0;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "SparseDistanceMatrix", "updateRowMin");
+		exit(1);
+	}
+}
+/***********************************************************************/
+//the distance between seqA and seqB was removed
+int SparseDistanceMatrix::removeRowMin(ull seqA, ull seqB){
+	try {
+        if (!heapBuilt) { return 0; }
+        
+        ull row = seqA; ull col = seqB;
+        if (seqA > seqB) { row = seqB; col = seqA; }
+        
+        if ((!rowDirty[row]) && (rowMinCol[row] == col)) { rowDirty[row] = true; dirtyRows.push_back(row); }
+        
+        return 0;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "SparseDistanceMatrix", "removeRowMin");
+		exit(1);
+	}
+}
+/***********************************************************************/
+
 int SparseDistanceMatrix::sortSeqVec(){
 	try {
         
@@ -29,6 +29,21 @@ struct PDistCellMin{
 	PDistCellMin(ull r, ull c) :  col(c), row(r) {}
 };
 /***********************************************************************/
+/* Each row caches the smallest cell in its upper triangle. The heap orders the rows by that cell, so finding the 
+ smallest distance does not require a scan of seqVec. Entries are invalidated lazily using the rows version. */
+struct PDistRowMin{
+	float dist;
+    ull row;
+    int version;
+	PDistRowMin(float d, ull r, int v) :  dist(d), row(r), version(v) {}
+};
+/***********************************************************************/
+//used as the heap comparator, so the top of the heap is the smallest distance, ties go to the lowest row
+inline bool compareRowMins(const PDistRowMin& left, const PDistRowMin& right){
+	if (left.dist == right.dist) { return (left.row > right.row); }
+	return (left.dist > right.dist);
+}
+/***********************************************************************/
 
 
 
@@ -43,7 +58,7 @@ public:
 	
 	int rmCell(ull, ull);
     int updateCellCompliment(ull, ull);
-    void resize(ull n) { seqVec.resize(n);  }
+    void resize(ull n) { seqVec.resize(n); heapBuilt = false; }
     void clear();
 	void addCell(ull, PDistCell);
     int addCellSorted(ull, PDistCell);
@@ -59,6 +74,20 @@ private:
     int sortSeqVec(int);
 	float smallDist, aboveCutoff;
     
+    bool heapBuilt;
+    vector<PDistRowMin> minHeap;
+    vector<float> rowMinDist;
+    vector<ull> rowMinCol;          //rowMinCol[i] <= i means row i has no cells in the upper triangle
+    vector<int> rowVersion;
+    vector<bool> rowDirty;
+    vector<ull> dirtyRows;
+    
+    int buildMinHeap();
+    int findRowMin(ull);
+    int pushRowMin(ull);
+    int updateRowMin(ull, ull, float);
+    int removeRowMin(ull, ull);
+    
 	MothurOut* m;
 
 };
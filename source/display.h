@@ -14,6 +14,7 @@ class Display {
 public:
 	virtual void update(SAbundVector* rank) = 0;
 	virtual void update(vector<SharedRAbundVector*> shared, int numSeqs, int numGroupComb) = 0;
+	virtual void updateExpected(int, vector<double>) {}		//numSeqs, the curve's value and interval at numSeqs
 	virtual void init(string) = 0;
 	virtual void reset() = 0;
 	virtual void close() = 0;
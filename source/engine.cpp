@@ -13,6 +13,7 @@
 
 
 #include "engine.hpp"
+#include "seqnametable.h"
 
 /***********************************************************************/
 Engine::Engine(){
@@ -134,10 +135,21 @@ bool InteractEngine::getInput(){
 					mout->sharedBinLabelsInFile.clear();
                     mout->printedListHeaders = false;
                     mout->listBinLabelsInFile.clear();
+                    SeqNameTable::getInstance()->clear();
 							
+					Profiler::getInstance()->startCommand(commandName);
+					
 					Command* command = cFactory->getCommand(commandName, options);
 					if (mout->commandInputsConvertError) { quitCommandCalled = 2; }
 					else { quitCommandCalled = command->execute(); }
+					
+				#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+				#ifdef USE_COMPRESSION
+					CompressedStreams::getInstance()->waitAll();	//so the command's compressed files are complete
+				#endif
+				#endif
+					
+					Profiler::getInstance()->endCommand(quitCommandCalled);
 							
 					//if we aborted command
 					if (quitCommandCalled == 2) {  mout->mothurOut("[ERROR]: did not complete " + commandName + ".\n");  }
@@ -333,11 +345,22 @@ bool BatchEngine::getInput(){
                     mout->sharedBinLabelsInFile.clear();
                     mout->printedListHeaders = false;
                     mout->listBinLabelsInFile.clear();
+                    SeqNameTable::getInstance()->clear();
 
 							
+					Profiler::getInstance()->startCommand(commandName);
+					
 					Command* command = cFactory->getCommand(commandName, options);
 					if (mout->commandInputsConvertError) { quitCommandCalled = 2; }
 					else { quitCommandCalled = command->execute(); }
+					
+				#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+				#ifdef USE_COMPRESSION
+					CompressedStreams::getInstance()->waitAll();	//so the command's compressed files are complete
+				#endif
+				#endif
+					
+					Profiler::getInstance()->endCommand(quitCommandCalled);
 							
 					//if we aborted command
 					if (quitCommandCalled == 2) {  mout->mothurOut("[ERROR]: did not complete " + commandName + ".\n");  }
@@ -518,11 +541,22 @@ bool ScriptEngine::getInput(){
                     mout->sharedBinLabelsInFile.clear();
                     mout->printedListHeaders = false;
                     mout->listBinLabelsInFile.clear();
+                    SeqNameTable::getInstance()->clear();
 
+					Profiler::getInstance()->startCommand(commandName);
+					
 					Command* command = cFactory->getCommand(commandName, options);
 					if (mout->commandInputsConvertError) { quitCommandCalled = 2; }
 					else { quitCommandCalled = command->execute(); }
 					
+				#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+				#ifdef USE_COMPRESSION
+					CompressedStreams::getInstance()->waitAll();	//so the command's compressed files are complete
+				#endif
+				#endif
+					
+					Profiler::getInstance()->endCommand(quitCommandCalled);
+					
 					//if we aborted command
 					if (quitCommandCalled == 2) {  mout->mothurOut("[ERROR]: did not complete " + commandName + ".\n");  }
 							
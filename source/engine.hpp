@@ -17,6 +17,8 @@
 #include "command.hpp"
 #include "commandfactory.hpp"
 #include "mothurout.h"
+#include "profiler.h"
+#include "compressedstreams.h"
 
 class Engine {
 public:
@@ -63,7 +63,7 @@ void HCluster::clusterNames(){
 		///cout << smallCol << '\t' << smallRow << '\t' << smallDist << '\t' << list->get(clusterArray[smallRow].smallChild) << '\t' << list->get(clusterArray[smallCol].smallChild);
 		if (mapWanted) {  updateMap();  }
 		
-		list->set(clusterArray[smallCol].smallChild, list->get(clusterArray[smallRow].smallChild)+','+list->get(clusterArray[smallCol].smallChild));
+		list->merge(clusterArray[smallCol].smallChild, clusterArray[smallRow].smallChild, clusterArray[smallCol].smallChild);
 		list->set(clusterArray[smallRow].smallChild, "");	
 		list->setLabel(toString(smallDist));
 	
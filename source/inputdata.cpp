@@ -425,7 +425,9 @@ vector<SharedRAbundVector*> InputData::getSharedRAbundVectors(){
 			if (format == "sharedfile")  {
 				SharedRAbundVector* SharedRAbund = new SharedRAbundVector(fileHandle);
 				if (SharedRAbund != NULL) {
-					return SharedRAbund->getSharedRAbundVectors();
+					vector<SharedRAbundVector*> lookup = SharedRAbund->getSharedRAbundVectors();
+					delete SharedRAbund;
+					return lookup;
 				}
 			}else if (format == "shared") {
 				SharedList = new SharedListVector(fileHandle);
@@ -465,7 +467,7 @@ vector<SharedRAbundVector*> InputData::getSharedRAbundVectors(string label){
 						thisLabel = SharedRAbund->getLabel();
 					
 						//if you are at the last label
-						if (thisLabel == label) {  in.close(); return SharedRAbund->getSharedRAbundVectors();  }
+						if (thisLabel == label) {  in.close(); vector<SharedRAbundVector*> lookup = SharedRAbund->getSharedRAbundVectors(); delete SharedRAbund; return lookup;  }
 						else {
 							//so you don't loose this memory
 							vector<SharedRAbundVector*> lookup = SharedRAbund->getSharedRAbundVectors(); 
@@ -0,0 +1,131 @@
+/*
+ *  mismatchindex.cpp
+ *  Mothur
+ *
+ *  Copyright 2026 Schloss Lab. All rights reserved.
+ *
+ */
+
+#include "mismatchindex.h"
+
+/**************************************************************************************************/
+MisMatchIndex::MisMatchIndex(vector<string>& seqs, int d) {
+	try {
+		m = MothurOut::getInstance();
+		diffs = d;
+		numSeqs = seqs.size();
+		numWords = 0;
+		if (numSeqs == 0) { return; }
+
+		//the columns where the seqs are not all the same
+		vector<int> columns;
+		int length = seqs[0].length();
+		for (int i = 0; i < length; i++) {
+			for (int j = 1; j < numSeqs; j++) {
+				if (seqs[j][i] != seqs[0][i]) { columns.push_back(i); break; }
+			}
+		}
+
+		int numColumns = columns.size();
+		numWords = (numColumns + 7) / 8;
+		words.assign((long long)numSeqs * numWords, 0);
+		for (int i = 0; i < numSeqs; i++) {
+			if (m->control_pressed) { return; }
+
+			unsigned long long* seqWords = &words[(long long)i * numWords];
+			for (int k = 0; k < numColumns; k++) {
+				seqWords[k / 8] |= ((unsigned long long)(unsigned char)seqs[i][columns[k]]) << (8 * (k % 8));
+			}
+		}
+
+		//with fewer columns than segments every pair is within diffs
+		int numSegments = diffs + 1;
+		if (numColumns < numSegments) { return; }
+
+		for (int s = 0; s <= numSegments; s++) { segmentStarts.push_back((int)(((long long)s * numColumns) / numSegments)); }
+
+		segments.resize(numSegments);
+		for (int i = 0; i < numSeqs; i++) {
+			if (m->control_pressed) { return; }
+			for (int s = 0; s < numSegments; s++) { segments[s][hashSegment(i, s)].push_back(i); }
+		}
+	}
+	catch(exception& e) {
+		m->errorOut(e, "MisMatchIndex", "MisMatchIndex");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//seqs with the same bases in a segment share its hash, seqs with different bases may share it too and are weeded out when counted
+unsigned long long MisMatchIndex::hashSegment(int seq, int segment) {
+	try {
+		const unsigned long long* seqWords = &words[(long long)seq * numWords];
+
+		unsigned long long hash = 14695981039346656037ULL;
+		for (int k = segmentStarts[segment]; k < segmentStarts[segment+1]; k++) {
+			hash ^= (seqWords[k / 8] >> (8 * (k % 8))) & 0xFF;
+			hash *= 1099511628211ULL;
+		}
+		return hash;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "MisMatchIndex", "hashSegment");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+vector<int> MisMatchIndex::getCandidates(int seq) {
+	try {
+		vector<int> candidates;
+
+		if (segments.size() == 0) {
+			for (int i = seq+1; i < numSeqs; i++) { candidates.push_back(i); }
+			return candidates;
+		}
+
+		for (int s = 0; s < segments.size(); s++) {
+			vector<int>& found = segments[s][hashSegment(seq, s)];
+			candidates.insert(candidates.end(), upper_bound(found.begin(), found.end(), seq), found.end());
+		}
+
+		sort(candidates.begin(), candidates.end());
+		candidates.erase(unique(candidates.begin(), candidates.end()), candidates.end());
+
+		return candidates;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "MisMatchIndex", "getCandidates");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//the bytes that differ are counted 8 at a time by folding each byte's bits into its lowest bit
+int MisMatchIndex::countMisMatches(int seq1, int seq2) {
+	try {
+		if (numWords == 0) { return 0; }
+
+		const unsigned long long* words1 = &words[(long long)seq1 * numWords];
+		const unsigned long long* words2 = &words[(long long)seq2 * numWords];
+
+		int numBad = 0;
+		for (int w = 0; w < numWords; w++) {
+			unsigned long long diff = words1[w] ^ words2[w];
+			if (diff == 0) { continue; }
+
+			diff |= diff >> 4;
+			diff |= diff >> 2;
+			diff |= diff >> 1;
+			diff &= 0x0101010101010101ULL;
+			numBad += (int)((diff * 0x0101010101010101ULL) >> 56);
+
+			if (numBad > diffs) { return diffs+1; } //to far to cluster
+		}
+
+		return numBad;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "MisMatchIndex", "countMisMatches");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
@@ -0,0 +1,46 @@
+#ifndef MISMATCHINDEX_H
+#define MISMATCHINDEX_H
+
+/*
+ *  mismatchindex.h
+ *  Mothur
+ *
+ *  Copyright 2026 Schloss Lab. All rights reserved.
+ *
+ */
+
+/* MisMatchIndex finds the aligned seqs that may be within diffs mismatches of a seq, so pre.cluster only counts the
+ mismatches of those pairs instead of every pair. Only the columns where the seqs are not all the same can have a
+ mismatch, so the seqs are kept with just those columns. The columns are cut into diffs+1 segments. Two seqs with at
+ most diffs mismatches have the same bases in at least one segment, so the index maps each segment's bases to its seqs.
+
+ The seqs are kept 8 bases to a word, and countMisMatches compares a word at a time, stopping once there are more
+ than diffs mismatches. */
+
+#include "mothur.h"
+#include "mothurout.h"
+
+/**************************************************************************************************/
+
+class MisMatchIndex {
+
+public:
+	MisMatchIndex(vector<string>&, int);		//aligned seqs all the same length, diffs
+	~MisMatchIndex() {}
+
+	vector<int> getCandidates(int);			//the seqs after this one that may be within diffs, in order
+	int countMisMatches(int, int);			//number of mismatches, or diffs+1 if there are more than diffs
+
+private:
+	MothurOut* m;
+	int diffs, numSeqs, numWords;
+	vector<unsigned long long> words;		//numWords for each seq
+	vector< map<unsigned long long, vector<int> > > segments;	//hash of the segment's bases to the seqs with them, in order
+	vector<int> segmentStarts;				//the first column of each segment, and the end of the last one
+
+	unsigned long long hashSegment(int, int);
+};
+
+/**************************************************************************************************/
+
+#endif
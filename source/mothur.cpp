@@ -11,12 +11,22 @@
 #include "engine.hpp"
 #include "mothurout.h"
 #include "referencedb.h"
+#include "profiler.h"
+#include "seqnametable.h"
+#include "compressedstreams.h"
 
 /**************************************************************************************************/
 
 CommandFactory* CommandFactory::_uniqueInstance = 0;
 MothurOut* MothurOut::_uniqueInstance = 0;
 ReferenceDB* ReferenceDB::myInstance = 0;
+Profiler* Profiler::myInstance = 0;
+SeqNameTable* SeqNameTable::myInstance = 0;
+#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+#ifdef USE_COMPRESSION
+CompressedStreams* CompressedStreams::myInstance = 0;
+#endif
+#endif
 /***********************************************************************/
 volatile int ctrlc_pressed = 0;
 void ctrlc_handler ( int sig ) {
@@ -47,6 +57,7 @@ int main(int argc, char *argv[]){
 		#endif
 
 		m->setFileName(logFileName);
+		Profiler::getInstance()->setReportFile(m->getRootName(logFileName) + "profile");
 		
 		#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
 			system("clear");
@@ -85,26 +96,24 @@ int main(int argc, char *argv[]){
 		if (argc>1) {
 			string guiInput = argv[1];
 			if (guiInput[0] == '+') { outputHeader = false; }
-			if (guiInput[0] == '-') { outputHeader = false; }
+			if ((guiInput[0] == '-') && (guiInput != "--profile")) { outputHeader = false; }
             
-            if (argc > 2) { //is one of these -q for quiet mode?
-                if (argc > 3) { m->mothurOut("[ERROR]: mothur only allows command inputs and the -q command line options.\n  i.e. ./mothur \"#summary.seqs(fasta=final.fasta);\" -q\n or ./mothur -q \"#summary.seqs(fasta=final.fasta);\"\n"); return 0; }
-                else {
-                    string argv1 = argv[1];
-                    string argv2 = argv[2];
-                    if ((argv1 == "--quiet") || (argv1 == "-q")) {
-                        m->quietMode = true;
-                        argv[1] = argv[2];
-                    }else if ((argv2 == "--quiet") || (argv2 == "-q")) {
-                         m->quietMode = true;
-                    }else {
-                        m->mothurOut("[ERROR]: mothur only allows command inputs and the -q command line options.\n");
-                        m->mothurOut("[ERROR]: Unrecognized options: " + argv1 + " " + argv2 + "\n");
-                        return 0;
-                    }
-                   
-                }
+            //-q or --quiet for quiet mode and --profile for the profile report can come before or after the commands
+            int numInputs = 1;
+            string unrecognized = "";
+            for (int i = 1; i < argc; i++) {
+                string arg = argv[i];
+                if ((argc > 2) && ((arg == "--quiet") || (arg == "-q"))) {	m->quietMode = true;						}
+                else if (arg == "--profile") {								Profiler::getInstance()->setActive(true);	}
+                else { argv[numInputs++] = argv[i]; unrecognized += arg + " "; }
             }
+            
+            if (numInputs > 2) {
+                m->mothurOut("[ERROR]: mothur only allows command inputs and the -q and --profile command line options.\n  i.e. ./mothur \"#summary.seqs(fasta=final.fasta);\" -q\n or ./mothur -q \"#summary.seqs(fasta=final.fasta);\"\n");
+                m->mothurOut("[ERROR]: Unrecognized options: " + unrecognized + "\n");
+                return 0;
+            }
+            argc = numInputs;
 		}
 		
         
@@ -289,7 +298,9 @@ int main(int argc, char *argv[]){
 			rename(logFileName.c_str(), newlogFileName.c_str()); //logfile with timestamp
 		}
         
-        if (!createLogFile) { m->mothurRemove(newlogFileName); }
+        Profiler::getInstance()->moveReport(newlogFileName, append);
+        
+        if (!createLogFile) { m->mothurRemove(newlogFileName); m->mothurRemove(Profiler::getInstance()->getReportFile()); }
 				
 		if (mothur != NULL) { delete mothur; }
 		
@@ -42,6 +42,7 @@
 #include <map>
 #include <string>
 #include <list>
+#include <deque>
 #include <string.h>
 
 //math
@@ -54,6 +55,14 @@
 #include <cerrno>
 #include <ctime>
 #include <limits>
+#include <random>
+
+//threads
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
 
 #ifdef USE_MPI
 	#include "mpi.h"
@@ -8,6 +8,7 @@
  */
 
 #include "mothurout.h"
+#include "compressedstreams.h"
 
 //needed for testing project
 //MothurOut* MothurOut::_uniqueInstance;
@@ -347,6 +348,7 @@ MothurOut::~MothurOut() {
 /*********************************************************************************************/
 void MothurOut::mothurOut(string output) {
 	try {
+		lock_guard<recursive_mutex> guard(outputLock);
 		
 		#ifdef USE_MPI
 			int pid;
@@ -377,6 +379,7 @@ void MothurOut::mothurOut(string output) {
 /*********************************************************************************************/
 void MothurOut::mothurOutJustToScreen(string output) {
 	try {
+		lock_guard<recursive_mutex> guard(outputLock);
 		
 #ifdef USE_MPI
         int pid;
@@ -406,6 +409,7 @@ void MothurOut::mothurOutJustToScreen(string output) {
 /*********************************************************************************************/
 void MothurOut::mothurOutEndLine() {
 	try {
+		lock_guard<recursive_mutex> guard(outputLock);
 		#ifdef USE_MPI
 			int pid;
 			MPI_Comm_rank(MPI_COMM_WORLD, &pid); 
@@ -430,6 +434,7 @@ void MothurOut::mothurOutEndLine() {
 /*********************************************************************************************/
 void MothurOut::mothurOut(string output, ofstream& outputFile) {
 	try {
+		lock_guard<recursive_mutex> guard(outputLock);
 		
 #ifdef USE_MPI
 		int pid;
@@ -465,6 +470,7 @@ void MothurOut::mothurOut(string output, ofstream& outputFile) {
 /*********************************************************************************************/
 void MothurOut::mothurOutEndLine(ofstream& outputFile) {
 	try {
+		lock_guard<recursive_mutex> guard(outputLock);
 #ifdef USE_MPI
 		int pid;
 		MPI_Comm_rank(MPI_COMM_WORLD, &pid); 
@@ -489,6 +495,7 @@ void MothurOut::mothurOutEndLine(ofstream& outputFile) {
 /*********************************************************************************************/
 void MothurOut::mothurOutJustToLog(string output) {
 	try {
+		lock_guard<recursive_mutex> guard(outputLock);
 		#ifdef USE_MPI
 			int pid;
 			MPI_Comm_rank(MPI_COMM_WORLD, &pid); 
@@ -515,6 +522,7 @@ void MothurOut::mothurOutJustToLog(string output) {
 }
 /*********************************************************************************************/
 void MothurOut::errorOut(exception& e, string object, string function) {
+	lock_guard<recursive_mutex> guard(outputLock);
 	//double vm, rss;
 	//mem_usage(vm, rss);
 	
@@ -627,6 +635,12 @@ int MothurOut::openOutputFileAppend(string fileName, ofstream& fileHandle){
 	try {
 		fileName = getFullPathName(fileName);
 		
+#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+#ifdef USE_COMPRESSION
+		if (CompressedStreams::isCompressed(fileName)) { CompressedStreams::getInstance()->openOutput(fileName, fileHandle, ios::out | ios::app); }
+		else
+#endif
+#endif
 		fileHandle.open(fileName.c_str(), ios::app);
 		if(!fileHandle) {
 			mothurOut("[ERROR]: Could not open " + fileName); mothurOutEndLine();
@@ -646,6 +660,12 @@ int MothurOut::openOutputFileBinaryAppend(string fileName, ofstream& fileHandle)
 	try {
 		fileName = getFullPathName(fileName);
 		
+#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+#ifdef USE_COMPRESSION
+		if (CompressedStreams::isCompressed(fileName)) { CompressedStreams::getInstance()->openOutput(fileName, fileHandle, ios::out | ios::app | ios::binary); }
+		else
+#endif
+#endif
 		fileHandle.open(fileName.c_str(), ios::app | ios::binary);
 		if(!fileHandle) {
 			mothurOut("[ERROR]: Could not open " + fileName); mothurOutEndLine();
@@ -762,15 +782,6 @@ string MothurOut::getline(ifstream& fileHandle) {
 }
 /***********************************************************************/
 
-#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
-#ifdef USE_COMPRESSION
-inline bool endsWith(string s, const char * suffix){
-  size_t suffixLength = strlen(suffix);
-  return s.size() >= suffixLength && s.substr(s.size() - suffixLength, suffixLength).compare(suffix) == 0;
-}
-#endif
-#endif
-
 string MothurOut::getRootName(string longName){
 	try {
 	
@@ -778,10 +789,9 @@ string MothurOut::getRootName(string longName){
 
 #if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
 #ifdef USE_COMPRESSION
-    if (endsWith(rootName, ".gz") || endsWith(rootName, ".bz2")) {
+    if (CompressedStreams::isCompressed(rootName)) {
       int pos = rootName.find_last_of('.');
       rootName = rootName.substr(0, pos);
-      cerr << "shortening " << longName << " to " << rootName << "\n";
     }
 #endif
 #endif
@@ -1210,29 +1220,11 @@ int MothurOut::openInputFile(string fileName, ifstream& fileHandle, string m){
 			string completeFileName = getFullPathName(fileName);
 #if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
 #ifdef USE_COMPRESSION
-      // check for gzipped or bzipped file
-      if (endsWith(completeFileName, ".gz") || endsWith(completeFileName, ".bz2")) {
-        string tempName = string(tmpnam(0));
-        mkfifo(tempName.c_str(), 0666);
-        int fork_result = fork();
-        if (fork_result < 0) {
-          cerr << "Error forking.\n";
-          exit(1);
-        } else if (fork_result == 0) {
-          string command = (endsWith(completeFileName, ".gz") ? "zcat " : "bzcat ") + completeFileName + string(" > ") + tempName;
-          cerr << "Decompressing " << completeFileName << " via temporary named pipe " << tempName << "\n";
-          system(command.c_str());
-          cerr << "Done decompressing " << completeFileName << "\n";
-          mothurRemove(tempName);
-          exit(EXIT_SUCCESS);
-        } else {
-          cerr << "waiting on child process " << fork_result << "\n";
-          completeFileName = tempName;
-        }
-      }
+		if (CompressedStreams::isCompressed(completeFileName)) { CompressedStreams::getInstance()->openInput(completeFileName, fileHandle, ios::in); }
+		else
 #endif
 #endif
-			fileHandle.open(completeFileName.c_str());
+		fileHandle.open(completeFileName.c_str());
 			if(!fileHandle) {
 				//mothurOut("[ERROR]: Could not open " + completeFileName); mothurOutEndLine();
 				return 1;
@@ -1257,29 +1249,10 @@ int MothurOut::openInputFile(string fileName, ifstream& fileHandle){
 		string completeFileName = getFullPathName(fileName);
 #if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
 #ifdef USE_COMPRESSION
-  // check for gzipped or bzipped file
-  if (endsWith(completeFileName, ".gz") || endsWith(completeFileName, ".bz2")) {
-    string tempName = string(tmpnam(0));
-    mkfifo(tempName.c_str(), 0666);
-    int fork_result = fork();
-    if (fork_result < 0) {
-      cerr << "Error forking.\n";
-      exit(1);
-    } else if (fork_result == 0) {
-      string command = (endsWith(completeFileName, ".gz") ? "zcat " : "bzcat ") + completeFileName + string(" > ") + tempName;
-      cerr << "Decompressing " << completeFileName << " via temporary named pipe " << tempName << "\n";
-      system(command.c_str());
-      cerr << "Done decompressing " << completeFileName << "\n";
-      mothurRemove(tempName);
-      exit(EXIT_SUCCESS);
-    } else {
-      cerr << "waiting on child process " << fork_result << "\n";
-      completeFileName = tempName;
-    }
-  }
+		if (CompressedStreams::isCompressed(completeFileName)) { CompressedStreams::getInstance()->openInput(completeFileName, fileHandle, ios::in); }
+		else
 #endif
 #endif
-
 		fileHandle.open(completeFileName.c_str());
 		if(!fileHandle) {
 			mothurOut("[ERROR]: Could not open " + completeFileName); mothurOutEndLine();
@@ -1307,29 +1280,10 @@ int MothurOut::openInputFileBinary(string fileName, ifstream& fileHandle){
 		string completeFileName = getFullPathName(fileName);
 #if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
 #ifdef USE_COMPRESSION
-        // check for gzipped or bzipped file
-        if (endsWith(completeFileName, ".gz") || endsWith(completeFileName, ".bz2")) {
-            string tempName = string(tmpnam(0));
-            mkfifo(tempName.c_str(), 0666);
-            int fork_result = fork();
-            if (fork_result < 0) {
-                cerr << "Error forking.\n";
-                exit(1);
-            } else if (fork_result == 0) {
-                string command = (endsWith(completeFileName, ".gz") ? "zcat " : "bzcat ") + completeFileName + string(" > ") + tempName;
-                cerr << "Decompressing " << completeFileName << " via temporary named pipe " << tempName << "\n";
-                system(command.c_str());
-                cerr << "Done decompressing " << completeFileName << "\n";
-                mothurRemove(tempName);
-                exit(EXIT_SUCCESS);
-            } else {
-                cerr << "waiting on child process " << fork_result << "\n";
-                completeFileName = tempName;
-            }
-        }
+		if (CompressedStreams::isCompressed(completeFileName)) { CompressedStreams::getInstance()->openInput(completeFileName, fileHandle, ios::in | ios::binary); }
+		else
 #endif
 #endif
-        
 		fileHandle.open(completeFileName.c_str(), ios::binary);
 		if(!fileHandle) {
 			mothurOut("[ERROR]: Could not open " + completeFileName); mothurOutEndLine();
@@ -1357,29 +1311,10 @@ int MothurOut::openInputFileBinary(string fileName, ifstream& fileHandle, string
 		string completeFileName = getFullPathName(fileName);
 #if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
 #ifdef USE_COMPRESSION
-        // check for gzipped or bzipped file
-        if (endsWith(completeFileName, ".gz") || endsWith(completeFileName, ".bz2")) {
-            string tempName = string(tmpnam(0));
-            mkfifo(tempName.c_str(), 0666);
-            int fork_result = fork();
-            if (fork_result < 0) {
-                cerr << "Error forking.\n";
-                exit(1);
-            } else if (fork_result == 0) {
-                string command = (endsWith(completeFileName, ".gz") ? "zcat " : "bzcat ") + completeFileName + string(" > ") + tempName;
-                cerr << "Decompressing " << completeFileName << " via temporary named pipe " << tempName << "\n";
-                system(command.c_str());
-                cerr << "Done decompressing " << completeFileName << "\n";
-                mothurRemove(tempName);
-                exit(EXIT_SUCCESS);
-            } else {
-                cerr << "waiting on child process " << fork_result << "\n";
-                completeFileName = tempName;
-            }
-        }
+		if (CompressedStreams::isCompressed(completeFileName)) { CompressedStreams::getInstance()->openInput(completeFileName, fileHandle, ios::in | ios::binary); }
+		else
 #endif
 #endif
-        
 		fileHandle.open(completeFileName.c_str(), ios::binary);
 		if(!fileHandle) {
 			//mothurOut("[ERROR]: Could not open " + completeFileName); mothurOutEndLine();
@@ -1531,6 +1466,13 @@ int MothurOut::renameFile(string oldName, string newName){
         
         if (oldName == newName) { return 0; }
         
+#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+#ifdef USE_COMPRESSION
+        CompressedStreams::getInstance()->wait(getFullPathName(oldName));
+        CompressedStreams::getInstance()->wait(getFullPathName(newName));
+#endif
+#endif
+        
 		ifstream inTest;
 		int exist = openInputFile(newName, inTest, "");
 		inTest.close();
@@ -1564,23 +1506,8 @@ int MothurOut::openOutputFile(string fileName, ofstream& fileHandle){
 		string completeFileName = getFullPathName(fileName);
 #if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
 #ifdef USE_COMPRESSION
-    // check for gzipped file
-    if (endsWith(completeFileName, ".gz") || endsWith(completeFileName, ".bz2")) {
-      string tempName = string(tmpnam(0));
-      mkfifo(tempName.c_str(), 0666);
-      cerr << "Compressing " << completeFileName << " via temporary named pipe " << tempName << "\n";
-      int fork_result = fork();
-      if (fork_result < 0) {
-        cerr << "Error forking.\n";
-        exit(1);
-      } else if (fork_result == 0) {
-        string command = string(endsWith(completeFileName, ".gz") ?  "gzip" : "bzip2") + " -v > " + completeFileName + string(" < ") + tempName;
-        system(command.c_str());
-        exit(0);
-      } else {
-        completeFileName = tempName;
-      }
-    }
+		if (CompressedStreams::isCompressed(completeFileName)) { CompressedStreams::getInstance()->openOutput(completeFileName, fileHandle, ios::out | ios::trunc); }
+		else
 #endif
 #endif
 		fileHandle.open(completeFileName.c_str(), ios::trunc);
@@ -1606,23 +1533,8 @@ int MothurOut::openOutputFileBinary(string fileName, ofstream& fileHandle){
 		string completeFileName = getFullPathName(fileName);
 #if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
 #ifdef USE_COMPRESSION
-        // check for gzipped file
-        if (endsWith(completeFileName, ".gz") || endsWith(completeFileName, ".bz2")) {
-            string tempName = string(tmpnam(0));
-            mkfifo(tempName.c_str(), 0666);
-            cerr << "Compressing " << completeFileName << " via temporary named pipe " << tempName << "\n";
-            int fork_result = fork();
-            if (fork_result < 0) {
-                cerr << "Error forking.\n";
-                exit(1);
-            } else if (fork_result == 0) {
-                string command = string(endsWith(completeFileName, ".gz") ?  "gzip" : "bzip2") + " -v > " + completeFileName + string(" < ") + tempName;
-                system(command.c_str());
-                exit(0);
-            } else {
-                completeFileName = tempName;
-            }
-        }
+		if (CompressedStreams::isCompressed(completeFileName)) { CompressedStreams::getInstance()->openOutput(completeFileName, fileHandle, ios::out | ios::trunc | ios::binary); }
+		else
 #endif
 #endif
 		fileHandle.open(completeFileName.c_str(), ios::trunc | ios::binary);
@@ -1779,70 +1691,18 @@ int MothurOut::appendFilesWithoutHeaders(string temp, string filename) {
 	}	
 }
 /**************************************************************************************************/
-string MothurOut::sortFile(string distFile, string outputDir){
-	try {	
-	
-		//if (outputDir == "") {  outputDir += hasPath(distFile);  }
-		string outfile = getRootName(distFile) + "sorted.dist";
-
-		
-		//if you can, use the unix sort since its been optimized for years
-		#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
-			string command = "sort -n -k +3 " + distFile + " -o " + outfile;
-			system(command.c_str());
-		#else //you are stuck with my best attempt...
-			//windows sort does not have a way to specify a column, only a character in the line
-			//since we cannot assume that the distance will always be at the the same character location on each line
-			//due to variable sequence name lengths, I chose to force the distance into first position, then sort and then put it back.
-		
-			//read in file line by file and put distance first
-			string tempDistFile = distFile + ".temp";
-			ifstream input;
-			ofstream output;
-			openInputFile(distFile, input);
-			openOutputFile(tempDistFile, output);
-
-			string firstName, secondName;
-			float dist;
-			while (!input.eof()) {
-				input >> firstName >> secondName >> dist;
-				output << dist << '\t' << firstName << '\t' << secondName << endl;
-				gobble(input);
-			}
-			input.close();
-			output.close();
-		
-	
-			//sort using windows sort
-			string tempOutfile = outfile + ".temp";
-			string command = "sort " + tempDistFile + " /O " + tempOutfile;
-			system(command.c_str());
-		
-			//read in sorted file and put distance at end again
-			ifstream input2;
-            ofstream output2;
-			openInputFile(tempOutfile, input2);
-			openOutputFile(outfile, output2);
-		
-            while (!input2.eof()) {
-				input2 >> dist >> firstName >> secondName;
-				output2 << firstName << '\t' << secondName << '\t' << dist << endl;
-				gobble(input2);
-			}
-			input2.close();
-			output2.close();
-		
-			//remove temp files
-			mothurRemove(tempDistFile);
-			mothurRemove(tempOutfile);
-		#endif
-		
-		return outfile;
+//the commands that read a file in pieces seek to positions in it, which a compressed file does not have
+static bool splittingCompressedFile(MothurOut* m, string fileName) {
+#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+#ifdef USE_COMPRESSION
+	if (CompressedStreams::isCompressed(fileName)) {
+		m->mothurOut("[ERROR]: " + fileName + " is compressed, and this command reads its input by file position. Please decompress it and rerun.\n");
+		m->control_pressed = true;
+		return true;
 	}
-	catch(exception& e) {
-		errorOut(e, "MothurOut", "sortFile");
-		exit(1);
-	}	
+#endif
+#endif
+	return false;
 }
 /**************************************************************************************************/
 vector<unsigned long long> MothurOut::setFilePosFasta(string filename, long long& num) {
@@ -1851,6 +1711,7 @@ vector<unsigned long long> MothurOut::setFilePosFasta(string filename, long long
 			ifstream inFASTA;
 			//openInputFileBinary(filename, inFASTA);
             string completeFileName = getFullPathName(filename);
+            if (splittingCompressedFile(this, completeFileName)) { num = 0; positions.push_back(0); return positions; }
             inFASTA.open(completeFileName.c_str(), ios::binary);
 						
 			string input;
@@ -1914,6 +1775,7 @@ vector<unsigned long long> MothurOut::setFilePosFasta(string filename, long long
         vector<unsigned long long> positions;
         ifstream inFASTA;
         string completeFileName = getFullPathName(filename);
+        if (splittingCompressedFile(this, completeFileName)) { num = 0; positions.push_back(0); return positions; }
         inFASTA.open(completeFileName.c_str(), ios::binary);
         int nameLine = 2;
         if (delim == '@') { nameLine = 4; }
@@ -1981,6 +1843,7 @@ vector<unsigned long long> MothurOut::setFilePosFasta(string filename, int& num)
         ifstream inFASTA;
         //openInputFile(filename, inFASTA);
         string completeFileName = getFullPathName(filename);
+        if (splittingCompressedFile(this, completeFileName)) { num = 0; positions.push_back(0); return positions; }
         inFASTA.open(completeFileName.c_str(), ios::binary);
         
         string input;
@@ -2109,6 +1972,7 @@ vector<unsigned long long> MothurOut::setFilePosEachLine(string filename, int& n
 			filename = getFullPathName(filename);
 			
 			vector<unsigned long long> positions;
+			if (splittingCompressedFile(this, filename)) { num = 0; positions.push_back(0); return positions; }
 			ifstream in;
 			//openInputFile(filename, in);
 			openInputFileBinary(filename, in);
@@ -2164,6 +2028,7 @@ vector<unsigned long long> MothurOut::setFilePosEachLine(string filename, unsign
         filename = getFullPathName(filename);
         
         vector<unsigned long long> positions;
+        if (splittingCompressedFile(this, filename)) { num = 0; positions.push_back(0); return positions; }
         ifstream in;
         //openInputFile(filename, in);
         openInputFileBinary(filename, in);
@@ -2225,6 +2090,7 @@ vector<unsigned long long> MothurOut::divideFile(string filename, int& proc) {
         unsigned long long size;
         
         filename = getFullPathName(filename);
+        if (splittingCompressedFile(this, filename)) { proc = 1; filePos.push_back(0); return filePos; }
         
         //get num bytes in file
         pFile = fopen (filename.c_str(),"rb");
@@ -2304,6 +2170,7 @@ vector<unsigned long long> MothurOut::divideFile(string filename, int& proc, cha
         unsigned long long size;
         
         filename = getFullPathName(filename);
+        if (splittingCompressedFile(this, filename)) { proc = 1; filePos.push_back(0); return filePos; }
         
         //get num bytes in file
         pFile = fopen (filename.c_str(),"rb");
@@ -2406,6 +2273,7 @@ vector<unsigned long long> MothurOut::divideFilePerLine(string filename, int& pr
 		unsigned long long size;
 		
 		filename = getFullPathName(filename);
+		if (splittingCompressedFile(this, filename)) { proc = 1; filePos.push_back(0); return filePos; }
         
 		//get num bytes in file
 		pFile = fopen (filename.c_str(),"rb");
@@ -3503,6 +3371,11 @@ bool MothurOut::isSubset(vector<string> bigset, vector<string> subset) {
 int MothurOut::mothurRemove(string filename){
 	try {
 		filename = getFullPathName(filename);
+#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+#ifdef USE_COMPRESSION
+		CompressedStreams::getInstance()->wait(filename);
+#endif
+#endif
 		int error = remove(filename.c_str());
         if (debug) {
             mothurOut("[DEBUG]: removed " + filename + "\n");
@@ -86,7 +86,6 @@ class MothurOut {
 		vector<unsigned long long> setFilePosFasta(string, long long&);
         vector<unsigned long long> setFilePosFasta(string, long long&, char);
         vector<unsigned long long> setFilePosFasta(string, int&);
-		string sortFile(string, string);
 		int appendFiles(string, string);
         int appendBinaryFiles(string, string);
         int appendSFFFiles(string, string);
@@ -325,6 +324,7 @@ class MothurOut {
 		vector<string> Groups;
 		vector<string> namesOfGroups;
 		ofstream out;
+		recursive_mutex outputLock;	//commands running on a ThreadPool report from several threads
 		
 		int mem_usage(double&, double&);
 
@@ -80,16 +80,7 @@ NastReport::~NastReport() {
 
 void NastReport::print(){
 	try {
-		candidateReportFile << queryName << '\t' << queryLength << '\t' << templateName << '\t' << templateLength << '\t';
-		candidateReportFile << searchMethod << '\t' << setprecision(2) << fixed << searchScore << '\t';
-
-		candidateReportFile << alignmentMethod << '\t' << candidateStartPosition << "\t" << candidateEndPosition << '\t';
-		candidateReportFile << templateStartPosition << "\t" << templateEndPosition << '\t';
-		candidateReportFile << pairwiseAlignmentLength << '\t' << totalGapsInQuery << '\t' << totalGapsInTemplate << '\t';
-		candidateReportFile << longestInsert << '\t';
-		candidateReportFile << setprecision(2) << similarityToTemplate;
-		
-		candidateReportFile << endl;
+		print(candidateReportFile);
 		candidateReportFile.flush();
 	}
 	catch(exception& e) {
@@ -99,6 +90,26 @@ void NastReport::print(){
 }
 /******************************************************************************************************************/
 
+void NastReport::print(ostream& out){
+	try {
+		out << queryName << '\t' << queryLength << '\t' << templateName << '\t' << templateLength << '\t';
+		out << searchMethod << '\t' << setprecision(2) << fixed << searchScore << '\t';
+
+		out << alignmentMethod << '\t' << candidateStartPosition << "\t" << candidateEndPosition << '\t';
+		out << templateStartPosition << "\t" << templateEndPosition << '\t';
+		out << pairwiseAlignmentLength << '\t' << totalGapsInQuery << '\t' << totalGapsInTemplate << '\t';
+		out << longestInsert << '\t';
+		out << setprecision(2) << similarityToTemplate;
+		
+		out << endl;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "NastReport", "print");
+		exit(1);
+	}
+}
+/******************************************************************************************************************/
+
 string NastReport::getReport(){
 	try {
 		output = "";
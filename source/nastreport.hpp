@@ -27,6 +27,7 @@ public:
 	void setAlignmentParameters(string, Alignment*);
 	void setNastParameters(Nast);
 	void print();
+	void print(ostream&);
 	string getReport();
 	string getHeaders();
 	
@@ -0,0 +1,325 @@
+/*
+ *  needlemansimd.cpp
+ *  Mothur
+ *
+ *  Copyright 2026 Schloss Lab. All rights reserved.
+ *
+ *	The scores are the same floating point sums, compared in the same order, as NeedlemanOverlap::align, so both
+ *	classes pick the same pointer for every cell and give identical alignments.  Cells are indexed by their row i and
+ *	anti-diagonal d = i + j.  Up is (i-1, d-1), left is (i, d-1) and diagonal is (i-1, d-2), so a run of rows on an
+ *	anti-diagonal reads runs of rows from the two before it.
+ *
+ */
+
+#include "needlemansimd.hpp"
+
+#if defined(__AVX__)
+	#include <immintrin.h>
+#elif defined(__SSE2__)
+	#include <emmintrin.h>
+#endif
+
+#define NEEDLEMANSIMD_PAD 16			//the kernel works on 8 cells at a time, so it may read and write past the end of a diagonal
+#define NEEDLEMANSIMD_KMER 7
+
+static const float minusInfinity = -1e30f;
+
+/**************************************************************************************************/
+
+NeedlemanSIMD::NeedlemanSIMD(float gO, float f, float mm, int r, int b) :
+Alignment(), gap(gO), match(f), mismatch(mm), band(b), boundarySize(r) {
+	try {
+		nRows = r;
+		nCols = r;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "NeedlemanSIMD", "NeedlemanSIMD");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+
+NeedlemanSIMD::~NeedlemanSIMD(){	/*	do nothing	*/	}
+
+/**************************************************************************************************/
+//there is no matrix to grow, but NeedlemanOverlap leaves the new cells of its first row and column pointing
+//nowhere, so boundarySize is left alone to give the same alignments
+void NeedlemanSIMD::resize(int A) {
+	nRows = A;
+	nCols = A;
+}
+/**************************************************************************************************/
+
+void NeedlemanSIMD::align(string A, string B){
+	try {
+
+		seqA = ' ' + A;	lA = seqA.length();		//	algorithm requires a dummy space at the beginning of each string
+		seqB = ' ' + B;	lB = seqB.length();		//	algorithm requires a dummy space at the beginning of each string
+
+		if (lA > nRows) { m->mothurOut("One of your candidate sequences is longer than you longest template sequence. Your longest template sequence is " + toString(nRows) + ". Your candidate is " + toString(lA) + "."); m->mothurOutEndLine();  }
+
+		baseB.assign(lB + NEEDLEMANSIMD_PAD, 0);
+		for(int i=1;i<lB;i++){	baseB[i] = (unsigned char)seqB[i];	}
+
+		baseARev.assign(lA + NEEDLEMANSIMD_PAD, 0);
+		for(int i=0;i<lA;i++){	baseARev[i] = (unsigned char)seqA[lA-1-i];	}
+
+		for(int i=0;i<3;i++){	scores[i].assign(lB + NEEDLEMANSIMD_PAD, minusInfinity);	}
+
+		int size = max(lA, lB);
+		lastRow.assign(size, minusInfinity);
+		lastColumn.assign(size, minusInfinity);
+		lastRow[0] = 0;	lastColumn[0] = 0;
+		if(lA == 1){	for(int i=0;i<lB;i++){	lastColumn[i] = 0;	}	}
+		if(lB == 1){	for(int i=0;i<lA;i++){	lastRow[i] = 0;		}	}
+
+		//	find the rows of each anti-diagonal we need to score
+		int lowest = -lA;	int highest = lB;
+		if(band > 0){
+			int diagonal = findDiagonal();
+			if(diagonal != -lA){	lowest = diagonal - band;	highest = diagonal + band;	}
+		}
+
+		int numDiags = lA + lB - 1;
+		diagStart.resize(numDiags);
+		diagEnd.resize(numDiags);
+		diagOffset.resize(numDiags+1);
+		diagOffset[0] = 0;
+
+		for(int d=0;d<numDiags;d++){
+			int start = max(1, d-lA+1);
+			int end = min(lB-1, d-1);
+			if(d+lowest > 0)	{	start = max(start, (d+lowest+1)/2);	}	//	row - column = 2 * row - d must be in [lowest, highest]
+			if(d+highest < 0)	{	end = -1;							}
+			else				{	end = min(end, (d+highest)/2);		}
+			start = min(start, lB);
+			if(end < start)		{	end = start - 1;					}
+
+			diagStart[d] = start;
+			diagEnd[d] = end;
+			diagOffset[d+1] = diagOffset[d] + (end - start + 8) / 8;
+		}
+		upBits.resize(diagOffset[numDiags]);
+		leftBits.resize(diagOffset[numDiags]);
+
+		for(int d=0;d<numDiags;d++){
+			float* current = &scores[d%3][0];
+			float* previous = &scores[(d+2)%3][0];
+			float* twoBack = &scores[(d+1)%3][0];
+
+			int start = diagStart[d];
+			int end = diagEnd[d];
+
+			if(end >= start){	fillDiagonal(d, previous, twoBack, current);	}
+
+			current[start-1] = boundaryValue(start-1, d);		//	the next two diagonals may read one row past either end
+			current[end+1] = boundaryValue(end+1, d);
+
+			int row = d - (lA-1);
+			if(row >= start && row <= end)		{	lastColumn[row] = current[row];		}
+			if(lB-1 >= start && lB-1 <= end)	{	lastRow[d-(lB-1)] = current[lB-1];	}
+		}
+
+		setOverlap();								//	Fix gaps at the beginning and end of the sequences
+		traceBack();								//	Traceback the alignment to populate seqAaln and seqBaln
+
+	}
+	catch(exception& e) {
+		m->errorOut(e, "NeedlemanSIMD", "align");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//	scores the rows diagStart[d] to diagEnd[d] of anti-diagonal d and sets their pointers
+void NeedlemanSIMD::fillDiagonal(int d, const float* previous, const float* twoBack, float* current){
+	try {
+		int start = diagStart[d];
+		int numCells = diagEnd[d] - start + 1;
+
+		const float* up = previous + start - 1;
+		const float* left = previous + start;
+		const float* diagonal = twoBack + start - 1;
+		const float* baseRow = &baseB[start];
+		const float* baseColumn = &baseARev[lA-1-d+start];	//	seqA[d-i] is baseARev[lA-1-d+i]
+		float* score = current + start;
+		unsigned char* upPointers = &upBits[diagOffset[d]];
+		unsigned char* leftPointers = &leftBits[diagOffset[d]];
+
+	#if defined(__AVX__)
+		__m256 vGap = _mm256_set1_ps(gap);
+		__m256 vMatch = _mm256_set1_ps(match);
+		__m256 vMismatch = _mm256_set1_ps(mismatch);
+
+		for(int i=0;i<numCells;i+=8){
+			__m256 same = _mm256_cmp_ps(_mm256_loadu_ps(baseRow+i), _mm256_loadu_ps(baseColumn+i), _CMP_EQ_OQ);
+			__m256 diagScore = _mm256_add_ps(_mm256_loadu_ps(diagonal+i), _mm256_blendv_ps(vMismatch, vMatch, same));
+			__m256 upScore = _mm256_add_ps(_mm256_loadu_ps(up+i), vGap);
+			__m256 leftScore = _mm256_add_ps(_mm256_loadu_ps(left+i), vGap);
+
+			__m256 isDiag = _mm256_and_ps(_mm256_cmp_ps(diagScore, upScore, _CMP_GE_OQ), _mm256_cmp_ps(diagScore, leftScore, _CMP_GE_OQ));
+			__m256 upOverLeft = _mm256_cmp_ps(upScore, leftScore, _CMP_GE_OQ);
+
+			__m256 best = _mm256_blendv_ps(_mm256_blendv_ps(leftScore, upScore, upOverLeft), diagScore, isDiag);
+			_mm256_storeu_ps(score+i, best);
+
+			upPointers[i/8] = _mm256_movemask_ps(_mm256_andnot_ps(isDiag, upOverLeft));
+			leftPointers[i/8] = ~_mm256_movemask_ps(_mm256_or_ps(isDiag, upOverLeft));
+		}
+	#elif defined(__SSE2__)
+		__m128 vGap = _mm_set1_ps(gap);
+		__m128 vMatch = _mm_set1_ps(match);
+		__m128 vMismatch = _mm_set1_ps(mismatch);
+
+		for(int i=0;i<numCells;i+=8){
+			int upMask = 0;
+			int notLeftMask = 0;
+
+			for(int h=i;h<i+8;h+=4){
+				__m128 same = _mm_cmpeq_ps(_mm_loadu_ps(baseRow+h), _mm_loadu_ps(baseColumn+h));
+				__m128 diagScore = _mm_add_ps(_mm_loadu_ps(diagonal+h), _mm_or_ps(_mm_and_ps(same, vMatch), _mm_andnot_ps(same, vMismatch)));
+				__m128 upScore = _mm_add_ps(_mm_loadu_ps(up+h), vGap);
+				__m128 leftScore = _mm_add_ps(_mm_loadu_ps(left+h), vGap);
+
+				__m128 isDiag = _mm_and_ps(_mm_cmpge_ps(diagScore, upScore), _mm_cmpge_ps(diagScore, leftScore));
+				__m128 upOverLeft = _mm_cmpge_ps(upScore, leftScore);
+
+				__m128 best = _mm_or_ps(_mm_and_ps(upOverLeft, upScore), _mm_andnot_ps(upOverLeft, leftScore));
+				best = _mm_or_ps(_mm_and_ps(isDiag, diagScore), _mm_andnot_ps(isDiag, best));
+				_mm_storeu_ps(score+h, best);
+
+				upMask |= _mm_movemask_ps(_mm_andnot_ps(isDiag, upOverLeft)) << (h-i);
+				notLeftMask |= _mm_movemask_ps(_mm_or_ps(isDiag, upOverLeft)) << (h-i);
+			}
+
+			upPointers[i/8] = upMask;
+			leftPointers[i/8] = ~notLeftMask;
+		}
+	#else
+		for(int i=0;i<numCells;i+=8){
+			unsigned char upMask = 0;
+			unsigned char leftMask = 0;
+
+			for(int h=i;h<i+8 && h<numCells;h++){
+				float diagScore = diagonal[h] + ((baseRow[h] == baseColumn[h]) ? match : mismatch);
+				float upScore = up[h] + gap;
+				float leftScore = left[h] + gap;
+
+				if(diagScore >= upScore && diagScore >= leftScore)	{	score[h] = diagScore;											}
+				else if(upScore >= leftScore)						{	score[h] = upScore;		upMask |= (1 << (h-i));		}
+				else												{	score[h] = leftScore;	leftMask |= (1 << (h-i));	}
+			}
+
+			upPointers[i/8] = upMask;
+			leftPointers[i/8] = leftMask;
+		}
+	#endif
+	}
+	catch(exception& e) {
+		m->errorOut(e, "NeedlemanSIMD", "fillDiagonal");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//	the first row and column score zero, everything else outside the scored rows can't be used
+float NeedlemanSIMD::boundaryValue(int row, int d){
+	int column = d - row;
+	if(row == 0 && column < lA)		{	return 0;	}
+	if(column == 0 && row < lB)		{	return 0;	}
+	return minusInfinity;
+}
+/**************************************************************************************************/
+//	same as Overlap::setOverlap, using the right most column and bottom row we kept
+void NeedlemanSIMD::setOverlap(){
+	try {
+		float max = -100;
+		int rowIndex = lA - 1;
+		for(int i=0;i<lB;i++){
+			if(lastColumn[i] >= max){	rowIndex = i;	max = lastColumn[i];	}
+		}
+
+		max = -100;
+		int colIndex = lB - 1;
+		for(int i=0;i<lA;i++){
+			if(lastRow[i] >= max){	colIndex = i;	max = lastRow[i];	}
+		}
+
+		overlapRow = lB;
+		overlapColumn = lA;
+
+		if(colIndex == lA-1 && rowIndex == lB-1){}		//	if the max values are the lower right corner, then we're good
+		else if(lastRow[colIndex] < lastColumn[rowIndex])	{	overlapRow = rowIndex;		}
+		else												{	overlapColumn = colIndex;	}
+	}
+	catch(exception& e) {
+		m->errorOut(e, "NeedlemanSIMD", "setOverlap");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+
+char NeedlemanSIMD::getPrevCell(int row, int column){
+	if(column == lA-1 && row > overlapRow)		{	return 'u';	}
+	if(row == lB-1 && column > overlapColumn)	{	return 'l';	}
+
+	if(row == 0)	{	return (column == 0 || column >= boundarySize) ? 'x' : 'l';	}
+	if(column == 0)	{	return (row >= boundarySize) ? 'x' : 'u';					}
+
+	int d = row + column;
+	if(row < diagStart[d])	{	return 'l';	}		//	outside the band, head back towards it
+	if(row > diagEnd[d])	{	return 'u';	}
+
+	int k = row - diagStart[d];
+	unsigned char bit = 1 << (k & 7);
+	if(upBits[diagOffset[d] + k/8] & bit)	{	return 'u';	}
+	if(leftBits[diagOffset[d] + k/8] & bit)	{	return 'l';	}
+	return 'd';
+}
+/**************************************************************************************************/
+//	returns the row - column offset shared by the most 7-mers of the two sequences, or -lA if they share none
+int NeedlemanSIMD::findDiagonal(){
+	try {
+		int numKmers = 1 << (2 * NEEDLEMANSIMD_KMER);
+		int mask = numKmers - 1;
+		kmerPos.assign(numKmers, -1);
+
+		int kmer = 0;	int length = 0;
+		for(int i=1;i<lB;i++){
+			int base = -1;
+			switch(toupper(seqB[i])){
+				case 'A': base = 0; break;
+				case 'C': base = 1; break;
+				case 'G': base = 2; break;
+				case 'T': case 'U': base = 3; break;
+			}
+			if(base == -1)	{	length = 0;	continue;	}
+			kmer = ((kmer << 2) | base) & mask;
+			if(++length >= NEEDLEMANSIMD_KMER){	kmerPos[kmer] = i;	}
+		}
+
+		votes.assign(lA + lB, 0);
+		kmer = 0;	length = 0;
+		for(int j=1;j<lA;j++){
+			int base = -1;
+			switch(toupper(seqA[j])){
+				case 'A': base = 0; break;
+				case 'C': base = 1; break;
+				case 'G': base = 2; break;
+				case 'T': case 'U': base = 3; break;
+			}
+			if(base == -1)	{	length = 0;	continue;	}
+			kmer = ((kmer << 2) | base) & mask;
+			if(++length >= NEEDLEMANSIMD_KMER && kmerPos[kmer] != -1){	votes[kmerPos[kmer] - j + lA]++;	}
+		}
+
+		int diagonal = -lA;	int most = 0;
+		for(int i=0;i<votes.size();i++){
+			if(votes[i] > most){	most = votes[i];	diagonal = i - lA;	}
+		}
+		return diagonal;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "NeedlemanSIMD", "findDiagonal");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
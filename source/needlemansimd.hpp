@@ -0,0 +1,60 @@
+#ifndef NEEDLEMANSIMD_H
+#define NEEDLEMANSIMD_H
+
+/*
+ *  needlemansimd.hpp
+ *  Mothur
+ *
+ *  Copyright 2026 Schloss Lab. All rights reserved.
+ *
+ *	This class is an Alignment child class that finds the same alignments as NeedlemanOverlap, but fills the dynamic
+ *	programming matrix one anti-diagonal at a time.  The cells on an anti-diagonal only depend on the two anti-diagonals
+ *	before it, so they are scored several at a time in the SSE (or AVX) registers.  Only the last three anti-diagonals
+ *	of scores are kept, along with the right most column and bottom row needed to fix the ends (see Overlap class
+ *	documentation).  The traceback pointers are stored as two bits per cell.
+ *
+ *	If band is set, only the cells within band positions of the diagonal with the most 7-mers in common are scored.
+ *	This is faster for long sequences, but can miss the best alignment, so it is off by default.
+ *
+ */
+
+#include "mothur.h"
+#include "alignment.hpp"
+
+/**************************************************************************************************/
+
+class NeedlemanSIMD : public Alignment {
+
+public:
+	NeedlemanSIMD(float, float, float, int, int);		//gap, match, mismatch, longest base, band (0 scores the full matrix)
+	~NeedlemanSIMD();
+	void align(string, string);
+	void resize(int);
+
+protected:
+	char getPrevCell(int, int);
+
+private:
+	float gap;
+	float match;
+	float mismatch;
+	int band;
+	int boundarySize;						//the first row and column point to the left and up out to the size we were constructed with
+	int overlapRow, overlapColumn;			//set by setOverlap, the end gaps start after these cells
+
+	vector<float> baseB, baseARev;			//the sequences as floats so they can be compared in the vector registers, seqA is reversed
+	vector<float> scores[3];				//the last three anti-diagonals, indexed by row
+	vector<float> lastRow, lastColumn;
+	vector<int> diagStart, diagEnd, diagOffset;
+	vector<unsigned char> upBits, leftBits;	//two bits per cell, neither set means the cell points diagonally
+	vector<int> kmerPos, votes;
+
+	int findDiagonal();
+	float boundaryValue(int, int);
+	void fillDiagonal(int, const float*, const float*, float*);
+	void setOverlap();
+};
+
+/**************************************************************************************************/
+
+#endif
@@ -0,0 +1,235 @@
+/*
+ *  oligoindex.cpp
+ *  Mothur
+ *
+ *  Copyright 2026 Schloss Lab. All rights reserved.
+ *
+ */
+
+#include "oligoindex.h"
+
+/**************************************************************************************************/
+OligoIndex::OligoIndex() {
+	m = MothurOut::getInstance();
+	diffs = 0;
+}
+/**************************************************************************************************/
+OligoIndex::OligoIndex(vector<string> o, int d) {
+	try {
+		m = MothurOut::getInstance();
+		oligos = o;
+		diffs = d;
+
+		for (int i = 0; i < oligos.size(); i++) {
+			if (!addSegments(i)) { unindexed.push_back(i); }
+		}
+	}
+	catch(exception& e) {
+		m->errorOut(e, "OligoIndex", "OligoIndex");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//cuts the oligo into diffs+1 segments and adds each segment's bases, returns false if the oligo can't be indexed
+bool OligoIndex::addSegments(int index) {
+	try {
+		string oligo = oligos[index];
+		int numSegments = diffs + 1;
+		int length = oligo.length() / numSegments;
+
+		if (length < 4) { return false; }	//short segments are found almost everywhere
+
+		vector< vector<string> > segments;
+		int offset = 0;
+		for (int i = 0; i < numSegments; i++) {
+			int segmentLength = length;
+			if (i < (oligo.length() % numSegments)) { segmentLength++; }
+
+			//list out the bases each ambiguous base matches
+			vector<string> bases(1, "");
+			for (int j = offset; j < offset+segmentLength; j++) {
+				string matches = getMatches(oligo[j]);
+				if ((matches == "") || ((bases.size() * matches.length()) > 256)) { return false; }
+
+				vector<string> temp;
+				for (int k = 0; k < bases.size(); k++) {
+					for (int l = 0; l < matches.length(); l++) { temp.push_back(bases[k] + matches[l]); }
+				}
+				bases = temp;
+			}
+			segments.push_back(bases);
+			offset += segmentLength;
+		}
+
+		offset = 0;
+		for (int i = 0; i < segments.size(); i++) {
+			int segmentLength = segments[i][0].length();
+
+			int p = 0;
+			for (; p < probes.size(); p++) {
+				if ((probes[p].offset == offset) && (probes[p].length == segmentLength)) { break; }
+			}
+			if (p == probes.size()) {
+				Probe probe; probe.offset = offset; probe.length = segmentLength;
+				probes.push_back(probe);
+			}
+
+			for (int j = 0; j < segments[i].size(); j++) {
+				vector<int>& found = probes[p].oligos[segments[i][j]];
+				if ((found.size() == 0) || (found.back() != index)) { found.push_back(index); }
+			}
+			offset += segmentLength;
+		}
+
+		return true;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "OligoIndex", "addSegments");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//the oligos that may align to the start of the seq, the window TrimOligos aligns is the oligo's length plus diffs
+vector<int> OligoIndex::getCandidates(string& seq) {
+	try {
+		vector<bool> found(oligos.size(), false);
+		for (int i = 0; i < unindexed.size(); i++) { found[unindexed[i]] = true; }
+
+		int seqLength = seq.length();
+		for (int p = 0; p < probes.size(); p++) {
+			for (int shift = -diffs; shift <= diffs; shift++) {
+				int pos = probes[p].offset + shift;
+				if ((pos < 0) || ((pos + probes[p].length) > seqLength)) { continue; }
+
+				map<string, vector<int> >::iterator it = probes[p].oligos.find(seq.substr(pos, probes[p].length));
+				if (it != probes[p].oligos.end()) {
+					for (int i = 0; i < it->second.size(); i++) { found[it->second[i]] = true; }
+				}
+			}
+		}
+
+		vector<int> candidates;
+		for (int i = 0; i < found.size(); i++) {
+			if (found[i]) { candidates.push_back(i); }
+		}
+
+		return candidates;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "OligoIndex", "getCandidates");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//the starts of the windows that each oligo may align to when sliding it along the seq, as findForward does
+vector< vector<int> > OligoIndex::getCandidateStarts(string& seq) {
+	try {
+		vector< vector<int> > starts(oligos.size());
+		int seqLength = seq.length();
+
+		for (int i = 0; i < unindexed.size(); i++) {
+			int window = oligos[unindexed[i]].length() + diffs;
+			for (int j = 0; j < (seqLength - window); j++) { starts[unindexed[i]].push_back(j); }
+		}
+
+		for (int p = 0; p < probes.size(); p++) {
+			for (int pos = 0; (pos + probes[p].length) <= seqLength; pos++) {
+				if (m->control_pressed) { return starts; }
+
+				map<string, vector<int> >::iterator it = probes[p].oligos.find(seq.substr(pos, probes[p].length));
+				if (it == probes[p].oligos.end()) { continue; }
+
+				for (int i = 0; i < it->second.size(); i++) {
+					int window = oligos[it->second[i]].length() + diffs;
+					for (int shift = -diffs; shift <= diffs; shift++) {
+						int start = pos - probes[p].offset - shift;
+						if ((start >= 0) && (start < (seqLength - window))) { starts[it->second[i]].push_back(start); }
+					}
+				}
+			}
+		}
+
+		for (int i = 0; i < starts.size(); i++) {
+			sort(starts[i].begin(), starts[i].end());
+			starts[i].erase(unique(starts[i].begin(), starts[i].end()), starts[i].end());
+		}
+
+		return starts;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "OligoIndex", "getCandidateStarts");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//the fewest diffs of any alignment of the oligo to the window at start, with the bases after the oligo left off. the
+//fewest diffs in a row never goes down, so once a row has none below the cutoff the rest are skipped
+int OligoIndex::getBound(int index, string& seq, int start, int cutoff) {
+	try {
+		string oligo = oligos[index];
+		int window = min((int)(oligo.length() + diffs), (int)(seq.length() - start));
+		if (window < 0) { window = 0; }
+
+		vector<int> previous(window+1, 0);
+		vector<int> current(window+1, 0);
+		for (int j = 0; j <= window; j++) { previous[j] = j; }
+
+		for (int i = 0; i < oligo.length(); i++) {
+			int gap = isDiff(oligo[i], '-');
+			current[0] = previous[0] + gap;
+			int rowMin = current[0];
+			for (int j = 1; j <= window; j++) {
+				int best = previous[j-1] + isDiff(oligo[i], seq[start+j-1]);
+				if ((previous[j] + gap) < best) { best = previous[j] + gap; }
+				if ((current[j-1] + 1) < best) { best = current[j-1] + 1; }
+				current[j] = best;
+				if (best < rowMin) { rowMin = best; }
+			}
+			previous.swap(current);
+			if (rowMin >= cutoff) { return rowMin; }
+		}
+
+		return *min_element(previous.begin(), previous.end());
+	}
+	catch(exception& e) {
+		m->errorOut(e, "OligoIndex", "getBound");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//the bases of the seq that are not a diff against the oligo's base, empty if any base would do
+string OligoIndex::getMatches(char base) {
+	if ((base == 'A') || (base == 'T') || (base == 'G') || (base == 'C'))	{	return string(1, base);	}
+	else if (base == 'R')	{	return "RAG";	}
+	else if (base == 'Y')	{	return "YCT";	}
+	else if (base == 'M')	{	return "MCA";	}
+	else if (base == 'K')	{	return "KTG";	}
+	else if (base == 'W')	{	return "WTA";	}
+	else if (base == 'S')	{	return "SCG";	}
+	else if (base == 'B')	{	return "BCTG";	}
+	else if (base == 'D')	{	return "DATG";	}
+	else if (base == 'H')	{	return "HATC";	}
+	else if (base == 'V')	{	return "VACG";	}
+	return "";
+}
+/**************************************************************************************************/
+//same as TrimOligos::countDiffs for one base
+bool OligoIndex::isDiff(char oligo, char seq) {
+	if (oligo == seq) { return false; }
+
+	if(oligo == 'A' || oligo == 'T' || oligo == 'G' || oligo == 'C' || oligo == '-' || oligo == '.')	{	return true; }
+	else if((oligo == 'N' || oligo == 'I') && (seq == 'N'))	{	return true;	}
+	else if(oligo == 'R' && (seq != 'A' && seq != 'G'))	{	return true;	}
+	else if(oligo == 'Y' && (seq != 'C' && seq != 'T'))	{	return true;	}
+	else if(oligo == 'M' && (seq != 'C' && seq != 'A'))	{	return true;	}
+	else if(oligo == 'K' && (seq != 'T' && seq != 'G'))	{	return true;	}
+	else if(oligo == 'W' && (seq != 'T' && seq != 'A'))	{	return true;	}
+	else if(oligo == 'S' && (seq != 'C' && seq != 'G'))	{	return true;	}
+	else if(oligo == 'B' && (seq != 'C' && seq != 'T' && seq != 'G'))	{	return true;	}
+	else if(oligo == 'D' && (seq != 'A' && seq != 'T' && seq != 'G'))	{	return true;	}
+	else if(oligo == 'H' && (seq != 'A' && seq != 'T' && seq != 'C'))	{	return true;	}
+	else if(oligo == 'V' && (seq != 'A' && seq != 'C' && seq != 'G'))	{	return true;	}
+
+	return false;
+}
+/**************************************************************************************************/
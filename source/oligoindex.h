@@ -0,0 +1,58 @@
+#ifndef OLIGOINDEX_H
+#define OLIGOINDEX_H
+
+/*
+ *  oligoindex.h
+ *  Mothur
+ *
+ *  Copyright 2026 Schloss Lab. All rights reserved.
+ *
+ */
+
+/* OligoIndex finds the barcodes or primers that may align to a read with at most diffs differences, so TrimOligos
+ only aligns those instead of every oligo. Each oligo is cut into diffs+1 segments. An alignment with at most diffs
+ differences leaves one segment without any, so that segment is found in the read at its offset in the oligo, give or
+ take diffs bases. The index maps the bases of each segment, with the ambiguous bases listed out, to its oligos.
+
+ The oligos with N's, or segments too short to be worth looking up, can't be indexed and are always searched.
+ getBound is the fewest differences of any alignment of the oligo to the read, counted as TrimOligos counts them, so
+ the oligos not worth aligning can be skipped when looking for the closest one. */
+
+#include "mothur.h"
+#include "mothurout.h"
+
+/**************************************************************************************************/
+
+class OligoIndex {
+
+public:
+	OligoIndex();
+	OligoIndex(vector<string>, int);		//oligos in the order they are searched, diffs
+	~OligoIndex() {}
+
+	int getNumOligos() { return oligos.size(); }
+	string getOligo(int i) { return oligos[i]; }
+	vector<int> getCandidates(string&);		//the oligos that may align to the start of the seq, in order
+	vector< vector<int> > getCandidateStarts(string&);		//the starts of the windows of the seq that each oligo may align to
+	int getBound(int, string&, int, int);	//oligo, seq, start of the window, cutoff - stops early once the bound is at least the cutoff
+
+private:
+	struct Probe {
+		int offset, length;
+		map<string, vector<int> > oligos;		//bases of the segments at the offset, the oligos they are from
+	};
+
+	MothurOut* m;
+	int diffs;
+	vector<string> oligos;
+	vector<Probe> probes;
+	vector<int> unindexed;
+
+	bool addSegments(int);
+	string getMatches(char);
+	bool isDiff(char, char);
+};
+
+/**************************************************************************************************/
+
+#endif
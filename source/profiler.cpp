@@ -0,0 +1,234 @@
+/*
+ *  profiler.cpp
+ *  Mothur
+ *
+ *  Copyright 2026 Schloss Lab. All rights reserved.
+ *
+ */
+
+#include "profiler.h"
+#include <chrono>
+
+/**************************************************************************************************/
+
+Profiler* Profiler::getInstance() {
+	if (myInstance == NULL) {
+		myInstance = new Profiler();
+	}
+	return myInstance;
+}
+/**************************************************************************************************/
+
+Profiler::Profiler() {
+	m = MothurOut::getInstance();
+	active = false;
+	running = false;
+	reportFile = "";
+	commandName = "";
+	numCommands = 0;
+}
+/**************************************************************************************************/
+
+Profiler::Sample Profiler::getSample() {
+	try {
+		Sample sample;
+		sample.wall = chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count();
+		sample.cpu = 0; sample.peak = 0; sample.childPeak = 0; sample.read = 0; sample.written = 0;
+
+	#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+		struct rusage self, children;
+		getrusage(RUSAGE_SELF, &self);
+		getrusage(RUSAGE_CHILDREN, &children);
+
+		sample.cpu = self.ru_utime.tv_sec + self.ru_utime.tv_usec / 1000000.0 + self.ru_stime.tv_sec + self.ru_stime.tv_usec / 1000000.0;
+		sample.cpu += children.ru_utime.tv_sec + children.ru_utime.tv_usec / 1000000.0 + children.ru_stime.tv_sec + children.ru_stime.tv_usec / 1000000.0;
+
+		#if defined (__APPLE__) || (__MACH__)
+			sample.peak = self.ru_maxrss / 1024;		//bytes on the mac
+			sample.childPeak = children.ru_maxrss / 1024;
+		#else
+			sample.peak = self.ru_maxrss;
+			sample.childPeak = children.ru_maxrss;
+
+			//the high water mark can be reset for each command, ru_maxrss is the peak since mothur started
+			ifstream status("/proc/self/status");
+			string line;
+			while (getline(status, line)) {
+				if (line.compare(0, 6, "VmHWM:") == 0) { sample.peak = atol(line.c_str() + 6); break; }
+			}
+			status.close();
+
+			ifstream io("/proc/self/io");
+			while (getline(io, line)) {
+				if (line.compare(0, 6, "rchar:") == 0)		{ sample.read = strtoull(line.c_str() + 6, NULL, 10);		}
+				else if (line.compare(0, 6, "wchar:") == 0) { sample.written = strtoull(line.c_str() + 6, NULL, 10);	}
+			}
+			io.close();
+		#endif
+	#endif
+
+		return sample;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Profiler", "getSample");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//on Linux, writing 5 to clear_refs resets the VmHWM of the process to its current size
+void Profiler::resetPeak() {
+	try {
+	#if (linux) || (__linux) || (__linux__)
+		ofstream clear("/proc/self/clear_refs");
+		if (clear) { clear << "5"; clear.close(); }
+	#endif
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Profiler", "resetPeak");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+
+void Profiler::startCommand(string name) {
+	try {
+		lock_guard<mutex> guard(lock);
+		if (!active) { return; }
+
+		numCommands++;
+		commandName = name;
+		phases.clear();
+		resetPeak();
+		commandStart = getSample();
+		running = true;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Profiler", "startCommand");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+
+void Profiler::startPhase(string name) {
+	try {
+		lock_guard<mutex> guard(lock);
+		if (!running) { return; }
+
+		Phase phase;
+		phase.name = name;
+		phase.start = getSample();
+		phases.push_back(phase);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Profiler", "startPhase");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+
+void Profiler::endCommand(int status) {
+	try {
+		lock_guard<mutex> guard(lock);
+		if (!running) { return; }	//set.profile turned the profiler on while the command ran
+		running = false;
+		if (!active) { return; }
+
+		Sample end = getSample();
+
+		//each phase ends when the next one starts
+		vector<string> rows;
+		rows.push_back(getRow("total", status, commandStart, end));
+		for (int i = 0; i < phases.size(); i++) {
+			const Sample& phaseEnd = (i+1 < phases.size()) ? phases[i+1].start : end;
+			rows.push_back(getRow(phases[i].name, status, phases[i].start, phaseEnd));
+		}
+
+		writeRows(rows);
+		phases.clear();
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Profiler", "endCommand");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//a forked process's peak is only known once it is larger than the largest before the command
+string Profiler::getRow(string phase, int status, const Sample& start, const Sample& end) {
+	try {
+		long peak = end.peak;
+		if (end.childPeak > commandStart.childPeak) { peak = max(peak, end.childPeak); }
+
+		string row = toString(numCommands) + "\t" + commandName + "\t" + phase + "\t" + toString(status) + "\t";
+		row += toString(end.wall - start.wall, 3) + "\t" + toString(end.cpu - start.cpu, 3) + "\t" + toString(peak) + "\t";
+		row += toString(end.read - start.read) + "\t" + toString(end.written - start.written);
+		return row;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Profiler", "getRow");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+
+void Profiler::writeRows(vector<string>& rows) {
+	try {
+	#ifdef USE_MPI
+		int pid;
+		MPI_Comm_rank(MPI_COMM_WORLD, &pid);
+		if (pid != 0) { return; }	//only one process writes the report
+	#endif
+
+		if (reportFile == "") { return; }
+
+		ifstream test(reportFile.c_str());
+		bool exists = test.good();
+		test.close();
+
+		ofstream out;
+		m->openOutputFileAppend(reportFile, out);
+		if (!exists) { out << "command_number\tcommand\tphase\tstatus\twall_secs\tcpu_secs\tpeak_rss_kb\tbytes_read\tbytes_written\n"; }
+		for (int i = 0; i < rows.size(); i++) { out << rows[i] << '\n'; }
+		out.close();
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Profiler", "writeRows");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//the report is kept next to the logfile, and appended to the old report when the logfile is appended to
+void Profiler::moveReport(string logFile, bool append) {
+	try {
+		if (reportFile == "") { return; }
+
+		ifstream in(reportFile.c_str());
+		if (!in.good()) { return; }
+
+		string newReport = m->getRootName(logFile) + "profile";
+		if (newReport == reportFile) { in.close(); return; }
+
+		ifstream test(newReport.c_str());
+		bool exists = test.good();
+		test.close();
+
+		if (append && exists) {
+			ofstream out;
+			m->openOutputFileAppend(newReport, out);
+			string line;
+			getline(in, line);		//header
+			while (getline(in, line)) { out << line << '\n'; }
+			out.close();
+			in.close();
+			m->mothurRemove(reportFile);
+		}else {
+			in.close();
+			m->renameFile(reportFile, newReport);
+		}
+		reportFile = newReport;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Profiler", "moveReport");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
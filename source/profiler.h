@@ -0,0 +1,74 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+/*
+ *  profiler.h
+ *  Mothur
+ *
+ *  Copyright 2026 Schloss Lab. All rights reserved.
+ *
+ */
+
+/* The Profiler records the resources used by each command the Engine runs, once it is turned on with set.profile or
+ the --profile command line option. For each command it writes a row to a tab separated report next to the logfile
+ with the wall time, cpu time, peak resident memory and bytes read and written. Commands can split their work into
+ phases, such as read, compute, write and merge, by calling startPhase, and each phase gets its own row.
+
+ The cpu time includes the threads of the command and the processes it forked and waited for. The peak memory is
+ the larger of mothur's own peak during the command and the largest forked process. The bytes read and written are
+ only known on Linux, and only count mothur's own process. */
+
+#include "mothur.h"
+#include "mothurout.h"
+
+/**************************************************************************************************/
+
+class Profiler {
+
+public:
+	static Profiler* getInstance();
+
+	void setActive(bool a)			{ active = a;			}
+	bool isActive()					{ return active;		}
+	void setReportFile(string f)	{ reportFile = f;		}
+	string getReportFile()			{ return reportFile;	}
+
+	void startCommand(string);		//command name
+	void startPhase(string);		//ends the current phase of the command, if any
+	void endCommand(int);			//the value returned by the command's execute
+	void moveReport(string, bool);	//the final logfile name and whether the logfile was appended to
+
+private:
+	struct Sample {
+		double wall, cpu;
+		long peak, childPeak;				//KB
+		unsigned long long read, written;
+	};
+	struct Phase {
+		string name;
+		Sample start;
+	};
+
+	static Profiler* myInstance;
+	Profiler();
+	Profiler(const Profiler&){}			// Disable copy constructor
+	void operator=(const Profiler&){}	// Disable assignment operator
+	~Profiler(){}
+
+	MothurOut* m;
+	bool active, running;
+	string reportFile, commandName;
+	int numCommands;
+	Sample commandStart;
+	vector<Phase> phases;
+	mutex lock;
+
+	Sample getSample();
+	void resetPeak();
+	string getRow(string, int, const Sample&, const Sample&);
+	void writeRows(vector<string>&);
+};
+
+/**************************************************************************************************/
+
+#endif
@@ -13,7 +13,8 @@
 AbstractDecisionTree::AbstractDecisionTree(vector<vector<int> >& baseDataSet,
                                          vector<int> globalDiscardedFeatureIndices,
                                          OptimumFeatureSubsetSelector optimumFeatureSubsetSelector, 
-                                         string treeSplitCriterion)
+                                         string treeSplitCriterion,
+                                         unsigned int seed)
 
                     : baseDataSet(baseDataSet),
                     numSamples((int)baseDataSet.size()),
@@ -23,7 +24,8 @@ AbstractDecisionTree::AbstractDecisionTree(vector<vector<int> >& baseDataSet,
                     nodeIdCount(0),
                     globalDiscardedFeatureIndices(globalDiscardedFeatureIndices),
                     optimumFeatureSubsetSize(optimumFeatureSubsetSelector.getOptimumFeatureSubsetSize(numFeatures)),
-                    treeSplitCriterion(treeSplitCriterion) {
+                    treeSplitCriterion(treeSplitCriterion),
+                    randomGenerator(seed) {
 
     try {
         // TODO: istead of calculating this for every DecisionTree
@@ -57,8 +59,7 @@ int AbstractDecisionTree::createBootStrappedSamples(){
         
         for (int i = 0; i < numSamples; i++) {
             if (m->control_pressed) { return 0; }
-            // TODO: optimize the rand() function call + double check if it's working properly
-            int randomIndex = rand() % numSamples;
+            int randomIndex = randomGenerator() % numSamples;
             bootstrappedTrainingSamples.push_back(baseDataSet[randomIndex]);
             isInTrainingSamples[randomIndex] = true;
         }
@@ -93,43 +94,61 @@ int AbstractDecisionTree::createBootStrappedSamples(){
 	} 
 }
 /**************************************************************************************************/
-int AbstractDecisionTree::getMinEntropyOfFeature(vector<int> featureVector,
-                                                 vector<int> outputVector,
+//the bootstrapped samples are sorted by each feature once per tree, the nodes below the root keep the order as
+//their samples are split, so no node has to sort
+int AbstractDecisionTree::sortSampleIndicesByFeature(vector< vector<int> >& sortedSampleIndices){
+    try {
+        
+        sortedSampleIndices.assign(numFeatures, vector<int>());
+        
+        for (int j = 0; j < numFeatures; j++) {
+            if (m->control_pressed) { return 0; }
+            
+            vector< pair<int, int> > featureIndexPairs(bootstrappedTrainingSamples.size(), pair<int, int>(0, 0));
+            for (int i = 0; i < bootstrappedTrainingSamples.size(); i++) {
+                featureIndexPairs[i].first = bootstrappedTrainingSamples[i][j];
+                featureIndexPairs[i].second = i;
+            }
+            
+            IntPairVectorSorter intPairVectorSorter;
+            stable_sort(featureIndexPairs.begin(), featureIndexPairs.end(), intPairVectorSorter);
+            
+            sortedSampleIndices[j].resize(featureIndexPairs.size());
+            for (int i = 0; i < featureIndexPairs.size(); i++) { sortedSampleIndices[j][i] = featureIndexPairs[i].second; }
+        }
+        
+        return 0;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "AbstractDecisionTree", "sortSampleIndicesByFeature");
+		exit(1);
+	} 
+}
+/**************************************************************************************************/
+//sortedSampleIndices are the node's samples, as indexes into bootstrappedTrainingSamples, sorted by the feature
+int AbstractDecisionTree::getMinEntropyOfFeature(const vector<int>& sortedSampleIndices,
+                                                 int featureIndex,
                                                  double& minEntropy,
                                                  int& featureSplitValue,
                                                  double& intrinsicValue){
     try {
 
-        vector< pair<int, int> > featureOutputPair(featureVector.size(), pair<int, int>(0, 0));
+        vector< pair<int, int> > featureOutputPair(sortedSampleIndices.size(), pair<int, int>(0, 0));
         
-        for (int i = 0; i < featureVector.size(); i++) { 
+        for (int i = 0; i < sortedSampleIndices.size(); i++) { 
             if (m->control_pressed) { return 0; }
             
-            featureOutputPair[i].first = featureVector[i];
-            featureOutputPair[i].second = outputVector[i];
+            const vector<int>& sample = bootstrappedTrainingSamples[sortedSampleIndices[i]];
+            featureOutputPair[i].first = sample[featureIndex];
+            featureOutputPair[i].second = sample[numFeatures];
         }
-        // TODO: using default behavior to sort(), need to specify the comparator for added safety and compiler portability,
-        
-        IntPairVectorSorter intPairVectorSorter;
-        sort(featureOutputPair.begin(), featureOutputPair.end(), intPairVectorSorter);
         
+        //the pairs are in sorted order, so a split point is wherever the value changes
         vector<int> splitPoints;
-        vector<int> uniqueFeatureValues(1, featureOutputPair[0].first);
-        
-        for (int i = 0; i < featureOutputPair.size(); i++) {
-
-            if (m->control_pressed) { return 0; }
-            int featureValue = featureOutputPair[i].first;
-
-            vector<int>::iterator it = find(uniqueFeatureValues.begin(), uniqueFeatureValues.end(), featureValue);
-            if (it == uniqueFeatureValues.end()){                 // NOT FOUND
-                uniqueFeatureValues.push_back(featureValue);
-                splitPoints.push_back(i);
-            }
+        for (int i = 1; i < featureOutputPair.size(); i++) {
+            if (featureOutputPair[i].first != featureOutputPair[i-1].first) { splitPoints.push_back(i); }
         }
         
-
-        
         int bestSplitIndex = -1;
         if (splitPoints.size() == 0){
             // TODO: trying out C++'s infitinity, don't know if this will work properly
@@ -172,7 +191,9 @@ double AbstractDecisionTree::calcIntrinsicValue(int numLessThanValueAtSplitPoint
 }
 /**************************************************************************************************/
 
-int AbstractDecisionTree::getBestSplitAndMinEntropy(vector< pair<int, int> > featureOutputPairs, vector<int> splitPoints,
+//the samples below each split point are counted as the sorted pairs are walked once, so every split point is
+//scored without rescanning the pairs
+int AbstractDecisionTree::getBestSplitAndMinEntropy(const vector< pair<int, int> >& featureOutputPairs, const vector<int>& splitPoints,
                                                     double& minEntropy, int& minEntropyIndex, double& relatedIntrinsicValue){
     try {
         
@@ -180,23 +201,26 @@ int AbstractDecisionTree::getBestSplitAndMinEntropy(vector< pair<int, int> > fea
         vector<double> entropies;
         vector<double> intrinsicValues;
         
+        vector<int> totalClassCounts(numOutputClasses, 0);
+        for (int k = 0; k < numSamples; k++) { totalClassCounts[featureOutputPairs[k].second]++; }
+        
+        vector<int> upperClassCounts(numOutputClasses, 0);
+        vector<int> lowerClassCounts(numOutputClasses, 0);
+        int j = 0;
+        
         for (int i = 0; i < splitPoints.size(); i++) {
             if (m->control_pressed) { return 0; }
             int index = splitPoints[i];
-            int valueAtSplitPoint = featureOutputPairs[index].first;
-
-            int numLessThanValueAtSplitPoint = 0;
-            int numGreaterThanValueAtSplitPoint = 0;
             
-            for (int j = 0; j < featureOutputPairs.size(); j++) {
-                if (m->control_pressed) { return 0; }
-                pair<int, int> record = featureOutputPairs[j];
-                if (record.first < valueAtSplitPoint){ numLessThanValueAtSplitPoint++; }
-                else{ numGreaterThanValueAtSplitPoint++; }
-            }
+            //the pairs are sorted, so the ones before the split point are the ones less than its value
+            for (; j < index; j++) { upperClassCounts[featureOutputPairs[j].second]++; }
+            for (int k = 0; k < numOutputClasses; k++) { lowerClassCounts[k] = totalClassCounts[k] - upperClassCounts[k]; }
+
+            int numLessThanValueAtSplitPoint = index;
+            int numGreaterThanValueAtSplitPoint = numSamples - index;
             
-            double upperEntropyOfSplit = calcSplitEntropy(featureOutputPairs, index, numOutputClasses, true);
-            double lowerEntropyOfSplit = calcSplitEntropy(featureOutputPairs, index, numOutputClasses, false);
+            double upperEntropyOfSplit = calcSplitEntropy(upperClassCounts, numLessThanValueAtSplitPoint);
+            double lowerEntropyOfSplit = calcSplitEntropy(lowerClassCounts, numGreaterThanValueAtSplitPoint);
             
             double totalEntropy = (numLessThanValueAtSplitPoint * upperEntropyOfSplit + numGreaterThanValueAtSplitPoint * lowerEntropyOfSplit) / (double)numSamples;
             double intrinsicValue = calcIntrinsicValue(numLessThanValueAtSplitPoint, numGreaterThanValueAtSplitPoint, numSamples);
@@ -220,28 +244,11 @@ int AbstractDecisionTree::getBestSplitAndMinEntropy(vector< pair<int, int> > fea
 }
 /**************************************************************************************************/
 
-double AbstractDecisionTree::calcSplitEntropy(vector< pair<int, int> > featureOutputPairs, int splitIndex, int numOutputClasses, bool isUpperSplit = true) {
+double AbstractDecisionTree::calcSplitEntropy(const vector<int>& classCounts, int totalClassCounts) {
     try {
-        vector<int> classCounts(numOutputClasses, 0);
-        
-        if (isUpperSplit) { 
-            for (int i = 0; i < splitIndex; i++) {
-                if (m->control_pressed) { return 0; }
-                classCounts[featureOutputPairs[i].second]++;
-            }
-        } else {
-            for (int i = splitIndex; i < featureOutputPairs.size(); i++) { 
-                if (m->control_pressed) { return 0; }
-                classCounts[featureOutputPairs[i].second]++;
-            }
-        }
-        
-        int totalClassCounts = accumulate(classCounts.begin(), classCounts.end(), 0);
-        
         double splitEntropy = 0.0;
         
         for (int i = 0; i < classCounts.size(); i++) {
-            if (m->control_pressed) { return 0; }
             if (classCounts[i] == 0) { continue; }
             double probability = (double) classCounts[i] / (double) totalClassCounts;
             splitEntropy += -(probability * log2(probability));
@@ -257,7 +264,9 @@ double AbstractDecisionTree::calcSplitEntropy(vector< pair<int, int> > featureOu
 
 /**************************************************************************************************/
 
-int AbstractDecisionTree::getSplitPopulation(RFTreeNode* node, vector< vector<int> >& leftChildSamples, vector< vector<int> >& rightChildSamples){    
+//the node's sorted sample indexes are split with a stable partition, so the children's stay sorted by each feature
+int AbstractDecisionTree::getSplitPopulation(RFTreeNode* node, vector< vector<int> >& leftChildSamples, vector< vector<int> >& rightChildSamples,
+                                             vector< vector<int> >& leftSortedSampleIndices, vector< vector<int> >& rightSortedSampleIndices){    
     try {
         // TODO: there is a possibility of optimization if we can recycle the samples in each nodes
         // we just need to pointers to the samples i.e. vector<int> and use it everywhere and not create the sample 
@@ -277,6 +286,29 @@ int AbstractDecisionTree::getSplitPopulation(RFTreeNode* node, vector< vector<in
             else { rightChildSamples.push_back(sample); }
         }
         
+        const vector< vector<int> >& sortedSampleIndices = node->getSortedSampleIndices();
+        
+        vector<bool> isLeft(bootstrappedTrainingSamples.size(), false);
+        const vector<int>& splitFeatureIndices = sortedSampleIndices[splitFeatureGlobalIndex];
+        for (int i = 0; i < splitFeatureIndices.size(); i++) {
+            int index = splitFeatureIndices[i];
+            if (bootstrappedTrainingSamples[index][splitFeatureGlobalIndex] < node->getSplitFeatureValue()) { isLeft[index] = true; }
+        }
+        
+        leftSortedSampleIndices.assign(sortedSampleIndices.size(), vector<int>());
+        rightSortedSampleIndices.assign(sortedSampleIndices.size(), vector<int>());
+        for (int j = 0; j < sortedSampleIndices.size(); j++) {
+            if (m->control_pressed) { return 0; }
+            
+            leftSortedSampleIndices[j].reserve(leftChildSamples.size());
+            rightSortedSampleIndices[j].reserve(rightChildSamples.size());
+            for (int i = 0; i < sortedSampleIndices[j].size(); i++) {
+                int index = sortedSampleIndices[j][i];
+                if (isLeft[index]) { leftSortedSampleIndices[j].push_back(index); }
+                else { rightSortedSampleIndices[j].push_back(index); }
+            }
+        }
+        
         return 0;
     }
 	catch(exception& e) {
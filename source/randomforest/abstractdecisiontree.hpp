@@ -32,19 +32,22 @@ public:
     AbstractDecisionTree(vector<vector<int> >& baseDataSet,
                            vector<int> globalDiscardedFeatureIndices, 
                            OptimumFeatureSubsetSelector optimumFeatureSubsetSelector, 
-                           string treeSplitCriterion);    
+                           string treeSplitCriterion,
+                           unsigned int seed);    
     virtual ~AbstractDecisionTree(){}
     
   
 protected:
   
     virtual int createBootStrappedSamples();
-    virtual int getMinEntropyOfFeature(vector<int> featureVector, vector<int> outputVector, double& minEntropy, int& featureSplitValue, double& intrinsicValue);
-        virtual int getBestSplitAndMinEntropy(vector< pair<int, int> > featureOutputPairs, vector<int> splitPoints, double& minEntropy, int& minEntropyIndex, double& relatedIntrinsicValue);
+    virtual int sortSampleIndicesByFeature(vector< vector<int> >& sortedSampleIndices);
+    virtual int getMinEntropyOfFeature(const vector<int>& sortedSampleIndices, int featureIndex, double& minEntropy, int& featureSplitValue, double& intrinsicValue);
+        virtual int getBestSplitAndMinEntropy(const vector< pair<int, int> >& featureOutputPairs, const vector<int>& splitPoints, double& minEntropy, int& minEntropyIndex, double& relatedIntrinsicValue);
     virtual double calcIntrinsicValue(int numLessThanValueAtSplitPoint, int numGreaterThanValueAtSplitPoint, int numSamples);
-    virtual double calcSplitEntropy(vector< pair<int, int> > featureOutputPairs, int splitIndex, int numOutputClasses, bool);
+    virtual double calcSplitEntropy(const vector<int>& classCounts, int totalClassCounts);
 
-    virtual int getSplitPopulation(RFTreeNode* node, vector< vector<int> >& leftChildSamples, vector< vector<int> >& rightChildSamples);
+    virtual int getSplitPopulation(RFTreeNode* node, vector< vector<int> >& leftChildSamples, vector< vector<int> >& rightChildSamples,
+                                   vector< vector<int> >& leftSortedSampleIndices, vector< vector<int> >& rightSortedSampleIndices);
     virtual bool checkIfAlreadyClassified(RFTreeNode* treeNode, int& outputClass);
 
     vector< vector<int> >& baseDataSet;
@@ -66,6 +69,7 @@ protected:
     vector<int> globalDiscardedFeatureIndices;
     int optimumFeatureSubsetSize;
     string treeSplitCriterion;
+    mt19937 randomGenerator;        // each tree has its own, so trees built at the same time draw the same numbers as one at a time
     MothurOut* m;
   
 private:
@@ -12,11 +12,13 @@ DecisionTree::DecisionTree(vector< vector<int> >& baseDataSet,
                            vector<int> globalDiscardedFeatureIndices,
                            OptimumFeatureSubsetSelector optimumFeatureSubsetSelector,
                            string treeSplitCriterion,
-                           float featureStandardDeviationThreshold)
+                           float featureStandardDeviationThreshold,
+                           unsigned int seed)
             : AbstractDecisionTree(baseDataSet,
                                    globalDiscardedFeatureIndices,
                                    optimumFeatureSubsetSelector,
-                                   treeSplitCriterion),
+                                   treeSplitCriterion,
+                                   seed),
             variableImportanceList(numFeatures, 0),
             featureStandardDeviationThreshold(featureStandardDeviationThreshold) {
                 
@@ -176,7 +178,7 @@ void DecisionTree::randomlyShuffleAttribute(const vector< vector<int> >& samples
             if (m->control_pressed) { return; }
             featureVectors[j] = samples[j][featureIndex];
         }
-        random_shuffle(featureVectors.begin(), featureVectors.end());
+        shuffle(featureVectors.begin(), featureVectors.end(), randomGenerator);
         for (int j = 0; j < samples.size(); j++) {
             if (m->control_pressed) { return; }
             shuffledSample[j][featureIndex] = featureVectors[j];
@@ -196,6 +198,7 @@ int DecisionTree::purgeTreeNodesDataRecursively(RFTreeNode* treeNode) {
         treeNode->bootstrappedTrainingSamples.clear();
         treeNode->bootstrappedFeatureVectors.clear();
         treeNode->bootstrappedOutputVector.clear();
+        treeNode->sortedSampleIndices.clear();
         treeNode->localDiscardedFeatureIndices.clear();
         treeNode->globalDiscardedFeatureIndices.clear();
         
@@ -217,6 +220,10 @@ void DecisionTree::buildDecisionTree(){
         rootNode = new RFTreeNode(bootstrappedTrainingSamples, globalDiscardedFeatureIndices, numFeatures, numSamples, numOutputClasses, generation, nodeIdCount, featureStandardDeviationThreshold);
         nodeIdCount++;
         
+        vector< vector<int> > sortedSampleIndices;
+        sortSampleIndicesByFeature(sortedSampleIndices);
+        rootNode->swapSortedSampleIndices(sortedSampleIndices);
+        
         splitRecursively(rootNode);
         
         }
@@ -261,7 +268,9 @@ int DecisionTree::splitRecursively(RFTreeNode* rootNode) {
         
         vector< vector<int> > leftChildSamples;
         vector< vector<int> > rightChildSamples;
-        getSplitPopulation(rootNode, leftChildSamples, rightChildSamples);
+        vector< vector<int> > leftSortedSampleIndices;
+        vector< vector<int> > rightSortedSampleIndices;
+        getSplitPopulation(rootNode, leftChildSamples, rightChildSamples, leftSortedSampleIndices, rightSortedSampleIndices);
         
         if (m->control_pressed) { return 0; }
         
@@ -277,6 +286,11 @@ int DecisionTree::splitRecursively(RFTreeNode* rootNode) {
         rootNode->setRightChildNode(rightChildNode);
         rightChildNode->setParentNode(rootNode);
         
+        //the children hold the sorted indexes now
+        vector< vector<int> >().swap(rootNode->sortedSampleIndices);
+        leftChildNode->swapSortedSampleIndices(leftSortedSampleIndices);
+        rightChildNode->swapSortedSampleIndices(rightSortedSampleIndices);
+        
         // TODO: This recursive split can be parrallelized later
         splitRecursively(leftChildNode);
         if (m->control_pressed) { return 0; }
@@ -295,11 +309,9 @@ int DecisionTree::splitRecursively(RFTreeNode* rootNode) {
 int DecisionTree::findAndUpdateBestFeatureToSplitOn(RFTreeNode* node){
     try {
 
-        vector< vector<int> > bootstrappedFeatureVectors = node->getBootstrappedFeatureVectors();
-        if (m->control_pressed) { return 0; }
-        vector<int> bootstrappedOutputVector = node->getBootstrappedOutputVector();
+        const vector< vector<int> >& sortedSampleIndices = node->getSortedSampleIndices();
         if (m->control_pressed) { return 0; }
-        vector<int> featureSubsetIndices = node->getFeatureSubsetIndices();
+        const vector<int>& featureSubsetIndices = node->getFeatureSubsetIndices();
         if (m->control_pressed) { return 0; }
         
         vector<double> featureSubsetEntropies;
@@ -316,7 +328,7 @@ int DecisionTree::findAndUpdateBestFeatureToSplitOn(RFTreeNode* node){
             int featureSplitValue;
             double featureIntrinsicValue;
             
-            getMinEntropyOfFeature(bootstrappedFeatureVectors[tryIndex], bootstrappedOutputVector, featureMinEntropy, featureSplitValue, featureIntrinsicValue);
+            getMinEntropyOfFeature(sortedSampleIndices[tryIndex], tryIndex, featureMinEntropy, featureSplitValue, featureIntrinsicValue);
             if (m->control_pressed) { return 0; }
             
             featureSubsetEntropies.push_back(featureMinEntropy);
@@ -386,8 +398,7 @@ vector<int> DecisionTree::selectFeatureSubsetRandomly(vector<int> globalDiscarde
             
             if (m->control_pressed) { return featureSubsetIndices; }
             
-            // TODO: optimize rand() call here
-            int randomIndex = rand() % numFeatures;
+            int randomIndex = randomGenerator() % numFeatures;
             vector<int>::iterator it = find(featureSubsetIndices.begin(), featureSubsetIndices.end(), randomIndex);
             if (it == featureSubsetIndices.end()){    // NOT FOUND
                 vector<int>::iterator it2 = find(combinedDiscardedFeatureIndices.begin(), combinedDiscardedFeatureIndices.end(), randomIndex);
@@ -37,7 +37,8 @@ public:
                  vector<int> globalDiscardedFeatureIndices,
                  OptimumFeatureSubsetSelector optimumFeatureSubsetSelector,
                  string treeSplitCriterion,
-                 float featureStandardDeviationThreshold);
+                 float featureStandardDeviationThreshold,
+                 unsigned int seed);
     
     virtual ~DecisionTree(){ deleteTreeNodesRecursively(rootNode); }
     
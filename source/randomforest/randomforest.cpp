@@ -7,6 +7,7 @@
 //
 
 #include "randomforest.hpp" 
+#include "threadpool.h"
 
 /***********************************************************************/
 
@@ -18,8 +19,9 @@ RandomForest::RandomForest(const vector <vector<int> > dataSet,
                            const bool discardHighErrorTrees = true,
                            const float highErrorTreeDiscardThreshold = 0.4,
                            const string optimumFeatureSubsetSelectionCriteria = "log2",
-                           const float featureStandardDeviationThreshold = 0.0)
-            : Forest(dataSet, numDecisionTrees, treeSplitCriterion, doPruning, pruneAggressiveness, discardHighErrorTrees, highErrorTreeDiscardThreshold, optimumFeatureSubsetSelectionCriteria, featureStandardDeviationThreshold) {
+                           const float featureStandardDeviationThreshold = 0.0,
+                           const int processors = 1)
+            : Forest(dataSet, numDecisionTrees, treeSplitCriterion, doPruning, pruneAggressiveness, discardHighErrorTrees, highErrorTreeDiscardThreshold, optimumFeatureSubsetSelectionCriteria, featureStandardDeviationThreshold), processors(processors) {
     m = MothurOut::getInstance();
 }
 
@@ -196,70 +198,49 @@ int RandomForest::populateDecisionTrees() {
         
         vector<double> errorRateImprovements;
         
-        for (int i = 0; i < numDecisionTrees; i++) {
-          
-            if (m->control_pressed) { return 0; }
-            if (((i+1) % 100) == 0) {  m->mothurOut("Creating " + toString(i+1) + " (th) Decision tree\n");  }
-          
-            // TODO: need to first fix if we are going to use pointer based system or anything else
-            DecisionTree* decisionTree = new DecisionTree(dataSet, globalDiscardedFeatureIndices, OptimumFeatureSubsetSelector(optimumFeatureSubsetSelectionCriteria), treeSplitCriterion, featureStandardDeviationThreshold);
-          
-            if (m->debug && doPruning) {
-                m->mothurOut("Before pruning\n");
-                decisionTree->printTree(decisionTree->rootNode, "ROOT");
-            }
-            
-            int numCorrect;
-            double treeErrorRate;
+        // each tree's seed is drawn here in order, so a seed gives the same forest whatever the number of processors
+        vector<unsigned int> treeSeeds(numDecisionTrees, 0);
+        for (int i = 0; i < numDecisionTrees; i++) { treeSeeds[i] = rand(); }
+        
+        ThreadPool pool(processors);
+        
+        // the trees are built a batch at a time and added to the forest in order,
+        // so only one batch of trees holds its training data at a time
+        int batchSize = pool.getNumProcessors() * 4;
+        
+        for (int batchStart = 0; batchStart < numDecisionTrees; batchStart += batchSize) {
             
-            decisionTree->calcTreeErrorRate(numCorrect, treeErrorRate);
-            double prePrunedErrorRate = treeErrorRate;
+            if (m->control_pressed) { return 0; }
             
-            if (m->debug) {
-                m->mothurOut("treeErrorRate: " + toString(treeErrorRate) + " numCorrect: " + toString(numCorrect) + "\n");
-            }
+            int batchEnd = min(batchStart + batchSize, numDecisionTrees);
+            vector<DecisionTree*> batchTrees(batchEnd - batchStart, NULL);
+            vector<double> treeErrorRates(batchEnd - batchStart, 0);
+            vector<double> treeErrorRateImprovements(batchEnd - batchStart, 0);
             
-            if (doPruning) {
-                decisionTree->pruneTree(pruneAggressiveness);
-                if (m->debug) {
-                    m->mothurOut("After pruning\n");
-                    decisionTree->printTree(decisionTree->rootNode, "ROOT");
-                }
-                decisionTree->calcTreeErrorRate(numCorrect, treeErrorRate);
+            for (int i = batchStart; i < batchEnd; i++) {
+                pool.submit([this, &treeSeeds, &batchTrees, &treeErrorRates, &treeErrorRateImprovements, batchStart, i](int) {
+                    batchTrees[i-batchStart] = createDecisionTree(treeSeeds[i], treeErrorRates[i-batchStart], treeErrorRateImprovements[i-batchStart]);
+                });
             }
-            double postPrunedErrorRate = treeErrorRate;
+            pool.wait();
             
-          
-            decisionTree->calcTreeVariableImportanceAndError(numCorrect, treeErrorRate);
-            double errorRateImprovement = (prePrunedErrorRate - postPrunedErrorRate) / prePrunedErrorRate;
-
-            if (m->debug) {
-                m->mothurOut("treeErrorRate: " + toString(treeErrorRate) + " numCorrect: " + toString(numCorrect) + "\n");
-                if (doPruning) {
-                    m->mothurOut("errorRateImprovement: " + toString(errorRateImprovement) + "\n");
-                }
-            }
-            
-            
-            if (discardHighErrorTrees) {
-                if (treeErrorRate < highErrorTreeDiscardThreshold) {
+            for (int i = batchStart; i < batchEnd; i++) {
+                
+                DecisionTree* decisionTree = batchTrees[i-batchStart];
+                
+                if (m->control_pressed) { delete decisionTree; continue; }
+                if (((i+1) % 100) == 0) {  m->mothurOut("Creating " + toString(i+1) + " (th) Decision tree\n");  }
+                
+                if (!discardHighErrorTrees || (treeErrorRates[i-batchStart] < highErrorTreeDiscardThreshold)) {
                     updateGlobalOutOfBagEstimates(decisionTree);
-                    decisionTree->purgeDataSetsFromTree();
                     decisionTrees.push_back(decisionTree);
                     if (doPruning) {
-                        errorRateImprovements.push_back(errorRateImprovement);
+                        errorRateImprovements.push_back(treeErrorRateImprovements[i-batchStart]);
                     }
                 } else {
                     delete decisionTree;
                 }
-            } else {
-                updateGlobalOutOfBagEstimates(decisionTree);
-                decisionTree->purgeDataSetsFromTree();
-                decisionTrees.push_back(decisionTree);
-                if (doPruning) {
-                    errorRateImprovements.push_back(errorRateImprovement);
-                }
-            }          
+            }
         }
         
         double avgErrorRateImprovement = -1.0;
@@ -283,6 +264,58 @@ int RandomForest::populateDecisionTrees() {
     }  
 }
 /***********************************************************************/
+// builds, prunes and scores one tree. It only reads the forest, so trees can be created at the same time.
+DecisionTree* RandomForest::createDecisionTree(unsigned int seed, double& treeErrorRate, double& errorRateImprovement) {
+    try {
+        
+        // TODO: need to first fix if we are going to use pointer based system or anything else
+        DecisionTree* decisionTree = new DecisionTree(dataSet, globalDiscardedFeatureIndices, OptimumFeatureSubsetSelector(optimumFeatureSubsetSelectionCriteria), treeSplitCriterion, featureStandardDeviationThreshold, seed);
+        
+        if (m->debug && doPruning) {
+            m->mothurOut("Before pruning\n");
+            decisionTree->printTree(decisionTree->rootNode, "ROOT");
+        }
+        
+        int numCorrect;
+        
+        decisionTree->calcTreeErrorRate(numCorrect, treeErrorRate);
+        double prePrunedErrorRate = treeErrorRate;
+        
+        if (m->debug) {
+            m->mothurOut("treeErrorRate: " + toString(treeErrorRate) + " numCorrect: " + toString(numCorrect) + "\n");
+        }
+        
+        if (doPruning) {
+            decisionTree->pruneTree(pruneAggressiveness);
+            if (m->debug) {
+                m->mothurOut("After pruning\n");
+                decisionTree->printTree(decisionTree->rootNode, "ROOT");
+            }
+            decisionTree->calcTreeErrorRate(numCorrect, treeErrorRate);
+        }
+        double postPrunedErrorRate = treeErrorRate;
+        
+        
+        decisionTree->calcTreeVariableImportanceAndError(numCorrect, treeErrorRate);
+        errorRateImprovement = (prePrunedErrorRate - postPrunedErrorRate) / prePrunedErrorRate;
+        
+        if (m->debug) {
+            m->mothurOut("treeErrorRate: " + toString(treeErrorRate) + " numCorrect: " + toString(numCorrect) + "\n");
+            if (doPruning) {
+                m->mothurOut("errorRateImprovement: " + toString(errorRateImprovement) + "\n");
+            }
+        }
+        
+        decisionTree->purgeDataSetsFromTree();
+        
+        return decisionTree;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "RandomForest", "createDecisionTree");
+        exit(1);
+    }  
+}
+/***********************************************************************/
 // TODO: need to finalize bettween reference and pointer for DecisionTree [partially solved]
 // DONE: make this pure virtual in superclass
 // DONE
@@ -25,7 +25,8 @@ public:
                  const bool discardHighErrorTrees,
                  const float highErrorTreeDiscardThreshold,
                  const string optimumFeatureSubsetSelectionCriteria,
-                 const float featureStandardDeviationThreshold);
+                 const float featureStandardDeviationThreshold,
+                 const int processors);
     
     
     //NOTE:: if you are going to dynamically cast, aren't you undoing the advantage of abstraction. Why abstract at all?
@@ -48,6 +49,9 @@ public:
     
 private:
     MothurOut* m;
+    int processors;
+    
+    DecisionTree* createDecisionTree(unsigned int, double&, double&);
     
 };
 
@@ -47,6 +47,7 @@ public:
     const vector< vector<int> >& getBootstrappedFeatureVectors() { return bootstrappedFeatureVectors; }
     const vector<int>& getBootstrappedOutputVector() { return bootstrappedOutputVector; }
     const vector<int>& getFeatureSubsetIndices() { return featureSubsetIndices; }
+    const vector< vector<int> >& getSortedSampleIndices() { return sortedSampleIndices; }
     const double getOwnEntropy() { return ownEntropy; }
     const int getTestSampleMisclassificationCount() { return testSampleMisclassificationCount; }
     
@@ -60,6 +61,7 @@ public:
     void setSplitFeatureIndex(int splitFeatureIndex) { this->splitFeatureIndex = splitFeatureIndex; }
     void setSplitFeatureValue(int splitFeatureValue) { this->splitFeatureValue = splitFeatureValue; }
     void setSplitFeatureEntropy(double splitFeatureEntropy) { this->splitFeatureEntropy = splitFeatureEntropy; }
+    void swapSortedSampleIndices(vector< vector<int> >& sortedSampleIndices) { this->sortedSampleIndices.swap(sortedSampleIndices); }
     
     // TODO: need to remove this mechanism of friend class
     //NOTE: friend classes can be useful for testing purposes, but I would avoid using them otherwise.
@@ -73,6 +75,7 @@ private:
     vector<vector<int> > bootstrappedFeatureVectors;
     vector<int> bootstrappedOutputVector;
     vector<int> featureSubsetIndices;
+    vector<vector<int> > sortedSampleIndices;     // for each feature, the indexes of the tree's samples in this node sorted by the feature's value
 
     int numFeatures;
     int numSamples;
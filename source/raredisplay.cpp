@@ -65,6 +65,18 @@ void RareDisplay::update(vector<SharedRAbundVector*> shared, int numSeqs, int nu
 
 /***********************************************************************/
 
+void RareDisplay::updateExpected(int numSeqs, vector<double> data){
+	try {
+		expected[numSeqs] = data;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "RareDisplay", "updateExpected");
+		exit(1);
+	}
+}
+
+/***********************************************************************/
+
 void RareDisplay::reset(){
 	try {
 		nIters++;
@@ -81,6 +93,10 @@ void RareDisplay::close(){
 	try {
 		output->initFile(label);
 	
+		for (map<int, vector<double> >::iterator it = expected.begin(); it != expected.end(); it++) {
+			output->output(it->first, it->second);
+		}
+		
 		for (map<int, vector<double> >::iterator it = results.begin(); it != results.end(); it++) {
 		
 			vector<double> data(3,0);
@@ -101,6 +117,7 @@ void RareDisplay::close(){
 		
 		nIters = 1;
         results.clear();
+        expected.clear();
 		
 		output->resetFile();
 	}
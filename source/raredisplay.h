@@ -17,8 +17,10 @@ public:
 	void reset();
 	void update(SAbundVector*);
 	void update(vector<SharedRAbundVector*> shared, int numSeqs, int numGroupComb);
+	void updateExpected(int, vector<double>);
 	void close();
 	bool isCalcMultiple() { return estimate->getMultiple(); }
+	string getName() { return estimate->getName(); }
 	
 	void outputTempFiles(string);
 	void inputTempFiles(string);
@@ -28,6 +30,7 @@ private:
 	FileOutput* output;
 	string label;
 	map<int, vector<double> > results; //maps seqCount to results for that number of sequences
+	map<int, vector<double> > expected; //maps seqCount to the computed curve, when there are no iterations
 	int nIters;
 };
 
@@ -24,6 +24,9 @@ int Rarefact::getCurve(float percentFreq = 0.01, int nIters = 1000){
 		if (percentFreq < 1.0) {  increment = numSeqs * percentFreq;  }
 		else { increment = percentFreq;  }	
 		
+		//the expected curve does not need any iterations
+		if (method == "analytic") {  analyticCurve(increment);  }
+		else {
 		#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
 				if(processors == 1){
 					driver(rcd, increment, nIters);	
@@ -46,6 +49,7 @@ int Rarefact::getCurve(float percentFreq = 0.01, int nIters = 1000){
 		#else
 			driver(rcd, increment, nIters);	
 		#endif
+		}
 
 		for(int i=0;i<displays.size();i++){
 			displays[i]->close();
@@ -62,6 +66,7 @@ int Rarefact::getCurve(float percentFreq = 0.01, int nIters = 1000){
 /***********************************************************************/
 int Rarefact::driver(RarefactionCurveData* rcd, int increment, int nIters = 1000){
 	try {
+		if (method == "hypergeometric") { return hypergeometricDriver(rcd, increment, nIters); }
 			
 		for(int iter=0;iter<nIters;iter++){
 		
@@ -110,6 +115,272 @@ int Rarefact::driver(RarefactionCurveData* rcd, int increment, int nIters = 1000
 		exit(1);
 	}
 }
+/***********************************************************************/
+//the chance that none of an otu's seqs are among the n seqs drawn, C(numSeqs-a, n) / C(numSeqs, n)
+static double probAbsent(int numSeqs, int n, int a) {
+	if (numSeqs - a < n) { return 0.0; }
+	return exp(lgamma(numSeqs-a+1.0) - lgamma(numSeqs-a-n+1.0) - lgamma(numSeqs+1.0) + lgamma(numSeqs-n+1.0));
+}
+/***********************************************************************/
+static double nextUniform(unsigned long long& state) {
+	state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+	return (state >> 11) * (1.0 / 9007199254740992.0);
+}
+/***********************************************************************/
+//the numbers of seqs the displays are updated at, in the order driver updates them
+vector<int> Rarefact::getSampleSizes(int increment){
+	try {
+		vector<int> sizes;
+		
+		for(int i=0;i<numSeqs;i++){
+			if((i == 0) || ((i+1) % increment == 0) || (ends.count(i+1) != 0)){
+				sizes.push_back(i+1);
+			}
+		}
+		
+		if((numSeqs % increment != 0) || (ends.count(numSeqs) != 0)){
+			sizes.push_back(numSeqs);
+		}
+		
+		return sizes;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Rarefact", "getSampleSizes");
+		exit(1);
+	}
+}
+/***********************************************************************/
+//draws the seqs from the sabund without replacement, without making the order vector
+int Rarefact::hypergeometricDriver(RarefactionCurveData* rcd, int increment, int nIters = 1000){
+	try {
+		vector<int> sizes = getSampleSizes(increment);
+		
+		//the abundance of each otu, most abundant first
+		vector<int> abunds;
+		for (int i = sabund->getMaxRank(); i > 0; i--) {
+			for (int j = 0; j < sabund->get(i); j++) { abunds.push_back(i); }
+		}
+		int numOTUs = abunds.size();
+		int logOTUs = 0;
+		while ((1 << logOTUs) < numOTUs) { logOTUs++; }
+		
+		vector<int> remaining;
+		vector<int> tree(numOTUs+1, 0); //fenwick tree of the seqs remaining in each otu
+		
+		for(int iter=0;iter<nIters;iter++){
+			
+			for(int i=0;i<displays.size();i++){
+				displays[i]->init(label);
+			}
+			
+			SAbundVector* rank = new SAbundVector(sabund->getMaxRank()+1);
+			remaining = abunds;
+			bool treeValid = false;
+			int sampled = 0;
+			unsigned long long state = ((unsigned long long)rand() << 31) ^ (unsigned long long)rand();
+			
+			for (int s = 0; s < sizes.size(); s++) {
+				
+				if (m->control_pressed) { delete rank; return 0;  }
+				
+				int draws = sizes[s] - sampled;
+				
+				if (((long long)draws * logOTUs) < numOTUs) {
+					//a few seqs are drawn one at a time
+					if (!treeValid) {
+						for (int i = 1; i <= numOTUs; i++) { tree[i] = remaining[i-1]; }
+						for (int i = 1; i <= numOTUs; i++) {
+							int parent = i + (i & -i);
+							if (parent <= numOTUs) { tree[parent] += tree[i]; }
+						}
+						treeValid = true;
+					}
+					
+					for (int d = 0; d < draws; d++) {
+						int target = (int)(nextUniform(state) * (numSeqs - sampled - d));
+						
+						int otu = 0;
+						for (int step = (1 << logOTUs); step > 0; step >>= 1) {
+							if (((otu + step) <= numOTUs) && (tree[otu+step] <= target)) { otu += step; target -= tree[otu]; }
+						}
+						for (int i = otu+1; i <= numOTUs; i += (i & -i)) { tree[i]--; }
+						
+						int abundance = abunds[otu] - remaining[otu];
+						remaining[otu]--;
+						
+						rank->set(abundance, rank->get(abundance)-1);
+						rank->set(abundance+1, rank->get(abundance+1)+1);
+					}
+				}else {
+					//each otu gets its share of the draws given the shares of the otus before it
+					int pool = numSeqs - sampled;
+					for (int i = 0; (i < numOTUs) && (draws > 0); i++) {
+						if (remaining[i] == 0) { continue; }
+						
+						int drawn = drawHypergeometric(pool, remaining[i], draws, state);
+						pool -= remaining[i];
+						draws -= drawn;
+						
+						if (drawn != 0) {
+							int abundance = abunds[i] - remaining[i];
+							remaining[i] -= drawn;
+							
+							rank->set(abundance, rank->get(abundance)-1);
+							rank->set(abundance+drawn, rank->get(abundance+drawn)+1);
+						}
+					}
+					treeValid = false;
+				}
+				
+				sampled = sizes[s];
+				rcd->updateRankData(rank);
+			}
+			
+			for(int i=0;i<displays.size();i++){
+				displays[i]->reset();
+			}
+			
+			delete rank;
+		}
+		
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Rarefact", "hypergeometricDriver");
+		exit(1);
+	}
+}
+/***********************************************************************/
+//the number of successes in draws from a population without replacement, found by searching out from the mode
+int Rarefact::drawHypergeometric(int population, int successes, int draws, unsigned long long& state){
+	try {
+		if ((draws == 0) || (successes == 0)) { return 0; }
+		if (successes == population) { return draws; }
+		if (draws == population) { return successes; }
+		
+		int failures = population - successes;
+		int low = max(0, draws - failures);
+		int high = min(draws, successes);
+		if (low == high) { return low; }
+		
+		//most otus have only a few seqs left, so start from 0 where the chance is a short product
+		if ((low == 0) && (min(successes, draws) <= 16)) {
+			int fewer = min(successes, draws); int more = max(successes, draws);
+			double prob = 1.0;
+			for (int j = 0; j < fewer; j++) { prob *= (double)(population - more - j) / (double)(population - j); }
+			
+			double u = nextUniform(state);
+			int drawn = 0;
+			while (drawn < high) {
+				u -= prob;
+				if (u <= 0) { break; }
+				prob *= ((double)(successes - drawn) * (double)(draws - drawn)) / ((drawn + 1.0) * (failures - draws + drawn + 1.0));
+				drawn++;
+			}
+			return drawn;
+		}
+		
+		int mode = (int)(((draws + 1.0) * (successes + 1.0)) / (population + 2.0));
+		if (mode < low) { mode = low; }
+		if (mode > high) { mode = high; }
+		
+		double probMode = exp(lgamma(successes+1.0) - lgamma(mode+1.0) - lgamma(successes-mode+1.0)
+							  + lgamma(failures+1.0) - lgamma(draws-mode+1.0) - lgamma(failures-draws+mode+1.0)
+							  - lgamma(population+1.0) + lgamma(draws+1.0) + lgamma(population-draws+1.0));
+		
+		double u = nextUniform(state) - probMode;
+		if (u <= 0) { return mode; }
+		
+		int up = mode; int down = mode;
+		double probUp = probMode; double probDown = probMode;
+		while ((up < high) || (down > low)) {
+			if (up < high) {
+				probUp *= ((double)(successes - up) * (double)(draws - up)) / ((up + 1.0) * (failures - draws + up + 1.0));
+				up++;
+				u -= probUp;
+				if (u <= 0) { return up; }
+			}
+			if (down > low) {
+				probDown *= ((double)down * (double)(failures - draws + down)) / ((successes - down + 1.0) * (draws - down + 1.0));
+				down--;
+				u -= probDown;
+				if (u <= 0) { return down; }
+			}
+		}
+		
+		return mode; //rounding left a little of u
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Rarefact", "drawHypergeometric");
+		exit(1);
+	}
+}
+/***********************************************************************/
+//the expected number of otus in n seqs and its variance, from Hurlbert (1971) and Heck et al. (1975)
+int Rarefact::analyticCurve(int increment){
+	try {
+		vector<int> sizes = getSampleSizes(increment);
+		
+		//the number of otus with each abundance, and of ordered pairs of otus with each total abundance
+		map<int, double> otus, pairs;
+		for (int i = 1; i <= sabund->getMaxRank(); i++) {
+			if (sabund->get(i) != 0) { otus[i] = sabund->get(i); }
+		}
+		for (map<int, double>::iterator it = otus.begin(); it != otus.end(); it++) {
+			for (map<int, double>::iterator it2 = otus.begin(); it2 != otus.end(); it2++) {
+				pairs[it->first + it2->first] += it->second * it2->second;
+			}
+		}
+		double numOTUs = sabund->getNumBins();
+		
+		for(int i=0;i<displays.size();i++){
+			displays[i]->init(label);
+		}
+		
+		set<int> done;
+		for (int s = 0; s < sizes.size(); s++) {
+			
+			if (m->control_pressed) { return 0; }
+			
+			int n = sizes[s];
+			if (done.count(n) != 0) { continue; }
+			done.insert(n);
+			
+			double absent = 0; double selfPairsAbsent = 0; double pairsAbsent = 0;
+			for (map<int, double>::iterator it = otus.begin(); it != otus.end(); it++) {
+				absent += it->second * probAbsent(numSeqs, n, it->first);
+				selfPairsAbsent += it->second * probAbsent(numSeqs, n, 2 * it->first);
+			}
+			//the pairs are in order of abundance, so once a pair can't be missed none can
+			for (map<int, double>::iterator it = pairs.begin(); it != pairs.end(); it++) {
+				double prob = probAbsent(numSeqs, n, it->first);
+				if (prob == 0) { break; }
+				pairsAbsent += it->second * prob;
+			}
+			
+			double expected = numOTUs - absent;
+			double variance = absent - absent * absent + pairsAbsent - selfPairsAbsent;
+			if (variance < 0) { variance = 0; }
+			double interval = 1.96 * sqrt(variance);
+			
+			for(int i=0;i<displays.size();i++){
+				vector<double> data(3, n);
+				if (displays[i]->getName() == "sobs") {
+					data[0] = expected;
+					data[1] = max(0.0, expected - interval);
+					data[2] = min(min(numOTUs, (double)n), expected + interval);
+				}
+				displays[i]->updateExpected(n, data);
+			}
+		}
+		
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Rarefact", "analyticCurve");
+		exit(1);
+	}
+}
 /**************************************************************************************************/
 
 int Rarefact::createProcesses(vector<int>& procIters, RarefactionCurveData* rcd, int increment, int nIters) {
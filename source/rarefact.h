@@ -11,7 +11,10 @@ class Rarefact {
 	
 public:
 	Rarefact(OrderVector* o, vector<Display*> disp, int p, set<int> en) :
-			numSeqs(o->getNumSeqs()), order(o), displays(disp), label(o->getLabel()), processors(p), ends(en)  { m = MothurOut::getInstance(); }
+			numSeqs(o->getNumSeqs()), order(o), sabund(NULL), displays(disp), label(o->getLabel()), processors(p), ends(en), method("shuffle")  { m = MothurOut::getInstance(); }
+	//method is hypergeometric to draw the seqs from the sabund, or analytic to compute the expected curve
+	Rarefact(SAbundVector* s, vector<Display*> disp, int p, set<int> en, string me) :
+			numSeqs(s->getNumSeqs()), order(NULL), sabund(s), displays(disp), label(s->getLabel()), processors(p), ends(en), method(me)  { m = MothurOut::getInstance(); }
 	Rarefact(vector<SharedRAbundVector*> shared, vector<Display*> disp) :
 					 lookup(shared), displays(disp) {  m = MothurOut::getInstance(); }
 
@@ -22,9 +25,10 @@ public:
 private:
 	
 	OrderVector* order;
+	SAbundVector* sabund;
 	vector<Display*> displays;
 	int numSeqs, numGroupComb, processors;
-	string label;
+	string label, method;
     set<int> ends;
 	void mergeVectors(SharedRAbundVector*, SharedRAbundVector*);
 	vector<SharedRAbundVector*> lookup; 
@@ -32,6 +36,10 @@ private:
 	
 	int createProcesses(vector<int>&, RarefactionCurveData*, int, int);
 	int driver(RarefactionCurveData*, int, int);
+	int hypergeometricDriver(RarefactionCurveData*, int, int);
+	int analyticCurve(int);
+	vector<int> getSampleSizes(int);
+	int drawHypergeometric(int, int, int, unsigned long long&);		//population, successes, draws, random state
 
 };
 
@@ -0,0 +1,334 @@
+/*
+ *  binarydistfile.cpp
+ *  Mothur
+ *
+ *  Copyright 2026 Schloss Lab. All rights reserved.
+ *
+ */
+
+#include "binarydistfile.h"
+
+#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+	#include <sys/mman.h>
+	#include <fcntl.h>
+#endif
+
+#define BINARYDIST_TAG "MOTHURBD"
+#define BINARYDIST_VERSION 1
+#define BINARYDIST_HEADERSIZE 24
+
+/***********************************************************************/
+
+BinaryDistFile::BinaryDistFile() {
+	m = MothurOut::getInstance();
+	dists = NULL; data = NULL;
+	numDists = 0; fileSize = 0;
+}
+/***********************************************************************/
+
+BinaryDistFile::~BinaryDistFile() { close(); }
+
+/***********************************************************************/
+
+bool BinaryDistFile::isBinary(string file) {
+	try {
+		ifstream in(file.c_str(), ios::binary);
+		if (!in) { return false; }
+
+		char tag[8];
+		in.read(tag, 8);
+		if (in.gcount() != 8) { return false; }
+
+		return (strncmp(tag, BINARYDIST_TAG, 8) == 0);
+	}
+	catch(exception& e) {
+		MothurOut::getInstance()->errorOut(e, "BinaryDistFile", "isBinary");
+		exit(1);
+	}
+}
+/***********************************************************************/
+
+int BinaryDistFile::writeHeader(ofstream& out, vector<string>& seqNames) {
+	try {
+		string nameTable = "";
+		for (int i = 0; i < seqNames.size(); i++) { nameTable += seqNames[i] + '\n'; }
+		while (((BINARYDIST_HEADERSIZE + nameTable.length()) % 4) != 0) { nameTable += '\0'; }
+
+		unsigned int version = BINARYDIST_VERSION;
+		unsigned int numSeqs = seqNames.size();
+		unsigned long long nameBytes = nameTable.length();
+
+		out.write(BINARYDIST_TAG, 8);
+		out.write((char*)&version, sizeof(unsigned int));
+		out.write((char*)&numSeqs, sizeof(unsigned int));
+		out.write((char*)&nameBytes, sizeof(unsigned long long));
+		out.write(nameTable.c_str(), nameTable.length());
+
+		return 0;
+	}
+	catch(exception& e) {
+		MothurOut::getInstance()->errorOut(e, "BinaryDistFile", "writeHeader");
+		exit(1);
+	}
+}
+/***********************************************************************/
+
+bool BinaryDistFile::open(string file) {
+	try {
+		close();
+		filename = file;
+
+		if (!isBinary(filename)) { m->mothurOut("[ERROR]: " + filename + " is not a binary distance file.\n"); return false; }
+
+	#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+		int fd = ::open(filename.c_str(), O_RDONLY);
+		if (fd == -1) { m->mothurOut("[ERROR]: Could not open " + filename + "\n"); return false; }
+
+		struct stat st;
+		fstat(fd, &st);
+		fileSize = st.st_size;
+
+		//read only and shared, so several processes can map the same distances
+		void* mapped = mmap(NULL, fileSize, PROT_READ, MAP_SHARED, fd, 0);
+		::close(fd);
+		if (mapped == MAP_FAILED) { m->mothurOut("[ERROR]: Could not map " + filename + " into memory.\n"); fileSize = 0; return false; }
+		data = (char*)mapped;
+	#else
+		ifstream in;
+		m->openInputFileBinary(filename, in);
+		in.seekg(0, ios::end);
+		fileSize = in.tellg();
+		in.seekg(0, ios::beg);
+		buffer.resize(fileSize);
+		in.read(&buffer[0], fileSize);
+		in.close();
+		data = &buffer[0];
+	#endif
+
+		if (fileSize < BINARYDIST_HEADERSIZE) { m->mothurOut("[ERROR]: " + filename + " is truncated.\n"); close(); return false; }
+
+		unsigned int version = *((unsigned int*)(data+8));
+		unsigned int numSeqs = *((unsigned int*)(data+12));
+		unsigned long long nameBytes = *((unsigned long long*)(data+16));
+
+		if (version != BINARYDIST_VERSION) { m->mothurOut("[ERROR]: " + filename + " was created by a different version of mothur, please rerun dist.seqs.\n"); close(); return false; }
+		if (nameBytes > (fileSize - BINARYDIST_HEADERSIZE)) { m->mothurOut("[ERROR]: " + filename + " is truncated.\n"); close(); return false; }
+
+		//parse name table
+		names.clear(); names.reserve(numSeqs);
+		const char* nameTable = data + BINARYDIST_HEADERSIZE;
+		string name = "";
+		for (unsigned long long i = 0; i < nameBytes; i++) {
+			if (nameTable[i] == '\n') { names.push_back(name); name = ""; }
+			else if (nameTable[i] != '\0') { name += nameTable[i]; }
+		}
+
+		if (names.size() != numSeqs) { m->mothurOut("[ERROR]: " + filename + " should contain " + toString(numSeqs) + " names, but I found " + toString(names.size()) + ".\n"); close(); return false; }
+
+		dists = (const binaryDistCell*)(data + BINARYDIST_HEADERSIZE + nameBytes);
+		numDists = (fileSize - BINARYDIST_HEADERSIZE - nameBytes) / sizeof(binaryDistCell);
+
+		return true;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "BinaryDistFile", "open");
+		exit(1);
+	}
+}
+/***********************************************************************/
+
+void BinaryDistFile::close() {
+	try {
+	#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+		if (data != NULL) { munmap(data, fileSize); }
+	#else
+		buffer.clear();
+	#endif
+		data = NULL; dists = NULL;
+		numDists = 0; fileSize = 0;
+		names.clear();
+	}
+	catch(exception& e) {
+		m->errorOut(e, "BinaryDistFile", "close");
+		exit(1);
+	}
+}
+/***********************************************************************/
+
+int BinaryDistFile::convertToColumn(string outputFile, float cutoff) {
+	try {
+		ofstream out;
+		m->openOutputFile(outputFile, out);
+		out.setf(ios::fixed, ios::showpoint);
+		out << setprecision(4);
+
+		for (unsigned long long i = 0; i < numDists; i++) {
+			if (m->control_pressed) { break; }
+
+			if (dists[i].dist <= cutoff) { out << names[dists[i].row] << ' ' << names[dists[i].col] << ' ' << dists[i].dist << '\n'; }
+		}
+		out.close();
+
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "BinaryDistFile", "convertToColumn");
+		exit(1);
+	}
+}
+/***********************************************************************/
+//counting sort of the distances by their larger (lower triangle row) or smaller sequence index.
+//offsets has numSeqs+1 entries, the distances for sequence i are order[offsets[i]] to order[offsets[i+1]-1]
+int BinaryDistFile::getOrder(vector<unsigned long long>& offsets, vector<unsigned long long>& order, bool lower) {
+	try {
+		int numSeqs = names.size();
+		offsets.assign(numSeqs+1, 0);
+		order.resize(numDists);
+
+		for (unsigned long long i = 0; i < numDists; i++) {
+			unsigned int key = lower ? max(dists[i].row, dists[i].col) : min(dists[i].row, dists[i].col);
+			offsets[key+1]++;
+		}
+		for (int i = 0; i < numSeqs; i++) { offsets[i+1] += offsets[i]; }
+
+		vector<unsigned long long> next(offsets.begin(), offsets.end()-1);
+		for (unsigned long long i = 0; i < numDists; i++) {
+			unsigned int key = lower ? max(dists[i].row, dists[i].col) : min(dists[i].row, dists[i].col);
+			order[next[key]++] = i;
+		}
+
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "BinaryDistFile", "getOrder");
+		exit(1);
+	}
+}
+/***********************************************************************/
+
+int BinaryDistFile::convertToPhylip(string outputFile, bool square) {
+	try {
+		int numSeqs = names.size();
+
+		vector<unsigned long long> lowerOffsets, lowerOrder, upperOffsets, upperOrder;
+		getOrder(lowerOffsets, lowerOrder, true);
+		if (square) { getOrder(upperOffsets, upperOrder, false); }
+
+		ofstream out;
+		m->openOutputFile(outputFile, out);
+		out.setf(ios::fixed, ios::showpoint);
+		out << setprecision(4);
+
+		out << numSeqs << endl;
+
+		for (int i = 0; i < numSeqs; i++) {
+			if (m->control_pressed) { break; }
+
+			int rowSize = i;
+			if (square) { rowSize = numSeqs; }
+			vector<float> row(rowSize, 1.0);
+			if (square) { row[i] = 0.0; }
+
+			for (unsigned long long j = lowerOffsets[i]; j < lowerOffsets[i+1]; j++) {
+				const binaryDistCell& cell = dists[lowerOrder[j]];
+				unsigned int col = min(cell.row, cell.col);
+				if (col != i) { row[col] = cell.dist; }
+			}
+			if (square) {
+				for (unsigned long long j = upperOffsets[i]; j < upperOffsets[i+1]; j++) {
+					const binaryDistCell& cell = dists[upperOrder[j]];
+					unsigned int col = max(cell.row, cell.col);
+					if (col != i) { row[col] = cell.dist; }
+				}
+			}
+
+			string name = names[i];
+			//pad with spaces to make compatible
+			if (name.length() < 10) { while (name.length() < 10) {  name += " ";  } }
+			out << name;
+
+			if (square) {
+				out << '\t';
+				for (int j = 0; j < row.size(); j++) { out << row[j] << '\t'; }
+			}else {
+				for (int j = 0; j < row.size(); j++) { out << '\t' << row[j]; }
+			}
+			out << endl;
+		}
+		out.close();
+
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "BinaryDistFile", "convertToPhylip");
+		exit(1);
+	}
+}
+/***********************************************************************/
+
+int BinaryDistFile::convertFromColumn(string columnFile, string outputFile, vector<string> seqNames) {
+	try {
+		MothurOut* m = MothurOut::getInstance();
+
+		map<string, unsigned int> nameIndex;
+		map<string, unsigned int>::iterator itA, itB;
+		for (int i = 0; i < seqNames.size(); i++) { nameIndex[seqNames[i]] = i; }
+
+		//first pass finds the names and whether the matrix is square
+		ifstream in;
+		m->openInputFile(columnFile, in);
+
+		string firstName, secondName;
+		float distance;
+		string refA = "", refB = "";
+		bool square = false;
+
+		while (!in.eof()) {
+			if (m->control_pressed) { in.close(); return 0; }
+
+			if (!(in >> firstName >> secondName >> distance)) { break; }
+			m->gobble(in);
+
+			if (nameIndex.count(firstName) == 0) { nameIndex[firstName] = seqNames.size(); seqNames.push_back(firstName); }
+			if (nameIndex.count(secondName) == 0) { nameIndex[secondName] = seqNames.size(); seqNames.push_back(secondName); }
+
+			if (firstName != secondName) {
+				if (refA == "") { refA = firstName; refB = secondName; }
+				else if ((refA == secondName) && (refB == firstName)) { square = true; }
+			}
+		}
+		in.close();
+
+		ofstream out;
+		m->openOutputFileBinary(outputFile, out);
+		writeHeader(out, seqNames);
+
+		m->openInputFile(columnFile, in);
+		while (!in.eof()) {
+			if (m->control_pressed) { break; }
+
+			if (!(in >> firstName >> secondName >> distance)) { break; }
+			m->gobble(in);
+
+			unsigned int row = nameIndex[firstName];
+			unsigned int col = nameIndex[secondName];
+
+			if (row == col) { continue; }
+			if (row < col) {
+				if (square) { continue; } //we will find its transpose
+				unsigned int temp = row; row = col; col = temp;
+			}
+
+			writeDist(out, row, col, distance);
+		}
+		in.close();
+		out.close();
+
+		return 0;
+	}
+	catch(exception& e) {
+		MothurOut::getInstance()->errorOut(e, "BinaryDistFile", "convertFromColumn");
+		exit(1);
+	}
+}
+/***********************************************************************/
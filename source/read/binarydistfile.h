@@ -0,0 +1,79 @@
+#ifndef BINARYDISTFILE_H
+#define BINARYDISTFILE_H
+/*
+ *  binarydistfile.h
+ *  Mothur
+ *
+ *  Copyright 2026 Schloss Lab. All rights reserved.
+ *
+ */
+
+#include "mothur.h"
+#include "mothurout.h"
+
+/* The binary distance file is created by dist.seqs output=binary. It holds the same distances as a column file,
+ without formatting or parsing the floats, and can be mapped into memory by the readers.
+
+ header:    8 byte tag "MOTHURBD", unsigned int version, unsigned int numSeqs, ull number of bytes in the name table
+ names:     numSeqs names, each followed by '\n', padded with '\0' so the distances start on a 4 byte boundary
+ distances: one binaryDistCell per distance below the cutoff. The row and column are the indexes of the sequences in the name table.
+            Distances are rounded to the 4 decimal places kept by the column format, so cluster finds the same OTUs from either file.
+
+ The number of distances is found from the size of the file, so processes can append distances without updating the header. */
+
+/******************************************************/
+
+struct binaryDistCell {
+	unsigned int row;
+	unsigned int col;
+	float dist;
+	binaryDistCell() : row(0), col(0), dist(0) {}
+	binaryDistCell(unsigned int r, unsigned int c, float d) : row(r), col(c), dist(d) {}
+};
+
+/******************************************************/
+
+class BinaryDistFile {
+
+public:
+	BinaryDistFile();
+	~BinaryDistFile();
+
+	static bool isBinary(string);										//checks the tag at the start of the file
+	static int writeHeader(ofstream&, vector<string>&);				//writes the header and name table to the start of the file
+	static void writeDist(ostream& out, unsigned int row, unsigned int col, double dist) {
+		binaryDistCell cell(row, col, (float)(floor(dist * 10000.0 + 0.5) / 10000.0));
+		out.write((char*)&cell, sizeof(binaryDistCell));
+	}
+
+	bool open(string);					//maps the file into memory, returns false if the file is not a binary distance file
+	void close();
+
+	vector<string> getNames()			{ return names;			}
+	int getNumSeqs()					{ return names.size();	}
+	unsigned long long getNumDists()	{ return numDists;		}
+	const binaryDistCell* getDists()	{ return dists;			}
+
+	int convertToColumn(string, float);			//writes the distances below the cutoff in column format
+	int convertToPhylip(string, bool);			//writes a lower triangle or square phylip matrix, distances not in the file are set to 1.0
+	static int convertFromColumn(string, string, vector<string>);		//column file, output file, names of sequences without distances
+
+private:
+	MothurOut* m;
+	string filename;
+	vector<string> names;
+	const binaryDistCell* dists;
+	unsigned long long numDists, fileSize;
+	char* data;
+
+	#if defined (__APPLE__) || (__MACH__) || (linux) || (__linux) || (__linux__) || (__unix__) || (__unix)
+	#else
+	vector<char> buffer;				//no mmap, so the file is read into memory
+	#endif
+
+	int getOrder(vector<unsigned long long>&, vector<unsigned long long>&, bool);
+};
+
+/******************************************************/
+
+#endif
@@ -0,0 +1,268 @@
+/*
+ *  distancesorter.cpp
+ *  Mothur
+ *
+ *  Copyright 2026 Schloss Lab. All rights reserved.
+ *
+ */
+
+#include "distancesorter.h"
+#include "threadpool.h"
+
+#define DISTANCESORTER_MAXRUNS 64
+
+/***********************************************************************/
+
+DistanceSorter::DistanceSorter(int p, int memory) {
+	m = MothurOut::getInstance();
+	processors = max(p, 1);
+	if (memory < 1) { memory = 1; }
+
+	//a sortLine is 16 bytes, about half the length of a line in a column file
+	blockSize = ((unsigned long long)memory * 1024 * 1024) / (processors + 1) * 2 / 3;
+	if (blockSize < 65536) { blockSize = 65536; }
+	if (blockSize > 2000000000) { blockSize = 2000000000; } //the lines are found by unsigned int offsets
+}
+/***********************************************************************/
+//the third column, or 0 if the line does not have one. Like sort -n, only the leading '-', digits and decimal point are read
+double DistanceSorter::getDistance(const char* line, const char* end) {
+	const char* pos = line;
+	for (int field = 0; field < 2; field++) {
+		while ((pos < end) && ((*pos == ' ') || (*pos == '\t'))) { pos++; }
+		while ((pos < end) && (*pos != ' ') && (*pos != '\t')) { pos++; }
+	}
+	while ((pos < end) && ((*pos == ' ') || (*pos == '\t'))) { pos++; }
+	
+	char number[64];
+	int length = 0;
+	bool decimal = false;
+	if ((pos < end) && (*pos == '-')) { number[length++] = *pos++; }
+	while ((pos < end) && (length < 63)) {
+		if (isdigit(*pos)) { number[length++] = *pos++; }
+		else if ((*pos == '.') && !decimal) { number[length++] = *pos++; decimal = true; }
+		else { break; }
+	}
+	number[length] = '\0';
+	
+	return atof(number);
+}
+/***********************************************************************/
+
+bool DistanceSorter::lessThan(double distA, const char* lineA, unsigned int lengthA, double distB, const char* lineB, unsigned int lengthB) {
+	if (distA != distB) { return distA < distB; }
+
+	int compare = memcmp(lineA, lineB, min(lengthA, lengthB));
+	if (compare != 0) { return compare < 0; }
+	return lengthA < lengthB;
+}
+/***********************************************************************/
+
+string DistanceSorter::getRunName(string outfile, int run) {
+	return outfile + ".run" + toString(run) + ".temp";
+}
+/***********************************************************************/
+
+string DistanceSorter::sortFile(string distFile, string outputDir) {
+	try {
+		string outfile = m->getRootName(distFile) + "sorted.dist";
+
+		ifstream in;
+		m->openInputFileBinary(distFile, in);
+
+		ThreadPool pool(processors);
+		vector<string> runs;
+		string leftover = "";
+		bool sorted = false;
+
+		while (!m->control_pressed) {
+			string* block = new string(leftover);
+			block->resize(leftover.length() + blockSize);
+			in.read(&(*block)[leftover.length()], blockSize);
+			unsigned long long numRead = in.gcount();
+			block->resize(leftover.length() + numRead);
+			bool done = (numRead < blockSize);
+
+			//the partial line at the end of the block is saved for the next one
+			leftover = "";
+			if (!done) {
+				size_t lastLine = block->rfind('\n');
+				if (lastLine == string::npos) { leftover = *block; delete block; continue; }
+				leftover = block->substr(lastLine + 1);
+				block->resize(lastLine + 1);
+			}
+
+			if (done && runs.empty()) {
+				ofstream out;
+				m->openOutputFile(outfile, out);
+				sortBlock(block, out, false);
+				out.close();
+				delete block;
+				sorted = true;
+				break;
+			}
+
+			if (block->length() != 0) {
+				string runName = getRunName(outfile, runs.size());
+				runs.push_back(runName);
+				m->mothurOutJustToScreen("Sorting block " + toString(runs.size()) + "\n");
+
+				pool.submit([this, block, runName](int processor) {
+					ofstream out;
+					m->openOutputFileBinary(runName, out);
+					sortBlock(block, out, true);
+					out.close();
+					delete block;
+				});
+
+				//keeps the number of blocks in memory bounded
+				pool.waitForSlot(processors);
+			}else { delete block; }
+
+			if (done) { break; }
+		}
+		pool.wait();
+		in.close();
+
+		if (!sorted && !m->control_pressed) {
+			//merge the runs in groups until one pass can write the sorted file
+			int numMerged = runs.size();
+			while ((runs.size() > DISTANCESORTER_MAXRUNS) && !m->control_pressed) {
+				vector<string> group(runs.begin(), runs.begin() + DISTANCESORTER_MAXRUNS);
+				string runName = getRunName(outfile, numMerged++);
+
+				ofstream out;
+				m->openOutputFileBinary(runName, out);
+				mergeRuns(group, out, true);
+				out.close();
+
+				for (int i = 0; i < group.size(); i++) { m->mothurRemove(group[i]); }
+				runs.erase(runs.begin(), runs.begin() + DISTANCESORTER_MAXRUNS);
+				runs.push_back(runName);
+			}
+
+			ofstream out;
+			m->openOutputFile(outfile, out);
+			mergeRuns(runs, out, false);
+			out.close();
+		}
+
+		for (int i = 0; i < runs.size(); i++) { m->mothurRemove(runs[i]); }
+
+		return outfile;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "DistanceSorter", "sortFile");
+		exit(1);
+	}
+}
+/***********************************************************************/
+//several processors sort blocks at once, so this only reads from the sorter
+int DistanceSorter::sortBlock(string* block, ostream& out, bool binary) {
+	try {
+		const char* data = block->c_str();
+		unsigned int size = block->length();
+
+		vector<sortLine> lines;
+		unsigned int start = 0;
+		while (start < size) {
+			const char* end = (const char*)memchr(data + start, '\n', size - start);
+			unsigned int lineEnd = (end == NULL) ? size : (end - data);
+
+			sortLine line;
+			line.dist = getDistance(data + start, data + lineEnd);
+			line.start = start;
+			line.length = lineEnd - start;
+			lines.push_back(line);
+
+			start = lineEnd + 1;
+		}
+
+		if (m->control_pressed) { return 0; }
+
+		sort(lines.begin(), lines.end(), [data](const sortLine& a, const sortLine& b) {
+			return lessThan(a.dist, data + a.start, a.length, b.dist, data + b.start, b.length);
+		});
+
+		for (int i = 0; i < lines.size(); i++) {
+			if (binary) {
+				out.write((char*)&lines[i].dist, sizeof(double));
+				out.write((char*)&lines[i].length, sizeof(unsigned int));
+				out.write(data + lines[i].start, lines[i].length);
+			}else {
+				out.write(data + lines[i].start, lines[i].length);
+				out.put('\n');
+			}
+		}
+
+		return lines.size();
+	}
+	catch(exception& e) {
+		m->errorOut(e, "DistanceSorter", "sortBlock");
+		exit(1);
+	}
+}
+/***********************************************************************/
+
+int DistanceSorter::mergeRuns(vector<string>& runs, ostream& out, bool binary) {
+	try {
+		m->mothurOutJustToScreen("Merging " + toString(runs.size()) + " sorted blocks\n");
+
+		vector<ifstream*> files(runs.size(), NULL);
+		vector<double> dists(runs.size(), 0);
+		vector<string> lines(runs.size(), "");
+
+		//reads the next line of a run, returns false at the end of the run
+		auto readLine = [&files, &dists, &lines](int run) {
+			unsigned int length = 0;
+			if (!files[run]->read((char*)&dists[run], sizeof(double))) { return false; }
+			files[run]->read((char*)&length, sizeof(unsigned int));
+			lines[run].resize(length);
+			if (length != 0) { files[run]->read(&lines[run][0], length); }
+			return true;
+		};
+
+		//the heap holds the runs that have lines left, ordered by their next line
+		auto greater = [&dists, &lines](int a, int b) {
+			return lessThan(dists[b], lines[b].c_str(), lines[b].length(), dists[a], lines[a].c_str(), lines[a].length());
+		};
+		vector<int> heap;
+
+		for (int i = 0; i < runs.size(); i++) {
+			files[i] = new ifstream(runs[i].c_str(), ios::binary);	//not openInputFileBinary, which skips leading whitespace
+			if (!(*files[i])) { m->mothurOut("[ERROR]: Could not open " + runs[i] + ".\n"); m->control_pressed = true; continue; }
+			if (readLine(i)) { heap.push_back(i); }
+		}
+		make_heap(heap.begin(), heap.end(), greater);
+
+		unsigned long long count = 0;
+		while (!heap.empty()) {
+			if ((count % 100000 == 0) && m->control_pressed) { break; }
+
+			pop_heap(heap.begin(), heap.end(), greater);
+			int run = heap.back();
+
+			if (binary) {
+				unsigned int length = lines[run].length();
+				out.write((char*)&dists[run], sizeof(double));
+				out.write((char*)&length, sizeof(unsigned int));
+				out.write(lines[run].c_str(), length);
+			}else {
+				out.write(lines[run].c_str(), lines[run].length());
+				out.put('\n');
+			}
+			count++;
+
+			if (readLine(run)) { push_heap(heap.begin(), heap.end(), greater); }
+			else { heap.pop_back(); }
+		}
+
+		for (int i = 0; i < files.size(); i++) { files[i]->close(); delete files[i]; }
+
+		return count;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "DistanceSorter", "mergeRuns");
+		exit(1);
+	}
+}
+/***********************************************************************/
@@ -0,0 +1,54 @@
+#ifndef DISTANCESORTER_H
+#define DISTANCESORTER_H
+/*
+ *  distancesorter.h
+ *  Mothur
+ *
+ *  Copyright 2026 Schloss Lab. All rights reserved.
+ *
+ */
+
+#include "mothur.h"
+#include "mothurout.h"
+
+/* The DistanceSorter sorts a column distance file by its third column, the same order as "sort -n -k +3" gives, with
+ ties broken by comparing the whole line byte by byte. It does not depend on the unix sort, its temp directory or its
+ locale.
+
+ The file is read in blocks, small enough that processors + 1 blocks and their sort keys fit in the memory given. Each
+ block is sorted on its own processor and written next to the output file as a run, a binary file of distance, line
+ length and line for each line, so the runs are merged without parsing the distances again. At most 64 runs are
+ merged at once, so very large files are merged in several passes. A file that fits in one block is sorted without
+ any runs. */
+
+/******************************************************/
+
+class DistanceSorter {
+
+public:
+	DistanceSorter(int, int);		//processors, megabytes of the file held in memory at once
+	~DistanceSorter() {}
+
+	string sortFile(string, string);	//distance file, output directory - returns the name of the sorted file
+
+private:
+	struct sortLine {
+		double dist;
+		unsigned int start;
+		unsigned int length;
+	};
+
+	MothurOut* m;
+	int processors;
+	unsigned long long blockSize;
+
+	static double getDistance(const char*, const char*);
+	static bool lessThan(double, const char*, unsigned int, double, const char*, unsigned int);
+	int sortBlock(string*, ostream&, bool);
+	int mergeRuns(vector<string>&, ostream&, bool);
+	string getRunName(string, int);
+};
+
+/******************************************************/
+
+#endif
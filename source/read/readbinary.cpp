@@ -0,0 +1,139 @@
+/*
+ *  readbinary.cpp
+ *  Mothur
+ *
+ *  Copyright 2026 Schloss Lab. All rights reserved.
+ *
+ */
+
+#include "readbinary.h"
+#include "progress.hpp"
+
+/***********************************************************************/
+
+ReadBinaryMatrix::ReadBinaryMatrix(string df) : filename(df){
+	
+	successOpen = 0;
+	if (!distFile.open(filename)) { successOpen = 1; }
+	sim = false;
+	
+}
+/***********************************************************************/
+
+ReadBinaryMatrix::ReadBinaryMatrix(string df, bool s) : filename(df){
+	
+	successOpen = 0;
+	if (!distFile.open(filename)) { successOpen = 1; }
+	sim = s;
+}
+/***********************************************************************/
+
+int ReadBinaryMatrix::read(NameAssignment* nameMap){
+	try {
+        vector<string> names = distFile.getNames();
+        vector<int> indexes(names.size(), 0);
+        
+        //the name table in the file lists every sequence, so the namefile is optional
+        if (nameMap == NULL) {
+            DMatrix->resize(names.size());
+            list = new ListVector(names.size());
+            for (int i = 0; i < names.size(); i++) { list->set(i, names[i]); indexes[i] = i; }
+        }else {
+            DMatrix->resize(nameMap->size());
+            list = new ListVector(nameMap->getListVector());
+            
+            for (int i = 0; i < names.size(); i++) {
+                map<string,int>::iterator it = nameMap->find(names[i]);
+                if(it == nameMap->end()){  m->mothurOut("[ERROR]: Sequence '" + names[i] + "' was not found in the names file, please correct\n"); m->control_pressed = true; return 0;  }
+                indexes[i] = it->second;
+            }
+        }
+        
+        fillMatrix(indexes);
+        
+        if (m->control_pressed) { return 0; }
+        
+		list->setLabel("0");
+		
+		return 1;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ReadBinaryMatrix", "read");
+		exit(1);
+	}
+}
+/***********************************************************************/
+
+int ReadBinaryMatrix::read(CountTable* countTable){
+	try {
+        vector<string> names = distFile.getNames();
+        vector<int> indexes(names.size(), 0);
+        
+        DMatrix->resize(countTable->size());
+        list = new ListVector(countTable->getListVector());
+        
+        for (int i = 0; i < names.size(); i++) {
+            indexes[i] = countTable->get(names[i]);
+            if (m->control_pressed) { return 0; }
+        }
+        
+        fillMatrix(indexes);
+        
+        if (m->control_pressed) { return 0; }
+        
+		list->setLabel("0");
+		
+		return 1;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ReadBinaryMatrix", "read");
+		exit(1);
+	}
+}
+/***********************************************************************/
+//indexes maps the sequences in the files name table to their rows in the matrix
+int ReadBinaryMatrix::fillMatrix(vector<int>& indexes){
+	try {
+        const binaryDistCell* dists = distFile.getDists();
+        unsigned long long numDists = distFile.getNumDists();
+        
+        Progress* reading = new Progress("Reading matrix:     ", 100);
+        unsigned long long tick = numDists / 100 + 1;
+        
+        for (unsigned long long i = 0; i < numDists; i++) {
+            
+            if (m->control_pressed) { delete reading; return 0; }
+            
+            int itA = indexes[dists[i].row];
+            int itB = indexes[dists[i].col];
+            float distance = dists[i].dist;
+            
+            if (distance == -1) { distance = 1000000; }
+			else if (sim) { distance = 1.0 - distance;  }  //user has entered a sim matrix that we need to convert.
+            
+            if(distance < cutoff && itA != itB){
+				if(itA > itB){
+                    PDistCell value(itA, distance);
+                    DMatrix->addCell(itB, value);
+                }else {
+                    PDistCell value(itB, distance);
+                    DMatrix->addCell(itA, value);
+                }
+            }
+            
+            if ((i % tick) == 0) { reading->update(i / tick); }
+        }
+        
+        reading->finish();
+        delete reading;
+        
+        return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ReadBinaryMatrix", "fillMatrix");
+		exit(1);
+	}
+}
+/***********************************************************************/
+ReadBinaryMatrix::~ReadBinaryMatrix(){ distFile.close(); }
+/***********************************************************************/
@@ -0,0 +1,33 @@
+#ifndef READBINARY_H
+#define READBINARY_H
+/*
+ *  readbinary.h
+ *  Mothur
+ *
+ *  Copyright 2026 Schloss Lab. All rights reserved.
+ *
+ */
+
+#include "readmatrix.hpp"
+#include "binarydistfile.h"
+
+/******************************************************/
+//reads the binary distance file created by dist.seqs output=binary. The distances are mapped into memory, not parsed.
+class ReadBinaryMatrix : public ReadMatrix {
+	
+public:
+	ReadBinaryMatrix(string);
+	ReadBinaryMatrix(string, bool);
+	~ReadBinaryMatrix();
+	int read(NameAssignment*);
+    int read(CountTable*);
+private:
+	BinaryDistFile distFile;
+	string filename;
+    
+    int fillMatrix(vector<int>&);
+};
+
+/******************************************************/
+
+#endif
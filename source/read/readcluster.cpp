@@ -18,6 +18,8 @@ ReadCluster::ReadCluster(string distfile, float c, string o, bool s){
 		outputDir = o;
 		sortWanted = s;
 		list = NULL;
+		processors = 1;
+		sortMemory = 512;
 }
 
 /***********************************************************************/
@@ -26,11 +28,25 @@ int ReadCluster::read(NameAssignment*& nameMap){
 	try {
         
 		if (format == "phylip") { convertPhylip2Column(nameMap); }
+		else if (format == "binary") {
+			vector<string> matrixNames;
+			convertBinary2Column(matrixNames);
+			
+			if(nameMap == NULL){
+				list = new ListVector(matrixNames.size());
+				nameMap = new NameAssignment();
+				for(int i=0;i<matrixNames.size();i++){ list->set(i, matrixNames[i]); nameMap->push_back(matrixNames[i]); }
+				list->setLabel("0");
+			}else { list = new ListVector(nameMap->getListVector());  }
+		}
 		else { list = new ListVector(nameMap->getListVector());  }
 		
 		if (m->control_pressed) { return 0; }
 		
-		if (sortWanted) {  OutPutFile = m->sortFile(distFile, outputDir);  }
+		if (sortWanted) {
+			DistanceSorter sorter(processors, sortMemory);
+			OutPutFile = sorter.sortFile(distFile, outputDir);
+		}
 		else {  OutPutFile = distFile;   } //for use by clusters splitMatrix to convert a phylip matrix to column
 		
 		return 0;
@@ -46,11 +62,25 @@ int ReadCluster::read(CountTable*& ct){
 	try {
         
 		if (format == "phylip") { convertPhylip2Column(ct); }
+		else if (format == "binary") {
+			vector<string> matrixNames;
+			convertBinary2Column(matrixNames);
+			
+			if(ct == NULL){
+				list = new ListVector(matrixNames.size());
+				ct = new CountTable();
+				for(int i=0;i<matrixNames.size();i++){ list->set(i, matrixNames[i]); ct->push_back(matrixNames[i]); }
+				list->setLabel("0");
+			}else { list = new ListVector(ct->getListVector());  }
+		}
 		else { list = new ListVector(ct->getListVector());  }
 		
 		if (m->control_pressed) { return 0; }
 		
-		if (sortWanted) {  OutPutFile = m->sortFile(distFile, outputDir);  }
+		if (sortWanted) {
+			DistanceSorter sorter(processors, sortMemory);
+			OutPutFile = sorter.sortFile(distFile, outputDir);
+		}
 		else {  OutPutFile = distFile;   } //for use by clusters splitMatrix to convert a phylip matrix to column
 		
 		return 0;
@@ -421,4 +451,28 @@ int ReadCluster::convertPhylip2Column(CountTable*& ct){
 
 ReadCluster::~ReadCluster(){}
 /***********************************************************************/
-
+/***********************************************************************/
+//the sort and split steps work on text, so the binary file created by dist.seqs output=binary is written as a column file
+int ReadCluster::convertBinary2Column(vector<string>& matrixNames){
+	try {
+		BinaryDistFile binary;
+		if (!binary.open(distFile)) { m->control_pressed = true; return 0; }
+		
+		matrixNames = binary.getNames();
+		
+		string outputFile = m->getRootName(distFile) + "column.dist";
+		binary.convertToColumn(outputFile, cutoff);
+		binary.close();
+		
+		distFile = outputFile;
+		
+		if (m->control_pressed) {  m->mothurRemove(outputFile);  }
+		
+		return 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ReadCluster", "convertBinary2Column");
+		exit(1);
+	}
+}
+/***********************************************************************/
@@ -14,6 +14,8 @@
 #include "nameassignment.hpp"
 #include "listvector.hpp"
 #include "counttable.h"
+#include "binarydistfile.h"
+#include "distancesorter.h"
 
 
 /******************************************************/
@@ -27,6 +29,7 @@ public:
     int read(CountTable*&);
 	string getOutputFile() { return OutPutFile; }
 	void setFormat(string f) { format = f;	}
+	void setSortOptions(int p, int mem) { processors = p; sortMemory = mem;	}	//processors and megabytes used to sort a column file
 	ListVector* getListVector()		{	return list;	}
 	
 private:
@@ -36,9 +39,11 @@ private:
 	float cutoff;
 	MothurOut* m;
 	bool sortWanted;
+	int processors, sortMemory;
 	
 	int convertPhylip2Column(NameAssignment*&);
     int convertPhylip2Column(CountTable*&);
+	int convertBinary2Column(vector<string>&);
 };
 
 /******************************************************/
@@ -447,277 +447,175 @@ int SplitMatrix::splitDistanceFileByTax(map<string, int>& seqGroup, int numGroup
 /***********************************************************************/
 int SplitMatrix::splitDistanceLarge(){
 	try {
-		vector<set<string> > groups;
-		
-		//for buffering the io to improve speed
-		 //allow for 30 dists to be stored, then output.
-		vector<string> outputs;
-		vector<int> numOutputs;
-		vector<bool> wroteOutPut;
+		//first pass joins the two seqs of each distance below the cutoff, the groups are then the connected sets of seqs
+		map<string, int> seqIndex;
+		parents.clear(); groupSizes.clear();
 		
-		int numGroups = 0;
-
-		//ofstream outFile;
 		ifstream dFile;
 		m->openInputFile(distFile, dFile);
-	
-		while(dFile){
-			string seqA, seqB;
-			float dist;
-
-			dFile >> seqA >> seqB >> dist;
+		
+		string line, seqA, seqB, distance;
+		string lastA = ""; int indexA = -1; //column files list the dists of each seq together, so save a lookup
+		while (getline(dFile, line)) {
+			if (m->control_pressed) { dFile.close(); return 0; }
 			
-			if (m->control_pressed) {   dFile.close();  for(int i=0;i<numGroups;i++){	if(groups[i].size() > 0){  m->mothurRemove((distFile + "." + toString(i) + ".temp")); }  } return 0; }
-					
-			if(dist < cutoff){
-				//cout << "in cutoff: " << dist << endl;
-				int groupIDA = -1;
-				int groupIDB = -1;
-				int groupID = -1;
-				
-				for(int i=0;i<numGroups;i++){
-					set<string>::iterator aIt = groups[i].find(seqA);
-					set<string>::iterator bIt = groups[i].find(seqB);
-					
-					if(groupIDA == -1 && aIt != groups[i].end()){//seqA is not already assigned to a group and is in group[i], so assign seqB to group[i]
-						groups[i].insert(seqB);
-						groupIDA = i;
-						groupID = groupIDA;
-
-						//cout << "in aIt: " << groupID << endl;
-	//					break;
-					}
-					else if(groupIDB == -1 && bIt != groups[i].end()){//seqB is not already assigned to a group and is in group[i], so assign seqA to group[i]
-						groups[i].insert(seqA);
-						groupIDB = i;
-						groupID = groupIDB;
-
-					//	cout << "in bIt: " << groupID << endl;
-	//					break;
-					}
-				
-					if(groupIDA != -1 && groupIDB != -1){//both ifs above have been executed, so we need to decide who to assign them to
-						if(groupIDA < groupIDB){
-						//	cout << "A: " << groupIDA << "\t" << groupIDB << endl;
-							groups[groupIDA].insert(groups[groupIDB].begin(), groups[groupIDB].end()); //merge two groups into groupIDA
-							groups[groupIDB].clear(); 
-							groupID = groupIDA;
-						}
-						else{
-						//	cout << "B: " << groupIDA << "\t" << groupIDB << endl;
-							groups[groupIDB].insert(groups[groupIDA].begin(), groups[groupIDA].end()); //merge two groups into groupIDB
-							groups[groupIDA].clear();  
-							groupID = groupIDB;
-						}
-						break;
-					}
-				}
-				
-	//windows is gonna gag on the reuse of outFile, will need to make it local...
-				
-				if(groupIDA == -1 && groupIDB == -1){ //we need a new group
-					set<string> newGroup;
-					newGroup.insert(seqA);
-					newGroup.insert(seqB);
-					groups.push_back(newGroup);
-									
-					string tempOut = seqA + '\t' + seqB + '\t' + toString(dist) + '\n';
-					outputs.push_back(tempOut);
-					numOutputs.push_back(1);
-					wroteOutPut.push_back(false);
-					
-					numGroups++;
-				}
-				else{
-					string fileName = distFile + "." + toString(groupID) + ".temp";
-											
-					//have we reached the max buffer size
-					if (numOutputs[groupID] > 60) { //write out sequence
-                        ofstream outFile;
-						outFile.open(fileName.c_str(), ios::app);
-						outFile << outputs[groupID] << seqA << '\t' << seqB << '\t' << dist << endl;
-						outFile.close();
-						
-						outputs[groupID] = "";
-						numOutputs[groupID] = 0;
-						wroteOutPut[groupID] = true;
-					}else {
-						outputs[groupID] +=  seqA + '\t' + seqB + '\t' + toString(dist)  + '\n';
-						numOutputs[groupID]++;
-					}
-					
-					if(groupIDA != -1 && groupIDB != -1){ //merge distance files of two groups you merged above
-						string row, column, distance;
-						if(groupIDA<groupIDB){
-							
-							//merge memory
-							numOutputs[groupID] += numOutputs[groupIDB];
-							outputs[groupID] += outputs[groupIDB];
-							
-							outputs[groupIDB] = "";
-							numOutputs[groupIDB] = 0;
-							
-							//if groupB is written to file it is above buffer size so read and write to new merged file
-							if (wroteOutPut[groupIDB]) {
-								string fileName2 = distFile + "." + toString(groupIDB) + ".temp";
-								/*ifstream fileB(fileName2.c_str(), ios::ate);
-								
-								outFile.open(fileName.c_str(), ios::app);
-								
-								long size;
-								char* memblock;
-
-								size = fileB.tellg();
-				
-								fileB.seekg (0, ios::beg);
-								
-								int numRead = size / 1024;
-								int lastRead = size % 1024;
-
-								for (int i = 0; i < numRead; i++) {
-				
-									memblock = new char [1024];
-								
-									fileB.read (memblock, 1024);
-									
-									string temp = memblock;
-									outFile << temp.substr(0, 1024);
-									
-									delete memblock;
-								}
-								
-								memblock = new char [lastRead];
-								
-								fileB.read (memblock, lastRead);
-								
-								//not sure why but it will read more than lastRead char...??
-								string temp = memblock;
-								outFile << temp.substr(0, lastRead);
-								delete memblock;
-								
-								fileB.close();*/
-                                m->appendFiles(fileName2, fileName);
-								m->mothurRemove(fileName2);
-                        
-								
-								//write out the merged memory
-								if (numOutputs[groupID] > 60) {
-                                    ofstream tempOut;
-                                    m->openOutputFile(fileName, tempOut);
-									tempOut << outputs[groupID];
-									outputs[groupID] = "";
-									numOutputs[groupID] = 0;
-                                    tempOut.close();
-								}
-								
-								//outFile.close();
-								
-								wroteOutPut[groupID] = true;
-								wroteOutPut[groupIDB] = false;
-							}else{ } //just merge b's memory with a's memory 
-						}
-						else{
-							numOutputs[groupID] += numOutputs[groupIDA];
-							outputs[groupID] += outputs[groupIDA];
-							
-							outputs[groupIDA] = "";
-							numOutputs[groupIDA] = 0;
-							
-							if (wroteOutPut[groupIDA]) {
-								string fileName2 = distFile + "." + toString(groupIDA) + ".temp";
-								/*ifstream fileB(fileName2.c_str(), ios::ate);
-								
-								outFile.open(fileName.c_str(), ios::app);
-								
-								long size;
-								char* memblock;
-
-								size = fileB.tellg();
-															
-								fileB.seekg (0, ios::beg);
-								
-								int numRead = size / 1024;
-								int lastRead = size % 1024;
-
-								for (int i = 0; i < numRead; i++) {
-				
-									memblock = new char [1024];
-								
-									fileB.read (memblock, 1024);
-									string temp = memblock;
-									outFile << temp.substr(0, 1024);
-									
-									delete memblock;
-								}
-								
-								memblock = new char [lastRead];
-								
-								fileB.read (memblock, lastRead);
-								
-								//not sure why but it will read more than lastRead char...??
-								string temp = memblock;
-								outFile << temp.substr(0, lastRead);
-									
-								delete memblock;
-								
-								fileB.close();*/
-                                m->appendFiles(fileName2, fileName);
-								m->mothurRemove(fileName2);
-								
-								//write out the merged memory
-								if (numOutputs[groupID] > 60) {
-                                    ofstream tempOut;
-                                    m->openOutputFile(fileName, tempOut);
-									tempOut << outputs[groupID];
-									outputs[groupID] = "";
-									numOutputs[groupID] = 0;
-                                    tempOut.close();
-								}
-								
-								//outFile.close();
-								
-								wroteOutPut[groupID] = true;
-								wroteOutPut[groupIDA] = false;
-							}else { } //just merge memory
-						}					
-					}
-				}
-			}
-			m->gobble(dFile);
+			if (!parseDistance(line, seqA, seqB, distance)) { continue; }
+			if (strtof(distance.c_str(), NULL) >= cutoff) { continue; }
+			
+			if ((indexA == -1) || (seqA != lastA)) { indexA = getSeqIndex(seqIndex, seqA); lastA = seqA; }
+			int indexB = getSeqIndex(seqIndex, seqB);
+			
+			joinGroups(indexA, indexB);
 		}
 		dFile.close();
-        
+		
+		//second pass writes each distance to its group's file, the groups are numbered in the order they are first seen
+		vector<int> groupID(parents.size(), -1);
 		vector<string> tempDistFiles;
-		for (int i = 0; i < numGroups; i++) {
-            string fileName = distFile + "." + toString(i) + ".temp";
-            tempDistFiles.push_back(fileName);
-            //remove old names files just in case
+		vector<string> outputs;
+		long long buffered = 0;
+		int numGroups = 0;
+		
+		m->openInputFile(distFile, dFile);
+		
+		lastA = ""; indexA = -1;
+		while (getline(dFile, line)) {
+			if (m->control_pressed) { dFile.close(); for (int i = 0; i < numGroups; i++) { m->mothurRemove(tempDistFiles[i]); } return 0; }
 			
-			if (numOutputs[i] > 0) {
-                ofstream outFile;
-				outFile.open(fileName.c_str(), ios::app);
-				outFile << outputs[i];
-				outFile.close();
+			if (!parseDistance(line, seqA, seqB, distance)) { continue; }
+			if (strtof(distance.c_str(), NULL) >= cutoff) { continue; }
+			
+			if ((indexA == -1) || (seqA != lastA)) { indexA = seqIndex[seqA]; lastA = seqA; }
+			int group = findGroup(indexA);
+			
+			if (groupID[group] == -1) { //we need a new group
+				groupID[group] = numGroups;
+				string fileName = distFile + "." + toString(numGroups) + ".temp";
+				m->mothurRemove(fileName);
+				tempDistFiles.push_back(fileName);
+				outputs.push_back("");
+				numGroups++;
+			}
+			group = groupID[group];
+			
+			int length = outputs[group].length();
+			outputs[group] += seqA; outputs[group] += '\t'; outputs[group] += seqB; outputs[group] += '\t'; outputs[group] += distance; outputs[group] += '\n';
+			buffered += outputs[group].length() - length;
+			
+			//big groups are written as they fill their buffer, the rest when all the buffers together get too big
+			if (outputs[group].length() > 65536) {
+				buffered -= outputs[group].length();
+				writeDistances(tempDistFiles[group], outputs[group]);
+			}
+			if (buffered > 67108864) {
+				for (int i = 0; i < numGroups; i++) { writeDistances(tempDistFiles[i], outputs[i]); }
+				buffered = 0;
 			}
 		}
-        
-        map<string, int> seqGroup;
-        for (int i = 0; i < groups.size(); i++) {
-            for (set<string>::iterator itNames = groups[i].begin(); itNames != groups[i].end();) {
-                seqGroup[*itNames] = i;
-                groups[i].erase(itNames++);
-            }
-        }
-        
+		dFile.close();
+		
+		for (int i = 0; i < numGroups; i++) { writeDistances(tempDistFiles[i], outputs[i]); }
+		
+		map<string, int> seqGroup;
+		for (map<string, int>::iterator it = seqIndex.begin(); it != seqIndex.end(); it++) {
+			seqGroup[it->first] = groupID[findGroup(it->second)];
+		}
+		parents.clear(); groupSizes.clear();
+		
 		splitNames(seqGroup, numGroups, tempDistFiles);
-				
-		return 0;			
+		
+		return 0;
 	}
 	catch(exception& e) {
 		m->errorOut(e, "SplitMatrix", "splitDistanceLarge");
 		exit(1);
 	}
 }
+/***********************************************************************/
+//reads the two seqs and the distance from a line of a column file, returns false if the line has less than three fields
+bool SplitMatrix::parseDistance(string& line, string& seqA, string& seqB, string& distance){
+	try {
+		string* fields[3] = { &seqA, &seqB, &distance };
+		int numFields = 0;
+		int i = 0;
+		int length = line.length();
+		
+		while ((numFields < 3) && (i < length)) {
+			while ((i < length) && isspace(line[i])) { i++; }
+			int start = i;
+			while ((i < length) && !isspace(line[i])) { i++; }
+			if (i > start) { fields[numFields]->assign(line, start, i-start); numFields++; }
+		}
+		
+		return (numFields == 3);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SplitMatrix", "parseDistance");
+		exit(1);
+	}
+}
+/***********************************************************************/
+//gives each seq a number the first time it is seen, each new seq starts as its own group
+int SplitMatrix::getSeqIndex(map<string, int>& seqIndex, string& name){
+	try {
+		map<string, int>::iterator it = seqIndex.find(name);
+		if (it != seqIndex.end()) { return it->second; }
+		
+		int index = parents.size();
+		seqIndex[name] = index;
+		parents.push_back(index);
+		groupSizes.push_back(1);
+		
+		return index;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SplitMatrix", "getSeqIndex");
+		exit(1);
+	}
+}
+/***********************************************************************/
+//the seq heading the group, pointing the seqs passed along the way at it so the next find is shorter
+int SplitMatrix::findGroup(int index){
+	int root = index;
+	while (parents[root] != root) { root = parents[root]; }
+	
+	while (parents[index] != root) {
+		int next = parents[index];
+		parents[index] = root;
+		index = next;
+	}
+	
+	return root;
+}
+/***********************************************************************/
+//merges the groups of the two seqs, the smaller group is put under the larger one
+void SplitMatrix::joinGroups(int indexA, int indexB){
+	int rootA = findGroup(indexA);
+	int rootB = findGroup(indexB);
+	if (rootA == rootB) { return; }
+	
+	if (groupSizes[rootA] < groupSizes[rootB]) { swap(rootA, rootB); }
+	parents[rootB] = rootA;
+	groupSizes[rootA] += groupSizes[rootB];
+}
+/***********************************************************************/
+//appends the buffered distances to the group's file and empties the buffer
+void SplitMatrix::writeDistances(string fileName, string& output){
+	try {
+		if (output.length() == 0) { return; }
+		
+		ofstream outFile;
+		outFile.open(fileName.c_str(), ios::app);
+		outFile << output;
+		outFile.close();
+		
+		output = "";
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SplitMatrix", "writeDistances");
+		exit(1);
+	}
+}
 //********************************************************************************************************************
 int SplitMatrix::splitNames(map<string, int>& seqGroup, int numGroups, vector<string>& tempDistFiles){
 	try {
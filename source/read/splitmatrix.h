@@ -35,12 +35,18 @@ class SplitMatrix  {
 		float cutoff, distCutoff;
 		bool large, classic;
 		int processors;
+		vector<int> parents, groupSizes;   //for splitDistanceLarge, the seq above each seq in its group and the size of the group each seq heads
 				
 		int splitDistance();
 		int splitClassify();
 		int splitDistanceLarge();
 		int splitDistanceRAM();
 		int splitNames(map<string, int>& groups, int, vector<string>&);
+		bool parseDistance(string&, string&, string&, string&);
+		int getSeqIndex(map<string, int>&, string&);
+		int findGroup(int);
+		void joinGroups(int, int);
+		void writeDistances(string, string&);
 		int splitDistanceFileByTax(map<string, int>&, int);
 		int createDistanceFilesFromTax(map<string, int>&, int);
         #ifdef USE_MPI
@@ -0,0 +1,206 @@
+/*
+ *  threadpool.cpp
+ *  Mothur
+ *
+ *  Copyright 2026 Schloss Lab. All rights reserved.
+ *
+ */
+
+#include "threadpool.h"
+
+/**************************************************************************************************/
+ThreadPool::ThreadPool(int processors) {
+	try {
+		m = MothurOut::getInstance();
+		unfinished = 0; queued = 0; nextQueue = 0;
+		stopping = false;
+		
+		if (processors < 1) { processors = 1; }
+		
+		for (int i = 0; i < processors; i++) { queues.push_back(new TaskQueue()); }
+		
+		//processor 0 is the thread that created the pool
+		for (int i = 1; i < processors; i++) { workers.push_back(thread(&ThreadPool::workerLoop, this, i)); }
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ThreadPool", "ThreadPool");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+ThreadPool::~ThreadPool() {
+	try {
+		wait();
+		
+		{
+			lock_guard<mutex> guard(poolLock);
+			stopping = true;
+		}
+		taskReady.notify_all();
+		
+		for (int i = 0; i < workers.size(); i++) { workers[i].join(); }
+		for (int i = 0; i < queues.size(); i++) { delete queues[i]; }
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ThreadPool", "~ThreadPool");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+void ThreadPool::submit(function<void(int)> task) {
+	try {
+		int queue;
+		{
+			lock_guard<mutex> guard(poolLock);
+			queue = nextQueue;
+			nextQueue = (nextQueue + 1) % queues.size();
+			unfinished++;
+		}
+		
+		{
+			lock_guard<mutex> guard(queues[queue]->lock);
+			queues[queue]->tasks.push_back(task);
+		}
+		
+		{
+			lock_guard<mutex> guard(poolLock);
+			queued++;
+		}
+		taskReady.notify_one();
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ThreadPool", "submit");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//takes the oldest task from processor's own queue or the newest task from another queue and runs it.
+//returns false if all the queues are empty.
+bool ThreadPool::runTask(int processor) {
+	try {
+		function<void(int)> task;
+		bool found = false;
+		
+		for (int i = 0; i < queues.size(); i++) {
+			TaskQueue* queue = queues[(processor + i) % queues.size()];
+			lock_guard<mutex> guard(queue->lock);
+			
+			if (queue->tasks.size() != 0) {
+				if (i == 0) { task = queue->tasks.front(); queue->tasks.pop_front(); }
+				else		{ task = queue->tasks.back(); queue->tasks.pop_back();	}
+				found = true;
+				break;
+			}
+		}
+		
+		if (!found) { return false; }
+		
+		{
+			lock_guard<mutex> guard(poolLock);
+			queued--;
+		}
+		
+		task(processor);
+		
+		{
+			lock_guard<mutex> guard(poolLock);
+			unfinished--;
+		}
+		taskDone.notify_all();
+		
+		return true;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ThreadPool", "runTask");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+void ThreadPool::workerLoop(int processor) {
+	try {
+		while (true) {
+			if (runTask(processor)) { continue; }
+			
+			unique_lock<mutex> guard(poolLock);
+			while (!stopping && (queued <= 0)) { taskReady.wait(guard); }
+			if (stopping && (queued <= 0)) { break; }
+		}
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ThreadPool", "workerLoop");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//the sink's output only changes when a task finishes, so checking it under poolLock does not miss the taskDone
+//notification. once nothing is unfinished every task has written, so the sink can not keep us waiting.
+void ThreadPool::waitForSlot(int maxUnfinished, OutputSink* sink) {
+	try {
+		while (true) {
+			{
+				lock_guard<mutex> guard(poolLock);
+				if ((unfinished == 0) || (numHeld(sink) < maxUnfinished)) { break; }
+			}
+			
+			if (runTask(0)) { continue; }
+			
+			//the remaining tasks are running on the other processors
+			unique_lock<mutex> guard(poolLock);
+			while ((unfinished > 0) && (numHeld(sink) >= maxUnfinished) && (queued <= 0)) { taskDone.wait(guard); }
+		}
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ThreadPool", "waitForSlot");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+void ThreadPool::wait() { waitForSlot(1); }
+/**************************************************************************************************/
+//unfinished tasks and the finished output waiting in the sink, called with poolLock held
+int ThreadPool::numHeld(OutputSink* sink) {
+	if (sink == NULL) { return unfinished; }
+	return unfinished + sink->getNumWaiting();
+}
+/**************************************************************************************************/
+OutputSink::OutputSink(vector<ostream*> f, bool r) {
+	try {
+		m = MothurOut::getInstance();
+		files = f;
+		reportProgress = r;
+		nextTask = 0; numWritten = 0;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "OutputSink", "OutputSink");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+void OutputSink::write(int task, vector<string>& output, int count) {
+	try {
+		lock_guard<mutex> guard(lock);
+		
+		if (task != nextTask) { waiting[task] = output; waitingCounts[task] = count; return; }
+		
+		for (int i = 0; i < files.size(); i++) { files[i]->write(output[i].c_str(), output[i].length()); }
+		numWritten += count; nextTask++;
+		
+		//write the tasks that were waiting on this one
+		map<int, vector<string> >::iterator it = waiting.find(nextTask);
+		while (it != waiting.end()) {
+			for (int i = 0; i < files.size(); i++) { files[i]->write((it->second)[i].c_str(), (it->second)[i].length()); }
+			numWritten += waitingCounts[nextTask];
+			
+			waiting.erase(it); waitingCounts.erase(nextTask);
+			nextTask++;
+			it = waiting.find(nextTask);
+		}
+		
+		if (reportProgress) { m->mothurOutJustToScreen(toString(numWritten) + "\n"); }
+	}
+	catch(exception& e) {
+		m->errorOut(e, "OutputSink", "write");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
@@ -0,0 +1,83 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+/*
+ *  threadpool.h
+ *  Mothur
+ *
+ *  Copyright 2026 Schloss Lab. All rights reserved.
+ *
+ */
+
+/* The ThreadPool runs a command's work on processors threads that share one copy of the command's reference data.
+ Each processor has its own queue of tasks, and when its queue is empty it takes tasks from the back of the other
+ queues, so a few slow tasks do not leave the other processors idle. The thread that submits the tasks is one of
+ the processors, and works on them while it waits.
+ 
+ The OutputSink collects the output of the tasks and writes it to the command's files in the order the tasks
+ were submitted, so the files are the same as the ones written with processors=1. Output that finished ahead of
+ the next task to write waits in the sink, so a command that reads its input in blocks passes its sink to waitForSlot
+ to bound the blocks in memory, finished or not. */
+
+#include "mothur.h"
+#include "mothurout.h"
+
+class OutputSink;
+
+/**************************************************************************************************/
+
+class ThreadPool {
+	
+public:
+	ThreadPool(int);		//number of processors, including the thread that creates the pool
+	~ThreadPool();
+	
+	void submit(function<void(int)>);	//the task is given the index of the processor running it, 0 to processors-1
+	void waitForSlot(int, OutputSink* = NULL);	//runs tasks until fewer than the given number are unfinished, counting the sink's waiting output as unfinished
+	void wait();						//runs tasks until all are finished
+	int getNumProcessors()	{ return queues.size();	}
+	
+private:
+	struct TaskQueue {
+		mutex lock;
+		deque< function<void(int)> > tasks;
+	};
+	
+	MothurOut* m;
+	vector<thread> workers;
+	vector<TaskQueue*> queues;
+	mutex poolLock;
+	condition_variable taskReady, taskDone;
+	int unfinished, queued, nextQueue;
+	bool stopping;
+	
+	bool runTask(int);
+	void workerLoop(int);
+	int numHeld(OutputSink*);
+};
+
+/**************************************************************************************************/
+
+class OutputSink {
+	
+public:
+	OutputSink(vector<ostream*>, bool);	//files, report the number of items written to the screen
+	~OutputSink() {}
+	
+	void write(int, vector<string>&, int);	//task number, output for each file, number of items in the output
+	int getNumWritten()	{ return numWritten;	}
+	int getNumWaiting()	{ lock_guard<mutex> guard(lock); return waiting.size();	}	//finished tasks not yet written
+	
+private:
+	MothurOut* m;
+	vector<ostream*> files;
+	map<int, vector<string> > waiting;	//output of tasks that finished before the tasks submitted ahead of them
+	map<int, int> waitingCounts;
+	int nextTask, numWritten;
+	bool reportProgress;
+	mutex lock;
+};
+
+/**************************************************************************************************/
+
+#endif
@@ -57,6 +57,8 @@ TrimOligos::TrimOligos(int p, int b, int l, int s, map<string, int> pr, map<stri
                 maxSpacerLength = spacer[i].length();
             }
         }
+        
+        indexOligos();
     }
     catch(exception& e) {
         m->errorOut(e, "TrimOligos", "TrimOligos");
@@ -130,6 +132,8 @@ TrimOligos::TrimOligos(int p, int b, int l, int s, map<int, oligosPair> pr, map<
         
         ipbarcodes = br;
         ipprimers = pr;
+        
+        indexOligos();
     }
     catch(exception& e) {
         m->errorOut(e, "TrimOligos", "TrimOligos");
@@ -168,6 +172,8 @@ TrimOligos::TrimOligos(int p, int b, map<string, int> pr, map<string, int> br, v
             }
         }
         maxRPrimerLength = maxFPrimerLength;
+        
+        indexOligos();
     }
     catch(exception& e) {
         m->errorOut(e, "TrimOligos", "TrimOligos");
@@ -175,7 +181,107 @@ TrimOligos::TrimOligos(int p, int b, map<string, int> pr, map<string, int> br, v
     }
 }
 /********************************************************************/
-TrimOligos::~TrimOligos() {}
+TrimOligos::~TrimOligos() { if (aligner != NULL) { delete aligner; } }
+/********************************************************************/
+//the oligos are kept in the order of their maps, so the matches are broken in the same order as before
+void TrimOligos::indexOligos(){
+    try {
+        aligner = NULL;
+        alignerLength = 0;
+        
+        vector<string> oligos;
+        for(map<string,int>::iterator it=barcodes.begin();it!=barcodes.end();it++){ oligos.push_back(it->first); }
+        barcodeIndex = OligoIndex(oligos, bdiffs);
+        
+        oligos.clear();
+        for(map<string,int>::iterator it=primers.begin();it!=primers.end();it++){ oligos.push_back(it->first); }
+        primerIndex = OligoIndex(oligos, pdiffs);
+        
+        oligos.clear();
+        for(map<string, vector<int> >::iterator it=ifbarcodes.begin();it!=ifbarcodes.end();it++){ oligos.push_back(it->first); }
+        fBarcodeIndex = OligoIndex(oligos, bdiffs);
+        
+        oligos.clear();
+        for(map<string, vector<int> >::iterator it=irbarcodes.begin();it!=irbarcodes.end();it++){ oligos.push_back(it->first); }
+        rBarcodeIndex = OligoIndex(oligos, bdiffs);
+        
+        oligos.clear();
+        for(map<string, vector<int> >::iterator it=ifprimers.begin();it!=ifprimers.end();it++){ oligos.push_back(it->first); }
+        fPrimerIndex = OligoIndex(oligos, pdiffs);
+        
+        oligos.clear();
+        for(map<string, vector<int> >::iterator it=irprimers.begin();it!=irprimers.end();it++){ oligos.push_back(it->first); }
+        rPrimerIndex = OligoIndex(oligos, pdiffs);
+        
+        //the reverse oligos of a single read are aligned to the reverse complement of its end
+        oligos.clear();
+        for(map<string, vector<int> >::iterator it=irbarcodes.begin();it!=irbarcodes.end();it++){ oligos.push_back(reverseOligo(it->first)); }
+        rcBarcodeIndex = OligoIndex(oligos, bdiffs);
+        
+        oligos.clear();
+        for(map<string, vector<int> >::iterator it=irprimers.begin();it!=irprimers.end();it++){ oligos.push_back(reverseOligo(it->first)); }
+        rcPrimerIndex = OligoIndex(oligos, pdiffs);
+    }
+    catch(exception& e) {
+        m->errorOut(e, "TrimOligos", "indexOligos");
+        exit(1);
+    }
+}
+/********************************************************************/
+//one aligner is kept for all the reads, and replaced when a longer oligo needs a bigger one
+Alignment* TrimOligos::getAligner(int length){
+    try {
+        if (length > alignerLength) {
+            if (aligner != NULL) { delete aligner; }
+            aligner = new NeedlemanOverlap(-1.0, 1.0, -1.0, length);
+            alignerLength = length;
+        }
+        return aligner;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "TrimOligos", "getAligner");
+        exit(1);
+    }
+}
+/********************************************************************/
+//the fewest diffs of any oligo in a read none of them matched, for reporting. it starts from the fewest diffs of the
+//oligos the index found, and a window is only aligned if its bound is below the fewest diffs so far
+int TrimOligos::getClosestDiffs(OligoIndex& index, string& rawSequence, int diffs, bool slide, int minDiff){
+    try {
+        Alignment* alignment = aligner;
+        for (int i = 0; i < index.getNumOligos(); i++) {
+            string prim = index.getOligo(i);
+            int numStarts = 1;
+            if (slide) { numStarts = (int)rawSequence.length() - (int)(prim.length() + diffs); }
+            
+            for (int j = 0; j < numStarts; j++) {
+                if (m->control_pressed) { return minDiff; }
+                if (index.getBound(i, rawSequence, j, minDiff) >= minDiff) { continue; }
+                
+                string oligo = prim;
+                alignment->alignPrimer(oligo, rawSequence.substr(j,oligo.length()+diffs));
+                oligo = alignment->getSeqAAln();
+                string temp = alignment->getSeqBAln();
+                
+                int alnLength = oligo.length();
+                for(int k=oligo.length()-1;k>=0;k--){ if(oligo[k] != '-'){	alnLength = k+1;	break;	} }
+                oligo = oligo.substr(0,alnLength);
+                temp = temp.substr(0,alnLength);
+                
+                int numDiff = countDiffs(oligo, temp);
+                if (alnLength == 0) { numDiff = diffs + 1000; }
+                
+                if (numDiff < minDiff) { minDiff = numDiff; }
+            }
+        }
+        
+        return minDiff;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "TrimOligos", "getClosestDiffs");
+        exit(1);
+    }
+}
 //********************************************************************/
 vector<int> TrimOligos::findForward(Sequence& seq, int& primerStart, int& primerEnd){
     try {
@@ -216,19 +322,23 @@ vector<int> TrimOligos::findForward(Sequence& seq, int& primerStart, int& primer
             int minCount = 1;
             
             Alignment* alignment;
-            if (primers.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxFPrimerLength+pdiffs+1)); }
+            if (primers.size() > 0) { alignment = getAligner(maxFPrimerLength+pdiffs+1); }
             else{ alignment = NULL; }
             
-            for(map<string,int>::iterator it=primers.begin();it!=primers.end();it++){
-                
-                string prim = it->first;
+            //only the windows the index found are aligned
+            vector< vector<int> > starts = primerIndex.getCandidateStarts(rawSequence);
+            bool skipped = false;
+            for(int c = 0; c < starts.size(); c++){
+                string prim = primerIndex.getOligo(c);
                 //search for primer
                 int olength = prim.length();
                 if (rawSequence.length() < olength+pdiffs) {} //ignore primers too long for this seq
                 else{
-                    for (int j = 0; j < rawSequence.length()-(olength+pdiffs); j++){
-                        
-                        string oligo = it->first;
+                    if (starts[c].size() < (rawSequence.length()-(olength+pdiffs))) { skipped = true; }
+                    
+                    for (int s = 0; s < starts[c].size(); s++){
+                        int j = starts[c][s];
+                        string oligo = prim;
                         
                         if (m->control_pressed) { primerStart = 0; primerEnd = 0; return success; }
                         
@@ -259,7 +369,9 @@ vector<int> TrimOligos::findForward(Sequence& seq, int& primerStart, int& primer
                 }
             }
             
-            if (alignment != NULL) { delete alignment; }
+            
+            //none of the oligos the index found were close enough, so report the closest of them all
+            if ((minDiff > pdiffs) && skipped) { minDiff = getClosestDiffs(primerIndex, rawSequence, pdiffs, true, minDiff); }
             
             if(minDiff > pdiffs)	{	primerStart = 0; primerEnd = 0; success[0] = minDiff;  success[1] = 1e6; return success;	}	//no good matches
             else if(minCount > 1)	{	primerStart = 0; primerEnd = 0; success[0] = minDiff; success[1] = pdiffs + 10000; return success;	}	//can't tell the difference between multiple primers
@@ -313,7 +425,7 @@ vector<int> TrimOligos::findReverse(Sequence& seq, int& primerStart, int& primer
         if ((pdiffs == 0) || (success[0] == 0)) { return success; }
         else { //try aligning and see if you can find it
             Alignment* alignment;
-            if (revPrimer.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxRevPrimerLength+pdiffs+1)); }
+            if (revPrimer.size() > 0) { alignment = getAligner(maxRevPrimerLength+pdiffs+1); }
             else{ alignment = NULL; }
             
             //can you find the revPrimer
@@ -365,7 +477,6 @@ vector<int> TrimOligos::findReverse(Sequence& seq, int& primerStart, int& primer
                 }
             }
             
-            if (alignment != NULL) { delete alignment; }
             
             if(minDiff > pdiffs)	{	primerStart = 0; primerEnd = 0; success[0] = minDiff;  success[1] = 1e6; return success;	}	//no good matches
             else if(minCount > 1)	{	primerStart = 0; primerEnd = 0; success[0] = minDiff; success[1] = pdiffs + 10000; return success;	}	//can't tell the difference between multiple primers
@@ -437,7 +548,7 @@ vector<int> TrimOligos::stripBarcode(Sequence& seq, QualityScores& qual, int& gr
         
         else { //try aligning and see if you can find it
             Alignment* alignment;
-            if (barcodes.size() > 0) {alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxFBarcodeLength+bdiffs+1)); }
+            if (barcodes.size() > 0) {alignment = getAligner(maxFBarcodeLength+bdiffs+1); }
             else{ alignment = NULL; }
             
             //can you find the barcode
@@ -446,7 +557,9 @@ vector<int> TrimOligos::stripBarcode(Sequence& seq, QualityScores& qual, int& gr
             int minGroup = -1;
             int minPos = 0;
             
-            for(map<string,int>::iterator it=barcodes.begin();it!=barcodes.end();it++){
+            vector<int> candidates = barcodeIndex.getCandidates(rawSequence);
+            for(int c = 0; c < candidates.size(); c++){
+                map<string,int>::iterator it = barcodes.find(barcodeIndex.getOligo(candidates[c]));
                 string oligo = it->first;
                 // int length = oligo.length();
                 
@@ -489,6 +602,9 @@ vector<int> TrimOligos::stripBarcode(Sequence& seq, QualityScores& qual, int& gr
                 
             }
             
+            //none of the oligos the index found were close enough, so report the closest of them all
+            if ((minDiff > bdiffs) && (candidates.size() < barcodes.size()) && (rawSequence.length() >= maxFBarcodeLength)) { minDiff = getClosestDiffs(barcodeIndex, rawSequence, bdiffs, false, minDiff); }
+            
             if(minDiff > bdiffs)	{	success[0] = minDiff;  success[1] = 1e6;	}	//no good matches
             else if(minCount > 1)	{	success[0] = minDiff; success[1] = bdiffs + 10000;	}	//can't tell the difference between multiple barcodes
             else{	//use the best match
@@ -501,7 +617,6 @@ vector<int> TrimOligos::stripBarcode(Sequence& seq, QualityScores& qual, int& gr
                 success[0] = minDiff; success[1] = 0;
             }
             
-            if (alignment != NULL) { delete alignment; }
             
         }
         
@@ -554,7 +669,7 @@ vector<int> TrimOligos::stripBarcode(Sequence& forwardSeq, Sequence& reverseSeq,
         if ((bdiffs == 0) || (success[0] == 0)) { return success; }
         else { //try aligning and see if you can find it
             Alignment* alignment;
-            if (ifbarcodes.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxFBarcodeLength+bdiffs+1)); }
+            if (ifbarcodes.size() > 0) { alignment = getAligner(maxFBarcodeLength+bdiffs+1); }
             else{ alignment = NULL; }
             
             //can you find the barcode
@@ -577,7 +692,9 @@ vector<int> TrimOligos::stripBarcode(Sequence& forwardSeq, Sequence& reverseSeq,
              but if best match forward = 4, and reverse = 1, we want to count as a valid match because forward 1 and forward 4 are the same. so both barcodes map to same group.
              */
             //cout << endl << forwardSeq.getName() << endl;
-            for(map<string, vector<int> >::iterator it=ifbarcodes.begin();it!=ifbarcodes.end();it++){
+            vector<int> candidates = fBarcodeIndex.getCandidates(rawFSequence);
+            for(int c = 0; c < candidates.size(); c++){
+                map<string, vector<int> >::iterator it = ifbarcodes.find(fBarcodeIndex.getOligo(candidates[c]));
                 string oligo = it->first;
                 
                 if(rawFSequence.length() < maxFBarcodeLength){	//let's just assume that the barcodes are the same length
@@ -629,14 +746,16 @@ vector<int> TrimOligos::stripBarcode(Sequence& forwardSeq, Sequence& reverseSeq,
             }
             
             //cout << minDiff << '\t' << minCount << '\t' << endl;
+            //none of the oligos the index found were close enough, so report the closest of them all
+            if ((minDiff > bdiffs) && (candidates.size() < ifbarcodes.size()) && (rawFSequence.length() >= maxFBarcodeLength)) { minDiff = getClosestDiffs(fBarcodeIndex, rawFSequence, bdiffs, false, minDiff); }
+            
             if(minDiff > bdiffs)	{	success[0] = minDiff;  success[1] = 1e6;	}	//no good matches
             else{
                 success[0] = minDiff;
                 
                 //check for reverse match
-                if (alignment != NULL) { delete alignment; }
                 
-                if (irbarcodes.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxRBarcodeLength+bdiffs+1)); }
+                if (irbarcodes.size() > 0) { alignment = getAligner(maxRBarcodeLength+bdiffs+1); }
                 else{ alignment = NULL; }
                 
                 //can you find the barcode
@@ -645,7 +764,9 @@ vector<int> TrimOligos::stripBarcode(Sequence& forwardSeq, Sequence& reverseSeq,
                 vector< vector<int> > minRGroup;
                 vector<int> minRPos;
                 
-                for(map<string, vector<int> >::iterator it=irbarcodes.begin();it!=irbarcodes.end();it++){
+                vector<int> candidates = rBarcodeIndex.getCandidates(rawRSequence);
+                for(int c = 0; c < candidates.size(); c++){
+                    map<string, vector<int> >::iterator it = irbarcodes.find(rBarcodeIndex.getOligo(candidates[c]));
                     string oligo = it->first;
                     //cout << "before = " << oligo << '\t' << rawRSequence.substr(0,oligo.length()+bdiffs) << endl;
                     if(rawRSequence.length() < maxRBarcodeLength){	//let's just assume that the barcodes are the same length
@@ -696,6 +817,9 @@ vector<int> TrimOligos::stripBarcode(Sequence& forwardSeq, Sequence& reverseSeq,
                     
                 }
                 
+                //none of the oligos the index found were close enough, so report the closest of them all
+                if ((minDiff > bdiffs) && (candidates.size() < irbarcodes.size()) && (rawRSequence.length() >= maxRBarcodeLength)) { minDiff = getClosestDiffs(rBarcodeIndex, rawRSequence, bdiffs, false, minDiff); }
+                
                 if(minDiff > bdiffs)	{	success[2] = minDiff;  success[3] = 1e6;	}	//no good matches
                 else {
                     bool foundMatch = false;
@@ -726,7 +850,6 @@ vector<int> TrimOligos::stripBarcode(Sequence& forwardSeq, Sequence& reverseSeq,
                 }
             }
             
-            if (alignment != NULL) { delete alignment; }
         }
         
         return success;
@@ -785,7 +908,7 @@ vector<int> TrimOligos::stripBarcode(Sequence& forwardSeq, Sequence& reverseSeq,
         if ((bdiffs == 0) || (success[0] == 0)) { return success; }
         else { //try aligning and see if you can find it
             Alignment* alignment;
-            if (ifbarcodes.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxFBarcodeLength+bdiffs+1)); }
+            if (ifbarcodes.size() > 0) { alignment = getAligner(maxFBarcodeLength+bdiffs+1); }
             else{ alignment = NULL; }
             
             //can you find the barcode
@@ -808,7 +931,9 @@ vector<int> TrimOligos::stripBarcode(Sequence& forwardSeq, Sequence& reverseSeq,
              but if best match forward = 4, and reverse = 1, we want to count as a valid match because forward 1 and forward 4 are the same. so both barcodes map to same group.
              */
             //cout << endl << forwardSeq.getName() << endl;
-            for(map<string, vector<int> >::iterator it=ifbarcodes.begin();it!=ifbarcodes.end();it++){
+            vector<int> candidates = fBarcodeIndex.getCandidates(rawFSequence);
+            for(int c = 0; c < candidates.size(); c++){
+                map<string, vector<int> >::iterator it = ifbarcodes.find(fBarcodeIndex.getOligo(candidates[c]));
                 string oligo = it->first;
                 
                 if(rawFSequence.length() < maxFBarcodeLength){	//let's just assume that the barcodes are the same length
@@ -858,14 +983,16 @@ vector<int> TrimOligos::stripBarcode(Sequence& forwardSeq, Sequence& reverseSeq,
             }
             
             //cout << minDiff << '\t' << minCount << '\t' << endl;
+            //none of the oligos the index found were close enough, so report the closest of them all
+            if ((minDiff > bdiffs) && (candidates.size() < ifbarcodes.size()) && (rawFSequence.length() >= maxFBarcodeLength)) { minDiff = getClosestDiffs(fBarcodeIndex, rawFSequence, bdiffs, false, minDiff); }
+            
             if(minDiff > bdiffs)	{	success[0] = minDiff;  success[1] = 1e6;	}	//no good matches
             else{
                 success[0] = minDiff; //set forward barcode diffs
                 
                 //check for reverse match
-                if (alignment != NULL) { delete alignment; }
                 
-                if (irbarcodes.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxRBarcodeLength+bdiffs+1)); }
+                if (irbarcodes.size() > 0) { alignment = getAligner(maxRBarcodeLength+bdiffs+1); }
                 else{ alignment = NULL; }
                 
                 //can you find the barcode
@@ -874,7 +1001,9 @@ vector<int> TrimOligos::stripBarcode(Sequence& forwardSeq, Sequence& reverseSeq,
                 vector< vector<int> > minRGroup;
                 vector<int> minRPos;
                 
-                for(map<string, vector<int> >::iterator it=irbarcodes.begin();it!=irbarcodes.end();it++){
+                vector<int> candidates = rBarcodeIndex.getCandidates(rawRSequence);
+                for(int c = 0; c < candidates.size(); c++){
+                    map<string, vector<int> >::iterator it = irbarcodes.find(rBarcodeIndex.getOligo(candidates[c]));
                     string oligo = it->first;
                     //cout << "before = " << oligo << '\t' << rawRSequence.substr(0,oligo.length()+bdiffs) << endl;
                     if(rawRSequence.length() < maxRBarcodeLength){	//let's just assume that the barcodes are the same length
@@ -924,6 +1053,9 @@ vector<int> TrimOligos::stripBarcode(Sequence& forwardSeq, Sequence& reverseSeq,
                     
                 }
                 
+                //none of the oligos the index found were close enough, so report the closest of them all
+                if ((minDiff > bdiffs) && (candidates.size() < irbarcodes.size()) && (rawRSequence.length() >= maxRBarcodeLength)) { minDiff = getClosestDiffs(rBarcodeIndex, rawRSequence, bdiffs, false, minDiff); }
+                
                 if(minDiff > bdiffs)	{	success[2] = minDiff;  success[3] = 1e6;	}	//no good matches
                 else {
                     bool foundMatch = false;
@@ -958,7 +1090,6 @@ vector<int> TrimOligos::stripBarcode(Sequence& forwardSeq, Sequence& reverseSeq,
                 }
             }
             
-            if (alignment != NULL) { delete alignment; }
         }
         
         return success;
@@ -1027,7 +1158,7 @@ vector<int> TrimOligos::stripPairedBarcode(Sequence& seq, QualityScores& qual, i
         if ((bdiffs == 0) || (success[0] == 0)) { return success; }
         else { //try aligning and see if you can find it
             Alignment* alignment;
-            if (ifbarcodes.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxFBarcodeLength+bdiffs+1)); }
+            if (ifbarcodes.size() > 0) { alignment = getAligner(maxFBarcodeLength+bdiffs+1); }
             else{ alignment = NULL; }
             
             //can you find the barcode
@@ -1050,7 +1181,9 @@ vector<int> TrimOligos::stripPairedBarcode(Sequence& seq, QualityScores& qual, i
              but if best match forward = 4, and reverse = 1, we want to count as a valid match because forward 1 and forward 4 are the same. so both barcodes map to same group.
              */
             //cout << endl << seq.getName() << endl;
-            for(map<string, vector<int> >::iterator it=ifbarcodes.begin();it!=ifbarcodes.end();it++){
+            vector<int> candidates = fBarcodeIndex.getCandidates(rawSeq);
+            for(int c = 0; c < candidates.size(); c++){
+                map<string, vector<int> >::iterator it = ifbarcodes.find(fBarcodeIndex.getOligo(candidates[c]));
                 string oligo = it->first;
                 
                 if(rawSeq.length() < maxFBarcodeLength){	//let's just assume that the barcodes are the same length
@@ -1099,18 +1232,20 @@ vector<int> TrimOligos::stripPairedBarcode(Sequence& seq, QualityScores& qual, i
                 }
             }
             
+            //none of the oligos the index found were close enough, so report the closest of them all
+            if ((minDiff > bdiffs) && (candidates.size() < ifbarcodes.size()) && (rawSeq.length() >= maxFBarcodeLength)) { minDiff = getClosestDiffs(fBarcodeIndex, rawSeq, bdiffs, false, minDiff); }
             fMinDiff = minDiff;
             
            
             //cout << minDiff << '\t' << minCount << '\t' << endl;
+            
             if(minDiff > bdiffs)	{	success[0] = minDiff;  success[1] = 1e6;	}	//no good matches
             else{
                 success[0] = minDiff; //set forward barcode diffs
                 
                 //check for reverse match
-                if (alignment != NULL) { delete alignment; }
                 
-                if (irbarcodes.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxRBarcodeLength+bdiffs+1)); }
+                if (irbarcodes.size() > 0) { alignment = getAligner(maxRBarcodeLength+bdiffs+1); }
                 else{ alignment = NULL; }
                 
                 //can you find the barcode
@@ -1121,7 +1256,9 @@ vector<int> TrimOligos::stripPairedBarcode(Sequence& seq, QualityScores& qual, i
                 
                 string rawRSequence = reverseOligo(seq.getUnaligned());
                 //cout << irbarcodes.size() << '\t' << maxRBarcodeLength << endl;
-                for(map<string, vector<int> >::iterator it=irbarcodes.begin();it!=irbarcodes.end();it++){
+                vector<int> candidates = rcBarcodeIndex.getCandidates(rawRSequence);
+                for(int c = 0; c < candidates.size(); c++){
+                    map<string, vector<int> >::iterator it = irbarcodes.find(rBarcodeIndex.getOligo(candidates[c]));
                     string oligo = reverseOligo(it->first);
                     //cout << "r before = " << reverseOligo(oligo) << '\t' << reverseOligo(rawRSequence.substr(0,oligo.length()+bdiffs)) << endl;
                     if(rawRSequence.length() < maxRBarcodeLength){	//let's just assume that the barcodes are the same length
@@ -1172,6 +1309,9 @@ vector<int> TrimOligos::stripPairedBarcode(Sequence& seq, QualityScores& qual, i
 
             
 
+                //none of the oligos the index found were close enough, so report the closest of them all
+                if ((minDiff > bdiffs) && (candidates.size() < irbarcodes.size()) && (rawRSequence.length() >= maxRBarcodeLength)) { minDiff = getClosestDiffs(rcBarcodeIndex, rawRSequence, bdiffs, false, minDiff); }
+                
                 if(minDiff > bdiffs)	{	success[2] = minDiff;  success[3] = 1e6;	}	//no good matches
                 else {
                     bool foundMatch = false;
@@ -1209,7 +1349,6 @@ vector<int> TrimOligos::stripPairedBarcode(Sequence& seq, QualityScores& qual, i
             }
             rMinDiff = minDiff;
 
-            if (alignment != NULL) { delete alignment; }
         }
         
 //        cout << "\nbcode:\t" << fMinDiff << '\t' << rMinDiff << endl;
@@ -1283,7 +1422,7 @@ vector<int> TrimOligos::stripPairedPrimers(Sequence& seq, QualityScores& qual, i
         if ((pdiffs == 0) || (success[0] == 0)) { return success; }
         else { //try aligning and see if you can find it
             Alignment* alignment;
-            if (ifprimers.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxFPrimerLength+pdiffs+1)); }
+            if (ifprimers.size() > 0) { alignment = getAligner(maxFPrimerLength+pdiffs+1); }
             else{ alignment = NULL; }
             
             //can you find the barcode
@@ -1306,7 +1445,9 @@ vector<int> TrimOligos::stripPairedPrimers(Sequence& seq, QualityScores& qual, i
              but if best match forward = 4, and reverse = 1, we want to count as a valid match because forward 1 and forward 4 are the same. so both barcodes map to same group.
              */
             //cout << endl << forwardSeq.getName() << endl;
-            for(map<string, vector<int> >::iterator it=ifprimers.begin();it!=ifprimers.end();it++){
+            vector<int> candidates = fPrimerIndex.getCandidates(rawSeq);
+            for(int c = 0; c < candidates.size(); c++){
+                map<string, vector<int> >::iterator it = ifprimers.find(fPrimerIndex.getOligo(candidates[c]));
                 string oligo = it->first;
                 
                 if(rawSeq.length() < maxFPrimerLength){	//let's just assume that the barcodes are the same length
@@ -1360,17 +1501,19 @@ vector<int> TrimOligos::stripPairedPrimers(Sequence& seq, QualityScores& qual, i
                 }
             }
             
+            //none of the oligos the index found were close enough, so report the closest of them all
+            if ((minDiff > pdiffs) && (candidates.size() < ifprimers.size()) && (rawSeq.length() >= maxFPrimerLength)) { minDiff = getClosestDiffs(fPrimerIndex, rawSeq, pdiffs, false, minDiff); }
             fMinDiff = minDiff;
 
             //cout << minDiff << '\t' << minCount << '\t' << endl;
+            
             if(minDiff > pdiffs)	{	success[0] = minDiff;  success[1] = 1e6;	}	//no good matches
             else{
                 success[0] = minDiff; //set forward primer diffs
                 
                 //check for reverse match
-                if (alignment != NULL) { delete alignment; }
                 
-                if (irprimers.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxRPrimerLength+pdiffs+1)); }
+                if (irprimers.size() > 0) { alignment = getAligner(maxRPrimerLength+pdiffs+1); }
                 else{ alignment = NULL; }
                 
                 //can you find the barcode
@@ -1381,7 +1524,9 @@ vector<int> TrimOligos::stripPairedPrimers(Sequence& seq, QualityScores& qual, i
                 
                 string rawRSequence = reverseOligo(seq.getUnaligned());
                 
-                for(map<string, vector<int> >::iterator it=irprimers.begin();it!=irprimers.end();it++){
+                vector<int> candidates = rcPrimerIndex.getCandidates(rawRSequence);
+                for(int c = 0; c < candidates.size(); c++){
+                    map<string, vector<int> >::iterator it = irprimers.find(rPrimerIndex.getOligo(candidates[c]));
                     string oligo = reverseOligo(it->first);
                     //cout << "r before = " << reverseOligo(oligo) << '\t' << reverseOligo(rawRSequence.substr(0,oligo.length()+pdiffs)) << endl;
                     if(rawRSequence.length() < maxRPrimerLength){	//let's just assume that the barcodes are the same length
@@ -1434,6 +1579,9 @@ vector<int> TrimOligos::stripPairedPrimers(Sequence& seq, QualityScores& qual, i
                     
                 }
             
+                //none of the oligos the index found were close enough, so report the closest of them all
+                if ((minDiff > pdiffs) && (candidates.size() < irprimers.size()) && (rawRSequence.length() >= maxRPrimerLength)) { minDiff = getClosestDiffs(rcPrimerIndex, rawRSequence, pdiffs, false, minDiff); }
+                
                 if(minDiff > pdiffs)	{	success[2] = minDiff;  success[3] = 1e6;	}	//no good matches
                 else {
                     bool foundMatch = false;
@@ -1474,7 +1622,6 @@ vector<int> TrimOligos::stripPairedPrimers(Sequence& seq, QualityScores& qual, i
 
             rMinDiff = minDiff;
             
-            if (alignment != NULL) { delete alignment; }
         }
         
 //        cout << "\nalign:\t" << fMinDiff << '\t' << rMinDiff << endl;
@@ -1533,7 +1680,7 @@ vector<int> TrimOligos::stripForward(Sequence& forwardSeq, Sequence& reverseSeq,
         if ((pdiffs == 0) || (success[0] == 0)) { return success; }
         else { //try aligning and see if you can find it
             Alignment* alignment;
-            if (ifprimers.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxFPrimerLength+pdiffs+1)); }
+            if (ifprimers.size() > 0) { alignment = getAligner(maxFPrimerLength+pdiffs+1); }
             else{ alignment = NULL; }
             
             //can you find the barcode
@@ -1556,7 +1703,9 @@ vector<int> TrimOligos::stripForward(Sequence& forwardSeq, Sequence& reverseSeq,
              but if best match forward = 4, and reverse = 1, we want to count as a valid match because forward 1 and forward 4 are the same. so both barcodes map to same group.
              */
             //cout << endl << forwardSeq.getName() << endl;
-            for(map<string, vector<int> >::iterator it=ifprimers.begin();it!=ifprimers.end();it++){
+            vector<int> candidates = fPrimerIndex.getCandidates(rawFSequence);
+            for(int c = 0; c < candidates.size(); c++){
+                map<string, vector<int> >::iterator it = ifprimers.find(fPrimerIndex.getOligo(candidates[c]));
                 string oligo = it->first;
                 
                 if(rawFSequence.length() < maxFPrimerLength){	//let's just assume that the barcodes are the same length
@@ -1608,14 +1757,16 @@ vector<int> TrimOligos::stripForward(Sequence& forwardSeq, Sequence& reverseSeq,
             }
             
             //cout << minDiff << '\t' << minCount << '\t' << endl;
+            //none of the oligos the index found were close enough, so report the closest of them all
+            if ((minDiff > pdiffs) && (candidates.size() < ifprimers.size()) && (rawFSequence.length() >= maxFPrimerLength)) { minDiff = getClosestDiffs(fPrimerIndex, rawFSequence, pdiffs, false, minDiff); }
+            
             if(minDiff > pdiffs)	{	success[0] = minDiff;  success[1] = 1e6;	}	//no good matches
             else{
                 success[0] = minDiff; //set forward primer diffs
                 
                 //check for reverse match
-                if (alignment != NULL) { delete alignment; }
                 
-                if (irbarcodes.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxRPrimerLength+pdiffs+1)); }
+                if (irbarcodes.size() > 0) { alignment = getAligner(maxRPrimerLength+pdiffs+1); }
                 else{ alignment = NULL; }
                 
                 //can you find the barcode
@@ -1624,7 +1775,9 @@ vector<int> TrimOligos::stripForward(Sequence& forwardSeq, Sequence& reverseSeq,
                 vector< vector<int> > minRGroup;
                 vector<int> minRPos;
                 
-                for(map<string, vector<int> >::iterator it=irprimers.begin();it!=irprimers.end();it++){
+                vector<int> candidates = rPrimerIndex.getCandidates(rawRSequence);
+                for(int c = 0; c < candidates.size(); c++){
+                    map<string, vector<int> >::iterator it = irprimers.find(rPrimerIndex.getOligo(candidates[c]));
                     string oligo = it->first;
                     //cout << "before = " << oligo << '\t' << rawRSequence.substr(0,oligo.length()+pdiffs) << endl;
                     if(rawRSequence.length() < maxRPrimerLength){	//let's just assume that the barcodes are the same length
@@ -1674,6 +1827,9 @@ vector<int> TrimOligos::stripForward(Sequence& forwardSeq, Sequence& reverseSeq,
                     
                 }
                 
+                //none of the oligos the index found were close enough, so report the closest of them all
+                if ((minDiff > pdiffs) && (candidates.size() < irprimers.size()) && (rawRSequence.length() >= maxRPrimerLength)) { minDiff = getClosestDiffs(rPrimerIndex, rawRSequence, pdiffs, false, minDiff); }
+                
                 if(minDiff > pdiffs)	{	success[2] = minDiff;  success[3] = 1e6;	}	//no good matches
                 else {
                     bool foundMatch = false;
@@ -1707,7 +1863,6 @@ vector<int> TrimOligos::stripForward(Sequence& forwardSeq, Sequence& reverseSeq,
                 }
             }
             
-            if (alignment != NULL) { delete alignment; }
         }
         
         return success;
@@ -1761,7 +1916,7 @@ vector<int> TrimOligos::stripForward(Sequence& forwardSeq, Sequence& reverseSeq,
         if ((pdiffs == 0) || (success[0] == 0)) { return success; }
         else { //try aligning and see if you can find it
             Alignment* alignment;
-            if (ifprimers.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxFPrimerLength+pdiffs+1)); }
+            if (ifprimers.size() > 0) { alignment = getAligner(maxFPrimerLength+pdiffs+1); }
             else{ alignment = NULL; }
             
             //can you find the barcode
@@ -1784,7 +1939,9 @@ vector<int> TrimOligos::stripForward(Sequence& forwardSeq, Sequence& reverseSeq,
              but if best match forward = 4, and reverse = 1, we want to count as a valid match because forward 1 and forward 4 are the same. so both barcodes map to same group.
              */
             //cout << endl << forwardSeq.getName() << endl;
-            for(map<string, vector<int> >::iterator it=ifprimers.begin();it!=ifprimers.end();it++){
+            vector<int> candidates = fPrimerIndex.getCandidates(rawFSequence);
+            for(int c = 0; c < candidates.size(); c++){
+                map<string, vector<int> >::iterator it = ifprimers.find(fPrimerIndex.getOligo(candidates[c]));
                 string oligo = it->first;
                 
                 if(rawFSequence.length() < maxFPrimerLength){	//let's just assume that the barcodes are the same length
@@ -1836,14 +1993,16 @@ vector<int> TrimOligos::stripForward(Sequence& forwardSeq, Sequence& reverseSeq,
             }
             
             //cout << minDiff << '\t' << minCount << '\t' << endl;
+            //none of the oligos the index found were close enough, so report the closest of them all
+            if ((minDiff > pdiffs) && (candidates.size() < ifprimers.size()) && (rawFSequence.length() >= maxFPrimerLength)) { minDiff = getClosestDiffs(fPrimerIndex, rawFSequence, pdiffs, false, minDiff); }
+            
             if(minDiff > pdiffs)	{	success[0] = minDiff;  success[1] = 1e6;	}	//no good matches
             else{
                 success[0] = minDiff; //set forward primer diffs
                 
                 //check for reverse match
-                if (alignment != NULL) { delete alignment; }
                 
-                if (irbarcodes.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxRPrimerLength+pdiffs+1)); }
+                if (irbarcodes.size() > 0) { alignment = getAligner(maxRPrimerLength+pdiffs+1); }
                 else{ alignment = NULL; }
                 
                 //can you find the barcode
@@ -1852,7 +2011,9 @@ vector<int> TrimOligos::stripForward(Sequence& forwardSeq, Sequence& reverseSeq,
                 vector< vector<int> > minRGroup;
                 vector<int> minRPos;
                 
-                for(map<string, vector<int> >::iterator it=irprimers.begin();it!=irprimers.end();it++){
+                vector<int> candidates = rPrimerIndex.getCandidates(rawRSequence);
+                for(int c = 0; c < candidates.size(); c++){
+                    map<string, vector<int> >::iterator it = irprimers.find(rPrimerIndex.getOligo(candidates[c]));
                     string oligo = it->first;
                     //cout << "before = " << oligo << '\t' << rawRSequence.substr(0,oligo.length()+pdiffs) << endl;
                     if(rawRSequence.length() < maxRPrimerLength){	//let's just assume that the barcodes are the same length
@@ -1903,6 +2064,9 @@ vector<int> TrimOligos::stripForward(Sequence& forwardSeq, Sequence& reverseSeq,
                     
                 }
                 
+                //none of the oligos the index found were close enough, so report the closest of them all
+                if ((minDiff > pdiffs) && (candidates.size() < irprimers.size()) && (rawRSequence.length() >= maxRPrimerLength)) { minDiff = getClosestDiffs(rPrimerIndex, rawRSequence, pdiffs, false, minDiff); }
+                
                 if(minDiff > pdiffs)	{	success[2] = minDiff;  success[3] = 1e6;	}	//no good matches
                 else {
                     bool foundMatch = false;
@@ -1933,7 +2097,6 @@ vector<int> TrimOligos::stripForward(Sequence& forwardSeq, Sequence& reverseSeq,
                 }
             }
             
-            if (alignment != NULL) { delete alignment; }
         }
         
         return success;
@@ -1977,7 +2140,7 @@ vector<int> TrimOligos::stripBarcode(Sequence& seq, int& group){
         
         else { //try aligning and see if you can find it
             Alignment* alignment;
-            if (barcodes.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxFBarcodeLength+bdiffs+1)); }
+            if (barcodes.size() > 0) { alignment = getAligner(maxFBarcodeLength+bdiffs+1); }
             else{ alignment = NULL; }
             
             //can you find the barcode
@@ -1986,7 +2149,9 @@ vector<int> TrimOligos::stripBarcode(Sequence& seq, int& group){
             int minGroup = -1;
             int minPos = 0;
             
-            for(map<string,int>::iterator it=barcodes.begin();it!=barcodes.end();it++){
+            vector<int> candidates = barcodeIndex.getCandidates(rawSequence);
+            for(int c = 0; c < candidates.size(); c++){
+                map<string,int>::iterator it = barcodes.find(barcodeIndex.getOligo(candidates[c]));
                 string oligo = it->first;
                 // int length = oligo.length();
                 
@@ -2030,6 +2195,9 @@ vector<int> TrimOligos::stripBarcode(Sequence& seq, int& group){
                 
             }
             
+            //none of the oligos the index found were close enough, so report the closest of them all
+            if ((minDiff > bdiffs) && (candidates.size() < barcodes.size()) && (rawSequence.length() >= maxFBarcodeLength)) { minDiff = getClosestDiffs(barcodeIndex, rawSequence, bdiffs, false, minDiff); }
+            
             if(minDiff > bdiffs)	{	success[0] = minDiff;  success[1] = 1e6;	}	//no good matches
             else if(minCount > 1)	{	success[0] = minDiff; success[1] = bdiffs + 10000;	}	//can't tell the difference between multiple barcodes
             else{	//use the best match
@@ -2038,7 +2206,6 @@ vector<int> TrimOligos::stripBarcode(Sequence& seq, int& group){
                 success[0] = minDiff; success[1] = 0;
             }
             
-            if (alignment != NULL) { delete alignment; }
             
         }
         
@@ -2083,7 +2250,7 @@ vector<int> TrimOligos::stripForward(Sequence& seq, int& group){
         
         else { //try aligning and see if you can find it
             Alignment* alignment;
-            if (primers.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxFPrimerLength+pdiffs+1)); }
+            if (primers.size() > 0) { alignment = getAligner(maxFPrimerLength+pdiffs+1); }
             else{ alignment = NULL; }
             
             //can you find the barcode
@@ -2092,7 +2259,9 @@ vector<int> TrimOligos::stripForward(Sequence& seq, int& group){
             int minGroup = -1;
             int minPos = 0;
             
-            for(map<string,int>::iterator it=primers.begin();it!=primers.end();it++){
+            vector<int> candidates = primerIndex.getCandidates(rawSequence);
+            for(int c = 0; c < candidates.size(); c++){
+                map<string,int>::iterator it = primers.find(primerIndex.getOligo(candidates[c]));
                 string oligo = it->first;
                 // int length = oligo.length();
                 
@@ -2134,6 +2303,9 @@ vector<int> TrimOligos::stripForward(Sequence& seq, int& group){
                 
             }
             
+            //none of the oligos the index found were close enough, so report the closest of them all
+            if ((minDiff > pdiffs) && (candidates.size() < primers.size()) && (rawSequence.length() >= maxFPrimerLength)) { minDiff = getClosestDiffs(primerIndex, rawSequence, pdiffs, false, minDiff); }
+            
             if(minDiff > pdiffs)	{	success[0] = minDiff;  success[1] = 1e6;	}	//no good matches
             else if(minCount > 1)	{	success[0] = minDiff; success[1] = pdiffs + 10000;	}	//can't tell the difference between multiple primers
             else{	//use the best match
@@ -2142,7 +2314,6 @@ vector<int> TrimOligos::stripForward(Sequence& seq, int& group){
                 success[0] = minDiff; success[1] = 0;
             }
             
-            if (alignment != NULL) { delete alignment; }
             
         }
         
@@ -2192,7 +2363,7 @@ vector<int> TrimOligos::stripForward(Sequence& seq, QualityScores& qual, int& gr
         
         else { //try aligning and see if you can find it
             Alignment* alignment;
-            if (primers.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxFPrimerLength+pdiffs+1)); }
+            if (primers.size() > 0) { alignment = getAligner(maxFPrimerLength+pdiffs+1); }
             else{ alignment = NULL; }
             
             //can you find the barcode
@@ -2201,7 +2372,9 @@ vector<int> TrimOligos::stripForward(Sequence& seq, QualityScores& qual, int& gr
             int minGroup = -1;
             int minPos = 0;
             
-            for(map<string,int>::iterator it=primers.begin();it!=primers.end();it++){
+            vector<int> candidates = primerIndex.getCandidates(rawSequence);
+            for(int c = 0; c < candidates.size(); c++){
+                map<string,int>::iterator it = primers.find(primerIndex.getOligo(candidates[c]));
                 string oligo = it->first;
                 // int length = oligo.length();
                 
@@ -2243,6 +2416,9 @@ vector<int> TrimOligos::stripForward(Sequence& seq, QualityScores& qual, int& gr
                 
             }
             
+            //none of the oligos the index found were close enough, so report the closest of them all
+            if ((minDiff > pdiffs) && (candidates.size() < primers.size()) && (rawSequence.length() >= maxFPrimerLength)) { minDiff = getClosestDiffs(primerIndex, rawSequence, pdiffs, false, minDiff); }
+            
             if(minDiff > pdiffs)	{	success[0] = minDiff;  success[1] = 1e6;	}	//no good matches
             else if(minCount > 1)	{	success[0] = minDiff; success[1] = pdiffs + 10000;	}//no good matches
             else{	//use the best match
@@ -2254,7 +2430,6 @@ vector<int> TrimOligos::stripForward(Sequence& seq, QualityScores& qual, int& gr
                 success[0] = minDiff; success[1] = 0;
             }
             
-            if (alignment != NULL) { delete alignment; }
             
         }
         
@@ -2301,7 +2476,7 @@ vector<int> TrimOligos::stripReverse(Sequence& seq, QualityScores& qual){
         
         else { //try aligning and see if you can find it
             Alignment* alignment;
-            if (revPrimer.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxRevPrimerLength+pdiffs+1)); }
+            if (revPrimer.size() > 0) { alignment = getAligner(maxRevPrimerLength+pdiffs+1); }
             else{ alignment = NULL; }
         
             //can you find the revPrimer
@@ -2363,7 +2538,6 @@ vector<int> TrimOligos::stripReverse(Sequence& seq, QualityScores& qual){
                 success[0] = minDiff; success[1] = 0;
             }
             
-            if (alignment != NULL) { delete alignment; }
             
         }
     
@@ -2410,7 +2584,7 @@ vector<int> TrimOligos::stripReverse(Sequence& seq){
         
         else { //try aligning and see if you can find it
             Alignment* alignment;
-            if (revPrimer.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxRevPrimerLength+pdiffs+1)); }
+            if (revPrimer.size() > 0) { alignment = getAligner(maxRevPrimerLength+pdiffs+1); }
             else{ alignment = NULL; }
             
             //can you find the revPrimer
@@ -2469,7 +2643,6 @@ vector<int> TrimOligos::stripReverse(Sequence& seq){
                 success[0] = minDiff; success[1] = 0;
             }
             
-            if (alignment != NULL) { delete alignment; }
             
         }
         
@@ -2511,7 +2684,7 @@ bool TrimOligos::stripLinker(Sequence& seq, QualityScores& qual){
         
         else { //try aligning and see if you can find it
             Alignment* alignment;
-            if (linker.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxLinkerLength+ldiffs+1)); }	
+            if (linker.size() > 0) { alignment = getAligner(maxLinkerLength+ldiffs+1); }	
             else{ alignment = NULL; }
             
             //can you find the barcode
@@ -2570,7 +2743,6 @@ bool TrimOligos::stripLinker(Sequence& seq, QualityScores& qual){
                 success = minDiff;
             }
             
-            if (alignment != NULL) { delete alignment; }
             
         }
         
@@ -2610,7 +2782,7 @@ bool TrimOligos::stripLinker(Sequence& seq){
         
         else { //try aligning and see if you can find it
             Alignment* alignment;
-            if (linker.size() > 0) {alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxLinkerLength+ldiffs+1)); }
+            if (linker.size() > 0) {alignment = getAligner(maxLinkerLength+ldiffs+1); }
             else{ alignment = NULL; }
             
             //can you find the barcode
@@ -2665,7 +2837,6 @@ bool TrimOligos::stripLinker(Sequence& seq){
                 success = minDiff;
             }
             
-            if (alignment != NULL) { delete alignment; }
             
         }
         
@@ -2707,7 +2878,7 @@ bool TrimOligos::stripSpacer(Sequence& seq, QualityScores& qual){
         
         else { //try aligning and see if you can find it
             Alignment* alignment;
-            if (spacer.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxSpacerLength+sdiffs+1)); }
+            if (spacer.size() > 0) { alignment = getAligner(maxSpacerLength+sdiffs+1); }
             else{ alignment = NULL; }
             
             //can you find the barcode
@@ -2766,7 +2937,6 @@ bool TrimOligos::stripSpacer(Sequence& seq, QualityScores& qual){
                 success = minDiff;
             }
             
-            if (alignment != NULL) { delete alignment; }
             
         }
         
@@ -2806,7 +2976,7 @@ bool TrimOligos::stripSpacer(Sequence& seq){
         
         else { //try aligning and see if you can find it
             Alignment* alignment;
-            if (spacer.size() > 0) { alignment = new NeedlemanOverlap(-1.0, 1.0, -1.0, (maxSpacerLength+sdiffs+1)); }
+            if (spacer.size() > 0) { alignment = getAligner(maxSpacerLength+sdiffs+1); }
             else{ alignment = NULL; }
             
             //can you find the barcode
@@ -2861,7 +3031,6 @@ bool TrimOligos::stripSpacer(Sequence& seq){
                 success = minDiff;
             }
             
-            if (alignment != NULL) { delete alignment; }
             
         }
         
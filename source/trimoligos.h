@@ -14,7 +14,9 @@
 #include "mothurout.h"
 #include "sequence.hpp"
 #include "qualityscores.h"
+#include "oligoindex.h"
 
+class Alignment;
 
 class TrimOligos {
 	
@@ -71,11 +73,19 @@ class TrimOligos {
         map<int, oligosPair> ipprimers;
     
         int maxFBarcodeLength, maxRBarcodeLength, maxFPrimerLength, maxRPrimerLength, maxLinkerLength, maxSpacerLength;
+    
+        //only the oligos the index finds near the start of a read are aligned
+        OligoIndex barcodeIndex, primerIndex, fBarcodeIndex, rBarcodeIndex, fPrimerIndex, rPrimerIndex, rcBarcodeIndex, rcPrimerIndex;
+        Alignment* aligner;
+        int alignerLength;
 	
 		MothurOut* m;
 	
 		bool compareDNASeq(string, string);				
 		int countDiffs(string, string);
+        Alignment* getAligner(int);
+        void indexOligos();
+        int getClosestDiffs(OligoIndex&, string&, int, bool, int); //index, seq, diffs, slide the oligos along the seq, fewest diffs of the oligos already aligned
         
         vector<int> stripPairedBarcode(Sequence& seq, QualityScores& qual, int& group);
         vector<int> stripPairedPrimers(Sequence& seq, QualityScores& qual, int& group, bool);
@@ -1,17 +1,18 @@
+#include "myutils.h"
+
 #if	UCHIMES
 
-#include "myutils.h"
 #include "chime.h"
 #include "ultra.h"
 #include <set>
+#include <algorithm>
 
 const float MAX_WORD_COUNT_DROP = 1;
 
 void SortDescending(const vector<float> &Values, vector<unsigned> &Order);
 bool GlobalAlign(const SeqData &Query, const SeqData &Target, string &Path);
 double GetFractIdGivenPath(const byte *A, const byte *B, const char *Path);
-void USort(const SeqData &Query, const SeqDB &DB, vector<float> &WordCounts,
-  vector<unsigned> &Order);
+void GetWordCounts(const SeqData &Query, const SeqDB &DB, vector<float> &WordCounts);
 
 void AddTargets(SeqDB &DB, const SeqData &Query, set<unsigned> &TargetIndexes)
 	{
@@ -19,19 +20,16 @@ void AddTargets(SeqDB &DB, const SeqData &Query, set<unsigned> &TargetIndexes)
 	if (SeqCount == 0)
 		return;
 
+// Same targets as taking the USort order until the count drops, without sorting the whole db
 	vector<float> WordCounts;
-	vector<unsigned> Order;
-	USort(Query, DB, WordCounts, Order);
-	asserta(SIZE(Order) == SeqCount);
-	unsigned TopSeqIndex = Order[0];
-	float TopWordCount = WordCounts[TopSeqIndex];
-	for (unsigned i = 0; i < SeqCount; ++i)
+	GetWordCounts(Query, DB, WordCounts);
+	asserta(SIZE(WordCounts) == SeqCount);
+	float TopWordCount = *max_element(WordCounts.begin(), WordCounts.end());
+	for (unsigned SeqIndex = 0; SeqIndex < SeqCount; ++SeqIndex)
 		{
-		unsigned SeqIndex = Order[i];
 		float WordCount = WordCounts[SeqIndex];
-		if (TopWordCount - WordCount > MAX_WORD_COUNT_DROP)
-			return;
-		TargetIndexes.insert(SeqIndex);
+		if (TopWordCount - WordCount <= MAX_WORD_COUNT_DROP)
+			TargetIndexes.insert(SeqIndex);
 		}
 	}
 
@@ -499,7 +499,7 @@ void AlignChimeGlobal3(const string &Q3, const string &A3, const string &B3,
 	double ScoreR = GetScore2(Hit.CS_RY, Hit.CS_RN, Hit.CS_RA);
 	Hit.Score = ScoreL*ScoreR;
 
-	extern bool g_UchimeDeNovo;
+	extern thread_local bool g_UchimeDeNovo;
 
 	//if (0)//g_UchimeDeNovo)
 	//	{
@@ -519,12 +519,9 @@ void AlignChimeGlobal3(const string &Q3, const string &A3, const string &B3,
 	//		}
 	//	}
 
-	extern FILE *g_fUChimeAlns;
-	if (g_fUChimeAlns != 0 && Hit.Div > 0.0)
-		{
-		void WriteChimeHitX(FILE *f, const ChimeHit2 &Hit);
-		WriteChimeHitX(g_fUChimeAlns, Hit);
-		}
+	extern thread_local string *g_UChimeAlns;
+	if (g_UChimeAlns != 0 && Hit.Div > 0.0)
+		WriteChimeHitX(*g_UChimeAlns, Hit);
 	}
 
 void AlignChime3(const string &Q3, const string &A3, const string &B3,
@@ -98,7 +98,8 @@ static bool inline isgap(char c)
 void GetChunkInfo(unsigned L, unsigned &Length, vector<unsigned> &Los);
 float GetAbFromLabel(const string &Label);
 void WriteChimeHitCS(FILE *f, const ChimeHit2 &Hit);
-void WriteChimeHit(FILE *f, const ChimeHit2 &Hit);
-void WriteChimeFileHdr(FILE *f);
+void WriteChimeHit(string &s, const ChimeHit2 &Hit);
+void WriteChimeHitX(string &s, const ChimeHit2 &Hit);
+void WriteChimeFileHdr(string &s);
 
 #endif // chime_h
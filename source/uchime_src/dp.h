@@ -111,10 +111,10 @@ const byte TRACEBITS_MI = 0x08;
 const byte TRACEBITS_SM = 0x10;
 const byte TRACEBITS_UNINIT = ~0x1f;
 
-extern Mx<byte> g_Mx_TBBit;
-extern float *g_DPRow1;
-extern float *g_DPRow2;
-extern byte **g_TBBit;
+extern thread_local Mx<byte> g_Mx_TBBit;
+extern thread_local float *g_DPRow1;
+extern thread_local float *g_DPRow2;
+extern thread_local byte **g_TBBit;
 
 static inline void Max_xM(float &Score, float MM, float DM, float IM, byte &State)
 	{
@@ -1,3 +1,5 @@
+#include "myutils.h"
+
 #if	UCHIMES
 
 #include "dp.h"
@@ -6,13 +8,17 @@
 static AlnParams g_AP;
 static bool g_APInitDone = false;
 
+// Called before aligning on more than one thread, the threads then only read g_AP
+void InitGlobalAlign()
+	{
+	g_AP.InitFromCmdLine(true);
+	g_APInitDone = true;
+	}
+
 bool GlobalAlign(const SeqData &Query, const SeqData &Target, PathData &PD)
 	{
 	if (!g_APInitDone)
-		{
-		g_AP.InitFromCmdLine(true);
-		g_APInitDone = true;
-		}
+		InitGlobalAlign();
 
 	ViterbiFast(Query.Seq, Query.L, Target.Seq, Target.L, g_AP, PD);
 	return true;
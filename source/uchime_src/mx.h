@@ -126,17 +126,17 @@ public:
 	const SeqData *m_SA;
 	const SeqData *m_SB;
 
-	static list<MxBase *> *m_Matrices;
+	static thread_local list<MxBase *> *m_Matrices;
 	//static MxBase *Get(const string &Name);
 	//static float **Getf(const string &Name);
 	//static double **Getd(const string &Name);
 	//static char **Getc(const string &Name);
 
-	static unsigned m_AllocCount;
-	static unsigned m_ZeroAllocCount;
-	static unsigned m_GrowAllocCount;
-	static double m_TotalBytes;
-	static double m_MaxBytes;
+	static thread_local unsigned m_AllocCount;
+	static thread_local unsigned m_ZeroAllocCount;
+	static thread_local unsigned m_GrowAllocCount;
+	static thread_local double m_TotalBytes;
+	static thread_local double m_MaxBytes;
 
 	static void OnCtor(MxBase *Mx);
 	static void OnDtor(MxBase *Mx);
@@ -14,8 +14,9 @@ struct PathBuffer
 	bool InUse;
 	};
 
-static PathBuffer **g_PathBuffers;
-static unsigned g_PathBufferSize;
+// Per thread, so threads can align at the same time
+static thread_local PathBuffer **g_PathBuffers;
+static thread_local unsigned g_PathBufferSize;
 
 static char *AllocBuffer(unsigned Size)
 	{
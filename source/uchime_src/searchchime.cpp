@@ -8,8 +8,6 @@
 
 #define TRACE	0
 
-extern FILE *g_fUChime;
-
 void GetCandidateParents(Ultra &U, const SeqData &QSD, float AbQ,
   vector<unsigned> &Parents);
 
@@ -5,6 +5,8 @@
 #include "sfasta.h"
 #include "seq.h"
 
+void GetWords(const byte *Seq, unsigned L, vector<unsigned> &Words);
+
 void SeqToFasta(FILE *f, const char *Label, const byte *Seq, unsigned L)
 	{
 	const unsigned ROWLEN = 80;
@@ -59,6 +61,9 @@ void SeqDB::Clear(bool ctor)
 	m_Aligned = false;
 	m_IsNucleo = false;
 	m_IsNucleoSet = false;
+
+	m_IndexWords = false;
+	m_Words.clear();
 	}
 
 void SeqDB::InitEmpty(bool Nucleo)
@@ -263,10 +268,24 @@ unsigned SeqDB::AddSeq(const char *Label, const byte *Seq, unsigned L)
 
 	m_SeqLengths[Index] = L;
 
+	if (m_IndexWords)
+		{
+		m_Words.resize(m_SeqCount);
+		GetWords(m_Seqs[Index], L, m_Words[Index]);
+		}
+
 	EndTimer(AddSeq);
 	return Index;
 	}
 
+void SeqDB::IndexWords()
+	{
+	m_IndexWords = true;
+	m_Words.resize(m_SeqCount);
+	for (unsigned Index = 0; Index < m_SeqCount; ++Index)
+		GetWords(m_Seqs[Index], m_SeqLengths[Index], m_Words[Index]);
+	}
+
 unsigned SeqDB::GetIndex(const char *Label) const
 	{
 	for (unsigned i = 0; i < m_SeqCount; ++i)
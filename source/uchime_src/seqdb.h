@@ -26,6 +26,10 @@ public:
 	bool m_IsNucleo;
 	bool m_IsNucleoSet;
 
+// Words of each sequence, kept by IndexWords so USort only looks them up
+	bool m_IndexWords;
+	vector<vector<unsigned> > m_Words;
+
 public:
 	SeqDB();
 	~SeqDB();
@@ -90,6 +94,7 @@ public:
 	unsigned GetMaxLabelLength() const;
 	unsigned GetMaxSeqLength() const;
 	void SetIsNucleo();
+	void IndexWords();
 	unsigned GetIndex(const char *Label) const;
 	void MakeLabelToIndex(map<string, unsigned> &LabelToIndex);
 
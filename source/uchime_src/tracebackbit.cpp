@@ -2,14 +2,15 @@
 
 #define TRACE	0
 
-Mx<byte> g_Mx_TBBit;
-byte **g_TBBit;
-float *g_DPRow1;
-float *g_DPRow2;
-static float *g_DPBuffer1;
-static float *g_DPBuffer2;
-
-static unsigned g_CacheLB;
+// Per thread, so threads can align at the same time
+thread_local Mx<byte> g_Mx_TBBit;
+thread_local byte **g_TBBit;
+thread_local float *g_DPRow1;
+thread_local float *g_DPRow2;
+static thread_local float *g_DPBuffer1;
+static thread_local float *g_DPBuffer2;
+
+static thread_local unsigned g_CacheLB;
 
 void AllocBit(unsigned LA, unsigned LB)
 	{
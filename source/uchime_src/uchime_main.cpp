@@ -13,79 +13,11 @@ bool SearchChime(Ultra &U, const SeqData &QSD, float QAb,
 
 FILE *g_fUChime;
 FILE *g_fUChimeAlns;
-const vector<float> *g_SortVecFloat;
-bool g_UchimeDeNovo = false;
+extern thread_local string *g_UChimeAlns;
+extern thread_local bool g_UchimeDeNovo;
 
-void Usage()
-	{
-	printf("\n");
-	printf("UCHIME %s by Robert C. Edgar\n", MY_VERSION);
-	printf("http://www.drive5.com/uchime\n");
-	printf("\n");
-	printf("This software is donated to the public domain\n");
-	printf("\n");
-
-	printf(
-#include "help.h"
-		);
-	}
-
-void SetBLOSUM62()
-	{
-	Die("SetBLOSUM62 not implemented");
-	}
-
-void ReadSubstMx(const string &/*FileName*/, Mx<float> &/*Mxf*/)
-	{
-	Die("ReadSubstMx not implemented");
-	}
-
-void LogAllocs()
-	{
-	/*empty*/
-	}
-
-static bool CmpDescVecFloat(unsigned i, unsigned j)
-	{
-	return (*g_SortVecFloat)[i] > (*g_SortVecFloat)[j];
-	}
-
-void Range(vector<unsigned> &v, unsigned N)
-	{
-	v.clear();
-	v.reserve(N);
-	for (unsigned i = 0; i < N; ++i)
-		v.push_back(i);
-	}
-
-void SortDescending(const vector<float> &Values, vector<unsigned> &Order)
-	{
-	StartTimer(Sort);
-	const unsigned N = SIZE(Values);
-	Range(Order, N);
-	g_SortVecFloat = &Values;
-	sort(Order.begin(), Order.end(), CmpDescVecFloat);
-	EndTimer(Sort);
-	}
-
-float GetAbFromLabel(const string &Label)
-	{
-	vector<string> Fields;
-	Split(Label, Fields, '/');
-	const unsigned N = SIZE(Fields);
-	for (unsigned i = 0; i < N; ++i)
-		{
-		const string &Field = Fields[i];
-		if (Field.substr(0, 3) == "ab=")
-			{
-			string a = Field.substr(3, string::npos);
-			return (float) atof(a.c_str());
-			}
-		}
-	if (g_UchimeDeNovo)
-		Die("Missing abundance /ab=xx/ in label >%s", Label.c_str());
-	return 0.0;
-	}
+void SortDescending(const vector<float> &Values, vector<unsigned> &Order);
+float GetAbFromLabel(const string &Label);
 
 int main(int argc, char *argv[])
 	{
@@ -134,8 +66,12 @@ int main(int argc, char *argv[])
 	if (opt_uchimeout != "")
 		g_fUChime = CreateStdioFile(opt_uchimeout);
 
+	string Alns;
 	if (opt_uchimealns != "")
+		{
 		g_fUChimeAlns = CreateStdioFile(opt_uchimealns);
+		g_UChimeAlns = &Alns;
+		}
 
 	SeqDB Input;
 	SeqDB DB;
@@ -169,6 +105,8 @@ int main(int argc, char *argv[])
 			Die("Database contains amino acid sequences");
 		}
 
+	DB.IndexWords();
+
 	vector<ChimeHit2> Hits;
 	unsigned HitCount = 0;
 	for (unsigned i = 0; i < QuerySeqCount; ++i)
@@ -195,7 +133,17 @@ int main(int argc, char *argv[])
 				DB.AddSeq(QSD.Label, QSD.Seq, QSD.L);
 			}
 
-		WriteChimeHit(g_fUChime, Hit);
+		if (g_fUChime != 0)
+			{
+			string s;
+			WriteChimeHit(s, Hit);
+			fputs(s.c_str(), g_fUChime);
+			}
+		if (g_fUChimeAlns != 0)
+			{
+			fputs(Alns.c_str(), g_fUChimeAlns);
+			Alns.clear();
+			}
 
 		ProgressStep(i, QuerySeqCount, "%u/%u chimeras found (%.1f%%)", HitCount, i, Pct(HitCount, i+1));
 		}
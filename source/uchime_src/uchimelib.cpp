@@ -0,0 +1,241 @@
+#include "myutils.h"
+#include "chime.h"
+#include "seqdb.h"
+#include "dp.h"
+#include "ultra.h"
+#include "hspfinder.h"
+#include "uchimelib.h"
+#include <algorithm>
+#include <set>
+
+bool SearchChime(Ultra &U, const SeqData &QSD, float QAb,
+  const AlnParams &AP, const AlnHeuristics &AH, HSPFinder &HF,
+  float MinFractId, ChimeHit2 &Hit);
+
+void InitGlobalAlign();
+
+// Per thread, each thread runs its own search
+thread_local string *g_UChimeAlns;
+thread_local bool g_UchimeDeNovo = false;
+
+static float g_MinFractId = 0.95f;
+
+void SetBLOSUM62()
+	{
+	Die("SetBLOSUM62 not implemented");
+	}
+
+void ReadSubstMx(const string &/*FileName*/, Mx<float> &/*Mxf*/)
+	{
+	Die("ReadSubstMx not implemented");
+	}
+
+void LogAllocs()
+	{
+	/*empty*/
+	}
+
+void Usage()
+	{
+	printf("\n");
+	printf("UCHIME %s by Robert C. Edgar\n", MY_VERSION);
+	printf("http://www.drive5.com/uchime\n");
+	printf("\n");
+	printf("This software is donated to the public domain\n");
+	printf("\n");
+
+	printf(
+#include "help.h"
+		);
+	}
+
+struct CmpDescVecFloat
+	{
+	const vector<float> &Values;
+
+	CmpDescVecFloat(const vector<float> &v) : Values(v) {}
+
+	bool operator()(unsigned i, unsigned j) const
+		{
+		return Values[i] > Values[j];
+		}
+	};
+
+void Range(vector<unsigned> &v, unsigned N)
+	{
+	v.clear();
+	v.reserve(N);
+	for (unsigned i = 0; i < N; ++i)
+		v.push_back(i);
+	}
+
+void SortDescending(const vector<float> &Values, vector<unsigned> &Order)
+	{
+	StartTimer(Sort);
+	const unsigned N = SIZE(Values);
+	Range(Order, N);
+	sort(Order.begin(), Order.end(), CmpDescVecFloat(Values));
+	EndTimer(Sort);
+	}
+
+float GetAbFromLabel(const string &Label)
+	{
+	vector<string> Fields;
+	Split(Label, Fields, '/');
+	const unsigned N = SIZE(Fields);
+	for (unsigned i = 0; i < N; ++i)
+		{
+		const string &Field = Fields[i];
+		if (Field.substr(0, 3) == "ab=")
+			{
+			string a = Field.substr(3, string::npos);
+			return (float) atof(a.c_str());
+			}
+		}
+	if (g_UchimeDeNovo)
+		Die("Missing abundance /ab=xx/ in label >%s", Label.c_str());
+	return 0.0;
+	}
+
+void UchimeSetOptions(const vector<string> &Args)
+	{
+	vector<string> Argv(1, "uchime");
+	Argv.insert(Argv.end(), Args.begin(), Args.end());
+
+	vector<char *> argv;
+	for (unsigned i = 0; i < SIZE(Argv); ++i)
+		argv.push_back(&Argv[i][0]);
+	MyCmdLine((int) SIZE(argv), &argv[0]);
+
+	opt_quiet = true;
+	if (!optset_w)
+		opt_w = 8;
+
+	g_MinFractId = 0.95f;
+	if (optset_id)
+		g_MinFractId = (float) opt_id;
+
+	InitGlobalAlign();
+	}
+
+SeqDB *UchimeLoadDB(const string &FileName, string &Error)
+	{
+	Error.clear();
+	SeqDB *DB = new SeqDB;
+	DB->FromFasta(FileName);
+	if (!DB->IsNucleo())
+		{
+		Error = "Database contains amino acid sequences";
+		delete DB;
+		return 0;
+		}
+	DB->IndexWords();
+	return DB;
+	}
+
+void UchimeFreeDB(SeqDB *DB)
+	{
+	delete DB;
+	}
+
+static bool HasAbInLabel(const string &Label)
+	{
+	vector<string> Fields;
+	Split(Label, Fields, '/');
+	for (unsigned i = 0; i < SIZE(Fields); ++i)
+		if (Fields[i].substr(0, 3) == "ab=")
+			return true;
+	return false;
+	}
+
+unsigned UchimeSearch(SeqDB *RefDB, const vector<string> &Labels,
+  const vector<string> &Seqs, string &Report, string *Alns, string &Error)
+	{
+	Error.clear();
+	g_UchimeDeNovo = (RefDB == 0);
+	g_UChimeAlns = Alns;
+
+// GetAbFromLabel dies on a missing abundance, check first so the caller
+// can report it
+	if (g_UchimeDeNovo)
+		for (unsigned i = 0; i < SIZE(Labels); ++i)
+			if (!HasAbInLabel(Labels[i]))
+				{
+				Error = "Missing abundance /ab=xx/ in label >" + Labels[i];
+				return 0;
+				}
+
+// Labels and letters as SFasta reads them, skipping the same lengths
+	SeqDB Input;
+	Input.InitEmpty(true);
+	for (unsigned i = 0; i < SIZE(Seqs); ++i)
+		{
+		string Label = Labels[i];
+		replace(Label.begin(), Label.end(), '\t', ' ');
+
+		string Seq;
+		Seq.reserve(Seqs[i].size());
+		for (unsigned j = 0; j < SIZE(Seqs[i]); ++j)
+			if (isalpha((byte) Seqs[i][j]))
+				Seq.push_back(Seqs[i][j]);
+
+		const unsigned L = SIZE(Seq);
+		if (L < opt_minlen || (L > opt_maxlen && opt_maxlen != 0))
+			continue;
+
+		Input.AddSeq(Label.c_str(), (const byte *) Seq.c_str(), L);
+		}
+
+	const unsigned QuerySeqCount = Input.GetSeqCount();
+	vector<unsigned> Order;
+	for (unsigned i = 0; i < QuerySeqCount; ++i)
+		Order.push_back(i);
+
+	SeqDB DeNovoDB;
+	if (g_UchimeDeNovo)
+		{
+		vector<float> Abs;
+		for (unsigned i = 0; i < QuerySeqCount; ++i)
+			{
+			const char *Label = Input.GetLabel(i);
+			float Ab = GetAbFromLabel(Label);
+			Abs.push_back(Ab);
+			}
+		SortDescending(Abs, Order);
+		DeNovoDB.m_IsNucleoSet = true;
+		DeNovoDB.m_IsNucleo = true;
+		DeNovoDB.IndexWords();
+		}
+	SeqDB &DB = (g_UchimeDeNovo ? DeNovoDB : *RefDB);
+
+	unsigned HitCount = 0;
+	for (unsigned i = 0; i < QuerySeqCount; ++i)
+		{
+		unsigned QuerySeqIndex = Order[i];
+
+		SeqData QSD;
+		Input.GetSeqData(QuerySeqIndex, QSD);
+
+		float QAb = -1.0;
+		if (g_UchimeDeNovo)
+			QAb = GetAbFromLabel(QSD.Label);
+
+		ChimeHit2 Hit;
+		AlnParams &AP = *(AlnParams *) 0;
+		AlnHeuristics &AH = *(AlnHeuristics *) 0;
+		HSPFinder &HF = *(HSPFinder *) 0;
+		bool Found = SearchChime(DB, QSD, QAb, AP, AH, HF, g_MinFractId, Hit);
+		if (Found)
+			++HitCount;
+		else
+			{
+			if (g_UchimeDeNovo)
+				DB.AddSeq(QSD.Label, QSD.Seq, QSD.L);
+			}
+
+		WriteChimeHit(Report, Hit);
+		}
+
+	g_UChimeAlns = 0;
+	return HitCount;
+	}
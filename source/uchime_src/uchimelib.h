@@ -0,0 +1,30 @@
+#ifndef uchimelib_h
+#define uchimelib_h
+
+// The uchime search for programs that link it in, such as mothur, on
+// sequences in memory instead of FASTA files.
+//
+// UchimeSetOptions takes the uchime command line options and must be
+// called before searching. A reference from UchimeLoadDB is only read
+// by UchimeSearch, so several threads can search it at the same time.
+// With no reference the search is de novo, the labels carry /ab=N/ and
+// each search builds its own reference from the more abundant queries.
+
+#include <string>
+#include <vector>
+
+struct SeqDB;
+
+void UchimeSetOptions(const std::vector<std::string> &Args);
+// Returns 0 and sets Error if the reference can not be searched.
+SeqDB *UchimeLoadDB(const std::string &FileName, std::string &Error);
+void UchimeFreeDB(SeqDB *DB);
+
+// Report gets the --uchimeout lines in the order the queries are checked
+// and Alns the --uchimealns text. Returns the number of chimeras found.
+// Error is set instead of searching when a de novo label has no /ab=N/.
+unsigned UchimeSearch(SeqDB *DB, const std::vector<std::string> &Labels,
+  const std::vector<std::string> &Seqs, std::string &Report, std::string *Alns,
+  std::string &Error);
+
+#endif // uchimelib_h
@@ -1,14 +1,15 @@
+#include "myutils.h"
+
 #if	UCHIMES
 
-#include "myutils.h"
 #include "seqdb.h"
 #include "seq.h"
 #include "alpha.h"
 
 void SortDescending(const vector<float> &Values, vector<unsigned> &Order);
 
-static byte *g_QueryHasWord;
-static unsigned g_WordCount;
+static thread_local vector<byte> g_QueryHasWord;
+static thread_local unsigned g_WordCount;
 
 unsigned GetWord(const byte *Seq)
 	{
@@ -24,16 +25,16 @@ unsigned GetWord(const byte *Seq)
 
 static void SetQuery(const SeqData &Query)
 	{
-	if (g_QueryHasWord == 0)
+	if (g_QueryHasWord.empty())
 		{
 		g_WordCount = 4;
 		for (unsigned i = 1; i < opt_w; ++i)
 			g_WordCount *= 4;
 
-		g_QueryHasWord = myalloc(byte, g_WordCount);
+		g_QueryHasWord.resize(g_WordCount);
 		}
 
-	memset(g_QueryHasWord, 0, g_WordCount);
+	memset(&g_QueryHasWord[0], 0, g_WordCount);
 
 	if (Query.L <= opt_w)
 		return;
@@ -64,22 +65,57 @@ static unsigned GetUniqueWordsInCommon(const SeqData &Target)
 	return Count;
 	}
 
-void USort(const SeqData &Query, const SeqDB &DB, vector<float> &WordCounts, 
-  vector<unsigned> &Order)
+static unsigned GetUniqueWordsInCommon(const vector<unsigned> &Words)
+	{
+	unsigned Count = 0;
+	const unsigned N = SIZE(Words);
+	for (unsigned i = 0; i < N; ++i)
+		if (g_QueryHasWord[Words[i]])
+			++Count;
+	return Count;
+	}
+
+// Words of a sequence in order, for SeqDB::IndexWords
+void GetWords(const byte *Seq, unsigned L, vector<unsigned> &Words)
+	{
+	Words.clear();
+	if (L <= opt_w)
+		return;
+
+	const unsigned N = L - opt_w + 1;
+	Words.reserve(N);
+	for (unsigned i = 0; i < N; ++i)
+		Words.push_back(GetWord(Seq++));
+	}
+
+void GetWordCounts(const SeqData &Query, const SeqDB &DB, vector<float> &WordCounts)
 	{
 	WordCounts.clear();
-	Order.clear();
 
 	SetQuery(Query);
 
 	const unsigned SeqCount = DB.GetSeqCount();
+	WordCounts.reserve(SeqCount);
 	for (unsigned SeqIndex = 0; SeqIndex < SeqCount; ++SeqIndex)
 		{
-		SeqData Target;
-		DB.GetSeqData(SeqIndex, Target);
-		float WordCount = (float) GetUniqueWordsInCommon(Target);
+		float WordCount;
+		if (DB.m_IndexWords)
+			WordCount = (float) GetUniqueWordsInCommon(DB.m_Words[SeqIndex]);
+		else
+			{
+			SeqData Target;
+			DB.GetSeqData(SeqIndex, Target);
+			WordCount = (float) GetUniqueWordsInCommon(Target);
+			}
 		WordCounts.push_back(WordCount);
 		}
+	}
+
+void USort(const SeqData &Query, const SeqDB &DB, vector<float> &WordCounts, 
+  vector<unsigned> &Order)
+	{
+	Order.clear();
+	GetWordCounts(Query, DB, WordCounts);
 	SortDescending(WordCounts, Order);
 	}
 